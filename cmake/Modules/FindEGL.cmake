@@ -0,0 +1,38 @@
+# Find the EGL library.
+#
+# This module defines the following variables:
+#
+# * EGL_INCLUDE_DIRS
+# * EGL_LIBRARIES
+#
+# This module defines the following imported targets:
+#
+# * EGL::EGL
+#
+# This module defines the following interfaces:
+#
+# * EGL
+
+find_path(EGL_INCLUDE_DIR NAMES EGL/egl.h)
+set(EGL_INCLUDE_DIRS ${EGL_INCLUDE_DIR})
+
+find_library(EGL_LIBRARY NAMES EGL)
+set(EGL_LIBRARIES ${EGL_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    EGL
+    REQUIRED_VARS EGL_INCLUDE_DIR EGL_LIBRARY)
+mark_as_advanced(EGL_INCLUDE_DIR EGL_LIBRARY)
+
+if(EGL_FOUND AND NOT TARGET EGL::EGL)
+    add_library(EGL::EGL UNKNOWN IMPORTED)
+    set_target_properties(EGL::EGL PROPERTIES
+        IMPORTED_LOCATION "${EGL_LIBRARY}"
+        INTERFACE_COMPILE_DEFINITIONS EGL_FOUND
+        INTERFACE_INCLUDE_DIRECTORIES "${EGL_INCLUDE_DIR}")
+endif()
+if(EGL_FOUND AND NOT TARGET EGL)
+    add_library(EGL INTERFACE)
+    target_link_libraries(EGL INTERFACE EGL::EGL)
+endif()
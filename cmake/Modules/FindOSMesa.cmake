@@ -0,0 +1,38 @@
+# Find the OSMesa library.
+#
+# This module defines the following variables:
+#
+# * OSMesa_INCLUDE_DIRS
+# * OSMesa_LIBRARIES
+#
+# This module defines the following imported targets:
+#
+# * OSMesa::OSMesa
+#
+# This module defines the following interfaces:
+#
+# * OSMesa
+
+find_path(OSMesa_INCLUDE_DIR NAMES GL/osmesa.h)
+set(OSMesa_INCLUDE_DIRS ${OSMesa_INCLUDE_DIR})
+
+find_library(OSMesa_LIBRARY NAMES OSMesa OSMesa32 OSMesa16)
+set(OSMesa_LIBRARIES ${OSMesa_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    OSMesa
+    REQUIRED_VARS OSMesa_INCLUDE_DIR OSMesa_LIBRARY)
+mark_as_advanced(OSMesa_INCLUDE_DIR OSMesa_LIBRARY)
+
+if(OSMesa_FOUND AND NOT TARGET OSMesa::OSMesa)
+    add_library(OSMesa::OSMesa UNKNOWN IMPORTED)
+    set_target_properties(OSMesa::OSMesa PROPERTIES
+        IMPORTED_LOCATION "${OSMesa_LIBRARY}"
+        INTERFACE_COMPILE_DEFINITIONS OSMesa_FOUND
+        INTERFACE_INCLUDE_DIRECTORIES "${OSMesa_INCLUDE_DIR}")
+endif()
+if(OSMesa_FOUND AND NOT TARGET OSMesa)
+    add_library(OSMesa INTERFACE)
+    target_link_libraries(OSMesa INTERFACE OSMesa::OSMesa)
+endif()
@@ -5,6 +5,8 @@ set(tlRender_ARGS
     -DTLRENDER_MMAP=${TLRENDER_MMAP}
     -DTLRENDER_PYTHON=${TLRENDER_PYTHON}
     -DTLRENDER_GLFW=${TLRENDER_GLFW}
+    -DTLRENDER_EGL=${TLRENDER_EGL}
+    -DTLRENDER_OSMESA=${TLRENDER_OSMESA}
     -DTLRENDER_OCIO=${TLRENDER_OCIO}
     -DTLRENDER_AUDIO=${TLRENDER_AUDIO}
     -DTLRENDER_JPEG=${TLRENDER_JPEG}
@@ -21,9 +21,6 @@
 #include <tlGlad/gl.h>
 #endif // TLRENDER_GL_DEBUG
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
 #include <opentimelineio/clip.h>
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/externalReference.h>
@@ -48,44 +45,15 @@ namespace tl
                     "test-patterns",
                     "Example test patterns application.");
 
-                // Create the window.
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_FALSE);
-                _glfwWindow = glfwCreateWindow(
-                    100,
-                    100,
-                    "tlbake",
-                    NULL,
-                    NULL);
-                if (!_glfwWindow)
-                {
-                    throw std::runtime_error("Cannot create window");
-                }
-                glfwMakeContextCurrent(_glfwWindow);
-                if (!gladLoaderLoadGL())
-                {
-                    throw std::runtime_error("Cannot initialize GLAD");
-                }
-                const int glMajor = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_VERSION_MAJOR);
-                const int glMinor = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_VERSION_MINOR);
-                const int glRevision = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_REVISION);
-                _log(string::Format("OpenGL version: {0}.{1}.{2}").arg(glMajor).arg(glMinor).arg(glRevision));
+                // Create the OpenGL context.
+                _glContext = gl::OffscreenContext::create(context);
             }
 
             App::App()
             {}
 
             App::~App()
-            {
-                if (_glfwWindow)
-                {
-                    glfwDestroyWindow(_glfwWindow);
-                }
-            }
+            {}
 
             std::shared_ptr<App> App::create(
                 int argc,
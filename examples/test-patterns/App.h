@@ -4,7 +4,7 @@
 
 #include <tlApp/IApp.h>
 
-struct GLFWwindow;
+#include <tlGL/OffscreenContext.h>
 
 namespace tl
 {
@@ -38,7 +38,7 @@ namespace tl
                 void run();
 
             private:
-                GLFWwindow* _glfwWindow = nullptr;
+                std::shared_ptr<gl::OffscreenContext> _glContext;
             };
         }
     }
@@ -4,14 +4,19 @@
 
 #include <tlBakeApp/App.h>
 
+#include <tlTimeline/FrameCacheSystem.h>
 #include <tlTimeline/GLRender.h>
+#include <tlTimeline/Util.h>
 
 #include <tlGL/Util.h>
 
 #include <tlIO/IOSystem.h>
 
 #include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/ImageConvert.h>
 #include <tlCore/Math.h>
+#include <tlCore/OS.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
@@ -22,13 +27,24 @@
 #include <tlGlad/gl.h>
 #endif // TLRENDER_GL_DEBUG
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
+#include <opentimelineio/clip.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace tl
 {
     namespace bake
     {
+        TLRENDER_ENUM_IMPL(
+            Renderer,
+            "GL",
+            "CPU");
+        TLRENDER_ENUM_SERIALIZE_IMPL(Renderer);
+
         namespace
         {
 #if defined(TLRENDER_GL_DEBUG)
@@ -59,6 +75,32 @@ namespace tl
                 }
             }
 #endif // TLRENDER_GL_DEBUG
+
+            // Add a worker command line option.
+            template<typename T>
+            void addWorkerArg(
+                std::vector<std::string>& args,
+                const std::string& name,
+                const T& value)
+            {
+                std::stringstream ss;
+                ss << value;
+                args.push_back(name);
+                args.push_back(ss.str());
+            }
+
+            // Get the segment file name used for a chunk of a movie.
+            std::string getChunkOutput(const std::string& output, size_t index, size_t count)
+            {
+                const file::Path path(output);
+                return string::Format("{0}{1}{2}.chunk{3}of{4}{5}").
+                    arg(path.getDirectory()).
+                    arg(path.getBaseName()).
+                    arg(path.getNumber()).
+                    arg(index + 1).
+                    arg(count).
+                    arg(path.getExtension());
+            }
         }
 
         void App::_init(
@@ -66,6 +108,11 @@ namespace tl
             char* argv[],
             const std::shared_ptr<system::Context>& context)
         {
+            if (argc > 0)
+            {
+                _program = argv[0];
+            }
+
             IApp::_init(
                 argc,
                 argv,
@@ -85,8 +132,43 @@ namespace tl
                 {
                     app::CmdLineValueOption<otime::TimeRange>::create(
                         _options.inOutRange,
-                        { "-inOutRange" },
+                        { "-inOutRange", "-range" },
                         "Set the in/out points range."),
+                    app::CmdLineValueOption<std::string>::create(
+                        _options.chunk,
+                        { "-chunk" },
+                        "Render one chunk of the in/out points range, given as \"i/K\" for chunk i of K chunks (e.g., 1/4)."),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.workers,
+                        { "-workers" },
+                        "Split the render into chunks and run them with this number of local worker processes.",
+                        string::Format("{0}").arg(_options.workers)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.chunks,
+                        { "-chunks" },
+                        "Number of chunks for the worker processes. By default there is one chunk for each worker.",
+                        string::Format("{0}").arg(_options.chunks)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.retries,
+                        { "-retries" },
+                        "Number of times a failed chunk is retried.",
+                        string::Format("{0}").arg(_options.retries)),
+                    app::CmdLineValueOption<std::string>::create(
+                        _options.manifest,
+                        { "-manifest" },
+                        "Manifest file written after the worker processes finish. By default the output file name with \".manifest.json\" appended."),
+                    app::CmdLineValueOption<Renderer>::create(
+                        _options.renderer,
+                        { "-renderer" },
+                        "Renderer. The CPU renderer can be used on machines without a GPU.",
+                        string::Format("{0}").arg(_options.renderer),
+                        string::join(getRendererLabels(), ", ")),
+                    app::CmdLineValueOption<gl::ContextBackend>::create(
+                        _options.glContext,
+                        { "-glContext", "-glc" },
+                        "OpenGL context backend. The EGL and OSMesa backends can be used on machines without a display.",
+                        string::Format("{0}").arg(_options.glContext),
+                        string::join(gl::getContextBackendLabels(), ", ")),
                     app::CmdLineValueOption<image::Size>::create(
                         _options.renderSize,
                         { "-renderSize", "-rs" },
@@ -123,6 +205,21 @@ namespace tl
                         "LUT operation order.",
                         string::Format("{0}").arg(_options.lutOptions.order),
                         string::join(timeline::getLUTOrderLabels(), ", ")),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.requestCount,
+                        { "-requestCount" },
+                        "Number of frames requested ahead of the render.",
+                        string::Format("{0}").arg(_options.requestCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.readbackCount,
+                        { "-readbackCount" },
+                        "Number of frames read back from the GPU asynchronously.",
+                        string::Format("{0}").arg(_options.readbackCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.writeQueueCount,
+                        { "-writeQueueCount" },
+                        "Maximum number of frames waiting to be written.",
+                        string::Format("{0}").arg(_options.writeQueueCount)),
                     app::CmdLineValueOption<float>::create(
                         _options.sequenceDefaultSpeed,
                         { "-sequenceDefaultSpeed" },
@@ -263,6 +360,10 @@ namespace tl
 #endif // TLRENDER_USD
             auto ioSystem = context->getSystem<io::System>();
             ioSystem->setOptions(ioOptions);
+
+            // Each frame is only rendered once, so the frame cache is not
+            // used.
+            context->getSystem<timeline::FrameCacheSystem>()->setMax(0);
         }
 
         App::App()
@@ -270,13 +371,26 @@ namespace tl
 
         App::~App()
         {
+            if (_writeThread.joinable())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.frames.clear();
+                    _writeMutex.finish = true;
+                }
+                _writeCV.notify_all();
+                _writeThread.join();
+            }
+            _videoRequests.clear();
             _timeline.reset();
-            _buffer.reset();
-            _render.reset();
-            if (_glfwWindow)
+            if (!_pbo.empty())
             {
-                glfwDestroyWindow(_glfwWindow);
+                glDeleteBuffers(_pbo.size(), _pbo.data());
             }
+            _buffer.reset();
+            _render.reset();
+            _cpuRender.reset();
+            _glContext.reset();
         }
 
         std::shared_ptr<App> App::create(
@@ -298,47 +412,12 @@ namespace tl
 
             _startTime = std::chrono::steady_clock::now();
 
-            // Create the window.
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_FALSE);
-#if defined(TLRENDER_GL_DEBUG)
-            glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
-#endif // TLRENDER_GL_DEBUG
-            _glfwWindow = glfwCreateWindow(1, 1, "tlbake", NULL, NULL);
-            if (!_glfwWindow)
-            {
-                throw std::runtime_error("Cannot create window");
-            }
-            glfwMakeContextCurrent(_glfwWindow);
-            if (!gladLoaderLoadGL())
+            // Run the worker processes.
+            if (_options.workers > 0)
             {
-                throw std::runtime_error("Cannot initialize GLAD");
-            }
-#if defined(TLRENDER_GL_DEBUG)
-            GLint flags = 0;
-            glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
-            if (flags & static_cast<GLint>(GL_CONTEXT_FLAG_DEBUG_BIT))
-            {
-                glEnable(GL_DEBUG_OUTPUT);
-                glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-                glDebugMessageCallback(glDebugOutput, _context.get());
-                glDebugMessageControl(
-                    static_cast<GLenum>(GL_DONT_CARE),
-                    static_cast<GLenum>(GL_DONT_CARE),
-                    static_cast<GLenum>(GL_DONT_CARE),
-                    0,
-                    nullptr,
-                    GL_TRUE);
+                _runCoordinator();
+                return;
             }
-#endif // TLRENDER_GL_DEBUG
-            const int glMajor = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_VERSION_MAJOR);
-            const int glMinor = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_VERSION_MINOR);
-            const int glRevision = glfwGetWindowAttrib(_glfwWindow, GLFW_CONTEXT_REVISION);
-            _log(string::Format("OpenGL version: {0}.{1}.{2}").arg(glMajor).arg(glMinor).arg(glRevision));
 
             // Read the timeline.
             _timeline = timeline::Timeline::create(_input, _context);
@@ -356,8 +435,31 @@ namespace tl
             _print(string::Format("In/out range: {0}-{1}").
                 arg(_timeRange.start_time().value()).
                 arg(_timeRange.end_time_inclusive().value()));
+            otime::RationalTime outputStartTime(0.0, _timeRange.duration().rate());
+            if (!_options.chunk.empty())
+            {
+                // Image sequence chunks keep the frame numbers of the whole
+                // render, movie chunks are written to separate files.
+                size_t chunk = 0;
+                size_t chunkCount = 0;
+                timeline::parseChunk(_options.chunk, chunk, chunkCount);
+                const otime::TimeRange chunkRange = timeline::getChunkRange(_timeRange, chunk, chunkCount);
+                const auto fileType = _context->getSystem<io::System>()->getFileType(
+                    file::Path(_output).getExtension());
+                if (fileType != io::FileType::Movie)
+                {
+                    outputStartTime = chunkRange.start_time() - _timeRange.start_time();
+                }
+                _timeRange = chunkRange;
+                _print(string::Format("Chunk {0}/{1}: {2}-{3}").
+                    arg(chunk + 1).
+                    arg(chunkCount).
+                    arg(_timeRange.start_time().value()).
+                    arg(_timeRange.end_time_inclusive().value()));
+            }
             _inputTime = _timeRange.start_time();
-            _outputTime = otime::RationalTime(0.0, _timeRange.duration().rate());
+            _requestTime = _inputTime;
+            _outputTime = outputStartTime;
 
             // Render information.
             const auto& info = _timeline->getIOInfo();
@@ -370,12 +472,6 @@ namespace tl
                 info.video[0].size;
             _print(string::Format("Render size: {0}").arg(_renderSize));
 
-            // Create the renderer.
-            _render = timeline::GLRender::create(_context);
-            gl::OffscreenBufferOptions offscreenBufferOptions;
-            offscreenBufferOptions.colorType = image::PixelType::RGBA_F32;
-            _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
-
             // Create the writer.
             _writerPlugin = _context->getSystem<io::System>()->getPlugin(file::Path(_output));
             if (!_writerPlugin)
@@ -395,20 +491,133 @@ namespace tl
             _print(string::Format("Output info: {0} {1}").
                 arg(_outputInfo.size).
                 arg(_outputInfo.pixelType));
-            _outputImage = image::Image::create(_outputInfo);
             ioInfo.video.push_back(_outputInfo);
+
+            // The writers store the rows of the frames bottom-up, which is
+            // the order they are read back from OpenGL. Frames from the
+            // readers and the software renderer are converted to this order.
+            _outputInfo.layout.mirror.y = false;
             ioInfo.videoTime = _timeRange;
+            const bool movie = io::FileType::Movie ==
+                _context->getSystem<io::System>()->getFileType(file::Path(_output).getExtension());
+            const bool writeAudio = movie && _writerPlugin->canWriteAudio();
+            if (writeAudio && info.audio.isValid())
+            {
+                ioInfo.audio = info.audio;
+                ioInfo.audioTime = otime::TimeRange(
+                    outputStartTime.rescaled_to(info.audio.sampleRate),
+                    _timeRange.duration().rescaled_to(info.audio.sampleRate));
+            }
             _writer = _writerPlugin->write(file::Path(_output), ioInfo);
             if (!_writer)
             {
                 throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
             }
 
+            // Frames of a single clip that are written at their original
+            // size without color conversion are passed from the reader to
+            // the writer without rendering.
+            _passthrough = _isPassthrough();
+            if (_passthrough)
+            {
+                _print("Passthrough: yes");
+            }
+            else if (Renderer::CPU == _options.renderer)
+            {
+                // Create the software renderer.
+                _cpuRender = timeline::CPURender::create(_context);
+                _render = _cpuRender;
+            }
+            else
+            {
+                // Create the OpenGL context.
+                _glContext = gl::OffscreenContext::create(_context, _options.glContext);
+#if defined(TLRENDER_GL_DEBUG)
+                GLint flags = 0;
+                glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+                if (flags & static_cast<GLint>(GL_CONTEXT_FLAG_DEBUG_BIT))
+                {
+                    glEnable(GL_DEBUG_OUTPUT);
+                    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+                    glDebugMessageCallback(glDebugOutput, _context.get());
+                    glDebugMessageControl(
+                        static_cast<GLenum>(GL_DONT_CARE),
+                        static_cast<GLenum>(GL_DONT_CARE),
+                        static_cast<GLenum>(GL_DONT_CARE),
+                        0,
+                        nullptr,
+                        GL_TRUE);
+                }
+#endif // TLRENDER_GL_DEBUG
+
+                // Create the renderer.
+                _render = timeline::GLRender::create(_context);
+                gl::OffscreenBufferOptions offscreenBufferOptions;
+                offscreenBufferOptions.colorType = image::PixelType::RGBA_F32;
+                _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
+
+                // Create the pixel buffers used to read back the frames. The
+                // frames are copied out of the pixel buffers after the
+                // following frames have been rendered, so the GPU can finish
+                // the transfer without stalling the render.
+                if (GL_NONE == gl::getReadPixelsFormat(_outputInfo.pixelType) ||
+                    GL_NONE == gl::getReadPixelsType(_outputInfo.pixelType))
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
+                }
+                _pbo.resize(std::max(_options.readbackCount, size_t(1)));
+                _pboTime.resize(_pbo.size(), time::invalidTime);
+                glGenBuffers(_pbo.size(), _pbo.data());
+                for (size_t i = 0; i < _pbo.size(); ++i)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[i]);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER,
+                        image::getDataByteCount(_outputInfo),
+                        NULL,
+                        GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            }
+
+            // Start the writer thread.
+            _writeThread = std::thread(
+                [this]
+                {
+                    _writeRun();
+                });
+
             // Start the main loop.
-            gl::OffscreenBufferBinding binding(_buffer);
-            while (_running)
+            if (_passthrough)
             {
-                _tick();
+                while (_running)
+                {
+                    _tickPassthrough();
+                }
+            }
+            else if (_cpuRender)
+            {
+                while (_running)
+                {
+                    _tick();
+                }
+            }
+            else
+            {
+                gl::OffscreenBufferBinding binding(_buffer);
+                while (_running)
+                {
+                    _tick();
+                }
+                for (size_t i = 0; i < _pbo.size(); ++i)
+                {
+                    _readback((_pboIndex + i) % _pbo.size());
+                }
+            }
+            _writeFinish();
+            if (writeAudio)
+            {
+                _writeAudio(outputStartTime);
             }
 
             const auto now = std::chrono::steady_clock::now();
@@ -417,41 +626,354 @@ namespace tl
             _print(string::Format("Average FPS: {0}").arg(_timeRange.duration().value() / diff.count()));
         }
 
+        void App::_runCoordinator()
+        {
+            // Get the time range.
+            auto timeline = timeline::Timeline::create(_input, _context);
+            const otime::TimeRange timeRange = time::isValid(_options.inOutRange) ?
+                _options.inOutRange :
+                timeline->getTimeRange();
+            timeline.reset();
+            const size_t chunkCount = _options.chunks > 0 ? _options.chunks : _options.workers;
+            const size_t workers = std::min(_options.workers, chunkCount);
+            auto ioSystem = _context->getSystem<io::System>();
+            const bool movie = io::FileType::Movie ==
+                ioSystem->getFileType(file::Path(_output).getExtension());
+
+            // Movie chunks are written as segments and concatenated, which
+            // is only supported for FFmpeg movies. Other movie formats
+            // can only be written with a single chunk.
+            bool movieSegments = false;
+            if (movie)
+            {
+#if defined(TLRENDER_FFMPEG)
+                movieSegments = std::dynamic_pointer_cast<ffmpeg::Plugin>(
+                    ioSystem->getPlugin(file::Path(_output))) != nullptr;
+#endif // TLRENDER_FFMPEG
+                if (!movieSegments && chunkCount > 1)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(_output).
+                        arg("Chunks are only supported for image sequences and FFmpeg movies"));
+                }
+            }
+            _print(string::Format("In/out range: {0}-{1}").
+                arg(timeRange.start_time().value()).
+                arg(timeRange.end_time_inclusive().value()));
+            _print(string::Format("Chunks: {0}").arg(chunkCount));
+            _print(string::Format("Workers: {0}").arg(workers));
+
+            struct Chunk
+            {
+                otime::TimeRange range = time::invalidTimeRange;
+                std::string output;
+                size_t attempts = 0;
+                int exitCode = -1;
+            };
+            std::vector<Chunk> chunks(chunkCount);
+            std::list<size_t> queue;
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                chunks[i].range = timeline::getChunkRange(timeRange, i, chunkCount);
+                chunks[i].output = movieSegments ? getChunkOutput(_output, i, chunkCount) : _output;
+                queue.push_back(i);
+            }
+
+            // Run the chunks with the worker processes. Failed chunks are
+            // put back in the queue until they run out of retries.
+            std::mutex mutex;
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < workers; ++i)
+            {
+                threads.push_back(std::thread(
+                    [this, &chunks, &queue, &mutex]
+                    {
+                        while (true)
+                        {
+                            size_t index = 0;
+                            {
+                                std::unique_lock<std::mutex> lock(mutex);
+                                if (queue.empty())
+                                    break;
+                                index = queue.front();
+                                queue.pop_front();
+                                ++chunks[index].attempts;
+                                _print(string::Format("Starting chunk {0}/{1}: {2}-{3}").
+                                    arg(index + 1).
+                                    arg(chunks.size()).
+                                    arg(chunks[index].range.start_time().value()).
+                                    arg(chunks[index].range.end_time_inclusive().value()));
+                            }
+
+                            int exitCode = -1;
+                            std::string error;
+                            try
+                            {
+                                exitCode = os::runProcess(
+                                    _program,
+                                    _getWorkerArgs(chunks[index].output, index, chunks.size()));
+                            }
+                            catch (const std::exception& e)
+                            {
+                                error = e.what();
+                            }
+
+                            std::unique_lock<std::mutex> lock(mutex);
+                            chunks[index].exitCode = exitCode;
+                            if (!error.empty())
+                            {
+                                _printError(error);
+                            }
+                            if (0 == exitCode)
+                            {
+                                _print(string::Format("Finished chunk {0}/{1}").
+                                    arg(index + 1).
+                                    arg(chunks.size()));
+                            }
+                            else if (chunks[index].attempts <= _options.retries)
+                            {
+                                _print(string::Format("Retrying chunk {0}/{1}, exit code: {2}").
+                                    arg(index + 1).
+                                    arg(chunks.size()).
+                                    arg(exitCode));
+                                queue.push_back(index);
+                            }
+                            else
+                            {
+                                _printError(string::Format("Chunk {0}/{1} failed, exit code: {2}").
+                                    arg(index + 1).
+                                    arg(chunks.size()).
+                                    arg(exitCode));
+                            }
+                        }
+                    }));
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            size_t failed = 0;
+            for (const auto& chunk : chunks)
+            {
+                if (chunk.exitCode != 0)
+                {
+                    ++failed;
+                }
+            }
+
+            // Concatenate the movie segments. The segments are kept if
+            // the concatenation fails, and the error is recorded in the
+            // manifest.
+            bool concatenated = false;
+            std::string concatenateError;
+#if defined(TLRENDER_FFMPEG)
+            if (movieSegments && 0 == failed)
+            {
+                std::vector<std::string> segments;
+                for (const auto& chunk : chunks)
+                {
+                    segments.push_back(chunk.output);
+                }
+                _print(string::Format("Concatenating: {0}").arg(_output));
+                try
+                {
+                    ffmpeg::concatenate(segments, _output);
+                    for (const auto& segment : segments)
+                    {
+                        file::rm(segment);
+                    }
+                    concatenated = true;
+                }
+                catch (const std::exception& e)
+                {
+                    concatenateError = e.what();
+                    _printError(concatenateError);
+                }
+            }
+#endif // TLRENDER_FFMPEG
+
+            // Write the manifest.
+            nlohmann::json json;
+            json["input"] = _input;
+            json["output"] = _output;
+            json["inOutRange"] = {
+                timeRange.start_time().value(),
+                timeRange.end_time_inclusive().value() };
+            json["rate"] = timeRange.duration().rate();
+            json["concatenated"] = concatenated;
+            if (!concatenateError.empty())
+            {
+                json["concatenateError"] = concatenateError;
+            }
+            json["chunks"] = nlohmann::json::array();
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                json["chunks"].push_back({
+                    { "chunk", i + 1 },
+                    { "range", {
+                        chunks[i].range.start_time().value(),
+                        chunks[i].range.end_time_inclusive().value() } },
+                    { "output", chunks[i].output },
+                    { "attempts", chunks[i].attempts },
+                    { "exitCode", chunks[i].exitCode },
+                    { "status", 0 == chunks[i].exitCode ? "finished" : "failed" } });
+            }
+            const std::string manifest = !_options.manifest.empty() ?
+                _options.manifest :
+                (_output + ".manifest.json");
+            auto io = file::FileIO::create(manifest, file::Mode::Write);
+            const std::string contents = json.dump(4);
+            io->write(contents.c_str(), contents.size());
+            _print(string::Format("Manifest: {0}").arg(manifest));
+
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<float> diff = now - _startTime;
+            _print(string::Format("Seconds elapsed: {0}").arg(diff.count()));
+            if (failed > 0)
+            {
+                throw std::runtime_error(string::Format("Chunks failed: {0}").arg(failed));
+            }
+            if (!concatenateError.empty())
+            {
+                throw std::runtime_error(string::Format("Cannot concatenate: {0}").arg(_output));
+            }
+        }
+
+        std::vector<std::string> App::_getWorkerArgs(
+            const std::string& output,
+            size_t chunk,
+            size_t chunkCount) const
+        {
+            // Build the worker command line from the parsed options. The
+            // coordinator options are not passed to the workers.
+            std::vector<std::string> out = { _input, output };
+            if (time::isValid(_options.inOutRange))
+            {
+                addWorkerArg(out, "-inOutRange", _options.inOutRange);
+            }
+            addWorkerArg(out, "-renderer", _options.renderer);
+            addWorkerArg(out, "-glContext", _options.glContext);
+            if (_options.renderSize.isValid())
+            {
+                addWorkerArg(out, "-renderSize", _options.renderSize);
+            }
+            if (_options.outputPixelType != image::PixelType::None)
+            {
+                addWorkerArg(out, "-outputPixelType", _options.outputPixelType);
+            }
+            if (!_options.colorConfigOptions.fileName.empty())
+            {
+                addWorkerArg(out, "-colorConfig", _options.colorConfigOptions.fileName);
+            }
+            if (!_options.colorConfigOptions.input.empty())
+            {
+                addWorkerArg(out, "-colorInput", _options.colorConfigOptions.input);
+            }
+            if (!_options.colorConfigOptions.display.empty())
+            {
+                addWorkerArg(out, "-colorDisplay", _options.colorConfigOptions.display);
+            }
+            if (!_options.colorConfigOptions.view.empty())
+            {
+                addWorkerArg(out, "-colorView", _options.colorConfigOptions.view);
+            }
+            if (!_options.lutOptions.fileName.empty())
+            {
+                addWorkerArg(out, "-lut", _options.lutOptions.fileName);
+            }
+            addWorkerArg(out, "-lutOrder", _options.lutOptions.order);
+            addWorkerArg(out, "-requestCount", _options.requestCount);
+            addWorkerArg(out, "-readbackCount", _options.readbackCount);
+            addWorkerArg(out, "-writeQueueCount", _options.writeQueueCount);
+            addWorkerArg(out, "-sequenceDefaultSpeed", _options.sequenceDefaultSpeed);
+            addWorkerArg(out, "-sequenceThreadCount", _options.sequenceThreadCount);
+#if defined(TLRENDER_EXR)
+            addWorkerArg(out, "-exrCompression", _options.exrCompression);
+            addWorkerArg(out, "-exrDWACompressionLevel", _options.exrDWACompressionLevel);
+#endif // TLRENDER_EXR
+#if defined(TLRENDER_FFMPEG)
+            if (!_options.ffmpegWriteProfile.empty())
+            {
+                addWorkerArg(out, "-ffmpegProfile", _options.ffmpegWriteProfile);
+            }
+            addWorkerArg(out, "-ffmpegThreadCount", _options.ffmpegThreadCount);
+#endif // TLRENDER_FFMPEG
+#if defined(TLRENDER_USD)
+            addWorkerArg(out, "-usdRenderWidth", _options.usdRenderWidth);
+            addWorkerArg(out, "-usdComplexity", _options.usdComplexity);
+            addWorkerArg(out, "-usdDrawMode", _options.usdDrawMode);
+            addWorkerArg(out, "-usdEnableLighting", _options.usdEnableLighting);
+            addWorkerArg(out, "-usdStageCache", _options.usdStageCache);
+            addWorkerArg(out, "-usdDiskCache", _options.usdDiskCache);
+#endif // TLRENDER_USD
+            out.push_back("-chunk");
+            out.push_back(string::Format("{0}/{1}").arg(chunk + 1).arg(chunkCount));
+            return out;
+        }
+
+        void App::_requestVideo()
+        {
+            // Request video ahead of the render, so the frames are read
+            // while the previous frames are rendered and written.
+            while (_videoRequests.size() < std::max(_options.requestCount, size_t(1)) &&
+                _requestTime <= _timeRange.end_time_inclusive())
+            {
+                _videoRequests.push_back(_timeline->getVideo(_requestTime));
+                _requestTime += otime::RationalTime(1, _requestTime.rate());
+            }
+        }
+
         void App::_tick()
         {
             _context->tick();
 
             _printProgress();
 
+            _requestVideo();
+
             // Render the video.
             _render->begin(
                 _renderSize,
                 _options.colorConfigOptions,
                 _options.lutOptions);
-            const auto videoData = _timeline->getVideo(_inputTime).get();
+            const auto videoData = _videoRequests.front().get();
+            _videoRequests.pop_front();
             _render->drawVideo(
                 { videoData },
                 { math::Box2i(0, 0, _renderSize.w, _renderSize.h) });
             _render->end();
 
-            // Write the frame.
-            glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
-            glPixelStorei(GL_PACK_SWAP_BYTES, _outputInfo.layout.endian != memory::getEndian());
-            const GLenum format = gl::getReadPixelsFormat(_outputInfo.pixelType);
-            const GLenum type = gl::getReadPixelsType(_outputInfo.pixelType);
-            if (GL_NONE == format || GL_NONE == type)
+            if (_cpuRender)
             {
-                throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
+                // Convert the rendered image from top-down to the bottom-up
+                // layout of the output and pass it to the writer thread.
+                auto image = _getImage();
+                image::convert(_cpuRender->getImage(), image);
+                _write(_outputTime, image);
+            }
+            else
+            {
+                // Start reading back the frame.
+                const size_t pboIndex = _pboIndex % _pbo.size();
+                glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
+                glPixelStorei(GL_PACK_SWAP_BYTES, _outputInfo.layout.endian != memory::getEndian());
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[pboIndex]);
+                glReadPixels(
+                    0,
+                    0,
+                    _outputInfo.size.w,
+                    _outputInfo.size.h,
+                    gl::getReadPixelsFormat(_outputInfo.pixelType),
+                    gl::getReadPixelsType(_outputInfo.pixelType),
+                    NULL);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                _pboTime[pboIndex] = _outputTime;
+                ++_pboIndex;
+
+                // Finish reading back the oldest frame and pass it to the
+                // writer thread.
+                _readback(_pboIndex % _pbo.size());
             }
-            glReadPixels(
-                0,
-                0,
-                _outputInfo.size.w,
-                _outputInfo.size.h,
-                format,
-                type,
-                _outputImage->getData());
-            _writer->writeVideo(_outputTime, _outputImage);
 
             // Advance the time.
             _inputTime += otime::RationalTime(1, _inputTime.rate());
@@ -462,6 +984,250 @@ namespace tl
             _outputTime += otime::RationalTime(1, _outputTime.rate());
         }
 
+        bool App::_isPassthrough() const
+        {
+            if (!_options.colorConfigOptions.fileName.empty() ||
+                !_options.lutOptions.fileName.empty())
+            {
+                return false;
+            }
+            const auto& info = _timeline->getIOInfo();
+            if (_renderSize != info.video[0].size)
+            {
+                return false;
+            }
+            if (info.video[0].pixelType != _outputInfo.pixelType &&
+                !image::canConvert(info.video[0].pixelType, _outputInfo.pixelType))
+            {
+                return false;
+            }
+            const auto& otioTracks = _timeline->getTimeline()->video_tracks();
+            if (otioTracks.size() != 1)
+            {
+                return false;
+            }
+            const auto& otioChildren = otioTracks[0]->children();
+            return 1 == otioChildren.size() &&
+                dynamic_cast<otio::Clip*>(otioChildren[0].value);
+        }
+
+        void App::_tickPassthrough()
+        {
+            _context->tick();
+
+            _printProgress();
+
+            _requestVideo();
+
+            // Pass the image to the writer, converting it when the writer
+            // needs a different pixel type or layout. Gaps are written as
+            // black frames.
+            const auto videoData = _videoRequests.front().get();
+            _videoRequests.pop_front();
+            std::shared_ptr<image::Image> image;
+            if (!videoData.layers.empty())
+            {
+                image = videoData.layers[0].image;
+            }
+            if (image &&
+                image->getPixelType() == _outputInfo.pixelType &&
+                image->getInfo().layout == _outputInfo.layout &&
+                image->getSize() == _outputInfo.size)
+            {
+                _write(_outputTime, image, false);
+            }
+            else
+            {
+                auto out = _getImage();
+                if (image && image->getSize() == _outputInfo.size)
+                {
+                    image::convert(image, out);
+                }
+                else
+                {
+                    out->zero();
+                }
+                _write(_outputTime, out);
+            }
+
+            // Advance the time.
+            _inputTime += otime::RationalTime(1, _inputTime.rate());
+            if (_inputTime > _timeRange.end_time_inclusive())
+            {
+                _running = false;
+            }
+            _outputTime += otime::RationalTime(1, _outputTime.rate());
+        }
+
+        std::shared_ptr<image::Image> App::_getImage()
+        {
+            // Get an image from the pool, or create a new one.
+            std::shared_ptr<image::Image> out;
+            {
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                if (!_writeMutex.images.empty())
+                {
+                    out = _writeMutex.images.back();
+                    _writeMutex.images.pop_back();
+                }
+            }
+            if (!out)
+            {
+                out = image::Image::create(_outputInfo);
+            }
+            return out;
+        }
+
+        void App::_readback(size_t index)
+        {
+            if (!time::isValid(_pboTime[index]))
+                return;
+
+            auto image = _getImage();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[index]);
+            if (void* buffer = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
+            {
+                memcpy(
+                    image->getData(),
+                    buffer,
+                    image->getDataByteCount());
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            _write(_pboTime[index], image);
+            _pboTime[index] = time::invalidTime;
+        }
+
+        void App::_write(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image,
+            bool pooled)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                _writeCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            _writeMutex.frames.size() < std::max(_options.writeQueueCount, size_t(1)) ||
+                            _writeMutex.error;
+                    });
+                if (_writeMutex.error)
+                {
+                    std::rethrow_exception(_writeMutex.error);
+                }
+                _writeMutex.frames.push_back({ time, image, pooled });
+            }
+            _writeCV.notify_all();
+        }
+
+        void App::_writeRun()
+        {
+            while (true)
+            {
+                WriteFrame frame;
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_writeMutex.frames.empty() || _writeMutex.finish;
+                        });
+                    if (_writeMutex.frames.empty())
+                    {
+                        break;
+                    }
+                    frame = _writeMutex.frames.front();
+                    _writeMutex.frames.pop_front();
+                }
+                _writeCV.notify_all();
+
+                try
+                {
+                    _writer->writeVideo(frame.time, frame.image);
+                }
+                catch (const std::exception&)
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.error = std::current_exception();
+                    _writeMutex.frames.clear();
+                    _writeCV.notify_all();
+                    break;
+                }
+
+                // Return the image to the pool.
+                if (frame.pooled)
+                {
+                    std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                    _writeMutex.images.push_back(frame.image);
+                }
+            }
+        }
+
+        void App::_writeFinish()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_writeMutex.mutex);
+                _writeMutex.finish = true;
+            }
+            _writeCV.notify_all();
+            _writeThread.join();
+            if (_writeMutex.error)
+            {
+                std::rethrow_exception(_writeMutex.error);
+            }
+        }
+
+        void App::_writeAudio(const otime::RationalTime& outputStartTime)
+        {
+            // Mix the audio layers one second at a time and pass them to
+            // the writer.
+            const auto& info = _timeline->getIOInfo();
+            if (!info.audio.isValid())
+                return;
+            const int64_t sampleRate = info.audio.sampleRate;
+            const int64_t start = std::round(_timeRange.start_time().rescaled_to(sampleRate).value());
+            const int64_t end = std::round(_timeRange.end_time_exclusive().rescaled_to(sampleRate).value());
+            const int64_t outputStart = std::round(outputStartTime.rescaled_to(sampleRate).value());
+            const size_t byteCount = info.audio.getByteCount();
+            int64_t frame = start;
+            while (frame < end)
+            {
+                const int64_t seconds = static_cast<int64_t>(std::floor(frame / static_cast<double>(sampleRate)));
+                const int64_t offset = frame - seconds * sampleRate;
+                const int64_t size = std::min(sampleRate - offset, end - frame);
+                const auto audioData = _timeline->getAudio(seconds).get();
+                std::vector<const uint8_t*> audioDataP;
+                for (const auto& layer : audioData.layers)
+                {
+                    if (layer.audio &&
+                        layer.audio->getInfo() == info.audio &&
+                        layer.audio->getSampleCount() >= static_cast<size_t>(offset + size))
+                    {
+                        audioDataP.push_back(layer.audio->getData() + offset * byteCount);
+                    }
+                }
+                auto audio = audio::Audio::create(info.audio, size);
+                audio->zero();
+                audio::mix(
+                    audioDataP.data(),
+                    audioDataP.size(),
+                    audio->getData(),
+                    1.F,
+                    size,
+                    info.audio.channelCount,
+                    info.audio.dataType);
+                _writer->writeAudio(
+                    otime::TimeRange(
+                        otime::RationalTime(outputStart + frame - start, sampleRate),
+                        otime::RationalTime(size, sampleRate)),
+                    audio);
+                frame += size;
+            }
+        }
+
         void App::_printProgress()
         {
             const int64_t c = static_cast<int64_t>(_inputTime.value() - _timeRange.start_time().value());
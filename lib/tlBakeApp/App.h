@@ -5,8 +5,9 @@
 #include <tlApp/IApp.h>
 
 #include <tlGL/OffscreenBuffer.h>
+#include <tlGL/OffscreenContext.h>
 
-#include <tlTimeline/IRender.h>
+#include <tlTimeline/CPURender.h>
 #include <tlTimeline/Timeline.h>
 
 #include <tlIO/SequenceIO.h>
@@ -20,21 +21,47 @@
 #include <tlIO/USD.h>
 #endif // TLRENDER_USD
 
-struct GLFWwindow;
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <thread>
 
 namespace tl
 {
     //! "tlbake" application.
     namespace bake
     {
+        //! Renderers.
+        enum class Renderer
+        {
+            GL,
+            CPU,
+
+            Count,
+            First = GL
+        };
+        TLRENDER_ENUM(Renderer);
+        TLRENDER_ENUM_SERIALIZE(Renderer);
+
         //! Application options.
         struct Options
         {
             otime::TimeRange inOutRange = time::invalidTimeRange;
+            std::string chunk;
+            size_t workers = 0;
+            size_t chunks = 0;
+            size_t retries = 2;
+            std::string manifest;
+            Renderer renderer = Renderer::GL;
+            gl::ContextBackend glContext = gl::getDefaultContextBackend();
             image::Size renderSize;
             image::PixelType outputPixelType = image::PixelType::None;
             timeline::ColorConfigOptions colorConfigOptions;
             timeline::LUTOptions lutOptions;
+            size_t requestCount = 16;
+            size_t readbackCount = 3;
+            size_t writeQueueCount = 16;
             float sequenceDefaultSpeed = io::sequenceDefaultSpeed;
             int sequenceThreadCount = io::sequenceThreadCount;
 #if defined(TLRENDER_EXR)
@@ -80,12 +107,24 @@ namespace tl
             void run();
 
         private:
+            void _runCoordinator();
+            std::vector<std::string> _getWorkerArgs(const std::string& output, size_t chunk, size_t chunkCount) const;
+            bool _isPassthrough() const;
+            void _requestVideo();
             void _tick();
+            void _tickPassthrough();
+            std::shared_ptr<image::Image> _getImage();
+            void _readback(size_t);
+            void _write(const otime::RationalTime&, const std::shared_ptr<image::Image>&, bool pooled = true);
+            void _writeRun();
+            void _writeFinish();
+            void _writeAudio(const otime::RationalTime&);
             void _printProgress();
 
             std::string _input;
             std::string _output;
             Options _options;
+            std::string _program;
 
             std::shared_ptr<timeline::Timeline> _timeline;
             image::Size _renderSize;
@@ -93,15 +132,38 @@ namespace tl
             otime::TimeRange _timeRange = time::invalidTimeRange;
             otime::RationalTime _inputTime = time::invalidTime;
             otime::RationalTime _outputTime = time::invalidTime;
+            otime::RationalTime _requestTime = time::invalidTime;
+            std::list<std::future<timeline::VideoData> > _videoRequests;
+            bool _passthrough = false;
 
-            GLFWwindow* _glfwWindow = nullptr;
+            std::shared_ptr<gl::OffscreenContext> _glContext;
             std::shared_ptr<io::IPlugin> _usdPlugin;
             std::shared_ptr<timeline::IRender> _render;
+            std::shared_ptr<timeline::CPURender> _cpuRender;
             std::shared_ptr<gl::OffscreenBuffer> _buffer;
+            std::vector<unsigned int> _pbo;
+            std::vector<otime::RationalTime> _pboTime;
+            size_t _pboIndex = 0;
 
             std::shared_ptr<io::IPlugin> _writerPlugin;
             std::shared_ptr<io::IWrite> _writer;
-            std::shared_ptr<image::Image> _outputImage;
+            struct WriteFrame
+            {
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::Image> image;
+                bool pooled = true;
+            };
+            struct WriteMutex
+            {
+                std::list<WriteFrame> frames;
+                std::vector<std::shared_ptr<image::Image> > images;
+                bool finish = false;
+                std::exception_ptr error;
+                std::mutex mutex;
+            };
+            WriteMutex _writeMutex;
+            std::condition_variable _writeCV;
+            std::thread _writeThread;
 
             bool _running = true;
             std::chrono::steady_clock::time_point _startTime;
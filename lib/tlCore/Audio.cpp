@@ -4,6 +4,7 @@
 
 #include <tlCore/Audio.h>
 
+#include <tlCore/AudioSIMD.h>
 #include <tlCore/Error.h>
 #include <tlCore/String.h>
 
@@ -110,53 +111,6 @@ namespace tl
             std::memset(_data, 0, getByteCount());
         }
 
-        namespace
-        {
-            template<typename T, typename TI>
-            void mixI(
-                const uint8_t** in,
-                size_t inCount,
-                uint8_t* out,
-                float volume,
-                size_t size)
-            {
-                const T** const inP = reinterpret_cast<const T**>(in);
-                T* const outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < size; ++i)
-                {
-                    const TI min = static_cast<TI>(std::numeric_limits<T>::min());
-                    const TI max = static_cast<TI>(std::numeric_limits<T>::max());
-                    TI v = 0;
-                    for (size_t j = 0; j < inCount; ++j)
-                    {
-                        v += math::clamp(static_cast<TI>(inP[j][i] * volume), min, max);
-                    }
-                    outP[i] = math::clamp(v, min, max);
-                }
-            }
-
-            template<typename T>
-            void mixF(
-                const uint8_t** in,
-                size_t inCount,
-                uint8_t* out,
-                float volume,
-                size_t size)
-            {
-                const T** const inP = reinterpret_cast<const T**>(in);
-                T* const outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < size; ++i)
-                {
-                    T v = static_cast<T>(0);
-                    for (size_t j = 0; j < inCount; ++j)
-                    {
-                        v += inP[j][i] * volume;
-                    }
-                    outP[i] = v;
-                }
-            }
-        }
-
         void mix(
             const uint8_t** in,
             size_t inCount,
@@ -166,38 +120,12 @@ namespace tl
             uint8_t channelCount,
             DataType type)
         {
-            const size_t size = sampleCount * static_cast<size_t>(channelCount);
-            switch (type)
+            if (const auto kernel = simd::getKernels().mix[static_cast<size_t>(type)])
             {
-            case DataType::S8:
-                mixI<int8_t, int16_t>(in, inCount, out, volume, size);
-                break;
-            case DataType::S16:
-                mixI<int16_t, int32_t>(in, inCount, out, volume, size);
-                break;
-            case DataType::S32:
-                mixI<int32_t, int64_t>(in, inCount, out, volume, size);
-                break;
-            case DataType::F32:
-                mixF<float>(in, inCount, out, volume, size);
-                break;
-            case DataType::F64:
-                mixF<double>(in, inCount, out, volume, size);
-                break;
-            default: break;
+                kernel(in, inCount, out, volume, sampleCount * static_cast<size_t>(channelCount));
             }
         }
 
-#define _CONVERT(a, b) \
-{ \
-    const a##_T * inP = reinterpret_cast<const a##_T *>(in->getData()); \
-    b##_T * outP = reinterpret_cast<b##_T *>(out->getData()); \
-    for (size_t i = 0; i < sampleCount * channelCount; ++i, ++inP, ++outP) \
-    { \
-        a##To##b(*inP, *outP); \
-    } \
-}
-
         std::shared_ptr<Audio> convert(const std::shared_ptr<Audio>& in, DataType type)
         {
             const DataType inType = in->getDataType();
@@ -211,62 +139,10 @@ namespace tl
                     in->getData(),
                     sampleCount * channelCount * getByteCount(type));
             }
-            else
+            else if (const auto kernel = simd::getKernels().convert[
+                static_cast<size_t>(inType)][static_cast<size_t>(type)])
             {
-                switch (inType)
-                {
-                case DataType::S8:
-                    switch (type)
-                    {
-                    case DataType::S16: _CONVERT(S8, S16); break;
-                    case DataType::S32: _CONVERT(S8, S32); break;
-                    case DataType::F32: _CONVERT(S8, F32); break;
-                    case DataType::F64: _CONVERT(S8, F64); break;
-                    default: break;
-                    }
-                    break;
-                case DataType::S16:
-                    switch (type)
-                    {
-                    case DataType::S8:  _CONVERT(S16, S8);  break;
-                    case DataType::S32: _CONVERT(S16, S32); break;
-                    case DataType::F32: _CONVERT(S16, F32); break;
-                    case DataType::F64: _CONVERT(S16, F64); break;
-                    default: break;
-                    }
-                    break;
-                case DataType::S32:
-                    switch (type)
-                    {
-                    case DataType::S8:  _CONVERT(S32, S8);  break;
-                    case DataType::S16: _CONVERT(S32, S16); break;
-                    case DataType::F32: _CONVERT(S32, F32); break;
-                    case DataType::F64: _CONVERT(S32, F64); break;
-                    default: break;
-                    }
-                    break;
-                case DataType::F32:
-                    switch (type)
-                    {
-                    case DataType::S8:  _CONVERT(F32, S8);  break;
-                    case DataType::S16: _CONVERT(F32, S16); break;
-                    case DataType::S32: _CONVERT(F32, S32); break;
-                    case DataType::F64: _CONVERT(F32, F64); break;
-                    default: break;
-                    }
-                    break;
-                case DataType::F64:
-                    switch (type)
-                    {
-                    case DataType::S8:  _CONVERT(F64, S8);  break;
-                    case DataType::S16: _CONVERT(F64, S16); break;
-                    case DataType::S32: _CONVERT(F64, S32); break;
-                    case DataType::F32: _CONVERT(F64, F32); break;
-                    default: break;
-                    }
-                    break;
-                default: break;
-                }
+                kernel(in->getData(), out->getData(), sampleCount * channelCount);
             }
             return out;
         }
@@ -294,6 +170,20 @@ namespace tl
         std::shared_ptr<Audio> planarInterleave(const std::shared_ptr<Audio>& value)
         {
             auto out = Audio::create(value->getInfo(), value->getSampleCount());
+            if (2 == value->getChannelCount())
+            {
+                if (const auto kernel = simd::getKernels().interleave2[
+                    static_cast<size_t>(value->getDataType())])
+                {
+                    const size_t sampleCount = value->getSampleCount();
+                    kernel(
+                        value->getData(),
+                        value->getData() + sampleCount * getByteCount(value->getDataType()),
+                        out->getData(),
+                        sampleCount);
+                    return out;
+                }
+            }
             switch (value->getDataType())
             {
             case DataType::S8: _planarInterleave<int8_t>(value, out); break;
@@ -329,6 +219,19 @@ namespace tl
             const uint8_t channelCount = value->getChannelCount();
             const size_t sampleCount = value->getSampleCount();
             auto out = Audio::create(value->getInfo(), sampleCount);
+            if (2 == channelCount)
+            {
+                if (const auto kernel = simd::getKernels().deinterleave2[
+                    static_cast<size_t>(value->getDataType())])
+                {
+                    kernel(
+                        value->getData(),
+                        out->getData(),
+                        out->getData() + sampleCount * getByteCount(value->getDataType()),
+                        sampleCount);
+                    return out;
+                }
+            }
             switch (value->getDataType())
             {
             case DataType::S8:
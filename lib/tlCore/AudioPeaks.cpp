@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioPeaks.h>
+
+#include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        namespace
+        {
+            const char peaksMagic[] = "tlPeaks";
+            const uint32_t peaksVersion = 1;
+            const uint64_t maxLevels = 64;
+            static_assert(sizeof(Peak) == 3 * sizeof(float), "Peaks are read and written as floats");
+
+            void addPeak(Peak& peak, double& sumSq, size_t& count, const Peak& value, size_t valueCount)
+            {
+                if (0 == count)
+                {
+                    peak.min = value.min;
+                    peak.max = value.max;
+                }
+                else
+                {
+                    peak.min = std::min(peak.min, value.min);
+                    peak.max = std::max(peak.max, value.max);
+                }
+                sumSq += static_cast<double>(value.rms) * value.rms * valueCount;
+                count += valueCount;
+            }
+        }
+
+        bool Peak::operator == (const Peak& other) const
+        {
+            return
+                min == other.min &&
+                max == other.max &&
+                rms == other.rms;
+        }
+
+        bool Peak::operator != (const Peak& other) const
+        {
+            return !(*this == other);
+        }
+
+        PeakPyramid::PeakPyramid()
+        {}
+
+        PeakPyramid::PeakPyramid(size_t sampleRate, size_t binSize) :
+            _sampleRate(sampleRate),
+            _binSize(std::max(binSize, size_t(1))),
+            _levels(1)
+        {}
+
+        size_t PeakPyramid::getSampleRate() const
+        {
+            return _sampleRate;
+        }
+
+        size_t PeakPyramid::getBinSize() const
+        {
+            return _binSize;
+        }
+
+        size_t PeakPyramid::getSampleCount() const
+        {
+            return _sampleCount;
+        }
+
+        size_t PeakPyramid::getLevelCount() const
+        {
+            return _levels.size();
+        }
+
+        const std::vector<Peak>& PeakPyramid::getLevel(size_t value) const
+        {
+            return _levels[value];
+        }
+
+        size_t PeakPyramid::getByteCount() const
+        {
+            size_t out = 0;
+            for (const auto& level : _levels)
+            {
+                out += level.size() * sizeof(Peak);
+            }
+            return out;
+        }
+
+        void PeakPyramid::add(const float* samples, size_t count)
+        {
+            if (_levels.empty())
+            {
+                _levels.resize(1);
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float v = samples[i];
+                if (0 == _binCount)
+                {
+                    _binMin = v;
+                    _binMax = v;
+                }
+                else
+                {
+                    _binMin = std::min(_binMin, v);
+                    _binMax = std::max(_binMax, v);
+                }
+                _binSumSq += static_cast<double>(v) * v;
+                ++_binCount;
+                if (_binCount == _binSize)
+                {
+                    Peak peak;
+                    peak.min = _binMin;
+                    peak.max = _binMax;
+                    peak.rms = static_cast<float>(std::sqrt(_binSumSq / _binCount));
+                    _levels[0].push_back(peak);
+                    _binSumSq = 0.0;
+                    _binCount = 0;
+                }
+            }
+            _sampleCount += count;
+            _finished = false;
+        }
+
+        void PeakPyramid::finish()
+        {
+            if (_levels.empty())
+            {
+                _levels.resize(1);
+            }
+            if (_binCount > 0)
+            {
+                Peak peak;
+                peak.min = _binMin;
+                peak.max = _binMax;
+                peak.rms = static_cast<float>(std::sqrt(_binSumSq / _binCount));
+                _levels[0].push_back(peak);
+                _binSumSq = 0.0;
+                _binCount = 0;
+            }
+            _levels.resize(1);
+            while (_levels.back().size() > 1)
+            {
+                const size_t level = _levels.size() - 1;
+                const auto& prev = _levels.back();
+                std::vector<Peak> next((prev.size() + 1) / 2);
+                for (size_t i = 0; i < next.size(); ++i)
+                {
+                    double sumSq = 0.0;
+                    size_t count = 0;
+                    for (size_t j = i * 2; j < std::min(i * 2 + 2, prev.size()); ++j)
+                    {
+                        addPeak(next[i], sumSq, count, prev[j], _getBinSampleCount(level, j));
+                    }
+                    next[i].rms = count > 0 ? static_cast<float>(std::sqrt(sumSq / count)) : 0.F;
+                }
+                _levels.push_back(std::move(next));
+            }
+            _finished = true;
+        }
+
+        bool PeakPyramid::isFinished() const
+        {
+            return _finished;
+        }
+
+        std::vector<Peak> PeakPyramid::getPeaks(
+            int64_t start,
+            int64_t end,
+            size_t count) const
+        {
+            std::vector<Peak> out(count);
+            if (_levels.empty() || _levels[0].empty() || end <= start)
+                return out;
+            const int64_t sampleCount = static_cast<int64_t>(_sampleCount);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const int64_t c = static_cast<int64_t>(count);
+                int64_t s0 = start + (end - start) * static_cast<int64_t>(i) / c;
+                int64_t s1 = start + (end - start) * static_cast<int64_t>(i + 1) / c;
+                s1 = std::max(s1, s0 + 1);
+                s0 = std::max(s0, int64_t(0));
+                s1 = std::min(s1, sampleCount);
+                if (s0 >= s1)
+                    continue;
+
+                // Use the coarsest level where a peak is no larger than
+                // the range.
+                const size_t span = static_cast<size_t>(s1 - s0);
+                size_t level = 0;
+                while (level + 1 < _levels.size() && (_binSize << (level + 1)) <= span)
+                {
+                    ++level;
+                }
+                const size_t levelBinSize = _binSize << level;
+                const auto& peaks = _levels[level];
+                const size_t b0 = static_cast<size_t>(s0) / levelBinSize;
+                const size_t b1 = std::min(
+                    (static_cast<size_t>(s1) + levelBinSize - 1) / levelBinSize,
+                    peaks.size());
+                double sumSq = 0.0;
+                size_t peakCount = 0;
+                for (size_t b = b0; b < b1; ++b)
+                {
+                    addPeak(out[i], sumSq, peakCount, peaks[b], _getBinSampleCount(level, b));
+                }
+                out[i].rms = peakCount > 0 ? static_cast<float>(std::sqrt(sumSq / peakCount)) : 0.F;
+            }
+            return out;
+        }
+
+        void PeakPyramid::write(const std::string& fileName) const
+        {
+            auto io = file::FileIO::create(fileName, file::Mode::Write);
+            io->write(peaksMagic, sizeof(peaksMagic));
+            io->writeU32(peaksVersion);
+            const uint64_t header[] =
+            {
+                _sampleRate,
+                _binSize,
+                _sampleCount,
+                _levels.size()
+            };
+            io->write(header, 4, sizeof(uint64_t));
+            for (const auto& level : _levels)
+            {
+                const uint64_t size = level.size();
+                io->write(&size, 1, sizeof(uint64_t));
+                io->writeF32(reinterpret_cast<const float*>(level.data()), level.size() * 3);
+            }
+        }
+
+        void PeakPyramid::read(const std::string& fileName)
+        {
+            auto io = file::FileIO::create(fileName, file::Mode::Read);
+            char magic[sizeof(peaksMagic)];
+            io->read(magic, sizeof(peaksMagic));
+            uint32_t version = 0;
+            io->readU32(&version);
+            if (std::memcmp(magic, peaksMagic, sizeof(peaksMagic)) != 0 ||
+                version != peaksVersion)
+            {
+                throw std::runtime_error(string::Format("{0}: Invalid peaks file").
+                    arg(fileName));
+            }
+            uint64_t header[4] = { 0, 0, 0, 0 };
+            io->read(header, 4, sizeof(uint64_t));
+
+            // Check the values from the file before they are used. Each
+            // level needs at least its size, and the bin size of a level
+            // must fit in 64 bits.
+            if (header[3] > maxLevels ||
+                header[3] > (io->getSize() - io->getPos()) / sizeof(uint64_t))
+            {
+                throw std::runtime_error(string::Format("{0}: Invalid peaks file").
+                    arg(fileName));
+            }
+            std::vector<std::vector<Peak> > levels(header[3]);
+            for (auto& level : levels)
+            {
+                uint64_t size = 0;
+                io->read(&size, 1, sizeof(uint64_t));
+                if (size > (io->getSize() - io->getPos()) / sizeof(Peak))
+                {
+                    throw std::runtime_error(string::Format("{0}: Invalid peaks file").
+                        arg(fileName));
+                }
+                level.resize(size);
+                io->readF32(reinterpret_cast<float*>(level.data()), size * 3);
+            }
+            _sampleRate = header[0];
+            _binSize = std::max(header[1], uint64_t(1));
+            _sampleCount = header[2];
+            _levels = std::move(levels);
+            _finished = true;
+            _binSumSq = 0.0;
+            _binCount = 0;
+        }
+
+        size_t PeakPyramid::_getBinSampleCount(size_t level, size_t index) const
+        {
+            const size_t levelBinSize = _binSize << level;
+            const size_t start = index * levelBinSize;
+            return start < _sampleCount ? std::min(levelBinSize, _sampleCount - start) : 0;
+        }
+    }
+}
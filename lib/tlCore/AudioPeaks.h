@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Audio peak.
+        struct Peak
+        {
+            float min = 0.F;
+            float max = 0.F;
+            float rms = 0.F;
+
+            bool operator == (const Peak&) const;
+            bool operator != (const Peak&) const;
+        };
+
+        //! Audio peak pyramid.
+        //!
+        //! Level zero of the pyramid has one peak for every "bin size"
+        //! samples, and each following level halves the resolution until
+        //! a level has a single peak. Peaks for any range of samples and
+        //! any number of divisions can be retrieved from the pyramid
+        //! without touching the original audio.
+        class PeakPyramid
+        {
+        public:
+            PeakPyramid();
+            explicit PeakPyramid(size_t sampleRate, size_t binSize = 256);
+
+            //! Get the sample rate.
+            size_t getSampleRate() const;
+
+            //! Get the number of samples in a level zero peak.
+            size_t getBinSize() const;
+
+            //! Get the number of samples.
+            size_t getSampleCount() const;
+
+            //! Get the number of levels.
+            size_t getLevelCount() const;
+
+            //! Get a level.
+            const std::vector<Peak>& getLevel(size_t) const;
+
+            //! Get the size of the peaks in bytes.
+            size_t getByteCount() const;
+
+            //! Add mono samples. Samples may be added in any number of
+            //! pieces, the pyramid levels are built by finish().
+            void add(const float*, size_t);
+
+            //! Finish adding samples and build the pyramid levels.
+            void finish();
+
+            //! Get whether the pyramid is finished.
+            bool isFinished() const;
+
+            //! Get the peaks for a range of samples, one peak for each
+            //! of the given number of equal divisions of the range.
+            std::vector<Peak> getPeaks(
+                int64_t start,
+                int64_t end,
+                size_t count) const;
+
+            //! Write the pyramid to a file.
+            void write(const std::string& fileName) const;
+
+            //! Read the pyramid from a file.
+            void read(const std::string& fileName);
+
+        private:
+            size_t _getBinSampleCount(size_t level, size_t index) const;
+
+            size_t _sampleRate = 0;
+            size_t _binSize = 256;
+            size_t _sampleCount = 0;
+            std::vector<std::vector<Peak> > _levels;
+            bool _finished = false;
+
+            float _binMin = 0.F;
+            float _binMax = 0.F;
+            double _binSumSq = 0.0;
+            size_t _binCount = 0;
+        };
+    }
+}
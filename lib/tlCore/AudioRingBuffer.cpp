@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        struct AudioRingBuffer::Private
+        {
+            Info info;
+            size_t sampleCount = 0;
+            size_t sampleByteCount = 0;
+            std::vector<uint8_t> data;
+
+            // The total number of samples read and written. These only
+            // increase, and the difference is the number of samples in
+            // the buffer.
+            std::atomic<size_t> readCount;
+            std::atomic<size_t> writeCount;
+        };
+
+        void AudioRingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.sampleCount = sampleCount;
+            p.sampleByteCount = info.getByteCount();
+            p.data.resize(sampleCount * p.sampleByteCount);
+            p.readCount = 0;
+            p.writeCount = 0;
+        }
+
+        AudioRingBuffer::AudioRingBuffer() :
+            _p(new Private)
+        {}
+
+        AudioRingBuffer::~AudioRingBuffer()
+        {}
+
+        std::shared_ptr<AudioRingBuffer> AudioRingBuffer::create(
+            const Info& info,
+            size_t sampleCount)
+        {
+            auto out = std::shared_ptr<AudioRingBuffer>(new AudioRingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        const Info& AudioRingBuffer::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t AudioRingBuffer::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        size_t AudioRingBuffer::getReadAvailable() const
+        {
+            TLRENDER_P();
+            const size_t readCount = p.readCount.load(std::memory_order_acquire);
+            const size_t writeCount = p.writeCount.load(std::memory_order_acquire);
+            return writeCount - readCount;
+        }
+
+        size_t AudioRingBuffer::getWriteAvailable() const
+        {
+            TLRENDER_P();
+            const size_t readCount = p.readCount.load(std::memory_order_acquire);
+            const size_t writeCount = p.writeCount.load(std::memory_order_acquire);
+            return p.sampleCount - (writeCount - readCount);
+        }
+
+        size_t AudioRingBuffer::write(const uint8_t* data, size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t writeCount = p.writeCount.load(std::memory_order_relaxed);
+            const size_t readCount = p.readCount.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, p.sampleCount - (writeCount - readCount));
+            if (out > 0)
+            {
+                const size_t pos = writeCount % p.sampleCount;
+                const size_t size = std::min(out, p.sampleCount - pos);
+                memcpy(
+                    p.data.data() + pos * p.sampleByteCount,
+                    data,
+                    size * p.sampleByteCount);
+                if (size < out)
+                {
+                    memcpy(
+                        p.data.data(),
+                        data + size * p.sampleByteCount,
+                        (out - size) * p.sampleByteCount);
+                }
+                p.writeCount.store(writeCount + out, std::memory_order_release);
+            }
+            return out;
+        }
+
+        size_t AudioRingBuffer::read(uint8_t* data, size_t sampleCount, float volume)
+        {
+            TLRENDER_P();
+            const size_t readCount = p.readCount.load(std::memory_order_relaxed);
+            const size_t writeCount = p.writeCount.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, writeCount - readCount);
+            if (out > 0)
+            {
+                const size_t pos = readCount % p.sampleCount;
+                const size_t sizes[2] =
+                {
+                    std::min(out, p.sampleCount - pos),
+                    out - std::min(out, p.sampleCount - pos)
+                };
+                const uint8_t* in[2] =
+                {
+                    p.data.data() + pos * p.sampleByteCount,
+                    p.data.data()
+                };
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    if (sizes[i] > 0)
+                    {
+                        if (1.F == volume)
+                        {
+                            memcpy(data, in[i], sizes[i] * p.sampleByteCount);
+                        }
+                        else
+                        {
+                            mix(
+                                in + i,
+                                1,
+                                data,
+                                volume,
+                                sizes[i],
+                                p.info.channelCount,
+                                p.info.dataType);
+                        }
+                        data += sizes[i] * p.sampleByteCount;
+                    }
+                }
+                p.readCount.store(readCount + out, std::memory_order_release);
+            }
+            return out;
+        }
+
+        size_t AudioRingBuffer::discard(size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t readCount = p.readCount.load(std::memory_order_relaxed);
+            const size_t writeCount = p.writeCount.load(std::memory_order_acquire);
+            const size_t out = std::min(sampleCount, writeCount - readCount);
+            p.readCount.store(readCount + out, std::memory_order_release);
+            return out;
+        }
+
+        void AudioRingBuffer::clear()
+        {
+            TLRENDER_P();
+            p.readCount.store(
+                p.writeCount.load(std::memory_order_acquire),
+                std::memory_order_release);
+        }
+    }
+}
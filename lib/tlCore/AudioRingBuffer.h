@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Lock-free audio ring buffer.
+        //!
+        //! The ring buffer has a single producer thread that writes audio
+        //! data and a single consumer thread that reads it. The storage is
+        //! allocated when the ring buffer is created, so reading and
+        //! writing never allocate memory or take locks, and the consumer
+        //! may be a real-time audio callback.
+        class AudioRingBuffer
+        {
+            TLRENDER_NON_COPYABLE(AudioRingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+
+            AudioRingBuffer();
+
+        public:
+            ~AudioRingBuffer();
+
+            //! Create a new ring buffer.
+            static std::shared_ptr<AudioRingBuffer> create(
+                const Info&,
+                size_t sampleCount);
+
+            //! Get the audio information.
+            const Info& getInfo() const;
+
+            //! Get the maximum number of samples.
+            size_t getSampleCount() const;
+
+            //! Get the number of samples available for reading.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples available for writing.
+            size_t getWriteAvailable() const;
+
+            //! Write audio data. Returns the number of samples written. This
+            //! function should only be called from the producer thread.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Read audio data, applying the given volume. Returns the
+            //! number of samples read. This function should only be called
+            //! from the consumer thread.
+            size_t read(uint8_t*, size_t sampleCount, float volume = 1.F);
+
+            //! Discard audio data. Returns the number of samples
+            //! discarded. This function should only be called from the
+            //! consumer thread.
+            size_t discard(size_t sampleCount);
+
+            //! Discard all of the audio data. This function should only be
+            //! called from the consumer thread.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,1098 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioSIMD.h>
+
+#include <tlCore/Error.h>
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TLRENDER_AUDIO_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+#endif // __x86_64__
+
+// The AVX2 kernels are compiled for AVX2 with a function attribute so
+// that the rest of the library does not require AVX2. Note that FMA is
+// deliberately not enabled, since fused multiply-adds would change the
+// results.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TLRENDER_AVX2
+#else
+#define TLRENDER_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace tl
+{
+    namespace audio
+    {
+        namespace simd
+        {
+            TLRENDER_ENUM_IMPL(
+                Instructions,
+                "Scalar",
+                "SSE2",
+                "AVX2");
+            TLRENDER_ENUM_SERIALIZE_IMPL(Instructions);
+
+            namespace
+            {
+                template<typename T, typename TI>
+                void mixI(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t start,
+                    size_t end)
+                {
+                    const T** const inP = reinterpret_cast<const T**>(in);
+                    T* const outP = reinterpret_cast<T*>(out);
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        const TI min = static_cast<TI>(std::numeric_limits<T>::min());
+                        const TI max = static_cast<TI>(std::numeric_limits<T>::max());
+                        TI v = 0;
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            v += math::clamp(static_cast<TI>(inP[j][i] * volume), min, max);
+                        }
+                        outP[i] = math::clamp(v, min, max);
+                    }
+                }
+
+                template<typename T>
+                void mixF(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t start,
+                    size_t end)
+                {
+                    const T** const inP = reinterpret_cast<const T**>(in);
+                    T* const outP = reinterpret_cast<T*>(out);
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        T v = static_cast<T>(0);
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            v += inP[j][i] * volume;
+                        }
+                        outP[i] = v;
+                    }
+                }
+
+                template<typename T, typename TI>
+                void mixIScalar(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    mixI<T, TI>(in, inCount, out, volume, 0, size);
+                }
+
+                template<typename T>
+                void mixFScalar(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    mixF<T>(in, inCount, out, volume, 0, size);
+                }
+
+                template<typename TIn, typename TOut, void (*F)(TIn, TOut&) noexcept>
+                void convert(const TIn* in, TOut* out, size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        F(in[i], out[i]);
+                    }
+                }
+
+                template<typename TIn, typename TOut, void (*F)(TIn, TOut&) noexcept>
+                void convertScalar(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    convert<TIn, TOut, F>(
+                        reinterpret_cast<const TIn*>(in),
+                        reinterpret_cast<TOut*>(out),
+                        0,
+                        size);
+                }
+
+                template<typename T>
+                void interleave2(const T* in0, const T* in1, T* out, size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        out[i * 2] = in0[i];
+                        out[i * 2 + 1] = in1[i];
+                    }
+                }
+
+                template<typename T>
+                void interleave2Scalar(
+                    const uint8_t* in0,
+                    const uint8_t* in1,
+                    uint8_t* out,
+                    size_t sampleCount)
+                {
+                    interleave2(
+                        reinterpret_cast<const T*>(in0),
+                        reinterpret_cast<const T*>(in1),
+                        reinterpret_cast<T*>(out),
+                        0,
+                        sampleCount);
+                }
+
+                template<typename T>
+                void deinterleave2(const T* in, T* out0, T* out1, size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        out0[i] = in[i * 2];
+                        out1[i] = in[i * 2 + 1];
+                    }
+                }
+
+                template<typename T>
+                void deinterleave2Scalar(
+                    const uint8_t* in,
+                    uint8_t* out0,
+                    uint8_t* out1,
+                    size_t sampleCount)
+                {
+                    deinterleave2(
+                        reinterpret_cast<const T*>(in),
+                        reinterpret_cast<T*>(out0),
+                        reinterpret_cast<T*>(out1),
+                        0,
+                        sampleCount);
+                }
+
+                size_t index(DataType value)
+                {
+                    return static_cast<size_t>(value);
+                }
+
+#define _CONVERT(a, b) \
+    out.convert[index(DataType::a)][index(DataType::b)] = \
+        convertScalar<a##_T, b##_T, a##To##b>
+
+                Kernels getScalarKernels()
+                {
+                    Kernels out;
+                    out.mix[index(DataType::S8)] = mixIScalar<int8_t, int16_t>;
+                    out.mix[index(DataType::S16)] = mixIScalar<int16_t, int32_t>;
+                    out.mix[index(DataType::S32)] = mixIScalar<int32_t, int64_t>;
+                    out.mix[index(DataType::F32)] = mixFScalar<float>;
+                    out.mix[index(DataType::F64)] = mixFScalar<double>;
+
+                    _CONVERT(S8, S16);
+                    _CONVERT(S8, S32);
+                    _CONVERT(S8, F32);
+                    _CONVERT(S8, F64);
+                    _CONVERT(S16, S8);
+                    _CONVERT(S16, S32);
+                    _CONVERT(S16, F32);
+                    _CONVERT(S16, F64);
+                    _CONVERT(S32, S8);
+                    _CONVERT(S32, S16);
+                    _CONVERT(S32, F32);
+                    _CONVERT(S32, F64);
+                    _CONVERT(F32, S8);
+                    _CONVERT(F32, S16);
+                    _CONVERT(F32, S32);
+                    _CONVERT(F32, F64);
+                    _CONVERT(F64, S8);
+                    _CONVERT(F64, S16);
+                    _CONVERT(F64, S32);
+                    _CONVERT(F64, F32);
+
+                    out.interleave2[index(DataType::S8)] = interleave2Scalar<S8_T>;
+                    out.interleave2[index(DataType::S16)] = interleave2Scalar<S16_T>;
+                    out.interleave2[index(DataType::S32)] = interleave2Scalar<S32_T>;
+                    out.interleave2[index(DataType::F32)] = interleave2Scalar<F32_T>;
+                    out.interleave2[index(DataType::F64)] = interleave2Scalar<F64_T>;
+
+                    out.deinterleave2[index(DataType::S8)] = deinterleave2Scalar<S8_T>;
+                    out.deinterleave2[index(DataType::S16)] = deinterleave2Scalar<S16_T>;
+                    out.deinterleave2[index(DataType::S32)] = deinterleave2Scalar<S32_T>;
+                    out.deinterleave2[index(DataType::F32)] = deinterleave2Scalar<F32_T>;
+                    out.deinterleave2[index(DataType::F64)] = deinterleave2Scalar<F64_T>;
+                    return out;
+                }
+
+#undef _CONVERT
+
+#if defined(TLRENDER_AUDIO_X86)
+                // The vectorized kernels must match the scalar kernels
+                // exactly:
+                //
+                // * Float to integer conversions truncate, like
+                //   static_cast<>().
+                // * Integer clamping is done with saturating packs or
+                //   min/max instructions.
+                // * Multiplies and adds are kept separate and in the same
+                //   order as the scalar code.
+                // * The 64-bit integer sums of the S32 mix are done with
+                //   doubles, which are exact for the clamped 32-bit values.
+                //
+                // Samples left over at the end are handled by the scalar
+                // code.
+
+                bool cpuAVX2()
+                {
+#if defined(_MSC_VER)
+                    int info[4] = { 0, 0, 0, 0 };
+                    __cpuid(info, 0);
+                    if (info[0] < 7)
+                        return false;
+                    __cpuid(info, 1);
+                    const bool osxsave = (info[2] & (1 << 27)) != 0;
+                    const bool avx = (info[2] & (1 << 28)) != 0;
+                    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+                        return false;
+                    __cpuidex(info, 7, 0);
+                    return (info[1] & (1 << 5)) != 0;
+#else // _MSC_VER
+                    __builtin_cpu_init();
+                    return __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+                }
+
+                //
+                // SSE2
+                //
+
+                inline __m128i sse2S16ToS32Lo(__m128i value)
+                {
+                    return _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+                }
+
+                inline __m128i sse2S16ToS32Hi(__m128i value)
+                {
+                    return _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+                }
+
+                void mixS8SSE2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const S8_T** const inP = reinterpret_cast<const S8_T**>(in);
+                    S8_T* const outP = reinterpret_cast<S8_T*>(out);
+                    const __m128 v = _mm_set1_ps(volume);
+                    const __m128i min = _mm_set1_epi16(S8Range.getMin());
+                    const __m128i max = _mm_set1_epi16(S8Range.getMax());
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        __m128i sum = _mm_setzero_si128();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            const __m128i s8 = _mm_loadl_epi64(
+                                reinterpret_cast<const __m128i*>(inP[j] + i));
+                            const __m128i s16 = _mm_srai_epi16(_mm_unpacklo_epi8(s8, s8), 8);
+                            __m128i lo = _mm_cvttps_epi32(
+                                _mm_mul_ps(_mm_cvtepi32_ps(sse2S16ToS32Lo(s16)), v));
+                            __m128i hi = _mm_cvttps_epi32(
+                                _mm_mul_ps(_mm_cvtepi32_ps(sse2S16ToS32Hi(s16)), v));
+                            // Wrap to 16-bits like static_cast<int16_t>().
+                            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+                            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+                            const __m128i x = _mm_packs_epi32(lo, hi);
+                            sum = _mm_add_epi16(sum, _mm_min_epi16(_mm_max_epi16(x, min), max));
+                        }
+                        sum = _mm_min_epi16(_mm_max_epi16(sum, min), max);
+                        _mm_storel_epi64(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_packs_epi16(sum, sum));
+                    }
+                    mixI<int8_t, int16_t>(in, inCount, out, volume, i, size);
+                }
+
+                void mixS16SSE2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const S16_T** const inP = reinterpret_cast<const S16_T**>(in);
+                    S16_T* const outP = reinterpret_cast<S16_T*>(out);
+                    const __m128 v = _mm_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        __m128i lo = _mm_setzero_si128();
+                        __m128i hi = _mm_setzero_si128();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            const __m128i s16 = _mm_loadu_si128(
+                                reinterpret_cast<const __m128i*>(inP[j] + i));
+                            const __m128i x = _mm_packs_epi32(
+                                _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sse2S16ToS32Lo(s16)), v)),
+                                _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sse2S16ToS32Hi(s16)), v)));
+                            lo = _mm_add_epi32(lo, sse2S16ToS32Lo(x));
+                            hi = _mm_add_epi32(hi, sse2S16ToS32Hi(x));
+                        }
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_packs_epi32(lo, hi));
+                    }
+                    mixI<int16_t, int32_t>(in, inCount, out, volume, i, size);
+                }
+
+                void mixS32SSE2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const S32_T** const inP = reinterpret_cast<const S32_T**>(in);
+                    S32_T* const outP = reinterpret_cast<S32_T*>(out);
+                    const __m128 v = _mm_set1_ps(volume);
+                    const __m128 overflow = _mm_set1_ps(2147483648.F);
+                    const __m128i max = _mm_set1_epi32(S32Range.getMax());
+                    const __m128d minD = _mm_set1_pd(S32Range.getMin());
+                    const __m128d maxD = _mm_set1_pd(S32Range.getMax());
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        __m128d lo = _mm_setzero_pd();
+                        __m128d hi = _mm_setzero_pd();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            const __m128 f = _mm_mul_ps(
+                                _mm_cvtepi32_ps(_mm_loadu_si128(
+                                    reinterpret_cast<const __m128i*>(inP[j] + i))),
+                                v);
+                            // Values below the minimum convert to the
+                            // minimum, values above the maximum must be
+                            // clamped.
+                            const __m128i m = _mm_castps_si128(_mm_cmpge_ps(f, overflow));
+                            const __m128i x = _mm_or_si128(
+                                _mm_and_si128(m, max),
+                                _mm_andnot_si128(m, _mm_cvttps_epi32(f)));
+                            lo = _mm_add_pd(lo, _mm_cvtepi32_pd(x));
+                            hi = _mm_add_pd(hi, _mm_cvtepi32_pd(_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2))));
+                        }
+                        lo = _mm_min_pd(_mm_max_pd(lo, minD), maxD);
+                        hi = _mm_min_pd(_mm_max_pd(hi, minD), maxD);
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi)));
+                    }
+                    mixI<int32_t, int64_t>(in, inCount, out, volume, i, size);
+                }
+
+                void mixF32SSE2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const F32_T** const inP = reinterpret_cast<const F32_T**>(in);
+                    F32_T* const outP = reinterpret_cast<F32_T*>(out);
+                    const __m128 v = _mm_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        __m128 lo = _mm_setzero_ps();
+                        __m128 hi = _mm_setzero_ps();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            lo = _mm_add_ps(lo, _mm_mul_ps(_mm_loadu_ps(inP[j] + i), v));
+                            hi = _mm_add_ps(hi, _mm_mul_ps(_mm_loadu_ps(inP[j] + i + 4), v));
+                        }
+                        _mm_storeu_ps(outP + i, lo);
+                        _mm_storeu_ps(outP + i + 4, hi);
+                    }
+                    mixF<float>(in, inCount, out, volume, i, size);
+                }
+
+                void mixF64SSE2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const F64_T** const inP = reinterpret_cast<const F64_T**>(in);
+                    F64_T* const outP = reinterpret_cast<F64_T*>(out);
+                    const __m128d v = _mm_set1_pd(volume);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        __m128d lo = _mm_setzero_pd();
+                        __m128d hi = _mm_setzero_pd();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            lo = _mm_add_pd(lo, _mm_mul_pd(_mm_loadu_pd(inP[j] + i), v));
+                            hi = _mm_add_pd(hi, _mm_mul_pd(_mm_loadu_pd(inP[j] + i + 2), v));
+                        }
+                        _mm_storeu_pd(outP + i, lo);
+                        _mm_storeu_pd(outP + i + 2, hi);
+                    }
+                    mixF<double>(in, inCount, out, volume, i, size);
+                }
+
+                void S16ToS32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S16_T* inP = reinterpret_cast<const S16_T*>(in);
+                    S32_T* outP = reinterpret_cast<S32_T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_slli_epi32(sse2S16ToS32Lo(x), 16));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i + 4),
+                            _mm_slli_epi32(sse2S16ToS32Hi(x), 16));
+                    }
+                    convert<S16_T, S32_T, S16ToS32>(inP, outP, i, size);
+                }
+
+                void S16ToF32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S16_T* inP = reinterpret_cast<const S16_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    const __m128 d = _mm_set1_ps(static_cast<float>(S16Range.getMax()));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(sse2S16ToS32Lo(x)), d));
+                        _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(sse2S16ToS32Hi(x)), d));
+                    }
+                    convert<S16_T, F32_T, S16ToF32>(inP, outP, i, size);
+                }
+
+                void S32ToS16SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S32_T* inP = reinterpret_cast<const S32_T*>(in);
+                    S16_T* outP = reinterpret_cast<S16_T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        // Divide with rounding towards zero.
+                        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i + 4));
+                        lo = _mm_add_epi32(lo, _mm_srli_epi32(_mm_srai_epi32(lo, 31), 16));
+                        hi = _mm_add_epi32(hi, _mm_srli_epi32(_mm_srai_epi32(hi, 31), 16));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16)));
+                    }
+                    convert<S32_T, S16_T, S32ToS16>(inP, outP, i, size);
+                }
+
+                void S32ToF32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S32_T* inP = reinterpret_cast<const S32_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    const __m128 d = _mm_set1_ps(static_cast<float>(S32Range.getMax()));
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(x), d));
+                    }
+                    convert<S32_T, F32_T, S32ToF32>(inP, outP, i, size);
+                }
+
+                void F32ToS16SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    S16_T* outP = reinterpret_cast<S16_T*>(out);
+                    const __m128 m = _mm_set1_ps(S16Range.getMax());
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP + i), m));
+                        const __m128i hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP + i + 4), m));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packs_epi32(lo, hi));
+                    }
+                    convert<F32_T, S16_T, F32ToS16>(inP, outP, i, size);
+                }
+
+                void F32ToF64SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    F64_T* outP = reinterpret_cast<F64_T*>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128 x = _mm_loadu_ps(inP + i);
+                        _mm_storeu_pd(outP + i, _mm_cvtps_pd(x));
+                        _mm_storeu_pd(outP + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+                    }
+                    convert<F32_T, F64_T, F32ToF64>(inP, outP, i, size);
+                }
+
+                void F64ToF32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F64_T* inP = reinterpret_cast<const F64_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(inP + i));
+                        const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(inP + i + 2));
+                        _mm_storeu_ps(outP + i, _mm_movelh_ps(lo, hi));
+                    }
+                    convert<F64_T, F32_T, F64ToF32>(inP, outP, i, size);
+                }
+
+                void interleave2S16SSE2(
+                    const uint8_t* in0,
+                    const uint8_t* in1,
+                    uint8_t* out,
+                    size_t sampleCount)
+                {
+                    const S16_T* in0P = reinterpret_cast<const S16_T*>(in0);
+                    const S16_T* in1P = reinterpret_cast<const S16_T*>(in1);
+                    S16_T* outP = reinterpret_cast<S16_T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= sampleCount; i += 8)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0P + i));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1P + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2), _mm_unpacklo_epi16(a, b));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2 + 8), _mm_unpackhi_epi16(a, b));
+                    }
+                    interleave2(in0P, in1P, outP, i, sampleCount);
+                }
+
+                template<typename T>
+                void interleave2B32SSE2(
+                    const uint8_t* in0,
+                    const uint8_t* in1,
+                    uint8_t* out,
+                    size_t sampleCount)
+                {
+                    const T* in0P = reinterpret_cast<const T*>(in0);
+                    const T* in1P = reinterpret_cast<const T*>(in1);
+                    T* outP = reinterpret_cast<T*>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= sampleCount; i += 4)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0P + i));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1P + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2), _mm_unpacklo_epi32(a, b));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2 + 4), _mm_unpackhi_epi32(a, b));
+                    }
+                    interleave2(in0P, in1P, outP, i, sampleCount);
+                }
+
+                void interleave2F64SSE2(
+                    const uint8_t* in0,
+                    const uint8_t* in1,
+                    uint8_t* out,
+                    size_t sampleCount)
+                {
+                    const F64_T* in0P = reinterpret_cast<const F64_T*>(in0);
+                    const F64_T* in1P = reinterpret_cast<const F64_T*>(in1);
+                    F64_T* outP = reinterpret_cast<F64_T*>(out);
+                    size_t i = 0;
+                    for (; i + 2 <= sampleCount; i += 2)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0P + i));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1P + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2), _mm_unpacklo_epi64(a, b));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i * 2 + 2), _mm_unpackhi_epi64(a, b));
+                    }
+                    interleave2(in0P, in1P, outP, i, sampleCount);
+                }
+
+                void deinterleave2S16SSE2(
+                    const uint8_t* in,
+                    uint8_t* out0,
+                    uint8_t* out1,
+                    size_t sampleCount)
+                {
+                    const S16_T* inP = reinterpret_cast<const S16_T*>(in);
+                    S16_T* out0P = reinterpret_cast<S16_T*>(out0);
+                    S16_T* out1P = reinterpret_cast<S16_T*>(out1);
+                    size_t i = 0;
+                    for (; i + 8 <= sampleCount; i += 8)
+                    {
+                        // Sign extend the even and odd samples to 32-bits
+                        // so they can be packed without saturating.
+                        const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2));
+                        const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2 + 8));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(out0P + i),
+                            _mm_packs_epi32(
+                                _mm_srai_epi32(_mm_slli_epi32(x0, 16), 16),
+                                _mm_srai_epi32(_mm_slli_epi32(x1, 16), 16)));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(out1P + i),
+                            _mm_packs_epi32(_mm_srai_epi32(x0, 16), _mm_srai_epi32(x1, 16)));
+                    }
+                    deinterleave2(inP, out0P, out1P, i, sampleCount);
+                }
+
+                template<typename T>
+                void deinterleave2B32SSE2(
+                    const uint8_t* in,
+                    uint8_t* out0,
+                    uint8_t* out1,
+                    size_t sampleCount)
+                {
+                    const T* inP = reinterpret_cast<const T*>(in);
+                    T* out0P = reinterpret_cast<T*>(out0);
+                    T* out1P = reinterpret_cast<T*>(out1);
+                    size_t i = 0;
+                    for (; i + 4 <= sampleCount; i += 4)
+                    {
+                        const __m128 x0 = _mm_castsi128_ps(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2)));
+                        const __m128 x1 = _mm_castsi128_ps(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2 + 4)));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(out0P + i),
+                            _mm_castps_si128(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0))));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(out1P + i),
+                            _mm_castps_si128(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1))));
+                    }
+                    deinterleave2(inP, out0P, out1P, i, sampleCount);
+                }
+
+                void deinterleave2F64SSE2(
+                    const uint8_t* in,
+                    uint8_t* out0,
+                    uint8_t* out1,
+                    size_t sampleCount)
+                {
+                    const F64_T* inP = reinterpret_cast<const F64_T*>(in);
+                    F64_T* out0P = reinterpret_cast<F64_T*>(out0);
+                    F64_T* out1P = reinterpret_cast<F64_T*>(out1);
+                    size_t i = 0;
+                    for (; i + 2 <= sampleCount; i += 2)
+                    {
+                        const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2));
+                        const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i * 2 + 2));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out0P + i), _mm_unpacklo_epi64(x0, x1));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out1P + i), _mm_unpackhi_epi64(x0, x1));
+                    }
+                    deinterleave2(inP, out0P, out1P, i, sampleCount);
+                }
+
+                Kernels getSSE2Kernels()
+                {
+                    Kernels out = getScalarKernels();
+                    out.mix[index(DataType::S8)] = mixS8SSE2;
+                    out.mix[index(DataType::S16)] = mixS16SSE2;
+                    out.mix[index(DataType::S32)] = mixS32SSE2;
+                    out.mix[index(DataType::F32)] = mixF32SSE2;
+                    out.mix[index(DataType::F64)] = mixF64SSE2;
+
+                    out.convert[index(DataType::S16)][index(DataType::S32)] = S16ToS32SSE2;
+                    out.convert[index(DataType::S16)][index(DataType::F32)] = S16ToF32SSE2;
+                    out.convert[index(DataType::S32)][index(DataType::S16)] = S32ToS16SSE2;
+                    out.convert[index(DataType::S32)][index(DataType::F32)] = S32ToF32SSE2;
+                    out.convert[index(DataType::F32)][index(DataType::S16)] = F32ToS16SSE2;
+                    out.convert[index(DataType::F32)][index(DataType::F64)] = F32ToF64SSE2;
+                    out.convert[index(DataType::F64)][index(DataType::F32)] = F64ToF32SSE2;
+
+                    out.interleave2[index(DataType::S16)] = interleave2S16SSE2;
+                    out.interleave2[index(DataType::S32)] = interleave2B32SSE2<S32_T>;
+                    out.interleave2[index(DataType::F32)] = interleave2B32SSE2<F32_T>;
+                    out.interleave2[index(DataType::F64)] = interleave2F64SSE2;
+
+                    out.deinterleave2[index(DataType::S16)] = deinterleave2S16SSE2;
+                    out.deinterleave2[index(DataType::S32)] = deinterleave2B32SSE2<S32_T>;
+                    out.deinterleave2[index(DataType::F32)] = deinterleave2B32SSE2<F32_T>;
+                    out.deinterleave2[index(DataType::F64)] = deinterleave2F64SSE2;
+                    return out;
+                }
+
+                //
+                // AVX2
+                //
+
+                TLRENDER_AVX2 void mixS16AVX2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const S16_T** const inP = reinterpret_cast<const S16_T**>(in);
+                    S16_T* const outP = reinterpret_cast<S16_T*>(out);
+                    const __m256 v = _mm256_set1_ps(volume);
+                    const __m256i min = _mm256_set1_epi32(S16Range.getMin());
+                    const __m256i max = _mm256_set1_epi32(S16Range.getMax());
+                    size_t i = 0;
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        __m256i lo = _mm256_setzero_si256();
+                        __m256i hi = _mm256_setzero_si256();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            const __m256i x0 = _mm256_cvtepi16_epi32(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP[j] + i)));
+                            const __m256i x1 = _mm256_cvtepi16_epi32(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP[j] + i + 8)));
+                            const __m256i y0 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(x0), v));
+                            const __m256i y1 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(x1), v));
+                            lo = _mm256_add_epi32(lo, _mm256_min_epi32(_mm256_max_epi32(y0, min), max));
+                            hi = _mm256_add_epi32(hi, _mm256_min_epi32(_mm256_max_epi32(y1, min), max));
+                        }
+                        // The pack works on 128-bit lanes, so the result
+                        // needs to be re-ordered.
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(outP + i),
+                            _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0)));
+                    }
+                    mixI<int16_t, int32_t>(in, inCount, out, volume, i, size);
+                }
+
+                TLRENDER_AVX2 void mixS32AVX2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const S32_T** const inP = reinterpret_cast<const S32_T**>(in);
+                    S32_T* const outP = reinterpret_cast<S32_T*>(out);
+                    const __m256 v = _mm256_set1_ps(volume);
+                    const __m256 overflow = _mm256_set1_ps(2147483648.F);
+                    const __m256 max = _mm256_castsi256_ps(_mm256_set1_epi32(S32Range.getMax()));
+                    const __m256d minD = _mm256_set1_pd(S32Range.getMin());
+                    const __m256d maxD = _mm256_set1_pd(S32Range.getMax());
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        __m256d lo = _mm256_setzero_pd();
+                        __m256d hi = _mm256_setzero_pd();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            const __m256 f = _mm256_mul_ps(
+                                _mm256_cvtepi32_ps(_mm256_loadu_si256(
+                                    reinterpret_cast<const __m256i*>(inP[j] + i))),
+                                v);
+                            const __m256i x = _mm256_castps_si256(_mm256_blendv_ps(
+                                _mm256_castsi256_ps(_mm256_cvttps_epi32(f)),
+                                max,
+                                _mm256_cmp_ps(f, overflow, _CMP_GE_OQ)));
+                            lo = _mm256_add_pd(lo, _mm256_cvtepi32_pd(_mm256_castsi256_si128(x)));
+                            hi = _mm256_add_pd(hi, _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)));
+                        }
+                        lo = _mm256_min_pd(_mm256_max_pd(lo, minD), maxD);
+                        hi = _mm256_min_pd(_mm256_max_pd(hi, minD), maxD);
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(outP + i),
+                            _mm256_inserti128_si256(
+                                _mm256_castsi128_si256(_mm256_cvttpd_epi32(lo)),
+                                _mm256_cvttpd_epi32(hi),
+                                1));
+                    }
+                    mixI<int32_t, int64_t>(in, inCount, out, volume, i, size);
+                }
+
+                TLRENDER_AVX2 void mixF32AVX2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const F32_T** const inP = reinterpret_cast<const F32_T**>(in);
+                    F32_T* const outP = reinterpret_cast<F32_T*>(out);
+                    const __m256 v = _mm256_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        __m256 lo = _mm256_setzero_ps();
+                        __m256 hi = _mm256_setzero_ps();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            lo = _mm256_add_ps(lo, _mm256_mul_ps(_mm256_loadu_ps(inP[j] + i), v));
+                            hi = _mm256_add_ps(hi, _mm256_mul_ps(_mm256_loadu_ps(inP[j] + i + 8), v));
+                        }
+                        _mm256_storeu_ps(outP + i, lo);
+                        _mm256_storeu_ps(outP + i + 8, hi);
+                    }
+                    mixF<float>(in, inCount, out, volume, i, size);
+                }
+
+                TLRENDER_AVX2 void mixF64AVX2(
+                    const uint8_t** in,
+                    size_t inCount,
+                    uint8_t* out,
+                    float volume,
+                    size_t size)
+                {
+                    const F64_T** const inP = reinterpret_cast<const F64_T**>(in);
+                    F64_T* const outP = reinterpret_cast<F64_T*>(out);
+                    const __m256d v = _mm256_set1_pd(volume);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        __m256d lo = _mm256_setzero_pd();
+                        __m256d hi = _mm256_setzero_pd();
+                        for (size_t j = 0; j < inCount; ++j)
+                        {
+                            lo = _mm256_add_pd(lo, _mm256_mul_pd(_mm256_loadu_pd(inP[j] + i), v));
+                            hi = _mm256_add_pd(hi, _mm256_mul_pd(_mm256_loadu_pd(inP[j] + i + 4), v));
+                        }
+                        _mm256_storeu_pd(outP + i, lo);
+                        _mm256_storeu_pd(outP + i + 4, hi);
+                    }
+                    mixF<double>(in, inCount, out, volume, i, size);
+                }
+
+                TLRENDER_AVX2 void S16ToF32AVX2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S16_T* inP = reinterpret_cast<const S16_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    const __m256 d = _mm256_set1_ps(static_cast<float>(S16Range.getMax()));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m256i x = _mm256_cvtepi16_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i)));
+                        _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(x), d));
+                    }
+                    convert<S16_T, F32_T, S16ToF32>(inP, outP, i, size);
+                }
+
+                TLRENDER_AVX2 void S32ToF32AVX2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const S32_T* inP = reinterpret_cast<const S32_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    const __m256 d = _mm256_set1_ps(static_cast<float>(S32Range.getMax()));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inP + i));
+                        _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(x), d));
+                    }
+                    convert<S32_T, F32_T, S32ToF32>(inP, outP, i, size);
+                }
+
+                TLRENDER_AVX2 void F32ToS16AVX2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    S16_T* outP = reinterpret_cast<S16_T*>(out);
+                    const __m256 m = _mm256_set1_ps(S16Range.getMax());
+                    size_t i = 0;
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        const __m256i lo = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(inP + i), m));
+                        const __m256i hi = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(inP + i + 8), m));
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(outP + i),
+                            _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0)));
+                    }
+                    convert<F32_T, S16_T, F32ToS16>(inP, outP, i, size);
+                }
+
+                TLRENDER_AVX2 void F32ToF64AVX2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    F64_T* outP = reinterpret_cast<F64_T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        _mm256_storeu_pd(outP + i, _mm256_cvtps_pd(_mm_loadu_ps(inP + i)));
+                        _mm256_storeu_pd(outP + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(inP + i + 4)));
+                    }
+                    convert<F32_T, F64_T, F32ToF64>(inP, outP, i, size);
+                }
+
+                TLRENDER_AVX2 void F64ToF32AVX2(const uint8_t* in, uint8_t* out, size_t size)
+                {
+                    const F64_T* inP = reinterpret_cast<const F64_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        _mm_storeu_ps(outP + i, _mm256_cvtpd_ps(_mm256_loadu_pd(inP + i)));
+                        _mm_storeu_ps(outP + i + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(inP + i + 4)));
+                    }
+                    convert<F64_T, F32_T, F64ToF32>(inP, outP, i, size);
+                }
+
+                template<typename T>
+                TLRENDER_AVX2 void interleave2B32AVX2(
+                    const uint8_t* in0,
+                    const uint8_t* in1,
+                    uint8_t* out,
+                    size_t sampleCount)
+                {
+                    const T* in0P = reinterpret_cast<const T*>(in0);
+                    const T* in1P = reinterpret_cast<const T*>(in1);
+                    T* outP = reinterpret_cast<T*>(out);
+                    size_t i = 0;
+                    for (; i + 8 <= sampleCount; i += 8)
+                    {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in0P + i));
+                        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in1P + i));
+                        const __m256i lo = _mm256_unpacklo_epi32(a, b);
+                        const __m256i hi = _mm256_unpackhi_epi32(a, b);
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(outP + i * 2),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(outP + i * 2 + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+                    }
+                    interleave2(in0P, in1P, outP, i, sampleCount);
+                }
+
+                template<typename T>
+                TLRENDER_AVX2 void deinterleave2B32AVX2(
+                    const uint8_t* in,
+                    uint8_t* out0,
+                    uint8_t* out1,
+                    size_t sampleCount)
+                {
+                    const T* inP = reinterpret_cast<const T*>(in);
+                    T* out0P = reinterpret_cast<T*>(out0);
+                    T* out1P = reinterpret_cast<T*>(out1);
+                    size_t i = 0;
+                    for (; i + 8 <= sampleCount; i += 8)
+                    {
+                        const __m256 x0 = _mm256_castsi256_ps(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inP + i * 2)));
+                        const __m256 x1 = _mm256_castsi256_ps(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inP + i * 2 + 8)));
+                        const __m256i a = _mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m256i b = _mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)));
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(out0P + i),
+                            _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0)));
+                        _mm256_storeu_si256(
+                            reinterpret_cast<__m256i*>(out1P + i),
+                            _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0)));
+                    }
+                    deinterleave2(inP, out0P, out1P, i, sampleCount);
+                }
+
+                Kernels getAVX2Kernels()
+                {
+                    Kernels out = getSSE2Kernels();
+                    out.mix[index(DataType::S16)] = mixS16AVX2;
+                    out.mix[index(DataType::S32)] = mixS32AVX2;
+                    out.mix[index(DataType::F32)] = mixF32AVX2;
+                    out.mix[index(DataType::F64)] = mixF64AVX2;
+
+                    out.convert[index(DataType::S16)][index(DataType::F32)] = S16ToF32AVX2;
+                    out.convert[index(DataType::S32)][index(DataType::F32)] = S32ToF32AVX2;
+                    out.convert[index(DataType::F32)][index(DataType::S16)] = F32ToS16AVX2;
+                    out.convert[index(DataType::F32)][index(DataType::F64)] = F32ToF64AVX2;
+                    out.convert[index(DataType::F64)][index(DataType::F32)] = F64ToF32AVX2;
+
+                    out.interleave2[index(DataType::S32)] = interleave2B32AVX2<S32_T>;
+                    out.interleave2[index(DataType::F32)] = interleave2B32AVX2<F32_T>;
+
+                    out.deinterleave2[index(DataType::S32)] = deinterleave2B32AVX2<S32_T>;
+                    out.deinterleave2[index(DataType::F32)] = deinterleave2B32AVX2<F32_T>;
+                    return out;
+                }
+#endif // TLRENDER_AUDIO_X86
+
+                struct KernelsTable
+                {
+                    KernelsTable()
+                    {
+                        kernels[static_cast<size_t>(Instructions::Scalar)] = getScalarKernels();
+#if defined(TLRENDER_AUDIO_X86)
+                        kernels[static_cast<size_t>(Instructions::SSE2)] = getSSE2Kernels();
+                        avx2 = cpuAVX2();
+                        kernels[static_cast<size_t>(Instructions::AVX2)] = avx2 ?
+                            getAVX2Kernels() :
+                            kernels[static_cast<size_t>(Instructions::SSE2)];
+                        best = avx2 ? Instructions::AVX2 : Instructions::SSE2;
+#endif // TLRENDER_AUDIO_X86
+                        current = best;
+                    }
+
+                    std::array<Kernels, static_cast<size_t>(Instructions::Count)> kernels;
+                    bool avx2 = false;
+                    Instructions best = Instructions::Scalar;
+                    std::atomic<Instructions> current;
+                };
+
+                KernelsTable& getKernelsTable()
+                {
+                    static KernelsTable table;
+                    return table;
+                }
+            }
+
+            bool isSupported(Instructions value)
+            {
+                bool out = false;
+                switch (value)
+                {
+                case Instructions::Scalar: out = true; break;
+#if defined(TLRENDER_AUDIO_X86)
+                case Instructions::SSE2: out = true; break;
+                case Instructions::AVX2: out = getKernelsTable().avx2; break;
+#endif // TLRENDER_AUDIO_X86
+                default: break;
+                }
+                return out;
+            }
+
+            Instructions getBestInstructions()
+            {
+                return getKernelsTable().best;
+            }
+
+            Instructions getInstructions()
+            {
+                return getKernelsTable().current;
+            }
+
+            void setInstructions(Instructions value)
+            {
+                if (!isSupported(value))
+                {
+                    throw std::runtime_error(string::Format("Unsupported instructions: {0}").
+                        arg(getLabel(value)));
+                }
+                getKernelsTable().current = value;
+            }
+
+            const Kernels& getKernels(Instructions value)
+            {
+                if (!isSupported(value))
+                {
+                    throw std::runtime_error(string::Format("Unsupported instructions: {0}").
+                        arg(getLabel(value)));
+                }
+                return getKernelsTable().kernels[static_cast<size_t>(value)];
+            }
+
+            const Kernels& getKernels()
+            {
+                auto& table = getKernelsTable();
+                return table.kernels[static_cast<size_t>(table.current.load())];
+            }
+        }
+    }
+}
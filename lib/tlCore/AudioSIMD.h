@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+#include <array>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Vectorized audio kernels.
+        //!
+        //! The audio mix, convert, and interleave functions dispatch to
+        //! the kernels for the best instruction set supported by the CPU.
+        //! The vectorized kernels produce results that are bit-identical
+        //! to the scalar kernels.
+        namespace simd
+        {
+            //! Instruction sets.
+            enum class Instructions
+            {
+                Scalar,
+                SSE2,
+                AVX2,
+
+                Count,
+                First = Scalar
+            };
+            TLRENDER_ENUM(Instructions);
+            TLRENDER_ENUM_SERIALIZE(Instructions);
+
+            //! Get whether an instruction set is supported by the CPU.
+            bool isSupported(Instructions);
+
+            //! Get the best instruction set supported by the CPU.
+            Instructions getBestInstructions();
+
+            //! Get the instruction set used by the audio functions.
+            Instructions getInstructions();
+
+            //! Set the instruction set used by the audio functions. This
+            //! is intended for testing and benchmarking.
+            void setInstructions(Instructions);
+
+            //! Mix kernel. The size is the number of samples multiplied
+            //! by the number of channels.
+            typedef void (*MixKernel)(
+                const uint8_t** in,
+                size_t inCount,
+                uint8_t* out,
+                float volume,
+                size_t size);
+
+            //! Convert kernel. The size is the number of samples
+            //! multiplied by the number of channels.
+            typedef void (*ConvertKernel)(
+                const uint8_t* in,
+                uint8_t* out,
+                size_t size);
+
+            //! Stereo interleave kernel.
+            typedef void (*InterleaveKernel)(
+                const uint8_t* in0,
+                const uint8_t* in1,
+                uint8_t* out,
+                size_t sampleCount);
+
+            //! Stereo de-interleave kernel.
+            typedef void (*DeinterleaveKernel)(
+                const uint8_t* in,
+                uint8_t* out0,
+                uint8_t* out1,
+                size_t sampleCount);
+
+            //! Audio kernels, indexed by data type. Kernels that are not
+            //! available are null.
+            struct Kernels
+            {
+                std::array<MixKernel, static_cast<size_t>(DataType::Count)> mix = {};
+                std::array<
+                    std::array<ConvertKernel, static_cast<size_t>(DataType::Count)>,
+                    static_cast<size_t>(DataType::Count)> convert = {};
+                std::array<InterleaveKernel, static_cast<size_t>(DataType::Count)> interleave2 = {};
+                std::array<DeinterleaveKernel, static_cast<size_t>(DataType::Count)> deinterleave2 = {};
+            };
+
+            //! Get the kernels for the given instruction set.
+            const Kernels& getKernels(Instructions);
+
+            //! Get the kernels used by the audio functions.
+            const Kernels& getKernels();
+        }
+    }
+}
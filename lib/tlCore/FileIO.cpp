@@ -3,13 +3,21 @@
 // All rights reserved.
 
 #include <tlCore/FileIO.h>
+#include <tlCore/FileIOPrivate.h>
 
 #include <tlCore/Assert.h>
 #include <tlCore/Error.h>
+#include <tlCore/StagingCache.h>
 
 #include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+
+#if defined(_WINDOWS)
+#include <malloc.h>
+#endif // _WINDOWS
 
 namespace tl
 {
@@ -23,10 +31,129 @@ namespace tl
             "Append");
         TLRENDER_ENUM_SERIALIZE_IMPL(Mode);
 
-        std::shared_ptr<FileIO> FileIO::create(const std::string& fileName, Mode mode)
+        TLRENDER_ENUM_IMPL(
+            ReadType,
+            "Normal",
+            "DirectIO");
+        TLRENDER_ENUM_SERIALIZE_IMPL(ReadType);
+
+        namespace
+        {
+            uint8_t* alignedAlloc(size_t size)
+            {
+#if defined(_WINDOWS)
+                return reinterpret_cast<uint8_t*>(_aligned_malloc(size, directIOAlignment));
+#else // _WINDOWS
+                void* p = nullptr;
+                return 0 == posix_memalign(&p, directIOAlignment, size) ?
+                    reinterpret_cast<uint8_t*>(p) :
+                    nullptr;
+#endif // _WINDOWS
+            }
+
+            void alignedFree(uint8_t* p)
+            {
+#if defined(_WINDOWS)
+                _aligned_free(p);
+#else // _WINDOWS
+                free(p);
+#endif // _WINDOWS
+            }
+        }
+
+        DirectIOPool::~DirectIOPool()
+        {
+            for (const auto& i : _buffers)
+            {
+                alignedFree(i.first);
+            }
+        }
+
+        uint8_t* DirectIOPool::get(size_t size, size_t& capacity)
+        {
+            uint8_t* out = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                for (auto i = _buffers.begin(); i != _buffers.end(); ++i)
+                {
+                    if (i->second >= size)
+                    {
+                        out = i->first;
+                        capacity = i->second;
+                        _byteCount -= i->second;
+                        _buffers.erase(i);
+                        break;
+                    }
+                }
+            }
+            if (!out)
+            {
+                out = alignedAlloc(size);
+                if (!out)
+                {
+                    throw std::bad_alloc();
+                }
+                capacity = size;
+            }
+            return out;
+        }
+
+        void DirectIOPool::release(uint8_t* buffer, size_t capacity)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_buffers.empty() && _byteCount + capacity > directIOPoolMax)
+            {
+                alignedFree(_buffers.front().first);
+                _byteCount -= _buffers.front().second;
+                _buffers.pop_front();
+            }
+            if (capacity <= directIOPoolMax)
+            {
+                _buffers.push_back(std::make_pair(buffer, capacity));
+                _byteCount += capacity;
+            }
+            else
+            {
+                alignedFree(buffer);
+            }
+        }
+
+        DirectIOPool& getDirectIOPool()
+        {
+            static DirectIOPool pool;
+            return pool;
+        }
+
+        std::shared_ptr<FileIO> FileIO::create(
+            const std::string& fileName,
+            Mode mode,
+            ReadType readType)
+        {
+            auto out = std::shared_ptr<FileIO>(new FileIO);
+            out->_open(fileName, mode, readType);
+            return out;
+        }
+
+        std::shared_ptr<FileIO> FileIO::createStaged(
+            const std::string& fileName,
+            ReadType readType)
         {
             auto out = std::shared_ptr<FileIO>(new FileIO);
-            out->_open(fileName, mode);
+            if (auto staged = getStagedFile(fileName))
+            {
+                try
+                {
+                    // Keep the staged copy while the file is open.
+                    out->_open(*staged, Mode::Read, readType);
+                    out->_setStaged(fileName, staged);
+                    return out;
+                }
+                catch (const std::exception&)
+                {
+                    // Fall back to the original file.
+                }
+            }
+            out->_open(fileName, Mode::Read, readType);
             return out;
         }
 
@@ -29,6 +29,18 @@ namespace tl
         TLRENDER_ENUM(Mode);
         TLRENDER_ENUM_SERIALIZE(Mode);
 
+        //! File read types.
+        enum class ReadType
+        {
+            Normal,   //!< Use memory mapping if it is enabled
+            DirectIO, //!< Read the file bypassing the operating system file cache
+
+            Count,
+            First = Normal
+        };
+        TLRENDER_ENUM(ReadType);
+        TLRENDER_ENUM_SERIALIZE(ReadType);
+
         //! Read files from memory.
         struct MemoryRead
         {
@@ -56,7 +68,16 @@ namespace tl
             //! Create a new file I/O object.
             static std::shared_ptr<FileIO> create(
                 const std::string& fileName,
-                Mode);
+                Mode,
+                ReadType = ReadType::Normal);
+
+            //! Create a new file I/O object for reading a file that may be
+            //! staged. If the staging cache has a copy of the file, the
+            //! copy is read instead of the original, otherwise the file is
+            //! queued for staging. The file name is always the original.
+            static std::shared_ptr<FileIO> createStaged(
+                const std::string& fileName,
+                ReadType = ReadType::Normal);
 
             //! Create a read-only file I/O object from memory.
             static std::shared_ptr<FileIO> create(
@@ -149,6 +170,14 @@ namespace tl
             //! Get the current memory-map position.
             const uint8_t* getMemoryP() const;
 
+            //! Memory map a range of the file with private copy-on-write
+            //! pages. The data can be modified without changing the file
+            //! or any other mapping. The range is unmapped when the
+            //! returned pointer is destroyed. A null pointer is returned
+            //! if memory mapping is not enabled or the range cannot be
+            //! mapped. This function is thread safe.
+            std::shared_ptr<uint8_t> mapCopyOnWrite(size_t offset, size_t size) const;
+
             ///@}
 
             //! \name Endian
@@ -163,7 +192,9 @@ namespace tl
             ///@}
 
         private:
-            void _open(const std::string& fileName, Mode);
+            void _open(const std::string& fileName, Mode, ReadType = ReadType::Normal);
+            void _readDirect();
+            void _setStaged(const std::string& fileName, const std::shared_ptr<const std::string>&);
             bool _close(std::string* error = nullptr);
 
             TLRENDER_PRIVATE();
@@ -187,6 +218,9 @@ namespace tl
 
         //! Truncate a file.
         void truncate(const std::string& fileName, size_t);
+
+        //! Hint to the operating system that a file will be read soon.
+        void prefetch(const std::string& fileName);
     }
 }
 
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Memory.h>
+
+#include <list>
+#include <mutex>
+
+namespace tl
+{
+    namespace file
+    {
+        //! Alignment for direct I/O buffers. This is a multiple of the sector
+        //! size required by O_DIRECT and FILE_FLAG_NO_BUFFERING.
+        const size_t directIOAlignment = 4096;
+
+        //! Maximum number of bytes kept in the direct I/O buffer pool.
+        const size_t directIOPoolMax = 256 * memory::megabyte;
+
+        //! Pool of aligned buffers for direct I/O.
+        class DirectIOPool
+        {
+        public:
+            ~DirectIOPool();
+
+            //! Get a buffer of at least the given size. The capacity is set
+            //! to the actual size of the buffer.
+            uint8_t* get(size_t size, size_t& capacity);
+
+            //! Return a buffer to the pool.
+            void release(uint8_t*, size_t capacity);
+
+        private:
+            std::list<std::pair<uint8_t*, size_t> > _buffers;
+            size_t _byteCount = 0;
+            std::mutex _mutex;
+        };
+
+        //! Get the direct I/O buffer pool.
+        DirectIOPool& getDirectIOPool();
+    }
+}
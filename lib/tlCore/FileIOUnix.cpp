@@ -3,6 +3,7 @@
 // All rights reserved.
 
 #include <tlCore/FileIO.h>
+#include <tlCore/FileIOPrivate.h>
 
 #include <tlCore/File.h>
 #include <tlCore/Memory.h>
@@ -19,6 +20,9 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <limits>
+
 #define _STAT     struct stat
 #define _STAT_FNC stat
 
@@ -101,7 +105,7 @@ namespace tl
 				}
 				return out;
 			}
-		
+
 		} // namespace
 
 		struct FileIO::Private
@@ -118,6 +122,9 @@ namespace tl
 			const uint8_t* memoryStart = nullptr;
 			const uint8_t* memoryEnd = nullptr;
 			const uint8_t* memoryP = nullptr;
+			uint8_t*       directIOBuffer = nullptr;
+			size_t         directIOCapacity = 0;
+			std::shared_ptr<const std::string> staged;
 		};
 
 		FileIO::FileIO() :
@@ -219,6 +226,31 @@ namespace tl
 			return _p->memoryP;
 		}
 
+		std::shared_ptr<uint8_t> FileIO::mapCopyOnWrite(size_t offset, size_t size) const
+		{
+			TLRENDER_P();
+			std::shared_ptr<uint8_t> out;
+#if defined(TLRENDER_MMAP)
+			if (p.f != -1 && Mode::Read == p.mode && size > 0 && offset + size <= p.size)
+			{
+				static const size_t pageSize = sysconf(_SC_PAGESIZE);
+				const size_t start = offset / pageSize * pageSize;
+				const size_t length = offset - start + size;
+				void* m = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, p.f, start);
+				if (m != MAP_FAILED)
+				{
+					out = std::shared_ptr<uint8_t>(
+						reinterpret_cast<uint8_t*>(m) + (offset - start),
+						[m, length](uint8_t*)
+						{
+							munmap(m, length);
+						});
+				}
+			}
+#endif // TLRENDER_MMAP
+			return out;
+		}
+
 		bool FileIO::hasEndianConversion() const
 		{
 			return _p->endianConversion;
@@ -336,7 +368,7 @@ namespace tl
 			p.size = std::max(p.pos, p.size);
 		}
 
-		void FileIO::_open(const std::string& fileName, Mode mode)
+		void FileIO::_open(const std::string& fileName, Mode mode, ReadType readType)
 		{
 			TLRENDER_P();
 			
@@ -382,6 +414,13 @@ namespace tl
 			p.pos      = 0;
 			p.size     = info.st_size;
 
+			// Direct I/O.
+			if (Mode::Read == p.mode && ReadType::DirectIO == readType && p.size > 0)
+			{
+				_readDirect();
+				return;
+			}
+
 #if defined(TLRENDER_MMAP)
 			// Memory mapping.
 			if (Mode::Read == p.mode && p.size > 0)
@@ -399,6 +438,70 @@ namespace tl
 #endif // TLRENDER_MMAP
 		}
 
+		void FileIO::_readDirect()
+		{
+			TLRENDER_P();
+
+			// Read the entire file into an aligned buffer, bypassing the
+			// operating system file cache.
+			int f = p.f;
+#if defined(__linux__)
+			const int directF = ::open(p.fileName.c_str(), O_RDONLY | O_DIRECT);
+			if (directF != -1)
+			{
+				f = directF;
+			}
+#elif defined(__APPLE__)
+			fcntl(f, F_NOCACHE, 1);
+#endif // __linux__
+			const size_t size =
+				((p.size + directIOAlignment - 1) / directIOAlignment) * directIOAlignment;
+			p.directIOBuffer = getDirectIOPool().get(size, p.directIOCapacity);
+			size_t pos = 0;
+			while (pos < p.size)
+			{
+				const ssize_t r = ::pread(f, p.directIOBuffer + pos, size - pos, pos);
+				if (-1 == r && f != p.f)
+				{
+					// Fall back to normal reads if the file system does not
+					// support direct I/O.
+					f = p.f;
+					continue;
+				}
+				else if (r <= 0)
+				{
+					break;
+				}
+				pos += r;
+			}
+#if defined(__linux__)
+			if (f == p.f)
+			{
+				posix_fadvise(f, 0, 0, POSIX_FADV_DONTNEED);
+			}
+			if (directF != -1)
+			{
+				::close(directF);
+			}
+#endif // __linux__
+			if (pos < p.size)
+			{
+				throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName, getErrorString()));
+			}
+			p.memoryStart = p.directIOBuffer;
+			p.memoryEnd   = p.memoryStart + p.size;
+			p.memoryP     = p.memoryStart;
+		}
+
+		void FileIO::_setStaged(
+			const std::string& fileName,
+			const std::shared_ptr<const std::string>& staged)
+		{
+			TLRENDER_P();
+			p.fileName = fileName;
+			p.staged = staged;
+		}
+
 		bool FileIO::_close(std::string* error)
 		{
 			TLRENDER_P();
@@ -420,6 +523,12 @@ namespace tl
 				}
 				p.mMap = (void*)-1;
 			}
+			if (p.directIOBuffer)
+			{
+				getDirectIOPool().release(p.directIOBuffer, p.directIOCapacity);
+				p.directIOBuffer = nullptr;
+				p.directIOCapacity = 0;
+			}
 			p.memoryStart = nullptr;
 			p.memoryEnd   = nullptr;
 
@@ -437,6 +546,8 @@ namespace tl
 				p.f = -1;
 			}
 
+			p.staged.reset();
+
 			p.mode = Mode::First;
 			p.pos  = 0;
 			p.size = 0;
@@ -503,5 +614,29 @@ namespace tl
 				throw std::runtime_error(getErrorMessage(ErrorType::Write, fileName, getErrorString()));
 			}				
 		}
+
+		void prefetch(const std::string& fileName)
+		{
+			const int f = ::open(fileName.c_str(), O_RDONLY);
+			if (f != -1)
+			{
+#if defined(__APPLE__)
+				_STAT info;
+				memset(&info, 0, sizeof(_STAT));
+				if (fstat(f, &info) == 0)
+				{
+					struct radvisory ra;
+					ra.ra_offset = 0;
+					ra.ra_count = static_cast<int>(std::min(
+						static_cast<off_t>(std::numeric_limits<int>::max()),
+						info.st_size));
+					fcntl(f, F_RDADVISE, &ra);
+				}
+#else // __APPLE__
+				posix_fadvise(f, 0, 0, POSIX_FADV_WILLNEED);
+#endif // __APPLE__
+				::close(f);
+			}
+		}
 	}
 }
@@ -3,12 +3,14 @@
 // All rights reserved.
 
 #include <tlCore/FileIO.h>
+#include <tlCore/FileIOPrivate.h>
 
 #include <tlCore/Error.h>
 #include <tlCore/Memory.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
 #include <cstring>
 #include <exception>
 
@@ -88,6 +90,30 @@ namespace tl
                 return out;
             }
 
+            // PrefetchVirtualMemory() is only available on Windows 8 and
+            // later, so it is loaded at run time.
+            struct PrefetchRange
+            {
+                PVOID  virtualAddress;
+                SIZE_T numberOfBytes;
+            };
+            typedef BOOL (WINAPI* PrefetchVirtualMemoryFnc)(HANDLE, ULONG_PTR, PrefetchRange*, ULONG);
+
+            PrefetchVirtualMemoryFnc getPrefetchVirtualMemory()
+            {
+                static const PrefetchVirtualMemoryFnc out = []
+                {
+                    PrefetchVirtualMemoryFnc fnc = nullptr;
+                    if (HMODULE module = GetModuleHandleW(L"kernel32.dll"))
+                    {
+                        fnc = reinterpret_cast<PrefetchVirtualMemoryFnc>(
+                            GetProcAddress(module, "PrefetchVirtualMemory"));
+                    }
+                    return fnc;
+                }();
+                return out;
+            }
+
         } // namespace
 
         struct FileIO::Private
@@ -104,6 +130,9 @@ namespace tl
             const uint8_t* memoryStart = nullptr;
             const uint8_t* memoryEnd = nullptr;
             const uint8_t* memoryP = nullptr;
+            uint8_t*       directIOBuffer = nullptr;
+            size_t         directIOCapacity = 0;
+            std::shared_ptr<const std::string> staged;
         };
 
         FileIO::FileIO() :
@@ -208,6 +237,41 @@ namespace tl
             return _p->memoryP;
         }
 
+        std::shared_ptr<uint8_t> FileIO::mapCopyOnWrite(size_t offset, size_t size) const
+        {
+            TLRENDER_P();
+            std::shared_ptr<uint8_t> out;
+#if defined(TLRENDER_MMAP)
+            if (p.mMap && Mode::Read == p.mode && size > 0 && offset + size <= p.size)
+            {
+                // Views must start on the allocation granularity.
+                static const size_t granularity = []
+                {
+                    SYSTEM_INFO info;
+                    GetSystemInfo(&info);
+                    return static_cast<size_t>(info.dwAllocationGranularity);
+                }();
+                const uint64_t start = offset / granularity * granularity;
+                const size_t length = offset - start + size;
+                if (void* m = MapViewOfFile(
+                    p.mMap,
+                    FILE_MAP_COPY,
+                    static_cast<DWORD>(start >> 32),
+                    static_cast<DWORD>(start & 0xffffffff),
+                    length))
+                {
+                    out = std::shared_ptr<uint8_t>(
+                        reinterpret_cast<uint8_t*>(m) + (offset - start),
+                        [m](uint8_t*)
+                        {
+                            ::UnmapViewOfFile(m);
+                        });
+                }
+            }
+#endif // TLRENDER_MMAP
+            return out;
+        }
+
         bool FileIO::hasEndianConversion() const
         {
             return _p->endianConversion;
@@ -321,7 +385,7 @@ namespace tl
             p.size = std::max(p.pos, p.size);
         }
 
-        void FileIO::_open(const std::string& fileName, Mode mode)
+        void FileIO::_open(const std::string& fileName, Mode mode, ReadType readType)
         {
             TLRENDER_P();
 
@@ -390,6 +454,13 @@ namespace tl
             }
             p.size = info.st_size;
 
+            // Direct I/O.
+            if (Mode::Read == p.mode && ReadType::DirectIO == readType && p.size > 0)
+            {
+                _readDirect();
+                return;
+            }
+
 #if defined(TLRENDER_MMAP)
             // Memory mapping.
             if (Mode::Read == p.mode && p.size > 0)
@@ -414,6 +485,84 @@ namespace tl
 #endif // TLRENDER_MMAP
         }
 
+        void FileIO::_readDirect()
+        {
+            TLRENDER_P();
+
+            // Read the entire file into an aligned buffer, bypassing the
+            // operating system file cache. Unbuffered reads must be a
+            // multiple of the sector size, so the buffer is rounded up and
+            // the last read stops at the end of the file.
+            HANDLE f = p.f;
+            HANDLE directF = INVALID_HANDLE_VALUE;
+            try
+            {
+                directF = CreateFileW(
+                    string::toWide(p.fileName).c_str(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    0,
+                    OPEN_EXISTING,
+                    FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN,
+                    0);
+            }
+            catch (const std::exception&)
+            {
+                directF = INVALID_HANDLE_VALUE;
+            }
+            if (directF != INVALID_HANDLE_VALUE)
+            {
+                f = directF;
+            }
+            const size_t size =
+                ((p.size + directIOAlignment - 1) / directIOAlignment) * directIOAlignment;
+            p.directIOBuffer = getDirectIOPool().get(size, p.directIOCapacity);
+            size_t pos = 0;
+            while (pos < p.size)
+            {
+                const DWORD count = static_cast<DWORD>(std::min(
+                    size - pos,
+                    static_cast<size_t>(1024) * memory::megabyte));
+                DWORD n = 0;
+                if (!::ReadFile(f, p.directIOBuffer + pos, count, &n, 0) && f != p.f)
+                {
+                    // Fall back to normal reads if the file system does not
+                    // support unbuffered I/O.
+                    f = p.f;
+                    LARGE_INTEGER v;
+                    v.QuadPart = pos;
+                    ::SetFilePointerEx(f, v, 0, FILE_BEGIN);
+                    continue;
+                }
+                else if (0 == n)
+                {
+                    break;
+                }
+                pos += n;
+            }
+            if (directF != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(directF);
+            }
+            if (pos < p.size)
+            {
+                throw std::runtime_error(
+                    getErrorMessage(ErrorType::Read, p.fileName, error::getLastError()));
+            }
+            p.memoryStart = p.directIOBuffer;
+            p.memoryEnd = p.memoryStart + p.size;
+            p.memoryP = p.memoryStart;
+        }
+
+        void FileIO::_setStaged(
+            const std::string& fileName,
+            const std::shared_ptr<const std::string>& staged)
+        {
+            TLRENDER_P();
+            p.fileName = fileName;
+            p.staged = staged;
+        }
+
         bool FileIO::_close(std::string* error)
         {
             TLRENDER_P();
@@ -450,9 +599,16 @@ namespace tl
                 }
                 p.mMap = nullptr;
             }
+#endif // TLRENDER_MMAP
+            if (p.directIOBuffer)
+            {
+                getDirectIOPool().release(p.directIOBuffer, p.directIOCapacity);
+                p.directIOBuffer = nullptr;
+                p.directIOCapacity = 0;
+            }
+            p.memoryStart = nullptr;
             p.memoryEnd = nullptr;
             p.memoryP = nullptr;
-#endif // TLRENDER_MMAP
 
             if (p.f != INVALID_HANDLE_VALUE)
             {
@@ -460,6 +616,8 @@ namespace tl
                 p.f = INVALID_HANDLE_VALUE;
             }
 
+            p.staged.reset();
+
             p.mode = Mode::First;
             p.pos = 0;
             p.size = 0;
@@ -576,5 +734,49 @@ namespace tl
             }
             CloseHandle(h);
         }
+
+        void prefetch(const std::string& fileName)
+        {
+            // Map the file and ask the memory manager to read it into the
+            // file cache. The pages stay cached after the view is unmapped.
+            const auto prefetchVirtualMemory = getPrefetchVirtualMemory();
+            if (!prefetchVirtualMemory)
+                return;
+            HANDLE f = INVALID_HANDLE_VALUE;
+            try
+            {
+                f = CreateFileW(
+                    string::toWide(fileName).c_str(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    0,
+                    OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN,
+                    0);
+            }
+            catch (const std::exception&)
+            {
+                f = INVALID_HANDLE_VALUE;
+            }
+            if (INVALID_HANDLE_VALUE == f)
+                return;
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(f, &size) && size.QuadPart > 0)
+            {
+                if (HANDLE mMap = CreateFileMapping(f, 0, PAGE_READONLY, 0, 0, 0))
+                {
+                    if (void* view = MapViewOfFile(mMap, FILE_MAP_READ, 0, 0, 0))
+                    {
+                        PrefetchRange range;
+                        range.virtualAddress = view;
+                        range.numberOfBytes = static_cast<SIZE_T>(size.QuadPart);
+                        prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+                        ::UnmapViewOfFile(view);
+                    }
+                    CloseHandle(mMap);
+                }
+            }
+            CloseHandle(f);
+        }
     }
 }
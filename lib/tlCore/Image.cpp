@@ -286,7 +286,10 @@ namespace tl
 
         Image::~Image()
         {
-            delete[] _data;
+            if (!_dataOwner)
+            {
+                delete[] _data;
+            }
         }
 
         std::shared_ptr<Image> Image::create(const Info& info)
@@ -306,6 +309,23 @@ namespace tl
             return create(Info(w, h, pixelType));
         }
 
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            uint8_t* data,
+            const std::shared_ptr<void>& dataOwner)
+        {
+            if (!dataOwner)
+            {
+                throw std::runtime_error("Image data has no owner");
+            }
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_info = info;
+            out->_dataByteCount = image::getDataByteCount(info);
+            out->_data = data;
+            out->_dataOwner = dataOwner;
+            return out;
+        }
+
         void Image::setTags(const Tags& value)
         {
             _tags = value;
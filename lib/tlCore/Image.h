@@ -11,6 +11,7 @@
 
 #include <half.h>
 
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -286,6 +287,16 @@ namespace tl
             //! Create a new image.
             static std::shared_ptr<Image> create(SizeType w, SizeType h, PixelType);
 
+            //! Create a new image that references external data instead
+            //! of allocating its own. The data is kept alive by the given
+            //! owner and must not be modified after the image has been
+            //! handed to other code, unless the owner allows it. An
+            //! exception is thrown if the owner is null.
+            static std::shared_ptr<Image> create(
+                const Info&,
+                uint8_t* data,
+                const std::shared_ptr<void>& dataOwner);
+
             //! Get the image information.
             const Info& getInfo() const;
 
@@ -330,8 +341,14 @@ namespace tl
             Tags _tags;
             size_t _dataByteCount = 0;
             uint8_t* _data = nullptr;
+            std::shared_ptr<void> _dataOwner;
         };
 
+        //! Function that allocates images, for example in memory that can
+        //! be uploaded to the GPU without another copy. A null pointer is
+        //! returned when the image cannot be allocated.
+        typedef std::function<std::shared_ptr<Image>(const Info&)> Allocator;
+
         //! \name Serialize
         ///@{
 
@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/ImageConvert.h>
+
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace tl
+{
+    namespace image
+    {
+        namespace
+        {
+            bool isYUV(PixelType value)
+            {
+                switch (value)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_444P_U8:
+                case PixelType::YUV_420P_U16:
+                case PixelType::YUV_422P_U16:
+                case PixelType::YUV_444P_U16:
+                    return true;
+                default: break;
+                }
+                return false;
+            }
+
+            size_t getWordSize(PixelType value)
+            {
+                return PixelType::RGB_U10 == value ? 4 : getBitDepth(value) / 8;
+            }
+
+            size_t getRowByteCount(const Info& info)
+            {
+                const size_t pixelByteCount = PixelType::RGB_U10 == info.pixelType ?
+                    4 :
+                    getChannelCount(info.pixelType) * getWordSize(info.pixelType);
+                return getAlignedByteCount(info.size.w * pixelByteCount, info.layout.alignment);
+            }
+
+            template<typename T>
+            void readChannels(const uint8_t* data, size_t w, uint8_t channels, float scale, float* out)
+            {
+                const T* p = reinterpret_cast<const T*>(data);
+                for (size_t x = 0; x < w; ++x, p += channels, out += 4)
+                {
+                    switch (channels)
+                    {
+                    case 1:
+                        out[0] = out[1] = out[2] = static_cast<float>(p[0]) * scale;
+                        out[3] = 1.F;
+                        break;
+                    case 2:
+                        out[0] = out[1] = out[2] = static_cast<float>(p[0]) * scale;
+                        out[3] = static_cast<float>(p[1]) * scale;
+                        break;
+                    case 3:
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = 1.F;
+                        break;
+                    case 4:
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = static_cast<float>(p[3]) * scale;
+                        break;
+                    default: break;
+                    }
+                }
+            }
+
+            template<typename T>
+            T fromFloat(float value, float max)
+            {
+                return static_cast<T>(std::min(std::max(value, 0.F), 1.F) * max + .5F);
+            }
+
+            template<>
+            F16_T fromFloat(float value, float)
+            {
+                return F16_T(value);
+            }
+
+            template<>
+            F32_T fromFloat(float value, float)
+            {
+                return value;
+            }
+
+            template<typename T>
+            void writeChannels(const float* in, size_t w, uint8_t channels, float max, uint8_t* data)
+            {
+                T* p = reinterpret_cast<T*>(data);
+                for (size_t x = 0; x < w; ++x, p += channels, in += 4)
+                {
+                    switch (channels)
+                    {
+                    case 1:
+                        p[0] = fromFloat<T>(in[0], max);
+                        break;
+                    case 2:
+                        p[0] = fromFloat<T>(in[0], max);
+                        p[1] = fromFloat<T>(in[3], max);
+                        break;
+                    case 3:
+                        p[0] = fromFloat<T>(in[0], max);
+                        p[1] = fromFloat<T>(in[1], max);
+                        p[2] = fromFloat<T>(in[2], max);
+                        break;
+                    case 4:
+                        p[0] = fromFloat<T>(in[0], max);
+                        p[1] = fromFloat<T>(in[1], max);
+                        p[2] = fromFloat<T>(in[2], max);
+                        p[3] = fromFloat<T>(in[3], max);
+                        break;
+                    default: break;
+                    }
+                }
+            }
+
+            template<typename T>
+            void readYUV(const Image& image, size_t y, float* out)
+            {
+                const Info& info = image.getInfo();
+                const size_t w = info.size.w;
+                const size_t h = info.size.h;
+                size_t cw = w;
+                size_t ch = h;
+                size_t sx = 0;
+                size_t sy = 0;
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_420P_U16:
+                    cw = w / 2;
+                    ch = h / 2;
+                    sx = sy = 1;
+                    break;
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_422P_U16:
+                    cw = w / 2;
+                    sx = 1;
+                    break;
+                default: break;
+                }
+                const T* yPlane = reinterpret_cast<const T*>(image.getData());
+                const T* uPlane = yPlane + w * h;
+                const T* vPlane = uPlane + cw * ch;
+                const size_t cy = std::min(y >> sy, ch > 0 ? ch - 1 : 0);
+                const float scale = 1.F / std::numeric_limits<T>::max();
+                const math::Vector4f k = getYUVCoefficients(info.yuvCoefficients);
+                for (size_t x = 0; x < w; ++x, out += 4)
+                {
+                    const size_t cx = std::min(x >> sx, cw > 0 ? cw - 1 : 0);
+                    float yv = yPlane[y * w + x] * scale;
+                    float cb = uPlane[cy * cw + cx] * scale;
+                    float cr = vPlane[cy * cw + cx] * scale;
+                    if (VideoLevels::LegalRange == info.videoLevels)
+                    {
+                        yv = (yv - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        cb = (cb - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                        cr = (cr - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                    }
+                    cb -= .5F;
+                    cr -= .5F;
+                    out[0] = yv + k.x * cr;
+                    out[1] = yv - k.z * cb - k.w * cr;
+                    out[2] = yv + k.y * cb;
+                    out[3] = 1.F;
+                }
+            }
+
+            void readRow(const Image& image, size_t y, float* out, std::vector<uint8_t>& buffer)
+            {
+                const Info& info = image.getInfo();
+                const size_t w = info.size.w;
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_444P_U8:
+                    readYUV<U8_T>(image, y, out);
+                    return;
+                case PixelType::YUV_420P_U16:
+                case PixelType::YUV_422P_U16:
+                case PixelType::YUV_444P_U16:
+                    readYUV<U16_T>(image, y, out);
+                    return;
+                default: break;
+                }
+
+                const size_t rowByteCount = getRowByteCount(info);
+                const uint8_t* data = image.getData() + y * rowByteCount;
+                const size_t wordSize = getWordSize(info.pixelType);
+                if (info.layout.endian != memory::getEndian() && wordSize > 1)
+                {
+                    buffer.resize(rowByteCount);
+                    memory::endian(data, buffer.data(), rowByteCount / wordSize, wordSize);
+                    data = buffer.data();
+                }
+                const uint8_t channels = getChannelCount(info.pixelType);
+                switch (info.pixelType)
+                {
+                case PixelType::L_U8:
+                case PixelType::LA_U8:
+                case PixelType::RGB_U8:
+                case PixelType::RGBA_U8:
+                    readChannels<U8_T>(data, w, channels, 1.F / U8Range.getMax(), out);
+                    break;
+                case PixelType::L_U16:
+                case PixelType::LA_U16:
+                case PixelType::RGB_U16:
+                case PixelType::RGBA_U16:
+                    readChannels<U16_T>(data, w, channels, 1.F / U16Range.getMax(), out);
+                    break;
+                case PixelType::L_U32:
+                case PixelType::LA_U32:
+                case PixelType::RGB_U32:
+                case PixelType::RGBA_U32:
+                    readChannels<U32_T>(data, w, channels, 1.F / U32Range.getMax(), out);
+                    break;
+                case PixelType::L_F16:
+                case PixelType::LA_F16:
+                case PixelType::RGB_F16:
+                case PixelType::RGBA_F16:
+                    readChannels<F16_T>(data, w, channels, 1.F, out);
+                    break;
+                case PixelType::L_F32:
+                case PixelType::LA_F32:
+                case PixelType::RGB_F32:
+                case PixelType::RGBA_F32:
+                    readChannels<F32_T>(data, w, channels, 1.F, out);
+                    break;
+                case PixelType::RGB_U10:
+                {
+                    const U10* p = reinterpret_cast<const U10*>(data);
+                    const float scale = 1.F / U10Range.getMax();
+                    for (size_t x = 0; x < w; ++x, ++p, out += 4)
+                    {
+                        out[0] = p->r * scale;
+                        out[1] = p->g * scale;
+                        out[2] = p->b * scale;
+                        out[3] = 1.F;
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+
+            void writeRow(const float* in, Image& image, size_t y)
+            {
+                const Info& info = image.getInfo();
+                const size_t w = info.size.w;
+                const size_t rowByteCount = getRowByteCount(info);
+                uint8_t* data = image.getData() + y * rowByteCount;
+                const uint8_t channels = getChannelCount(info.pixelType);
+                switch (info.pixelType)
+                {
+                case PixelType::L_U8:
+                case PixelType::LA_U8:
+                case PixelType::RGB_U8:
+                case PixelType::RGBA_U8:
+                    writeChannels<U8_T>(in, w, channels, U8Range.getMax(), data);
+                    break;
+                case PixelType::L_U16:
+                case PixelType::LA_U16:
+                case PixelType::RGB_U16:
+                case PixelType::RGBA_U16:
+                    writeChannels<U16_T>(in, w, channels, U16Range.getMax(), data);
+                    break;
+                case PixelType::L_U32:
+                case PixelType::LA_U32:
+                case PixelType::RGB_U32:
+                case PixelType::RGBA_U32:
+                    writeChannels<U32_T>(in, w, channels, U32Range.getMax(), data);
+                    break;
+                case PixelType::L_F16:
+                case PixelType::LA_F16:
+                case PixelType::RGB_F16:
+                case PixelType::RGBA_F16:
+                    writeChannels<F16_T>(in, w, channels, 1.F, data);
+                    break;
+                case PixelType::L_F32:
+                case PixelType::LA_F32:
+                case PixelType::RGB_F32:
+                case PixelType::RGBA_F32:
+                    writeChannels<F32_T>(in, w, channels, 1.F, data);
+                    break;
+                case PixelType::RGB_U10:
+                {
+                    U10* p = reinterpret_cast<U10*>(data);
+                    const float max = U10Range.getMax();
+                    for (size_t x = 0; x < w; ++x, ++p, in += 4)
+                    {
+                        p->r = fromFloat<uint16_t>(in[0], max);
+                        p->g = fromFloat<uint16_t>(in[1], max);
+                        p->b = fromFloat<uint16_t>(in[2], max);
+                        p->pad = 0;
+                    }
+                    break;
+                }
+                default: break;
+                }
+                const size_t wordSize = getWordSize(info.pixelType);
+                if (info.layout.endian != memory::getEndian() && wordSize > 1)
+                {
+                    memory::endian(data, rowByteCount / wordSize, wordSize);
+                }
+            }
+        }
+
+        bool canConvert(PixelType in, PixelType out) noexcept
+        {
+            return
+                in != PixelType::None &&
+                out != PixelType::None &&
+                !isYUV(out);
+        }
+
+        void convert(const std::shared_ptr<Image>& in, const std::shared_ptr<Image>& out)
+        {
+            const size_t h = out->getHeight();
+            convert(in, out, math::SizeTRange(0, h > 0 ? h - 1 : 0));
+        }
+
+        void convert(
+            const std::shared_ptr<Image>& in,
+            const std::shared_ptr<Image>& out,
+            const math::SizeTRange& rows)
+        {
+            const Info& inInfo = in->getInfo();
+            const Info& outInfo = out->getInfo();
+            if (inInfo.size != outInfo.size)
+            {
+                throw std::runtime_error(string::Format("Cannot convert image size {0} to {1}").
+                    arg(inInfo.size).
+                    arg(outInfo.size));
+            }
+            if (!canConvert(inInfo.pixelType, outInfo.pixelType))
+            {
+                throw std::runtime_error(string::Format("Cannot convert pixel type {0} to {1}").
+                    arg(inInfo.pixelType).
+                    arg(outInfo.pixelType));
+            }
+            const size_t w = inInfo.size.w;
+            const size_t h = inInfo.size.h;
+            if (0 == h || rows.getMin() >= h)
+                return;
+            const size_t y0 = rows.getMin();
+            const size_t y1 = std::min(rows.getMax(), h - 1);
+            if (inInfo.pixelType == outInfo.pixelType &&
+                inInfo.layout == outInfo.layout &&
+                !isYUV(inInfo.pixelType))
+            {
+                const size_t rowByteCount = getRowByteCount(outInfo);
+                memcpy(
+                    out->getData() + y0 * rowByteCount,
+                    in->getData() + y0 * rowByteCount,
+                    (y1 - y0 + 1) * rowByteCount);
+                return;
+            }
+
+            const bool mirrorX = inInfo.layout.mirror.x != outInfo.layout.mirror.x;
+            const bool mirrorY = inInfo.layout.mirror.y != outInfo.layout.mirror.y;
+            std::vector<float> row(w * 4);
+            std::vector<uint8_t> buffer;
+            for (size_t y = y0; y <= y1; ++y)
+            {
+                readRow(*in, mirrorY ? (h - 1 - y) : y, row.data(), buffer);
+                if (mirrorX)
+                {
+                    for (size_t x = 0; x < w / 2; ++x)
+                    {
+                        std::swap_ranges(
+                            row.begin() + x * 4,
+                            row.begin() + x * 4 + 4,
+                            row.begin() + (w - 1 - x) * 4);
+                    }
+                }
+                writeRow(row.data(), *out, y);
+            }
+        }
+    }
+}
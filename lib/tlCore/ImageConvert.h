@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Image.h>
+#include <tlCore/Range.h>
+
+namespace tl
+{
+    namespace image
+    {
+        //! \name Conversion
+        ///@{
+
+        //! Can image data be converted between the given pixel types? YUV
+        //! data can be converted from but not to.
+        bool canConvert(PixelType in, PixelType out) noexcept;
+
+        //! Convert image data on the CPU. The images must have the same
+        //! size. Differences in the pixel type, data layout, and video
+        //! levels are converted.
+        //!
+        //! Throws:
+        //! - std::exception
+        void convert(const std::shared_ptr<Image>& in, const std::shared_ptr<Image>& out);
+
+        //! Convert a range of rows of image data. The rows are indices into
+        //! the output image, so a conversion can be split across threads.
+        //!
+        //! Throws:
+        //! - std::exception
+        void convert(
+            const std::shared_ptr<Image>& in,
+            const std::shared_ptr<Image>& out,
+            const math::SizeTRange& rows);
+
+        ///@}
+    }
+}
@@ -48,6 +48,7 @@ namespace tl
             void _maxUpdate();
 
             size_t _max = 10000;
+            size_t _size = 0;
             std::map<T, std::pair<U, size_t> > _map;
             mutable std::map<T, int64_t> _counts;
             mutable int64_t _counter = 0;
@@ -17,12 +17,7 @@ namespace tl
         template<typename T, typename U>
         inline std::size_t LRUCache<T, U>::getSize() const
         {
-            size_t out = 0;
-            for (const auto& i : _map)
-            {
-                out += i.second.second;
-            }
-            return out;
+            return _size;
         }
 
         template<typename T, typename U>
@@ -73,7 +68,17 @@ namespace tl
         template<typename T, typename U>
         inline void LRUCache<T, U>::add(const T& key, const U& value, size_t size)
         {
-            _map[key] = std::make_pair(value, size);
+            auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _size -= i->second.second;
+                i->second = std::make_pair(value, size);
+            }
+            else
+            {
+                _map[key] = std::make_pair(value, size);
+            }
+            _size += size;
             ++_counter;
             _counts[key] = _counter;
             _maxUpdate();
@@ -85,6 +90,7 @@ namespace tl
             const auto i = _map.find(key);
             if (i != _map.end())
             {
+                _size -= i->second.second;
                 _map.erase(i);
             }
             const auto j = _counts.find(key);
@@ -99,6 +105,8 @@ namespace tl
         inline void LRUCache<T, U>::clear()
         {
             _map.clear();
+            _counts.clear();
+            _size = 0;
         }
 
         template<typename T, typename U>
@@ -126,19 +134,20 @@ namespace tl
         template<typename T, typename U>
         inline void LRUCache<T, U>::_maxUpdate()
         {
-            if (getSize() > _max)
+            if (_size > _max)
             {
                 std::map<int64_t, T> sorted;
                 for (const auto& i : _counts)
                 {
                     sorted[i.second] = i.first;
                 }
-                while (getSize() > _max)
+                while (_size > _max && !sorted.empty())
                 {
                     auto begin = sorted.begin();
                     auto i = _map.find(begin->second);
                     if (i != _map.end())
                     {
+                        _size -= i->second.second;
                         _map.erase(i);
                     }
                     auto j = _counts.find(begin->second);
@@ -74,5 +74,17 @@ namespace tl
         bool delEnv(const std::string& name);
 
         ///@}
+
+        //! \name Processes
+        ///@{
+
+        //! Run a program and wait for it to finish. Returns the exit code of
+        //! the program, or -1 if it did not exit normally.
+        //!
+        //! Throws:
+        //! - std::exception
+        int runProcess(const std::string& program, const std::vector<std::string>& args);
+
+        ///@}
     }
 }
@@ -5,6 +5,7 @@
 #include <tlCore/OS.h>
 
 #include <tlCore/Memory.h>
+#include <tlCore/StringFormat.h>
 
 #if defined(__APPLE__)
 #include <ApplicationServices/ApplicationServices.h>
@@ -24,9 +25,13 @@
 #include <sys/sysinfo.h>
 #endif // __APPLE__
 #include <sys/utsname.h>
+#include <sys/wait.h>
 #include <pwd.h>
+#include <spawn.h>
 #include <unistd.h>
 
+extern char** environ;
+
 namespace tl
 {
 	namespace os
@@ -97,5 +102,30 @@ namespace tl
 		{
 			return ::unsetenv(name.c_str()) == 0;
 		}
+
+		int runProcess(const std::string& program, const std::vector<std::string>& args)
+		{
+			std::vector<char*> argv;
+			argv.push_back(const_cast<char*>(program.c_str()));
+			for (const auto& arg : args)
+			{
+				argv.push_back(const_cast<char*>(arg.c_str()));
+			}
+			argv.push_back(nullptr);
+			pid_t pid = 0;
+			if (posix_spawnp(&pid, program.c_str(), nullptr, nullptr, argv.data(), environ) != 0)
+			{
+				throw std::runtime_error(string::Format("{0}: Cannot run process").arg(program));
+			}
+			int status = 0;
+			while (waitpid(pid, &status, 0) < 0)
+			{
+				if (errno != EINTR)
+				{
+					throw std::runtime_error(string::Format("{0}: Cannot wait for process").arg(program));
+				}
+			}
+			return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		}
 	}
 }
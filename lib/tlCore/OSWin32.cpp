@@ -6,6 +6,7 @@
 
 #include <tlCore/Memory.h>
 #include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -95,6 +96,35 @@ namespace tl
                 GlobalMemoryStatusEx(&statex);
                 return statex.ullTotalPhys;
             }
+
+            std::wstring quoteArg(const std::wstring& value)
+            {
+                if (!value.empty() && value.find_first_of(L" \t\"") == std::wstring::npos)
+                {
+                    return value;
+                }
+                std::wstring out = L"\"";
+                size_t backslashes = 0;
+                for (const auto c : value)
+                {
+                    if (L'\\' == c)
+                    {
+                        ++backslashes;
+                    }
+                    else
+                    {
+                        if (L'"' == c)
+                        {
+                            out.append(backslashes + 1, L'\\');
+                        }
+                        backslashes = 0;
+                    }
+                    out.push_back(c);
+                }
+                out.append(backslashes, L'\\');
+                out.push_back(L'"');
+                return out;
+            }
         }
 
         SystemInfo getSystemInfo()
@@ -140,5 +170,40 @@ namespace tl
             std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
             return _wputenv_s(utf16.from_bytes(name).c_str(), utf16.from_bytes(std::string()).c_str()) == 0;
         }
+
+        int runProcess(const std::string& program, const std::vector<std::string>& args)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+            std::wstring cmdLine = quoteArg(utf16.from_bytes(program));
+            for (const auto& arg : args)
+            {
+                cmdLine += L" " + quoteArg(utf16.from_bytes(arg));
+            }
+            STARTUPINFOW startupInfo;
+            ZeroMemory(&startupInfo, sizeof(startupInfo));
+            startupInfo.cb = sizeof(startupInfo);
+            PROCESS_INFORMATION processInfo;
+            ZeroMemory(&processInfo, sizeof(processInfo));
+            if (!CreateProcessW(
+                NULL,
+                &cmdLine[0],
+                NULL,
+                NULL,
+                FALSE,
+                0,
+                NULL,
+                NULL,
+                &startupInfo,
+                &processInfo))
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot run process").arg(program));
+            }
+            WaitForSingleObject(processInfo.hProcess, INFINITE);
+            DWORD exitCode = 0;
+            const bool exited = GetExitCodeProcess(processInfo.hProcess, &exitCode);
+            CloseHandle(processInfo.hThread);
+            CloseHandle(processInfo.hProcess);
+            return exited ? static_cast<int>(exitCode) : -1;
+        }
     }
 }
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/StagingCache.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/Memory.h>
+#include <tlCore/Path.h>
+#include <tlCore/StringFormat.h>
+
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace tl
+{
+    namespace file
+    {
+        namespace
+        {
+            const size_t copyBufferSize = 4 * memory::megabyte;
+            const std::chrono::milliseconds stagingTimeout(5);
+
+            struct StagingItem
+            {
+                ~StagingItem()
+                {
+                    rm(fileName);
+                }
+
+                std::string fileName;
+                uint64_t size = 0;
+                time_t time = 0;
+            };
+
+            // Get whether a file name matches the staged copies, i.e., a
+            // hexadecimal prefix, an underscore, a counter, and an optional
+            // extension.
+            bool isStagedFileName(const std::string& fileName)
+            {
+                size_t i = 0;
+                const size_t size = fileName.size();
+                while (i < size && std::isxdigit(static_cast<unsigned char>(fileName[i])))
+                {
+                    ++i;
+                }
+                if (0 == i || i >= size || fileName[i] != '_')
+                    return false;
+                const size_t counter = ++i;
+                while (i < size && std::isdigit(static_cast<unsigned char>(fileName[i])))
+                {
+                    ++i;
+                }
+                return i > counter && (i == size || '.' == fileName[i]);
+            }
+
+            std::shared_ptr<StagingCache> stagingCache;
+            std::mutex stagingCacheMutex;
+        }
+
+        struct StagingCache::Private
+        {
+            std::string directory;
+            bool tempDirectory = false;
+            size_t byteCount = 0;
+            std::string fileNamePrefix;
+            uint64_t fileNameCounter = 0;
+
+            struct Mutex
+            {
+                memory::LRUCache<std::string, std::shared_ptr<StagingItem> > cache;
+                std::list<std::string> queue;
+                std::set<std::string> pending;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+            Thread thread;
+        };
+
+        void StagingCache::_init(
+            const std::string& directory,
+            size_t byteCount,
+            const std::chrono::seconds& orphanAge)
+        {
+            TLRENDER_P();
+
+            p.directory = directory;
+            if (p.directory.empty())
+            {
+                p.directory = createTempDir();
+                p.tempDirectory = true;
+            }
+            else if (!exists(p.directory))
+            {
+                mkdir(p.directory);
+            }
+            else
+            {
+                // Remove the copies left by processes that have exited.
+                // Copies in use by running processes are expected to be
+                // newer than the given age.
+                ListOptions options;
+                options.sequence = false;
+                const time_t now = std::time(nullptr);
+                for (const auto& fileInfo : list(p.directory, options))
+                {
+                    if (fileInfo.getType() == Type::File &&
+                        isStagedFileName(fileInfo.getPath().get(-1, false)) &&
+                        now - fileInfo.getTime() >= orphanAge.count())
+                    {
+                        rm(fileInfo.getPath().get());
+                    }
+                }
+            }
+            p.byteCount = byteCount;
+            p.mutex.cache.setMax(byteCount);
+
+            // The copies are named with a random prefix and a counter, so
+            // they do not collide with copies from other processes.
+            std::random_device rd;
+            std::stringstream ss;
+            ss << std::hex << ((static_cast<uint64_t>(rd()) << 32) | rd());
+            p.fileNamePrefix = ss.str();
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this]
+                {
+                    _thread();
+                });
+        }
+
+        StagingCache::StagingCache() :
+            _p(new Private)
+        {}
+
+        StagingCache::~StagingCache()
+        {
+            TLRENDER_P();
+            p.thread.running = false;
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+            p.mutex.cache.clear();
+            if (p.tempDirectory)
+            {
+                rmdir(p.directory);
+            }
+        }
+
+        std::shared_ptr<StagingCache> StagingCache::create(
+            const std::string& directory,
+            size_t byteCount,
+            const std::chrono::seconds& orphanAge)
+        {
+            auto out = std::shared_ptr<StagingCache>(new StagingCache);
+            out->_init(directory, byteCount, orphanAge);
+            return out;
+        }
+
+        const std::string& StagingCache::getDirectory() const
+        {
+            return _p->directory;
+        }
+
+        size_t StagingCache::getMax() const
+        {
+            return _p->byteCount;
+        }
+
+        size_t StagingCache::getSize() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.cache.getSize();
+        }
+
+        std::shared_ptr<const std::string> StagingCache::get(const std::string& fileName)
+        {
+            TLRENDER_P();
+            std::shared_ptr<const std::string> out;
+            std::shared_ptr<StagingItem> item;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.cache.get(fileName, item);
+            }
+            if (item)
+            {
+                const FileInfo fileInfo = FileInfo(Path(fileName));
+                if (fileInfo.getSize() == item->size &&
+                    fileInfo.getTime() == item->time)
+                {
+                    // The returned pointer shares ownership of the item,
+                    // so the copy is not removed while it is in use.
+                    out = std::shared_ptr<const std::string>(item, &item->fileName);
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.cache.remove(fileName);
+                }
+            }
+            return out;
+        }
+
+        void StagingCache::stage(const std::string& fileName)
+        {
+            TLRENDER_P();
+            if (0 == fileName.compare(0, p.directory.size(), p.directory))
+                return;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.mutex.cache.contains(fileName) ||
+                    !p.mutex.pending.insert(fileName).second)
+                    return;
+                p.mutex.queue.push_back(fileName);
+            }
+            p.thread.cv.notify_one();
+        }
+
+        void StagingCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cache.clear();
+        }
+
+        void StagingCache::_thread()
+        {
+            TLRENDER_P();
+            while (p.thread.running)
+            {
+                std::string fileName;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.thread.cv.wait_for(
+                        lock,
+                        stagingTimeout,
+                        [this]
+                        {
+                            return !_p->mutex.queue.empty();
+                        }))
+                    {
+                        fileName = p.mutex.queue.front();
+                        p.mutex.queue.pop_front();
+                    }
+                }
+                if (!fileName.empty())
+                {
+                    try
+                    {
+                        _copy(fileName);
+                    }
+                    catch (const std::exception&)
+                    {}
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.pending.erase(fileName);
+                }
+            }
+        }
+
+        void StagingCache::_copy(const std::string& fileName)
+        {
+            TLRENDER_P();
+
+            const FileInfo fileInfo = FileInfo(Path(fileName));
+            if (0 == fileInfo.getSize() || fileInfo.getSize() > p.byteCount)
+                return;
+
+            const uint64_t counter = ++p.fileNameCounter;
+            auto item = std::make_shared<StagingItem>();
+            item->fileName = string::Format("{0}/{1}_{2}{3}").
+                arg(p.directory).
+                arg(p.fileNamePrefix).
+                arg(counter).
+                arg(Path(fileName).getExtension());
+            item->size = fileInfo.getSize();
+            item->time = fileInfo.getTime();
+
+            // Copy to a temporary file first so that a partial copy is
+            // never opened.
+            const std::string tmpFileName = item->fileName + ".tmp";
+            {
+                auto in = FileIO::create(fileName, Mode::Read);
+                auto out = FileIO::create(tmpFileName, Mode::Write);
+                std::vector<uint8_t> buf(copyBufferSize);
+                size_t size = in->getSize();
+                while (size > 0 && p.thread.running)
+                {
+                    const size_t count = std::min(size, copyBufferSize);
+                    in->read(buf.data(), count);
+                    out->write(buf.data(), count);
+                    size -= count;
+                }
+                if (size > 0)
+                {
+                    out.reset();
+                    rm(tmpFileName);
+                    return;
+                }
+            }
+            if (std::rename(tmpFileName.c_str(), item->fileName.c_str()) != 0)
+            {
+                rm(tmpFileName);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cache.add(fileName, item, item->size);
+        }
+
+        void setStagingCache(const std::shared_ptr<StagingCache>& value)
+        {
+            std::unique_lock<std::mutex> lock(stagingCacheMutex);
+            stagingCache = value;
+        }
+
+        std::shared_ptr<StagingCache> getStagingCache()
+        {
+            std::unique_lock<std::mutex> lock(stagingCacheMutex);
+            return stagingCache;
+        }
+
+        std::shared_ptr<const std::string> getStagedFile(const std::string& fileName)
+        {
+            std::shared_ptr<const std::string> out;
+            if (auto stagingCache = getStagingCache())
+            {
+                out = stagingCache->get(fileName);
+                if (!out)
+                {
+                    stagingCache->stage(fileName);
+                }
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace tl
+{
+    namespace file
+    {
+        //! Staging cache.
+        //!
+        //! The staging cache copies files from slow storage (e.g., network
+        //! file systems) to a local directory in the background. Files that
+        //! have been staged are opened from the local copy by
+        //! FileIO::createStaged().
+        //!
+        //! Staged copies are validated against the size and modification
+        //! time of the original file, and the least recently used copies
+        //! are removed when the cache is full. Each copy has a unique file
+        //! name, so caches in different processes can share a directory.
+        //! Copies left in a directory by processes that have exited are
+        //! removed when a cache is created, once they are older than the
+        //! given age.
+        class StagingCache : public std::enable_shared_from_this<StagingCache>
+        {
+            TLRENDER_NON_COPYABLE(StagingCache);
+
+        protected:
+            void _init(
+                const std::string& directory,
+                size_t byteCount,
+                const std::chrono::seconds& orphanAge);
+
+            StagingCache();
+
+        public:
+            ~StagingCache();
+
+            //! Create a new staging cache. If the directory is empty a
+            //! temporary directory is used.
+            static std::shared_ptr<StagingCache> create(
+                const std::string& directory,
+                size_t byteCount,
+                const std::chrono::seconds& orphanAge = std::chrono::hours(24));
+
+            //! Get the cache directory.
+            const std::string& getDirectory() const;
+
+            //! Get the maximum cache size in bytes.
+            size_t getMax() const;
+
+            //! Get the current cache size in bytes.
+            size_t getSize() const;
+
+            //! Get the file name of the staged copy of a file. A null
+            //! pointer is returned if the file has not been staged or the
+            //! staged copy is out of date. The staged copy is not removed
+            //! while the returned pointer exists.
+            std::shared_ptr<const std::string> get(const std::string& fileName);
+
+            //! Stage a file in the background.
+            void stage(const std::string& fileName);
+
+            //! Remove all of the staged copies.
+            void clear();
+
+        private:
+            void _thread();
+            void _copy(const std::string& fileName);
+
+            TLRENDER_PRIVATE();
+        };
+
+        //! Set the staging cache used by FileIO. Set to null to disable
+        //! staging.
+        void setStagingCache(const std::shared_ptr<StagingCache>&);
+
+        //! Get the staging cache used by FileIO.
+        std::shared_ptr<StagingCache> getStagingCache();
+
+        //! Get the file name of the staged copy of a file from the staging
+        //! cache used by FileIO. If there is no staged copy a null pointer
+        //! is returned and the file is queued for staging. The staged copy
+        //! is not removed while the returned pointer exists.
+        std::shared_ptr<const std::string> getStagedFile(const std::string& fileName);
+    }
+}
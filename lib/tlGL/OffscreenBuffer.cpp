@@ -21,6 +21,9 @@ namespace tl
     {
         namespace
         {
+            //! Framebuffer binding of the current thread.
+            thread_local unsigned int framebufferBinding = 0;
+
             enum class Error
             {
                 ColorTexture,
@@ -310,6 +313,17 @@ namespace tl
         void OffscreenBuffer::bind()
         {
             glBindFramebuffer(GL_FRAMEBUFFER, _p->id);
+            framebufferBinding = _p->id;
+        }
+
+        unsigned int getFramebufferBinding()
+        {
+            return framebufferBinding;
+        }
+
+        void setFramebufferBinding(unsigned int value)
+        {
+            framebufferBinding = value;
         }
 
         bool doCreate(
@@ -342,6 +356,7 @@ namespace tl
         OffscreenBufferBinding::~OffscreenBufferBinding()
         {
             glBindFramebuffer(GL_FRAMEBUFFER, _p->previous);
+            framebufferBinding = _p->previous;
         }
     }
 }
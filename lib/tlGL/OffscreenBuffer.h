@@ -110,6 +110,16 @@ namespace tl
             const image::Size&,
             const OffscreenBufferOptions&);
 
+        //! Get the framebuffer binding of the current thread. The binding is
+        //! tracked by OffscreenBuffer::bind() and OffscreenBufferBinding,
+        //! other code that binds a framebuffer should call
+        //! setFramebufferBinding().
+        unsigned int getFramebufferBinding();
+
+        //! Set the framebuffer binding of the current thread. This only
+        //! updates the tracked value, it does not bind the framebuffer.
+        void setFramebufferBinding(unsigned int);
+
         //! Offscreen buffer binding.
         class OffscreenBufferBinding
         {
@@ -0,0 +1,444 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/OffscreenContext.h>
+
+#include <tlGL/OffscreenContextPrivate.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/Error.h>
+#include <tlCore/LogSystem.h>
+#include <tlCore/OS.h>
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#if defined(TLRENDER_GL_DEBUG)
+#include <tlGladDebug/gl.h>
+#else // TLRENDER_GL_DEBUG
+#include <tlGlad/gl.h>
+#endif // TLRENDER_GL_DEBUG
+
+#if defined(TLRENDER_GLFW)
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#endif // TLRENDER_GLFW
+
+#if defined(TLRENDER_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <dlfcn.h>
+#endif // TLRENDER_EGL
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+namespace tl
+{
+    namespace gl
+    {
+        TLRENDER_ENUM_IMPL(
+            ContextBackend,
+            "Auto",
+            "GLFW",
+            "EGL",
+            "OSMesa");
+        TLRENDER_ENUM_SERIALIZE_IMPL(ContextBackend);
+
+        std::vector<ContextBackend> getAvailableContextBackends()
+        {
+            std::vector<ContextBackend> out;
+#if defined(TLRENDER_GLFW)
+            out.push_back(ContextBackend::GLFW);
+#endif // TLRENDER_GLFW
+#if defined(TLRENDER_EGL)
+            out.push_back(ContextBackend::EGL);
+#endif // TLRENDER_EGL
+#if defined(TLRENDER_OSMESA)
+            out.push_back(ContextBackend::OSMesa);
+#endif // TLRENDER_OSMESA
+            return out;
+        }
+
+        ContextBackend getDefaultContextBackend()
+        {
+            ContextBackend out = ContextBackend::Auto;
+            std::string env;
+            if (os::getEnv("TLRENDER_GL_CONTEXT", env) && !env.empty())
+            {
+                try
+                {
+                    std::stringstream ss(env);
+                    ss >> out;
+                }
+                catch (const std::exception&)
+                {}
+            }
+            return out;
+        }
+
+        namespace
+        {
+            const int glVersionMajor = 4;
+            const int glVersionMinor = 1;
+
+#if defined(TLRENDER_EGL)
+            // eglGetProcAddress() is only required to return extension
+            // functions, so the core functions are loaded from the OpenGL
+            // library.
+            GLADapiproc eglGetGLProcAddress(void* library, const char* name)
+            {
+                GLADapiproc out = nullptr;
+                if (library)
+                {
+                    out = reinterpret_cast<GLADapiproc>(dlsym(library, name));
+                }
+                if (!out)
+                {
+                    out = reinterpret_cast<GLADapiproc>(eglGetProcAddress(name));
+                }
+                return out;
+            }
+#endif // TLRENDER_EGL
+        }
+
+        struct OffscreenContext::Private
+        {
+            ContextBackend backend = ContextBackend::Auto;
+            std::string version;
+
+#if defined(TLRENDER_GLFW)
+            GLFWwindow* glfwWindow = nullptr;
+#endif // TLRENDER_GLFW
+#if defined(TLRENDER_EGL)
+            EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+            EGLContext eglContext = EGL_NO_CONTEXT;
+            EGLSurface eglSurface = EGL_NO_SURFACE;
+            void* eglGLLibrary = nullptr;
+#endif // TLRENDER_EGL
+#if defined(TLRENDER_OSMESA)
+            void* osmesaContext = nullptr;
+            std::vector<uint8_t> osmesaBuffer;
+#endif // TLRENDER_OSMESA
+
+            bool create(ContextBackend);
+            bool createGLFW();
+            bool createEGL();
+            bool createOSMesa();
+            void destroy();
+        };
+
+        void OffscreenContext::_init(
+            ContextBackend backend,
+            const std::shared_ptr<system::Context>& context)
+        {
+            TLRENDER_P();
+            auto logSystem = context->getSystem<log::System>();
+
+            std::vector<ContextBackend> backends;
+            if (ContextBackend::Auto == backend)
+            {
+                backends = getAvailableContextBackends();
+            }
+            else
+            {
+                backends.push_back(backend);
+            }
+            for (auto i : backends)
+            {
+                if (p.create(i))
+                {
+                    p.backend = i;
+                    break;
+                }
+                logSystem->print(
+                    "tl::gl::OffscreenContext",
+                    string::Format("Cannot create {0} context").arg(getLabel(i)),
+                    log::Type::Warning);
+                p.destroy();
+            }
+            if (ContextBackend::Auto == p.backend)
+            {
+                throw std::runtime_error(
+                    string::Format("Cannot create OpenGL context: {0}").arg(getLabel(backend)));
+            }
+
+            GLint glMajor = 0;
+            GLint glMinor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &glMajor);
+            glGetIntegerv(GL_MINOR_VERSION, &glMinor);
+            p.version = string::Format("{0}.{1}").arg(glMajor).arg(glMinor);
+            logSystem->print(
+                "tl::gl::OffscreenContext",
+                string::Format("OpenGL context: {0} {1}").arg(getLabel(p.backend)).arg(p.version));
+        }
+
+        OffscreenContext::OffscreenContext() :
+            _p(new Private)
+        {}
+
+        OffscreenContext::~OffscreenContext()
+        {
+            _p->destroy();
+        }
+
+        std::shared_ptr<OffscreenContext> OffscreenContext::create(
+            const std::shared_ptr<system::Context>& context,
+            ContextBackend backend)
+        {
+            auto out = std::shared_ptr<OffscreenContext>(new OffscreenContext);
+            out->_init(backend, context);
+            return out;
+        }
+
+        ContextBackend OffscreenContext::getBackend() const
+        {
+            return _p->backend;
+        }
+
+        const std::string& OffscreenContext::getVersion() const
+        {
+            return _p->version;
+        }
+
+        void OffscreenContext::makeCurrent()
+        {
+            TLRENDER_P();
+            switch (p.backend)
+            {
+#if defined(TLRENDER_GLFW)
+            case ContextBackend::GLFW:
+                glfwMakeContextCurrent(p.glfwWindow);
+                break;
+#endif // TLRENDER_GLFW
+#if defined(TLRENDER_EGL)
+            case ContextBackend::EGL:
+                eglMakeCurrent(p.eglDisplay, p.eglSurface, p.eglSurface, p.eglContext);
+                break;
+#endif // TLRENDER_EGL
+#if defined(TLRENDER_OSMESA)
+            case ContextBackend::OSMesa:
+                osmesa::makeCurrent(p.osmesaContext, p.osmesaBuffer);
+                break;
+#endif // TLRENDER_OSMESA
+            default: break;
+            }
+        }
+
+        void OffscreenContext::doneCurrent()
+        {
+            TLRENDER_P();
+            switch (p.backend)
+            {
+#if defined(TLRENDER_GLFW)
+            case ContextBackend::GLFW:
+                glfwMakeContextCurrent(nullptr);
+                break;
+#endif // TLRENDER_GLFW
+#if defined(TLRENDER_EGL)
+            case ContextBackend::EGL:
+                eglMakeCurrent(p.eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                break;
+#endif // TLRENDER_EGL
+#if defined(TLRENDER_OSMESA)
+            case ContextBackend::OSMesa:
+                osmesa::doneCurrent();
+                break;
+#endif // TLRENDER_OSMESA
+            default: break;
+            }
+        }
+
+        bool OffscreenContext::Private::create(ContextBackend value)
+        {
+            bool out = false;
+            switch (value)
+            {
+            case ContextBackend::GLFW: out = createGLFW(); break;
+            case ContextBackend::EGL: out = createEGL(); break;
+            case ContextBackend::OSMesa: out = createOSMesa(); break;
+            default: break;
+            }
+            return out;
+        }
+
+        bool OffscreenContext::Private::createGLFW()
+        {
+#if defined(TLRENDER_GLFW)
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glVersionMajor);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glVersionMinor);
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_FALSE);
+#if defined(TLRENDER_GL_DEBUG)
+            glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif // TLRENDER_GL_DEBUG
+            glfwWindow = glfwCreateWindow(1, 1, "tl::gl::OffscreenContext", NULL, NULL);
+            if (!glfwWindow)
+            {
+                return false;
+            }
+            glfwMakeContextCurrent(glfwWindow);
+            return gladLoaderLoadGL() != 0;
+#else // TLRENDER_GLFW
+            return false;
+#endif // TLRENDER_GLFW
+        }
+
+        bool OffscreenContext::Private::createEGL()
+        {
+#if defined(TLRENDER_EGL)
+            // Prefer the surfaceless platform so that no display server is
+            // needed, and fall back to the default display when the
+            // surfaceless platform is not available or cannot be
+            // initialized.
+#if defined(EGL_PLATFORM_SURFACELESS_MESA)
+            if (auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT")))
+            {
+                eglDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+                if (eglDisplay != EGL_NO_DISPLAY && !eglInitialize(eglDisplay, NULL, NULL))
+                {
+                    eglDisplay = EGL_NO_DISPLAY;
+                }
+            }
+#endif // EGL_PLATFORM_SURFACELESS_MESA
+            if (EGL_NO_DISPLAY == eglDisplay)
+            {
+                eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+                if (eglDisplay != EGL_NO_DISPLAY && !eglInitialize(eglDisplay, NULL, NULL))
+                {
+                    eglDisplay = EGL_NO_DISPLAY;
+                }
+            }
+            if (EGL_NO_DISPLAY == eglDisplay ||
+                !eglBindAPI(EGL_OPENGL_API))
+            {
+                return false;
+            }
+
+            const EGLint configAttribs[] =
+            {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_NONE
+            };
+            EGLConfig eglConfig = nullptr;
+            EGLint configCount = 0;
+            if (!eglChooseConfig(eglDisplay, configAttribs, &eglConfig, 1, &configCount) ||
+                0 == configCount)
+            {
+                return false;
+            }
+
+            const EGLint contextAttribs[] =
+            {
+                EGL_CONTEXT_MAJOR_VERSION, glVersionMajor,
+                EGL_CONTEXT_MINOR_VERSION, glVersionMinor,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#if defined(TLRENDER_GL_DEBUG)
+                EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif // TLRENDER_GL_DEBUG
+                EGL_NONE
+            };
+            eglContext = eglCreateContext(eglDisplay, eglConfig, EGL_NO_CONTEXT, contextAttribs);
+            if (EGL_NO_CONTEXT == eglContext)
+            {
+                return false;
+            }
+
+            // Use a surfaceless context when it is supported, otherwise
+            // create a small pixel buffer surface.
+            if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext))
+            {
+                const EGLint surfaceAttribs[] =
+                {
+                    EGL_WIDTH, 1,
+                    EGL_HEIGHT, 1,
+                    EGL_NONE
+                };
+                eglSurface = eglCreatePbufferSurface(eglDisplay, eglConfig, surfaceAttribs);
+                if (EGL_NO_SURFACE == eglSurface ||
+                    !eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext))
+                {
+                    return false;
+                }
+            }
+            for (const char* name : { "libOpenGL.so.0", "libGL.so.1" })
+            {
+                eglGLLibrary = dlopen(name, RTLD_LAZY | RTLD_LOCAL);
+                if (eglGLLibrary)
+                {
+                    break;
+                }
+            }
+            return gladLoadGLUserPtr(eglGetGLProcAddress, eglGLLibrary) != 0;
+#else // TLRENDER_EGL
+            return false;
+#endif // TLRENDER_EGL
+        }
+
+        bool OffscreenContext::Private::createOSMesa()
+        {
+#if defined(TLRENDER_OSMESA)
+            osmesaContext = osmesa::createContext(glVersionMajor, glVersionMinor);
+            if (!osmesaContext ||
+                !osmesa::makeCurrent(osmesaContext, osmesaBuffer))
+            {
+                return false;
+            }
+            return gladLoadGL(reinterpret_cast<GLADloadfunc>(osmesa::getProcAddress)) != 0;
+#else // TLRENDER_OSMESA
+            return false;
+#endif // TLRENDER_OSMESA
+        }
+
+        void OffscreenContext::Private::destroy()
+        {
+#if defined(TLRENDER_GLFW)
+            if (glfwWindow)
+            {
+                glfwDestroyWindow(glfwWindow);
+                glfwWindow = nullptr;
+            }
+#endif // TLRENDER_GLFW
+#if defined(TLRENDER_EGL)
+            if (eglDisplay != EGL_NO_DISPLAY)
+            {
+                eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                if (eglSurface != EGL_NO_SURFACE)
+                {
+                    eglDestroySurface(eglDisplay, eglSurface);
+                    eglSurface = EGL_NO_SURFACE;
+                }
+                if (eglContext != EGL_NO_CONTEXT)
+                {
+                    eglDestroyContext(eglDisplay, eglContext);
+                    eglContext = EGL_NO_CONTEXT;
+                }
+                eglTerminate(eglDisplay);
+                eglDisplay = EGL_NO_DISPLAY;
+            }
+            if (eglGLLibrary)
+            {
+                dlclose(eglGLLibrary);
+                eglGLLibrary = nullptr;
+            }
+#endif // TLRENDER_EGL
+#if defined(TLRENDER_OSMESA)
+            if (osmesaContext)
+            {
+                osmesa::destroyContext(osmesaContext);
+                osmesaContext = nullptr;
+            }
+#endif // TLRENDER_OSMESA
+        }
+    }
+}
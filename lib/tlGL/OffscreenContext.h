@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace system
+    {
+        class Context;
+    }
+
+    namespace gl
+    {
+        //! OpenGL context backends.
+        enum class ContextBackend
+        {
+            Auto,
+            GLFW,
+            EGL,
+            OSMesa,
+
+            Count,
+            First = Auto
+        };
+        TLRENDER_ENUM(ContextBackend);
+        TLRENDER_ENUM_SERIALIZE(ContextBackend);
+
+        //! Get the context backends that are available in this build, not
+        //! including the automatic backend.
+        std::vector<ContextBackend> getAvailableContextBackends();
+
+        //! Get the default context backend. The default can be set with the
+        //! "TLRENDER_GL_CONTEXT" environment variable (e.g., "EGL").
+        ContextBackend getDefaultContextBackend();
+
+        //! Offscreen OpenGL context.
+        //!
+        //! The context does not have a visible window, so rendering must be
+        //! done to an offscreen buffer. The EGL and OSMesa backends do not
+        //! need a display server, so they can be used on headless machines.
+        //! The automatic backend tries GLFW, EGL, and OSMesa in that order.
+        class OffscreenContext
+        {
+            TLRENDER_NON_COPYABLE(OffscreenContext);
+
+        protected:
+            void _init(
+                ContextBackend,
+                const std::shared_ptr<system::Context>&);
+
+            OffscreenContext();
+
+        public:
+            ~OffscreenContext();
+
+            //! Create a new context. The context is made current and GLAD
+            //! is initialized.
+            //!
+            //! Throws:
+            //! - std::exception
+            static std::shared_ptr<OffscreenContext> create(
+                const std::shared_ptr<system::Context>&,
+                ContextBackend = getDefaultContextBackend());
+
+            //! Get the backend that was used to create the context.
+            ContextBackend getBackend() const;
+
+            //! Get the OpenGL version.
+            const std::string& getVersion() const;
+
+            //! Make the context current on the calling thread.
+            void makeCurrent();
+
+            //! Release the context from the calling thread.
+            void doneCurrent();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/OffscreenContextPrivate.h>
+
+#include <GL/osmesa.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        namespace osmesa
+        {
+            void* createContext(int major, int minor)
+            {
+                const int attribs[] =
+                {
+                    OSMESA_FORMAT, OSMESA_RGBA,
+                    OSMESA_DEPTH_BITS, 0,
+                    OSMESA_STENCIL_BITS, 0,
+                    OSMESA_ACCUM_BITS, 0,
+                    OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+                    OSMESA_CONTEXT_MAJOR_VERSION, major,
+                    OSMESA_CONTEXT_MINOR_VERSION, minor,
+                    0
+                };
+                return OSMesaCreateContextAttribs(attribs, nullptr);
+            }
+
+            bool makeCurrent(void* context, std::vector<uint8_t>& buffer)
+            {
+                buffer.resize(4);
+                return OSMesaMakeCurrent(
+                    static_cast<OSMesaContext>(context),
+                    buffer.data(),
+                    GL_UNSIGNED_BYTE,
+                    1,
+                    1);
+            }
+
+            void doneCurrent()
+            {
+                OSMesaMakeCurrent(nullptr, nullptr, GL_UNSIGNED_BYTE, 0, 0);
+            }
+
+            void destroyContext(void* context)
+            {
+                OSMesaDestroyContext(static_cast<OSMesaContext>(context));
+            }
+
+            void* getProcAddress(const char* name)
+            {
+                return reinterpret_cast<void*>(OSMesaGetProcAddress(name));
+            }
+        }
+    }
+}
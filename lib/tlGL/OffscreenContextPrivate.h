@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace tl
+{
+    namespace gl
+    {
+#if defined(TLRENDER_OSMESA)
+        //! OSMesa functions. These are kept in a separate translation unit
+        //! because the OSMesa header includes the system OpenGL header,
+        //! which conflicts with GLAD.
+        namespace osmesa
+        {
+            //! Create a core profile context, or return null on failure.
+            void* createContext(int major, int minor);
+
+            //! Make a context current with the given buffer. The buffer
+            //! is only used as the default framebuffer.
+            bool makeCurrent(void* context, std::vector<uint8_t>& buffer);
+
+            //! Release the current context.
+            void doneCurrent();
+
+            //! Destroy a context.
+            void destroyContext(void* context);
+
+            //! Get the address of an OpenGL function.
+            void* getProcAddress(const char* name);
+        }
+#endif // TLRENDER_OSMESA
+    }
+}
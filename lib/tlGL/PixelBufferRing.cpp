@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/PixelBufferRing.h>
+
+#include <tlGL/Texture.h>
+
+#if defined(TLRENDER_GL_DEBUG)
+#include <tlGladDebug/gl.h>
+#else // TLRENDER_GL_DEBUG
+#include <tlGlad/gl.h>
+#endif // TLRENDER_GL_DEBUG
+
+#include <cstring>
+#include <list>
+#include <mutex>
+
+namespace tl
+{
+    namespace gl
+    {
+        namespace
+        {
+            //! Alignment of the regions in the ring.
+            const size_t regionAlignment = 64;
+
+            //! Time to wait for the GPU when the ring is full.
+            const GLuint64 fenceTimeout = 1000000000;
+
+            struct Region
+            {
+                size_t offset = 0;
+                size_t byteCount = 0;
+                bool released = false;
+                GLsync fence = nullptr;
+            };
+
+            //! The regions are shared with the images created in the ring, so
+            //! the images can be released on any thread without the ring.
+            struct Regions
+            {
+                uint8_t* data = nullptr;
+                size_t byteCount = 0;
+                std::list<std::shared_ptr<Region> > list;
+                size_t head = 0;
+                size_t imageCount = 0;
+                bool closed = false;
+                std::mutex mutex;
+            };
+
+            std::shared_ptr<Region> allocate(Regions& regions, size_t byteCount)
+            {
+                std::shared_ptr<Region> out;
+                const size_t size = (byteCount + regionAlignment - 1) / regionAlignment * regionAlignment;
+                if (size > 0 && size <= regions.byteCount)
+                {
+                    // The regions are allocated in order, so the free space
+                    // is between the end of the newest region (the head) and
+                    // the start of the oldest region (the tail).
+                    size_t offset = 0;
+                    bool found = false;
+                    if (regions.list.empty())
+                    {
+                        found = true;
+                    }
+                    else
+                    {
+                        const size_t tail = regions.list.front()->offset;
+                        if (regions.head > tail)
+                        {
+                            if (regions.head + size <= regions.byteCount)
+                            {
+                                offset = regions.head;
+                                found = true;
+                            }
+                            else if (size <= tail)
+                            {
+                                found = true;
+                            }
+                        }
+                        else if (regions.head < tail && regions.head + size <= tail)
+                        {
+                            offset = regions.head;
+                            found = true;
+                        }
+                    }
+                    if (found)
+                    {
+                        out = std::make_shared<Region>();
+                        out->offset = offset;
+                        out->byteCount = size;
+                        regions.list.push_back(out);
+                        regions.head = offset + size;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<image::Image> createImage(
+                const std::shared_ptr<Regions>& regions,
+                const image::Info& info)
+            {
+                std::shared_ptr<image::Image> out;
+                std::shared_ptr<Region> region;
+                {
+                    std::unique_lock<std::mutex> lock(regions->mutex);
+                    if (!regions->closed)
+                    {
+                        region = allocate(*regions, image::getDataByteCount(info));
+                        if (region)
+                        {
+                            ++regions->imageCount;
+                        }
+                    }
+                }
+                if (region)
+                {
+                    // The region is released when the image is destroyed,
+                    // and re-used after the GPU has finished reading it. The
+                    // image only references the regions, so it can be
+                    // released without an OpenGL context.
+                    uint8_t* data = regions->data + region->offset;
+                    std::shared_ptr<void> owner(
+                        data,
+                        [regions, region](void*)
+                        {
+                            std::unique_lock<std::mutex> lock(regions->mutex);
+                            region->released = true;
+                            --regions->imageCount;
+                        });
+                    out = image::Image::create(info, data, owner);
+                }
+                return out;
+            }
+        }
+
+        struct PixelBufferRing::Private
+        {
+            GLuint pbo = 0;
+            std::shared_ptr<Regions> regions;
+        };
+
+        void PixelBufferRing::_init(size_t byteCount)
+        {
+            TLRENDER_P();
+            if (!isSupported())
+            {
+                throw std::runtime_error("Persistently mapped buffers are not supported");
+            }
+            p.regions = std::make_shared<Regions>();
+            p.regions->byteCount = byteCount;
+
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glGenBuffers(1, &p.pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, byteCount, NULL, flags);
+            p.regions->data = static_cast<uint8_t*>(glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                byteCount,
+                flags));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            if (!p.regions->data)
+            {
+                glDeleteBuffers(1, &p.pbo);
+                p.pbo = 0;
+                throw std::runtime_error("Cannot map the pixel buffer");
+            }
+        }
+
+        PixelBufferRing::PixelBufferRing() :
+            _p(new Private)
+        {}
+
+        PixelBufferRing::~PixelBufferRing()
+        {
+            TLRENDER_P();
+            size_t imageCount = 0;
+            {
+                std::unique_lock<std::mutex> lock(p.regions->mutex);
+                p.regions->closed = true;
+                imageCount = p.regions->imageCount;
+                for (const auto& region : p.regions->list)
+                {
+                    if (region->fence)
+                    {
+                        glDeleteSync(region->fence);
+                        region->fence = nullptr;
+                    }
+                }
+            }
+            // Images that are still alive keep the buffer mapped until the
+            // OpenGL context is destroyed.
+            if (p.pbo && 0 == imageCount)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glDeleteBuffers(1, &p.pbo);
+                p.pbo = 0;
+            }
+        }
+
+        std::shared_ptr<PixelBufferRing> PixelBufferRing::create(size_t byteCount)
+        {
+            auto out = std::shared_ptr<PixelBufferRing>(new PixelBufferRing);
+            out->_init(byteCount);
+            return out;
+        }
+
+        bool PixelBufferRing::isSupported()
+        {
+            return GLAD_GL_ARB_buffer_storage && glBufferStorage;
+        }
+
+        size_t PixelBufferRing::getByteCount() const
+        {
+            return _p->regions->byteCount;
+        }
+
+        std::shared_ptr<image::Image> PixelBufferRing::createImage(const image::Info& info)
+        {
+            return gl::createImage(_p->regions, info);
+        }
+
+        image::Allocator PixelBufferRing::getImageAllocator() const
+        {
+            auto regions = _p->regions;
+            return [regions](const image::Info& info)
+            {
+                return gl::createImage(regions, info);
+            };
+        }
+
+        size_t PixelBufferRing::getImageCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.regions->mutex);
+            return p.regions->imageCount;
+        }
+
+        bool PixelBufferRing::contains(const uint8_t* data, size_t byteCount) const
+        {
+            TLRENDER_P();
+            const uint8_t* ringData = p.regions->data;
+            return data >= ringData && data + byteCount <= ringData + p.regions->byteCount;
+        }
+
+        bool PixelBufferRing::copy(
+            const uint8_t* data,
+            const image::Info& info,
+            Texture& texture)
+        {
+            TLRENDER_P();
+            const size_t byteCount = image::getDataByteCount(info);
+            std::shared_ptr<Region> region;
+            size_t offset = 0;
+            if (contains(data, byteCount))
+            {
+                // The data is already in the ring.
+                offset = data - p.regions->data;
+                std::unique_lock<std::mutex> lock(p.regions->mutex);
+                for (const auto& i : p.regions->list)
+                {
+                    if (offset >= i->offset && offset + byteCount <= i->offset + i->byteCount)
+                    {
+                        region = i;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                // Copy the data into a temporary region. When the ring is
+                // full wait for the GPU to finish with the oldest region.
+                while (!region)
+                {
+                    update();
+                    GLsync fence = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(p.regions->mutex);
+                        region = allocate(*p.regions, byteCount);
+                        if (region)
+                        {
+                            region->released = true;
+                        }
+                        else if (!p.regions->list.empty() &&
+                            p.regions->list.front()->released)
+                        {
+                            fence = p.regions->list.front()->fence;
+                        }
+                    }
+                    if (!region)
+                    {
+                        if (!fence ||
+                            GL_WAIT_FAILED == glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout))
+                        {
+                            return false;
+                        }
+                    }
+                }
+                offset = region->offset;
+                memcpy(p.regions->data + offset, data, byteCount);
+            }
+            if (!region)
+                return false;
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pbo);
+            texture.bind();
+            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+            glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                0,
+                info.size.w,
+                info.size.h,
+                getTextureFormat(info.pixelType),
+                getTextureType(info.pixelType),
+                reinterpret_cast<const void*>(offset));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            {
+                std::unique_lock<std::mutex> lock(p.regions->mutex);
+                std::swap(region->fence, fence);
+            }
+            if (fence)
+            {
+                glDeleteSync(fence);
+            }
+            return true;
+        }
+
+        void PixelBufferRing::update()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.regions->mutex);
+            while (!p.regions->list.empty())
+            {
+                const auto& region = p.regions->list.front();
+                if (!region->released)
+                    break;
+                if (region->fence)
+                {
+                    const GLenum result = glClientWaitSync(region->fence, 0, 0);
+                    if (GL_TIMEOUT_EXPIRED == result)
+                        break;
+                    glDeleteSync(region->fence);
+                    region->fence = nullptr;
+                }
+                p.regions->list.pop_front();
+            }
+            if (p.regions->list.empty())
+            {
+                p.regions->head = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Image.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        class Texture;
+
+        //! Ring of persistently mapped pixel buffer memory for texture
+        //! uploads.
+        //!
+        //! The buffer stays mapped, so image data can be written into it
+        //! at any time and textures are copied from it without mapping the
+        //! buffer on the render thread. Fences mark when the GPU has
+        //! finished reading each region of the ring, after which the
+        //! region can be re-used.
+        //!
+        //! Images can be created in the ring and written on any thread,
+        //! for example by a worker thread that decodes frames ahead of
+        //! the render. The data of these images is drawn without another
+        //! copy. Images created from the ring must not be modified after
+        //! they are drawn, and must not outlive the OpenGL context. The
+        //! images do not keep the ring alive and can be released on any
+        //! thread. The ring should be kept until its images are released
+        //! (see getImageCount()), otherwise the buffer stays mapped until
+        //! the OpenGL context is destroyed. The other functions must be
+        //! called on the thread with the OpenGL context.
+        //!
+        //! The ring requires OpenGL 4.4 or the ARB_buffer_storage
+        //! extension.
+        class PixelBufferRing : public std::enable_shared_from_this<PixelBufferRing>
+        {
+            TLRENDER_NON_COPYABLE(PixelBufferRing);
+
+        protected:
+            void _init(size_t byteCount);
+
+            PixelBufferRing();
+
+        public:
+            ~PixelBufferRing();
+
+            //! Create a new ring.
+            //!
+            //! Throws:
+            //! - std::exception
+            static std::shared_ptr<PixelBufferRing> create(size_t byteCount);
+
+            //! Get whether the current OpenGL context supports persistently
+            //! mapped buffers.
+            static bool isSupported();
+
+            //! Get the size of the ring in bytes.
+            size_t getByteCount() const;
+
+            //! Create an image with data in the ring. A null pointer is
+            //! returned when there is not enough free space. This function
+            //! is thread safe.
+            std::shared_ptr<image::Image> createImage(const image::Info&);
+
+            //! Get a function that creates images in the ring. The function
+            //! can be called on any thread, and returns a null pointer
+            //! after the ring is destroyed.
+            image::Allocator getImageAllocator() const;
+
+            //! Get the number of images in the ring that are still alive.
+            //! This function is thread safe.
+            size_t getImageCount() const;
+
+            //! Get whether the data is in the ring. This function is thread
+            //! safe.
+            bool contains(const uint8_t*, size_t byteCount) const;
+
+            //! Copy image data to a texture through the ring. Data that is
+            //! already in the ring is not copied again. False is returned
+            //! when there is not enough free space.
+            bool copy(const uint8_t*, const image::Info&, Texture&);
+
+            //! Re-use the regions of the ring that the GPU has finished
+            //! reading. This should be called once for each render.
+            void update();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
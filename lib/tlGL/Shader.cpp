@@ -4,6 +4,8 @@
 
 #include <tlGL/Shader.h>
 
+#include <tlGL/ShaderCache.h>
+
 #include <tlCore/Color.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -33,6 +35,35 @@ namespace tl
         {
             TLRENDER_P();
 
+            // Load the program binary if it has been linked before.
+            auto shaderCache = getShaderCache();
+            if (shaderCache && !ShaderCache::isSupported())
+            {
+                shaderCache.reset();
+            }
+            if (shaderCache)
+            {
+                ProgramBinary binary;
+                if (shaderCache->get(p.vertexSource, p.fragmentSource, binary))
+                {
+                    p.program = glCreateProgram();
+                    glProgramBinary(
+                        p.program,
+                        binary.format,
+                        binary.data.data(),
+                        static_cast<GLsizei>(binary.data.size()));
+                    int success = 0;
+                    glGetProgramiv(p.program, GL_LINK_STATUS, &success);
+                    if (success)
+                        return;
+
+                    // The binary can be rejected after a driver update, in
+                    // which case the program is compiled again.
+                    glDeleteProgram(p.program);
+                    p.program = 0;
+                }
+            }
+
             p.vertex = glCreateShader(GL_VERTEX_SHADER);
             if (!p.vertex)
             {
@@ -85,6 +116,10 @@ namespace tl
             }
 
             p.program = glCreateProgram();
+            if (shaderCache)
+            {
+                glProgramParameteri(p.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
             glAttachShader(p.program, p.vertex);
             glAttachShader(p.program, p.fragment);
             glLinkProgram(p.program);
@@ -95,6 +130,21 @@ namespace tl
                 glGetProgramInfoLog(p.program, string::cBufferSize, NULL, infoLog);
                 throw std::runtime_error(infoLog);
             }
+
+            if (shaderCache)
+            {
+                GLint size = 0;
+                glGetProgramiv(p.program, GL_PROGRAM_BINARY_LENGTH, &size);
+                if (size > 0)
+                {
+                    ProgramBinary binary;
+                    binary.data.resize(size);
+                    GLenum format = GL_NONE;
+                    glGetProgramBinary(p.program, size, NULL, &format, binary.data.data());
+                    binary.format = format;
+                    shaderCache->add(p.vertexSource, p.fragmentSource, binary);
+                }
+            }
         }
 
         Shader::Shader() :
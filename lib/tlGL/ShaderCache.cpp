@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/ShaderCache.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/StringFormat.h>
+
+#if defined(TLRENDER_GL_DEBUG)
+#include <tlGladDebug/gl.h>
+#else // TLRENDER_GL_DEBUG
+#include <tlGlad/gl.h>
+#endif // TLRENDER_GL_DEBUG
+
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+namespace tl
+{
+    namespace gl
+    {
+        namespace
+        {
+            //! Version of the cache file format.
+            const uint32_t fileVersion = 1;
+
+            //! Age in seconds after which temporary files are considered
+            //! abandoned.
+            const time_t tmpFileAge = 60 * 60;
+
+            std::string getGLString(GLenum name)
+            {
+                const GLubyte* s = glGetString(name);
+                return s ? reinterpret_cast<const char*>(s) : std::string();
+            }
+
+            //! Get the full key for a program. The key is stored with the
+            //! binary to guard against hash collisions.
+            std::string getKey(
+                const std::string& vertexSource,
+                const std::string& fragmentSource)
+            {
+                std::stringstream ss;
+                ss << getGLString(GL_VENDOR) << '\n';
+                ss << getGLString(GL_RENDERER) << '\n';
+                ss << getGLString(GL_VERSION) << '\n';
+                ss << vertexSource << '\0';
+                ss << fragmentSource;
+                return ss.str();
+            }
+
+            std::string getHash(const std::string& key)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::hash<std::string>()(key);
+                return ss.str();
+            }
+
+            std::shared_ptr<ShaderCache> shaderCache;
+            std::mutex shaderCacheMutex;
+        }
+
+        struct ShaderCache::Private
+        {
+            std::string directory;
+            size_t byteCount = 0;
+            std::string tmpFileNamePrefix;
+            uint64_t tmpFileNameCounter = 0;
+
+            struct Item
+            {
+                std::string key;
+                ProgramBinary binary;
+            };
+            std::map<std::string, std::shared_ptr<Item> > items;
+            mutable std::mutex mutex;
+
+            std::string getFileName(const std::string& hash) const
+            {
+                return string::Format("{0}/{1}.bin").arg(directory).arg(hash);
+            }
+
+            std::shared_ptr<Item> read(const std::string& hash) const;
+            void write(const std::string& hash, const Item&);
+            void directoryUpdate();
+        };
+
+        std::shared_ptr<ShaderCache::Private::Item> ShaderCache::Private::read(const std::string& hash) const
+        {
+            std::shared_ptr<Item> out;
+            const std::string fileName = getFileName(hash);
+            if (!directory.empty() && file::exists(fileName))
+            {
+                try
+                {
+                    auto io = file::FileIO::create(fileName, file::Mode::Read);
+                    uint32_t version = 0;
+                    io->readU32(&version);
+                    if (fileVersion == version)
+                    {
+                        auto item = std::make_shared<Item>();
+                        uint32_t format = 0;
+                        io->readU32(&format);
+                        item->binary.format = format;
+                        uint32_t size = 0;
+                        io->readU32(&size);
+                        item->key.resize(size);
+                        io->read(&item->key[0], size);
+                        io->readU32(&size);
+                        item->binary.data.resize(size);
+                        io->read(item->binary.data.data(), size);
+                        out = item;
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
+            return out;
+        }
+
+        void ShaderCache::Private::write(const std::string& hash, const Item& item)
+        {
+            if (!directory.empty())
+            {
+                // Write to a temporary file first so that a partial file is
+                // never read. The temporary file is named with a random
+                // prefix and a counter, so it does not collide with files
+                // written by other processes or threads.
+                const std::string fileName = getFileName(hash);
+                uint64_t counter = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    counter = ++tmpFileNameCounter;
+                }
+                const std::string tmpFileName = string::Format("{0}.{1}_{2}.tmp").
+                    arg(fileName).
+                    arg(tmpFileNamePrefix).
+                    arg(counter);
+                try
+                {
+                    {
+                        auto io = file::FileIO::create(tmpFileName, file::Mode::Write);
+                        io->writeU32(fileVersion);
+                        io->writeU32(item.binary.format);
+                        io->writeU32(item.key.size());
+                        io->write(item.key.data(), item.key.size());
+                        io->writeU32(item.binary.data.size());
+                        io->write(item.binary.data.data(), item.binary.data.size());
+                    }
+                    file::rm(fileName);
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        file::rm(tmpFileName);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    file::rm(tmpFileName);
+                }
+                directoryUpdate();
+            }
+        }
+
+        void ShaderCache::Private::directoryUpdate()
+        {
+            // Keep the newest binaries that fit in the maximum size, and
+            // remove temporary files that were abandoned by processes that
+            // did not finish writing them.
+            file::ListOptions options;
+            options.sort = file::ListSort::Time;
+            options.reverseSort = true;
+            options.sequence = false;
+            const time_t now = std::time(nullptr);
+            uint64_t size = 0;
+            for (const auto& fileInfo : file::list(directory, options))
+            {
+                if (fileInfo.getType() != file::Type::File)
+                    continue;
+                const auto& path = fileInfo.getPath();
+                const std::string& extension = path.getExtension();
+                if (".bin" == extension)
+                {
+                    size += fileInfo.getSize();
+                    if (size > byteCount)
+                    {
+                        file::rm(path.get());
+                    }
+                }
+                else if (".tmp" == extension && now - fileInfo.getTime() > tmpFileAge)
+                {
+                    file::rm(path.get());
+                }
+            }
+        }
+
+        void ShaderCache::_init(const std::string& directory, size_t byteCount)
+        {
+            TLRENDER_P();
+            p.directory = directory;
+            p.byteCount = byteCount;
+            std::random_device rd;
+            std::stringstream ss;
+            ss << std::hex << ((static_cast<uint64_t>(rd()) << 32) | rd());
+            p.tmpFileNamePrefix = ss.str();
+            if (!p.directory.empty() && !file::exists(p.directory))
+            {
+                file::mkdir(p.directory);
+            }
+        }
+
+        ShaderCache::ShaderCache() :
+            _p(new Private)
+        {}
+
+        ShaderCache::~ShaderCache()
+        {}
+
+        std::shared_ptr<ShaderCache> ShaderCache::create(
+            const std::string& directory,
+            size_t byteCount)
+        {
+            auto out = std::shared_ptr<ShaderCache>(new ShaderCache);
+            out->_init(directory, byteCount);
+            return out;
+        }
+
+        bool ShaderCache::isSupported()
+        {
+            GLint count = 0;
+            if (glGetProgramBinary && glProgramBinary)
+            {
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+            }
+            return count > 0;
+        }
+
+        const std::string& ShaderCache::getDirectory() const
+        {
+            return _p->directory;
+        }
+
+        size_t ShaderCache::getByteCount() const
+        {
+            return _p->byteCount;
+        }
+
+        size_t ShaderCache::getCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.items.size();
+        }
+
+        bool ShaderCache::get(
+            const std::string& vertexSource,
+            const std::string& fragmentSource,
+            ProgramBinary& out)
+        {
+            TLRENDER_P();
+            const std::string key = getKey(vertexSource, fragmentSource);
+            const std::string hash = getHash(key);
+            std::shared_ptr<Private::Item> item;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.items.find(hash);
+                if (i != p.items.end())
+                {
+                    item = i->second;
+                }
+            }
+            if (!item)
+            {
+                item = p.read(hash);
+                if (item)
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.items[hash] = item;
+                }
+            }
+            const bool found = item && item->key == key;
+            if (found)
+            {
+                out = item->binary;
+            }
+            return found;
+        }
+
+        void ShaderCache::add(
+            const std::string& vertexSource,
+            const std::string& fragmentSource,
+            const ProgramBinary& binary)
+        {
+            TLRENDER_P();
+            auto item = std::make_shared<Private::Item>();
+            item->key = getKey(vertexSource, fragmentSource);
+            item->binary = binary;
+            const std::string hash = getHash(item->key);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.items[hash] = item;
+            }
+            p.write(hash, *item);
+        }
+
+        void ShaderCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.items.clear();
+        }
+
+        void setShaderCache(const std::shared_ptr<ShaderCache>& value)
+        {
+            std::unique_lock<std::mutex> lock(shaderCacheMutex);
+            shaderCache = value;
+        }
+
+        std::shared_ptr<ShaderCache> getShaderCache()
+        {
+            std::unique_lock<std::mutex> lock(shaderCacheMutex);
+            return shaderCache;
+        }
+    }
+}
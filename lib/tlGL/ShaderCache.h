@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Memory.h>
+#include <tlCore/Util.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace gl
+    {
+        //! Linked shader program binary.
+        struct ProgramBinary
+        {
+            unsigned int format = 0;
+            std::vector<uint8_t> data;
+        };
+
+        //! Shader program binary cache.
+        //!
+        //! Linked programs are stored by a hash of their source code, so a
+        //! shader that has been seen before is loaded from the binary
+        //! instead of being compiled. The binaries are kept in memory and
+        //! written to the cache directory so they can be re-used by later
+        //! sessions. Binaries only work with the driver that created them,
+        //! so the OpenGL vendor, renderer, and version are part of the key.
+        //! When the directory grows larger than the maximum size the oldest
+        //! binaries are removed.
+        //!
+        //! The functions that use a key must be called with an OpenGL
+        //! context current.
+        class ShaderCache : public std::enable_shared_from_this<ShaderCache>
+        {
+            TLRENDER_NON_COPYABLE(ShaderCache);
+
+        protected:
+            void _init(const std::string& directory, size_t byteCount);
+
+            ShaderCache();
+
+        public:
+            ~ShaderCache();
+
+            //! Create a new shader cache. If the directory is empty the
+            //! binaries are only kept in memory.
+            static std::shared_ptr<ShaderCache> create(
+                const std::string& directory,
+                size_t byteCount = memory::megabyte * 64);
+
+            //! Get whether the current OpenGL context supports program
+            //! binaries.
+            static bool isSupported();
+
+            //! Get the cache directory.
+            const std::string& getDirectory() const;
+
+            //! Get the maximum size of the cache directory in bytes.
+            size_t getByteCount() const;
+
+            //! Get the number of program binaries in memory.
+            size_t getCount() const;
+
+            //! Get a program binary. False is returned if the program is not
+            //! in the cache.
+            bool get(
+                const std::string& vertexSource,
+                const std::string& fragmentSource,
+                ProgramBinary&);
+
+            //! Add a program binary.
+            void add(
+                const std::string& vertexSource,
+                const std::string& fragmentSource,
+                const ProgramBinary&);
+
+            //! Remove all of the program binaries from memory.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
+        //! Set the shader cache used by Shader. Set to null to disable the
+        //! cache.
+        void setShaderCache(const std::shared_ptr<ShaderCache>&);
+
+        //! Get the shader cache used by Shader.
+        std::shared_ptr<ShaderCache> getShaderCache();
+    }
+}
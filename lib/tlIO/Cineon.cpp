@@ -210,6 +210,89 @@ namespace tl
                     *in < _floatMax;
             }
 
+            void readTags(const Header& header, io::Info& info)
+            {
+                if (isValid(header.file.time, 24))
+                {
+                    info.tags["Time"] = toString(header.file.time, 24);
+                }
+                if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.offset[0] << " " << header.source.offset[1];
+                    info.tags["Source Offset"] = ss.str();
+                }
+                if (isValid(header.source.file, 100))
+                {
+                    info.tags["Source File"] = toString(header.source.file, 100);
+                }
+                if (isValid(header.source.time, 24))
+                {
+                    info.tags["Source Time"] = toString(header.source.time, 24);
+                }
+                if (isValid(header.source.inputDevice, 64))
+                {
+                    info.tags["Source Input Device"] = toString(header.source.inputDevice, 64);
+                }
+                if (isValid(header.source.inputModel, 32))
+                {
+                    info.tags["Source Input Model"] = toString(header.source.inputModel, 32);
+                }
+                if (isValid(header.source.inputSerial, 32))
+                {
+                    info.tags["Source Input Serial"] = toString(header.source.inputSerial, 32);
+                }
+                if (isValid(&header.source.inputPitch[0]) && isValid(&header.source.inputPitch[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.inputPitch[0] << " " << header.source.inputPitch[1];
+                    info.tags["Source Input Pitch"] = ss.str();
+                }
+                if (isValid(&header.source.gamma))
+                {
+                    std::stringstream ss;
+                    ss << header.source.gamma;
+                    info.tags["Source Gamma"] = ss.str();
+                }
+                if (isValid(&header.film.id) &&
+                    isValid(&header.film.type) &&
+                    isValid(&header.film.offset) &&
+                    isValid(&header.film.prefix) &&
+                    isValid(&header.film.count))
+                {
+                    info.tags["Keycode"] = time::keycodeToString(
+                        header.film.id,
+                        header.film.type,
+                        header.film.prefix,
+                        header.film.count,
+                        header.film.offset);
+                }
+                if (isValid(header.film.format, 32))
+                {
+                    info.tags["Film Format"] = toString(header.film.format, 32);
+                }
+                if (isValid(&header.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << header.film.frame;
+                    info.tags["Film Frame"] = ss.str();
+                }
+                if (isValid(&header.film.frameRate) && header.film.frameRate >= _minSpeed)
+                {
+                    std::stringstream ss;
+                    ss << header.film.frameRate;
+                    info.tags["Film Frame Rate"] = ss.str();
+                }
+                if (isValid(header.film.frameId, 32))
+                {
+                    info.tags["Film Frame ID"] = toString(header.film.frameId, 32);
+                }
+                if (isValid(header.film.slate, 200))
+                {
+                    info.tags["Film Slate"] = toString(header.film.slate, 200);
+                }
+            }
+
         } // namespace
 
         Header read(const std::shared_ptr<file::FileIO>& io, io::Info& info)
@@ -339,85 +422,7 @@ namespace tl
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = toString(out.file.time, 24);
-            }
-            if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.offset[0] << " " << out.source.offset[1];
-                info.tags["Source Offset"] = ss.str();
-            }
-            if (isValid(out.source.file, 100))
-            {
-                info.tags["Source File"] = toString(out.source.file, 100);
-            }
-            if (isValid(out.source.time, 24))
-            {
-                info.tags["Source Time"] = toString(out.source.time, 24);
-            }
-            if (isValid(out.source.inputDevice, 64))
-            {
-                info.tags["Source Input Device"] = toString(out.source.inputDevice, 64);
-            }
-            if (isValid(out.source.inputModel, 32))
-            {
-                info.tags["Source Input Model"] = toString(out.source.inputModel, 32);
-            }
-            if (isValid(out.source.inputSerial, 32))
-            {
-                info.tags["Source Input Serial"] = toString(out.source.inputSerial, 32);
-            }
-            if (isValid(&out.source.inputPitch[0]) && isValid(&out.source.inputPitch[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.inputPitch[0] << " " << out.source.inputPitch[1];
-                info.tags["Source Input Pitch"] = ss.str();
-            }
-            if (isValid(&out.source.gamma))
-            {
-                std::stringstream ss;
-                ss << out.source.gamma;
-                info.tags["Source Gamma"] = ss.str();
-            }
-            if (isValid(&out.film.id) &&
-                isValid(&out.film.type) &&
-                isValid(&out.film.offset) &&
-                isValid(&out.film.prefix) &&
-                isValid(&out.film.count))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    out.film.id,
-                    out.film.type,
-                    out.film.prefix,
-                    out.film.count,
-                    out.film.offset);
-            }
-            if (isValid(out.film.format, 32))
-            {
-                info.tags["Film Format"] = toString(out.film.format, 32);
-            }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
-            if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
-            {
-                std::stringstream ss;
-                ss << out.film.frameRate;
-                info.tags["Film Frame Rate"] = ss.str();
-            }
-            if (isValid(out.film.frameId, 32))
-            {
-                info.tags["Film Frame ID"] = toString(out.film.frameId, 32);
-            }
-            if (isValid(out.film.slate, 200))
-            {
-                info.tags["Film Slate"] = toString(out.film.slate, 200);
-            }
+            readTags(out, info);
 
             // Set the file position.
             if (out.file.imageOffset)
@@ -428,6 +433,62 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<io::FrameTemplate> createTemplate(
+            const std::shared_ptr<file::FileIO>& io,
+            const io::Info& info)
+        {
+            auto out = std::make_shared<io::FrameTemplate>();
+            const size_t pos = io->getPos();
+            out->header.resize(sizeof(Header::File) + sizeof(Header::Image));
+            io->setPos(0);
+            io->read(out->header.data(), out->header.size());
+            io->setPos(pos);
+            out->fileSize = io->getSize();
+            out->dataOffset = pos;
+            out->endianConversion = io->hasEndianConversion();
+            out->info = info.video[0];
+            return out;
+        }
+
+        bool readTemplate(
+            const std::shared_ptr<file::FileIO>& io,
+            const io::FrameTemplate& frameTemplate,
+            io::Info& info)
+        {
+            bool out = false;
+            if (io->getSize() == frameTemplate.fileSize &&
+                frameTemplate.header.size() == sizeof(Header::File) + sizeof(Header::Image))
+            {
+                Header header;
+                io->read(&header.file, sizeof(Header::File));
+                io->read(&header.image, sizeof(Header::Image));
+
+                // Compare the magic number, image offset, and image section
+                // with the template.
+                const uint8_t* p = frameTemplate.header.data();
+                if (0 == memcmp(&header.file, p, 8) &&
+                    0 == memcmp(&header.image, p + sizeof(Header::File), sizeof(Header::Image)))
+                {
+                    io->read(&header.source, sizeof(Header::Source));
+                    io->read(&header.film, sizeof(Header::Film));
+                    if (frameTemplate.endianConversion)
+                    {
+                        io->setEndianConversion(true);
+                        convertEndian(header);
+                    }
+                    info.video.push_back(frameTemplate.info);
+                    readTags(header, info);
+                    io->setPos(frameTemplate.dataOffset);
+                    out = true;
+                }
+                else
+                {
+                    io->setPos(0);
+                }
+            }
+            return out;
+        }
+
         void write(const std::shared_ptr<file::FileIO>& io, const io::Info& info)
         {
             Header header;
@@ -166,6 +166,19 @@ namespace tl
         //! Read a header.
         Header read(const std::shared_ptr<file::FileIO>&, io::Info&);
 
+        //! Create a frame template from a header that has just been read.
+        std::shared_ptr<io::FrameTemplate> createTemplate(
+            const std::shared_ptr<file::FileIO>&,
+            const io::Info&);
+
+        //! Read a header using a frame template. If the header does not
+        //! match the template false is returned and the file position is
+        //! reset, so the header can be read again with read().
+        bool readTemplate(
+            const std::shared_ptr<file::FileIO>&,
+            const io::FrameTemplate&,
+            io::Info&);
+
         //! Write a header.
         void write(const std::shared_ptr<file::FileIO>&, const io::Info&);
 
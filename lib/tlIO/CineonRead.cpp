@@ -82,9 +82,17 @@ namespace tl
 
             auto io = memory ?
                 file::FileIO::create(fileName, *memory) :
-                file::FileIO::create(fileName, file::Mode::Read);
+                _openFile(fileName);
             io::Info info;
-            read(io, info);
+            const auto frameTemplate = _getFrameTemplate();
+            if (!frameTemplate || !readTemplate(io, *frameTemplate, info))
+            {
+                read(io, info);
+                if (!frameTemplate)
+                {
+                    _setFrameTemplate(createTemplate(io, info));
+                }
+            }
 
             out.image = image::Image::create(info.video[0]);
             out.image->setTags(info.tags);
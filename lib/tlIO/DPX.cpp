@@ -185,6 +185,216 @@ namespace tl
                     *in > -_floatMax &&
                     *in < _floatMax;
             }
+
+            void readTags(const Header& header, io::Info& info)
+            {
+                if (cineon::isValid(header.file.time, 24))
+                {
+                    info.tags["Time"] = cineon::toString(header.file.time, 24);
+                }
+                if (cineon::isValid(header.file.creator, 100))
+                {
+                    info.tags["Creator"] = cineon::toString(header.file.creator, 100);
+                }
+                if (cineon::isValid(header.file.project, 200))
+                {
+                    info.tags["Project"] = cineon::toString(header.file.project, 200);
+                }
+                if (cineon::isValid(header.file.copyright, 200))
+                {
+                    info.tags["Copyright"] = cineon::toString(header.file.copyright, 200);
+                }
+
+                if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.offset[0] << " " << header.source.offset[1];
+                    info.tags["Source Offset"] = ss.str();
+                }
+                if (isValid(&header.source.center[0]) && isValid(&header.source.center[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.center[0] << " " << header.source.center[1];
+                    info.tags["Source Center"] = ss.str();
+                }
+                if (isValid(&header.source.size[0]) && isValid(&header.source.size[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.size[0] << " " << header.source.size[1];
+                    info.tags["Source Size"] = ss.str();
+                }
+                if (cineon::isValid(header.source.file, 100))
+                {
+                    info.tags["Source File"] = cineon::toString(header.source.file, 100);
+                }
+                if (cineon::isValid(header.source.time, 24))
+                {
+                    info.tags["Source Time"] = cineon::toString(header.source.time, 24);
+                }
+                if (cineon::isValid(header.source.inputDevice, 32))
+                {
+                    info.tags["Source Input Device"] = cineon::toString(header.source.inputDevice, 32);
+                }
+                if (cineon::isValid(header.source.inputSerial, 32))
+                {
+                    info.tags["Source Input Serial"] = cineon::toString(header.source.inputSerial, 32);
+                }
+                if (isValid(&header.source.border[0]) && isValid(&header.source.border[1]) &&
+                    isValid(&header.source.border[2]) && isValid(&header.source.border[3]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.border[0] << " ";
+                    ss << header.source.border[1] << " ";
+                    ss << header.source.border[2] << " ";
+                    ss << header.source.border[3];
+                    info.tags["Source Border"] = ss.str();
+                }
+                if (isValid(&header.source.pixelAspect[0]) && isValid(&header.source.pixelAspect[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.pixelAspect[0] << " " << header.source.pixelAspect[1];
+                    info.tags["Source Pixel Aspect"] = ss.str();
+                }
+                if (isValid(&header.source.scanSize[0]) && isValid(&header.source.scanSize[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.source.scanSize[0] << " " << header.source.scanSize[1];
+                    info.tags["Source Scan Size"] = ss.str();
+                }
+
+                if (cineon::isValid(header.film.id, 2) && cineon::isValid(header.film.type, 2) &&
+                    cineon::isValid(header.film.offset, 2) && cineon::isValid(header.film.prefix, 6) &&
+                    cineon::isValid(header.film.count, 4))
+                {
+                    info.tags["Keycode"] = time::keycodeToString(
+                        std::stoi(std::string(header.film.id, 2)),
+                        std::stoi(std::string(header.film.type, 2)),
+                        std::stoi(std::string(header.film.prefix, 6)),
+                        std::stoi(std::string(header.film.count, 4)),
+                        std::stoi(std::string(header.film.offset, 2)));
+                }
+                if (cineon::isValid(header.film.format, 32))
+                {
+                    info.tags["Film Format"] = cineon::toString(header.film.format, 32);
+                }
+                if (isValid(&header.film.frame))
+                {
+                    std::stringstream ss;
+                    ss << header.film.frame;
+                    info.tags["Film Frame"] = ss.str();
+                }
+                if (isValid(&header.film.sequence))
+                {
+                    std::stringstream ss;
+                    ss << header.film.sequence;
+                    info.tags["Film Sequence"] = ss.str();
+                }
+                if (isValid(&header.film.hold))
+                {
+                    std::stringstream ss;
+                    ss << header.film.hold;
+                    info.tags["Film Hold"] = ss.str();
+                }
+                if (isValid(&header.film.frameRate) && header.film.frameRate > _minSpeed)
+                {
+                    std::stringstream ss;
+                    ss << header.film.frameRate;
+                    info.tags["Film Frame Rate"] = ss.str();
+                }
+                if (isValid(&header.film.shutter))
+                {
+                    std::stringstream ss;
+                    ss << header.film.shutter;
+                    info.tags["Film Shutter"] = ss.str();
+                }
+                if (cineon::isValid(header.film.frameId, 32))
+                {
+                    info.tags["Film Frame ID"] = cineon::toString(header.film.frameId, 32);
+                }
+                if (cineon::isValid(header.film.slate, 100))
+                {
+                    info.tags["Film Slate"] = cineon::toString(header.film.slate, 100);
+                }
+
+                if (isValid(&header.tv.timecode))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.timecode;
+                    info.tags["Timecode"] = ss.str();
+                }
+                if (isValid(&header.tv.interlace))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(header.tv.interlace);
+                    info.tags["TV Interlace"] = ss.str();
+                }
+                if (isValid(&header.tv.field))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(header.tv.field);
+                    info.tags["TV Field"] = ss.str();
+                }
+                if (isValid(&header.tv.videoSignal))
+                {
+                    std::stringstream ss;
+                    ss << static_cast<unsigned int>(header.tv.videoSignal);
+                    info.tags["TV Video Signal"] = ss.str();
+                }
+                if (isValid(&header.tv.sampleRate[0]) && isValid(&header.tv.sampleRate[1]))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.sampleRate[0] << " " << header.tv.sampleRate[1];
+                    info.tags["TV Sample Rate"] = ss.str();
+                }
+                if (isValid(&header.tv.frameRate) && header.tv.frameRate > _minSpeed)
+                {
+                    std::stringstream ss;
+                    ss << header.tv.frameRate;
+                    info.tags["TV Frame Rate"] = ss.str();
+                }
+                if (isValid(&header.tv.timeOffset))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.timeOffset;
+                    info.tags["TV Time Offset"] = ss.str();
+                }
+                if (isValid(&header.tv.gamma))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.gamma;
+                    info.tags["TV Gamma"] = ss.str();
+                }
+                if (isValid(&header.tv.blackLevel))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.blackLevel;
+                    info.tags["TV Black Level"] = ss.str();
+                }
+                if (isValid(&header.tv.blackGain))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.blackGain;
+                    info.tags["TV Black Gain"] = ss.str();
+                }
+                if (isValid(&header.tv.breakpoint))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.breakpoint;
+                    info.tags["TV Breakpoint"] = ss.str();
+                }
+                if (isValid(&header.tv.whiteLevel))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.whiteLevel;
+                    info.tags["TV White Level"] = ss.str();
+                }
+                if (isValid(&header.tv.integrationTimes))
+                {
+                    std::stringstream ss;
+                    ss << header.tv.integrationTimes;
+                    info.tags["TV Integration Times"] = ss.str();
+                }
+            }
         }
 
         Header read(
@@ -334,212 +544,7 @@ namespace tl
             info.video.push_back(imageInfo);
 
             // Tags.
-            if (cineon::isValid(out.file.time, 24))
-            {
-                info.tags["Time"] = cineon::toString(out.file.time, 24);
-            }
-            if (cineon::isValid(out.file.creator, 100))
-            {
-                info.tags["Creator"] = cineon::toString(out.file.creator, 100);
-            }
-            if (cineon::isValid(out.file.project, 200))
-            {
-                info.tags["Project"] = cineon::toString(out.file.project, 200);
-            }
-            if (cineon::isValid(out.file.copyright, 200))
-            {
-                info.tags["Copyright"] = cineon::toString(out.file.copyright, 200);
-            }
-
-            if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.offset[0] << " " << out.source.offset[1];
-                info.tags["Source Offset"] = ss.str();
-            }
-            if (isValid(&out.source.center[0]) && isValid(&out.source.center[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.center[0] << " " << out.source.center[1];
-                info.tags["Source Center"] = ss.str();
-            }
-            if (isValid(&out.source.size[0]) && isValid(&out.source.size[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.size[0] << " " << out.source.size[1];
-                info.tags["Source Size"] = ss.str();
-            }
-            if (cineon::isValid(out.source.file, 100))
-            {
-                info.tags["Source File"] = cineon::toString(out.source.file, 100);
-            }
-            if (cineon::isValid(out.source.time, 24))
-            {
-                info.tags["Source Time"] = cineon::toString(out.source.time, 24);
-            }
-            if (cineon::isValid(out.source.inputDevice, 32))
-            {
-                info.tags["Source Input Device"] = cineon::toString(out.source.inputDevice, 32);
-            }
-            if (cineon::isValid(out.source.inputSerial, 32))
-            {
-                info.tags["Source Input Serial"] = cineon::toString(out.source.inputSerial, 32);
-            }
-            if (isValid(&out.source.border[0]) && isValid(&out.source.border[1]) &&
-                isValid(&out.source.border[2]) && isValid(&out.source.border[3]))
-            {
-                std::stringstream ss;
-                ss << out.source.border[0] << " ";
-                ss << out.source.border[1] << " ";
-                ss << out.source.border[2] << " ";
-                ss << out.source.border[3];
-                info.tags["Source Border"] = ss.str();
-            }
-            if (isValid(&out.source.pixelAspect[0]) && isValid(&out.source.pixelAspect[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.pixelAspect[0] << " " << out.source.pixelAspect[1];
-                info.tags["Source Pixel Aspect"] = ss.str();
-            }
-            if (isValid(&out.source.scanSize[0]) && isValid(&out.source.scanSize[1]))
-            {
-                std::stringstream ss;
-                ss << out.source.scanSize[0] << " " << out.source.scanSize[1];
-                info.tags["Source Scan Size"] = ss.str();
-            }
-
-            if (cineon::isValid(out.film.id, 2) && cineon::isValid(out.film.type, 2) &&
-                cineon::isValid(out.film.offset, 2) && cineon::isValid(out.film.prefix, 6) &&
-                cineon::isValid(out.film.count, 4))
-            {
-                info.tags["Keycode"] = time::keycodeToString(
-                    std::stoi(std::string(out.film.id, 2)),
-                    std::stoi(std::string(out.film.type, 2)),
-                    std::stoi(std::string(out.film.prefix, 6)),
-                    std::stoi(std::string(out.film.count, 4)),
-                    std::stoi(std::string(out.film.offset, 2)));
-            }
-            if (cineon::isValid(out.film.format, 32))
-            {
-                info.tags["Film Format"] = cineon::toString(out.film.format, 32);
-            }
-            if (isValid(&out.film.frame))
-            {
-                std::stringstream ss;
-                ss << out.film.frame;
-                info.tags["Film Frame"] = ss.str();
-            }
-            if (isValid(&out.film.sequence))
-            {
-                std::stringstream ss;
-                ss << out.film.sequence;
-                info.tags["Film Sequence"] = ss.str();
-            }
-            if (isValid(&out.film.hold))
-            {
-                std::stringstream ss;
-                ss << out.film.hold;
-                info.tags["Film Hold"] = ss.str();
-            }
-            if (isValid(&out.film.frameRate) && out.film.frameRate > _minSpeed)
-            {
-                std::stringstream ss;
-                ss << out.film.frameRate;
-                info.tags["Film Frame Rate"] = ss.str();
-            }
-            if (isValid(&out.film.shutter))
-            {
-                std::stringstream ss;
-                ss << out.film.shutter;
-                info.tags["Film Shutter"] = ss.str();
-            }
-            if (cineon::isValid(out.film.frameId, 32))
-            {
-                info.tags["Film Frame ID"] = cineon::toString(out.film.frameId, 32);
-            }
-            if (cineon::isValid(out.film.slate, 100))
-            {
-                info.tags["Film Slate"] = cineon::toString(out.film.slate, 100);
-            }
-
-            if (isValid(&out.tv.timecode))
-            {
-                std::stringstream ss;
-                ss << out.tv.timecode;
-                info.tags["Timecode"] = ss.str();
-            }
-            if (isValid(&out.tv.interlace))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.interlace);
-                info.tags["TV Interlace"] = ss.str();
-            }
-            if (isValid(&out.tv.field))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.field);
-                info.tags["TV Field"] = ss.str();
-            }
-            if (isValid(&out.tv.videoSignal))
-            {
-                std::stringstream ss;
-                ss << static_cast<unsigned int>(out.tv.videoSignal);
-                info.tags["TV Video Signal"] = ss.str();
-            }
-            if (isValid(&out.tv.sampleRate[0]) && isValid(&out.tv.sampleRate[1]))
-            {
-                std::stringstream ss;
-                ss << out.tv.sampleRate[0] << " " << out.tv.sampleRate[1];
-                info.tags["TV Sample Rate"] = ss.str();
-            }
-            if (isValid(&out.tv.frameRate) && out.tv.frameRate > _minSpeed)
-            {
-                std::stringstream ss;
-                ss << out.tv.frameRate;
-                info.tags["TV Frame Rate"] = ss.str();
-            }
-            if (isValid(&out.tv.timeOffset))
-            {
-                std::stringstream ss;
-                ss << out.tv.timeOffset;
-                info.tags["TV Time Offset"] = ss.str();
-            }
-            if (isValid(&out.tv.gamma))
-            {
-                std::stringstream ss;
-                ss << out.tv.gamma;
-                info.tags["TV Gamma"] = ss.str();
-            }
-            if (isValid(&out.tv.blackLevel))
-            {
-                std::stringstream ss;
-                ss << out.tv.blackLevel;
-                info.tags["TV Black Level"] = ss.str();
-            }
-            if (isValid(&out.tv.blackGain))
-            {
-                std::stringstream ss;
-                ss << out.tv.blackGain;
-                info.tags["TV Black Gain"] = ss.str();
-            }
-            if (isValid(&out.tv.breakpoint))
-            {
-                std::stringstream ss;
-                ss << out.tv.breakpoint;
-                info.tags["TV Breakpoint"] = ss.str();
-            }
-            if (isValid(&out.tv.whiteLevel))
-            {
-                std::stringstream ss;
-                ss << out.tv.whiteLevel;
-                info.tags["TV White Level"] = ss.str();
-            }
-            if (isValid(&out.tv.integrationTimes))
-            {
-                std::stringstream ss;
-                ss << out.tv.integrationTimes;
-                info.tags["TV Integration Times"] = ss.str();
-            }
+            readTags(out, info);
 
             // Set the file position.
             if (out.file.imageOffset)
@@ -550,6 +555,63 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<io::FrameTemplate> createTemplate(
+            const std::shared_ptr<file::FileIO>& io,
+            const io::Info& info)
+        {
+            auto out = std::make_shared<io::FrameTemplate>();
+            const size_t pos = io->getPos();
+            out->header.resize(sizeof(Header::File) + sizeof(Header::Image));
+            io->setPos(0);
+            io->read(out->header.data(), out->header.size());
+            io->setPos(pos);
+            out->fileSize = io->getSize();
+            out->dataOffset = pos;
+            out->endianConversion = io->hasEndianConversion();
+            out->info = info.video[0];
+            return out;
+        }
+
+        bool readTemplate(
+            const std::shared_ptr<file::FileIO>& io,
+            const io::FrameTemplate& frameTemplate,
+            io::Info& info)
+        {
+            bool out = false;
+            if (io->getSize() == frameTemplate.fileSize &&
+                frameTemplate.header.size() == sizeof(Header::File) + sizeof(Header::Image))
+            {
+                Header header;
+                io->read(&header.file, sizeof(Header::File));
+                io->read(&header.image, sizeof(Header::Image));
+
+                // Compare the magic number, image offset, and image section
+                // with the template.
+                const uint8_t* p = frameTemplate.header.data();
+                if (0 == memcmp(&header.file, p, 8) &&
+                    0 == memcmp(&header.image, p + sizeof(Header::File), sizeof(Header::Image)))
+                {
+                    io->read(&header.source, sizeof(Header::Source));
+                    io->read(&header.film, sizeof(Header::Film));
+                    io->read(&header.tv, sizeof(Header::TV));
+                    if (frameTemplate.endianConversion)
+                    {
+                        io->setEndianConversion(true);
+                        convertEndian(header);
+                    }
+                    info.video.push_back(frameTemplate.info);
+                    readTags(header, info);
+                    io->setPos(frameTemplate.dataOffset);
+                    out = true;
+                }
+                else
+                {
+                    io->setPos(0);
+                }
+            }
+            return out;
+        }
+
         void write(
             const std::shared_ptr<file::FileIO>& io,
             const io::Info& info,
@@ -91,10 +91,18 @@ namespace tl
 
             auto io = memory ?
                 file::FileIO::create(fileName, *memory) :
-                file::FileIO::create(fileName, file::Mode::Read);
+                _openFile(fileName);
             io::Info info;
-            Transfer transfer = Transfer::User;
-            read(io, info, transfer);
+            const auto frameTemplate = _getFrameTemplate();
+            if (!frameTemplate || !readTemplate(io, *frameTemplate, info))
+            {
+                Transfer transfer = Transfer::User;
+                read(io, info, transfer);
+                if (!frameTemplate)
+                {
+                    _setFrameTemplate(createTemplate(io, info));
+                }
+            }
 
             out.image = image::Image::create(info.video[0]);
             out.image->setTags(info.tags);
@@ -69,6 +69,19 @@ namespace tl
         //! Get a label for a FFmpeg error code.
         std::string getErrorLabel(int);
 
+        //! Concatenate movie files without re-encoding them. The files must
+        //! have the same streams with the same codec parameters and codec
+        //! extradata, for example segments written with the same profile.
+        //!
+        //! Each file starts at the end of the previous file. If the decode
+        //! timestamps of a file would overlap the previous file, for example
+        //! with B-frames, the file is moved later so the decode timestamps
+        //! keep increasing.
+        //!
+        //! Throws:
+        //! - std::exception
+        void concatenate(const std::vector<std::string>& inputs, const std::string& output);
+
         //! FFmpeg reader
         class Read : public io::IRead
         {
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/FFmpeg.h>
+
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tl
+{
+    namespace ffmpeg
+    {
+        namespace
+        {
+            struct InputContext
+            {
+                ~InputContext()
+                {
+                    if (p)
+                    {
+                        avformat_close_input(&p);
+                    }
+                }
+
+                AVFormatContext* p = nullptr;
+            };
+
+            struct OutputContext
+            {
+                ~OutputContext()
+                {
+                    if (p)
+                    {
+                        if (headerWritten)
+                        {
+                            av_write_trailer(p);
+                        }
+                        if (p->pb)
+                        {
+                            avio_closep(&p->pb);
+                        }
+                        avformat_free_context(p);
+                    }
+                }
+
+                AVFormatContext* p = nullptr;
+                bool headerWritten = false;
+            };
+        }
+
+        void concatenate(const std::vector<std::string>& inputs, const std::string& output)
+        {
+            if (inputs.empty())
+            {
+                throw std::runtime_error(string::Format("{0}: No input files").arg(output));
+            }
+
+            OutputContext outputContext;
+            int r = avformat_alloc_output_context2(&outputContext.p, NULL, NULL, output.c_str());
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").arg(output).arg(getErrorLabel(r)));
+            }
+
+            // Each file is offset by the end of the previous files, in the
+            // time base of the output streams.
+            std::vector<int64_t> offsets;
+            std::vector<int64_t> ends;
+            std::vector<int64_t> lastDts;
+            for (const auto& input : inputs)
+            {
+                InputContext inputContext;
+                r = avformat_open_input(&inputContext.p, input.c_str(), NULL, NULL);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").arg(input).arg(getErrorLabel(r)));
+                }
+                r = avformat_find_stream_info(inputContext.p, NULL);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").arg(input).arg(getErrorLabel(r)));
+                }
+
+                if (!outputContext.headerWritten)
+                {
+                    // Copy the streams from the first file.
+                    for (unsigned int i = 0; i < inputContext.p->nb_streams; ++i)
+                    {
+                        const AVStream* inputStream = inputContext.p->streams[i];
+                        AVStream* outputStream = avformat_new_stream(outputContext.p, NULL);
+                        if (!outputStream)
+                        {
+                            throw std::runtime_error(string::Format("{0}: Cannot allocate stream").arg(output));
+                        }
+                        r = avcodec_parameters_copy(outputStream->codecpar, inputStream->codecpar);
+                        if (r < 0)
+                        {
+                            throw std::runtime_error(string::Format("{0}: {1}").arg(output).arg(getErrorLabel(r)));
+                        }
+                        outputStream->codecpar->codec_tag = 0;
+                        outputStream->time_base = inputStream->time_base;
+                        outputStream->avg_frame_rate = inputStream->avg_frame_rate;
+                        av_dict_copy(&outputStream->metadata, inputStream->metadata, 0);
+                    }
+                    av_dict_copy(&outputContext.p->metadata, inputContext.p->metadata, 0);
+                    if (!(outputContext.p->oformat->flags & AVFMT_NOFILE))
+                    {
+                        r = avio_open(&outputContext.p->pb, output.c_str(), AVIO_FLAG_WRITE);
+                        if (r < 0)
+                        {
+                            throw std::runtime_error(string::Format("{0}: {1}").arg(output).arg(getErrorLabel(r)));
+                        }
+                    }
+                    r = avformat_write_header(outputContext.p, NULL);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").arg(output).arg(getErrorLabel(r)));
+                    }
+                    outputContext.headerWritten = true;
+                    offsets.resize(outputContext.p->nb_streams, 0);
+                    ends.resize(outputContext.p->nb_streams, 0);
+                    lastDts.resize(outputContext.p->nb_streams, AV_NOPTS_VALUE);
+                }
+                else if (inputContext.p->nb_streams != outputContext.p->nb_streams)
+                {
+                    throw std::runtime_error(string::Format("{0}: Incompatible streams").arg(input));
+                }
+                else
+                {
+                    // The output only has the codec extradata of the first
+                    // file, so the other files must have the same extradata.
+                    for (unsigned int i = 0; i < inputContext.p->nb_streams; ++i)
+                    {
+                        const AVCodecParameters* a = inputContext.p->streams[i]->codecpar;
+                        const AVCodecParameters* b = outputContext.p->streams[i]->codecpar;
+                        if (a->codec_type != b->codec_type ||
+                            a->codec_id != b->codec_id ||
+                            a->width != b->width ||
+                            a->height != b->height ||
+                            a->format != b->format ||
+                            a->extradata_size != b->extradata_size ||
+                            (a->extradata_size > 0 &&
+                                memcmp(a->extradata, b->extradata, a->extradata_size) != 0))
+                        {
+                            throw std::runtime_error(string::Format("{0}: Incompatible streams").arg(input));
+                        }
+                    }
+                }
+
+                // Copy the packets. With B-frames the decode timestamps
+                // start before the presentation timestamps, so they can
+                // overlap the end of the previous file. In that case the
+                // offset is increased to keep the decode timestamps
+                // increasing.
+                Packet packet;
+                while (av_read_frame(inputContext.p, packet.p) >= 0)
+                {
+                    const int index = packet.p->stream_index;
+                    av_packet_rescale_ts(
+                        packet.p,
+                        inputContext.p->streams[index]->time_base,
+                        outputContext.p->streams[index]->time_base);
+                    if (packet.p->dts != AV_NOPTS_VALUE &&
+                        lastDts[index] != AV_NOPTS_VALUE &&
+                        packet.p->dts + offsets[index] <= lastDts[index])
+                    {
+                        offsets[index] = lastDts[index] + 1 - packet.p->dts;
+                    }
+                    if (packet.p->pts != AV_NOPTS_VALUE)
+                    {
+                        packet.p->pts += offsets[index];
+                    }
+                    if (packet.p->dts != AV_NOPTS_VALUE)
+                    {
+                        packet.p->dts += offsets[index];
+                        lastDts[index] = packet.p->dts;
+                    }
+                    const int64_t t = packet.p->pts != AV_NOPTS_VALUE ? packet.p->pts : packet.p->dts;
+                    if (t != AV_NOPTS_VALUE)
+                    {
+                        ends[index] = std::max(ends[index], t + packet.p->duration);
+                    }
+                    packet.p->pos = -1;
+                    r = av_interleaved_write_frame(outputContext.p, packet.p);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot write frame").arg(output));
+                    }
+                    av_packet_unref(packet.p);
+                }
+                offsets = ends;
+            }
+        }
+    }
+}
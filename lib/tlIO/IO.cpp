@@ -84,6 +84,9 @@ namespace tl
             return std::future<AudioData>();
         }
 
+        void IRead::prefetch(const otime::TimeRange&)
+        {}
+
         void IWrite::_init(
             const file::Path& path,
             const Options& options,
@@ -100,6 +103,11 @@ namespace tl
         IWrite::~IWrite()
         {}
 
+        void IWrite::writeAudio(
+            const otime::TimeRange&,
+            const std::shared_ptr<audio::Audio>&)
+        {}
+
         struct IPlugin::Private
         {
             std::string name;
@@ -147,6 +155,11 @@ namespace tl
             _options = options;
         }
 
+        bool IPlugin::canWriteAudio() const
+        {
+            return false;
+        }
+
         bool IPlugin::_isWriteCompatible(const image::Info& info, const Options& options) const
         {
             return info.pixelType != image::PixelType::None && info == getWriteInfo(info, options);
@@ -148,6 +148,11 @@ namespace tl
             //! Read audio data.
             virtual std::future<AudioData> readAudio(const otime::TimeRange&);
 
+            //! Hint that video in the given time range will be read soon.
+            //! Readers may use this to prefetch data; the default
+            //! implementation does nothing.
+            virtual void prefetch(const otime::TimeRange&);
+
             //! Cancel pending requests.
             virtual void cancelRequests() = 0;
 
@@ -175,6 +180,11 @@ namespace tl
                 const otime::RationalTime&,
                 const std::shared_ptr<image::Image>&) = 0;
 
+            //! Write audio data. The default implementation does nothing.
+            virtual void writeAudio(
+                const otime::TimeRange&,
+                const std::shared_ptr<audio::Audio>&);
+
         protected:
             Info _info;
         };
@@ -223,6 +233,9 @@ namespace tl
                 const image::Info&,
                 const Options& = Options()) const = 0;
 
+            //! Get whether the writers support audio.
+            virtual bool canWriteAudio() const;
+
             //! Create a writer for the given path.
             virtual std::shared_ptr<IWrite> write(
                 const file::Path&,
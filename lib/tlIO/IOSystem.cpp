@@ -7,6 +7,7 @@
 #include <tlIO/Cineon.h>
 #include <tlIO/DPX.h>
 #include <tlIO/PPM.h>
+#include <tlIO/Raw.h>
 #include <tlIO/SGI.h>
 #if defined(TLRENDER_STB)
 #include <tlIO/STB.h>
@@ -51,6 +52,7 @@ namespace tl
                 _plugins.push_back(cineon::Plugin::create(logSystem));
                 _plugins.push_back(dpx::Plugin::create(logSystem));
                 _plugins.push_back(ppm::Plugin::create(logSystem));
+                _plugins.push_back(raw::Plugin::create(logSystem));
                 _plugins.push_back(sgi::Plugin::create(logSystem));
 #if defined(TLRENDER_STB)
                 _plugins.push_back(stb::Plugin::create(logSystem));
@@ -107,12 +107,19 @@ namespace tl
         Channel fromImf(const std::string& name, const Imf::Channel&);
 
         //! Input stream.
+        //!
+        //! The stream is memory mapped when the file can be memory mapped
+        //! or when it is created from memory, in which case OpenEXR reads
+        //! the chunk data directly from the mapping without copying it.
         class IStream : public Imf::IStream
         {
             TLRENDER_NON_COPYABLE(IStream);
 
         public:
-            IStream(const std::string& fileName);
+            IStream(
+                const std::string& fileName,
+                file::ReadType = file::ReadType::Normal);
+            IStream(const std::string& fileName, const std::shared_ptr<file::FileIO>&);
             IStream(const std::string& fileName, const uint8_t*, size_t);
 
             virtual ~IStream();
@@ -26,13 +26,23 @@ namespace tl
             uint64_t pos = 0;
         };
 
-        IStream::IStream(const std::string& fileName) :
+        IStream::IStream(const std::string& fileName, file::ReadType readType) :
             Imf::IStream(fileName.c_str()),
             _p(new Private)
         {
             TLRENDER_P();
-            p.f = file::FileIO::create(fileName, file::Mode::Read);
-            p.p = p.f->getMemoryP();
+            p.f = file::FileIO::create(fileName, file::Mode::Read, readType);
+            p.p = p.f->getMemoryStart();
+            p.size = p.f->getSize();
+        }
+
+        IStream::IStream(const std::string& fileName, const std::shared_ptr<file::FileIO>& f) :
+            Imf::IStream(fileName.c_str()),
+            _p(new Private)
+        {
+            TLRENDER_P();
+            p.f = f;
+            p.p = p.f->getMemoryStart();
             p.size = p.f->getSize();
         }
 
@@ -56,23 +66,21 @@ namespace tl
         char* IStream::readMemoryMapped(int n)
         {
             TLRENDER_P();
-            if (p.pos >= p.size || (p.pos + n) > p.size)
+            if (!p.p || n < 0 || (p.pos + n) > p.size)
             {
                 throw std::runtime_error(string::Format("{0}: Error reading file").arg(fileName()));
             }
-            char* out = nullptr;
-            if (p.p)
-            {
-                out = const_cast<char*>(reinterpret_cast<const char*>(p.p)) + p.pos;
-                p.pos += n;
-            }
+            // Return a pointer directly into the memory map, OpenEXR only
+            // reads from it.
+            char* out = const_cast<char*>(reinterpret_cast<const char*>(p.p)) + p.pos;
+            p.pos += n;
             return out;
         }
 
         bool IStream::read(char c[], int n)
         {
             TLRENDER_P();
-            if (p.pos >= p.size || (p.pos + n) > p.size)
+            if (n < 0 || (p.pos + n) > p.size)
             {
                 throw std::runtime_error(string::Format("{0}: Error reading file").arg(fileName()));
             }
@@ -96,7 +104,7 @@ namespace tl
         void IStream::seekg(uint64_t pos)
         {
             TLRENDER_P();
-            if (p.f)
+            if (!p.p && p.f)
             {
                 p.f->setPos(pos);
             }
@@ -141,7 +149,8 @@ namespace tl
                     const std::string& fileName,
                     const file::MemoryRead* memory,
                     ChannelGrouping channelGrouping,
-                    const std::weak_ptr<log::System>& logSystemWeak)
+                    const std::weak_ptr<log::System>& logSystemWeak,
+                    const std::shared_ptr<file::FileIO>& io = nullptr)
                 {
                     // Open the file.
                     // \bug https://lists.aswf.io/g/openexr-dev/message/43
@@ -149,6 +158,10 @@ namespace tl
                     {
                         _s.reset(new IStream(fileName.c_str(), memory->p, memory->size));
                     }
+                    else if (io)
+                    {
+                        _s.reset(new IStream(fileName.c_str(), io));
+                    }
                     else
                     {
                         _s.reset(new IStream(fileName.c_str()));
@@ -387,7 +400,12 @@ namespace tl
             const otime::RationalTime& time,
             uint16_t layer)
         {
-            return File(fileName, memory, _channelGrouping, _logSystem).read(fileName, time, layer);
+            return File(
+                fileName,
+                memory,
+                _channelGrouping,
+                _logSystem,
+                memory ? nullptr : _openFile(fileName)).read(fileName, time, layer);
         }
     }
 }
@@ -15,11 +15,23 @@ namespace tl
             class File
             {
             public:
-                File(const std::string& fileName, const file::MemoryRead* memory)
+                File(
+                    const std::string& fileName,
+                    const file::MemoryRead* memory,
+                    const std::shared_ptr<file::FileIO>& io = nullptr)
                 {
-                    _io = memory ?
-                        file::FileIO::create(fileName, *memory) :
-                        file::FileIO::create(fileName, file::Mode::Read);
+                    if (memory)
+                    {
+                        _io = file::FileIO::create(fileName, *memory);
+                    }
+                    else if (io)
+                    {
+                        _io = io;
+                    }
+                    else
+                    {
+                        _io = file::FileIO::create(fileName, file::Mode::Read);
+                    }
 
                     char magic[] = { 0, 0, 0 };
                     _io->read(magic, 2);
@@ -193,7 +205,10 @@ namespace tl
             const otime::RationalTime& time,
             uint16_t layer)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(
+                fileName,
+                memory,
+                memory ? nullptr : _openFile(fileName)).read(fileName, time);
         }
     }
 }
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/Raw.h>
+
+#include <tlCore/StringFormat.h>
+
+namespace tl
+{
+    namespace raw
+    {
+        Plugin::Plugin()
+        {}
+
+        std::shared_ptr<Plugin> Plugin::create(const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<Plugin>(new Plugin);
+            out->_init(
+                "Raw",
+                { { ".tlraw", io::FileType::Movie } },
+                logSystem);
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> Plugin::read(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return Read::create(path, io::merge(options, _options), _logSystem);
+        }
+
+        std::shared_ptr<io::IRead> Plugin::read(
+            const file::Path& path,
+            const std::vector<file::MemoryRead>& memory,
+            const io::Options& options)
+        {
+            return Read::create(path, memory, io::merge(options, _options), _logSystem);
+        }
+
+        image::Info Plugin::getWriteInfo(
+            const image::Info& info,
+            const io::Options& options) const
+        {
+            return info;
+        }
+
+        bool Plugin::canWriteAudio() const
+        {
+            return true;
+        }
+
+        std::shared_ptr<io::IWrite> Plugin::write(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options)
+        {
+            if (!info.video.empty() && !_isWriteCompatible(info.video[0], options))
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(path.get()).
+                    arg("Unsupported video"));
+            return Write::create(path, info, io::merge(options, _options), _logSystem);
+        }
+    }
+}
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/IO.h>
+
+namespace tl
+{
+    //! Raw frame store I/O.
+    //!
+    //! A raw frame store is a single file containing uncompressed video
+    //! frames, audio, and an index. Frames are aligned so that they can be
+    //! memory mapped and passed on without any copying or parsing. Each
+    //! frame is mapped copy-on-write, so the frames can be modified without
+    //! changing the file.
+    //!
+    //! File layout:
+    //! - Header
+    //! - Video frames and audio chunks, each aligned to frameAlignment
+    //! - Video frame offset table, one entry per frame (zero if the frame
+    //!   is missing)
+    //! - Audio chunk table
+    //!
+    //! All values are stored with the byte order of the machine that
+    //! wrote the file.
+    namespace raw
+    {
+        //! File magic number.
+        const char magic[8] = { 't', 'l', 'R', 'a', 'w', 0, 0, 0 };
+
+        //! File version.
+        const uint32_t version = 1;
+
+        //! Alignment of the video frames and audio chunks.
+        const size_t frameAlignment = 4096;
+
+        //! File header. The header is written as is, so every byte is an
+        //! explicit member and there is no padding.
+        struct Header
+        {
+            char     magic[8] = {};
+            uint32_t version = 0;
+            uint32_t endian = 0;
+
+            uint32_t videoWidth = 0;
+            uint32_t videoHeight = 0;
+            float    videoPixelAspectRatio = 1.F;
+            uint32_t videoPixelType = 0;
+            uint32_t videoLevels = 0;
+            uint32_t videoYUVCoefficients = 0;
+            uint8_t  videoMirrorX = 0;
+            uint8_t  videoMirrorY = 0;
+            uint8_t  videoAlignment = 1;
+            uint8_t  videoEndian = 0;
+            uint8_t  reserved[4] = {};
+            double   videoRate = 0.0;
+            int64_t  videoStartFrame = 0;
+            uint64_t videoFrameCount = 0;
+            uint64_t videoFrameByteCount = 0;
+            uint64_t videoIndexOffset = 0;
+
+            uint32_t audioChannelCount = 0;
+            uint32_t audioDataType = 0;
+            uint64_t audioSampleRate = 0;
+            uint64_t audioChunkCount = 0;
+            uint64_t audioIndexOffset = 0;
+        };
+        static_assert(sizeof(Header) == 120, "Unexpected raw header padding");
+
+        //! Audio chunk table entry.
+        struct AudioChunk
+        {
+            int64_t  start = 0;
+            uint64_t sampleCount = 0;
+            uint64_t offset = 0;
+        };
+        static_assert(sizeof(AudioChunk) == 24, "Unexpected raw audio chunk padding");
+
+        //! Raw frame store reader.
+        class Read : public io::IRead
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const std::vector<file::MemoryRead>&,
+                const io::Options&,
+                const std::weak_ptr<log::System>&);
+
+            Read();
+
+        public:
+            virtual ~Read();
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const io::Options&,
+                const std::weak_ptr<log::System>&);
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const std::vector<file::MemoryRead>&,
+                const io::Options&,
+                const std::weak_ptr<log::System>&);
+
+            std::future<io::Info> getInfo() override;
+            std::future<io::VideoData> readVideo(const otime::RationalTime&, uint16_t layer = 0) override;
+            std::future<io::AudioData> readAudio(const otime::TimeRange&) override;
+            void cancelRequests() override;
+
+        private:
+            void _open();
+            std::shared_ptr<file::FileIO> _openFile(const std::string& fileName) const;
+            io::VideoData _readVideo(const otime::RationalTime&);
+            io::AudioData _readAudio(const otime::TimeRange&);
+
+            TLRENDER_PRIVATE();
+        };
+
+        //! Raw frame store writer.
+        class Write : public io::IWrite
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const io::Info&,
+                const io::Options&,
+                const std::weak_ptr<log::System>&);
+
+            Write();
+
+        public:
+            virtual ~Write();
+
+            //! Create a new writer.
+            static std::shared_ptr<Write> create(
+                const file::Path&,
+                const io::Info&,
+                const io::Options&,
+                const std::weak_ptr<log::System>&);
+
+            void writeVideo(
+                const otime::RationalTime&,
+                const std::shared_ptr<image::Image>&) override;
+            void writeAudio(
+                const otime::TimeRange&,
+                const std::shared_ptr<audio::Audio>&) override;
+
+        private:
+            void _align();
+            void _finish();
+
+            TLRENDER_PRIVATE();
+        };
+
+        //! Raw frame store plugin.
+        class Plugin : public io::IPlugin
+        {
+        protected:
+            Plugin();
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<Plugin> create(const std::weak_ptr<log::System>&);
+
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const io::Options& = io::Options()) override;
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const std::vector<file::MemoryRead>&,
+                const io::Options& = io::Options()) override;
+            image::Info getWriteInfo(
+                const image::Info&,
+                const io::Options& = io::Options()) const override;
+            bool canWriteAudio() const override;
+            std::shared_ptr<io::IWrite> write(
+                const file::Path&,
+                const io::Info&,
+                const io::Options& = io::Options()) override;
+        };
+    }
+}
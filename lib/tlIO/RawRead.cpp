@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/Raw.h>
+
+#include <tlCore/LogSystem.h>
+#include <tlCore/StringFormat.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace tl
+{
+    namespace raw
+    {
+        struct Read::Private
+        {
+            std::shared_ptr<file::FileIO> io;
+            Header header;
+            std::vector<uint64_t> videoIndex;
+            std::vector<AudioChunk> audioIndex;
+            io::Info info;
+            std::mutex mutex;
+        };
+
+        void Read::_init(
+            const file::Path& path,
+            const std::vector<file::MemoryRead>& memory,
+            const io::Options& options,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            IRead::_init(path, memory, options, logSystem);
+            try
+            {
+                _open();
+            }
+            catch (const std::exception& e)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::raw::Read ({0}: {1})").
+                        arg(__FILE__).
+                        arg(__LINE__);
+                    logSystem->print(id, string::Format("{0}: {1}").
+                        arg(_path.get()).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+        }
+
+        Read::Read() :
+            _p(new Private)
+        {}
+
+        Read::~Read()
+        {}
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, {}, options, logSystem);
+            return out;
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const std::vector<file::MemoryRead>& memory,
+            const io::Options& options,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, memory, options, logSystem);
+            return out;
+        }
+
+        std::future<io::Info> Read::getInfo()
+        {
+            std::promise<io::Info> promise;
+            promise.set_value(_p->info);
+            return promise.get_future();
+        }
+
+        std::future<io::VideoData> Read::readVideo(
+            const otime::RationalTime& time,
+            uint16_t layer)
+        {
+            std::promise<io::VideoData> promise;
+            io::VideoData videoData;
+            videoData.time = time;
+            videoData.layer = layer;
+            try
+            {
+                videoData = _readVideo(time);
+            }
+            catch (const std::exception& e)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::raw::Read ({0}: {1})").
+                        arg(__FILE__).
+                        arg(__LINE__);
+                    logSystem->print(id, string::Format("{0}: {1}").
+                        arg(_path.get()).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+            promise.set_value(videoData);
+            return promise.get_future();
+        }
+
+        std::future<io::AudioData> Read::readAudio(const otime::TimeRange& timeRange)
+        {
+            std::promise<io::AudioData> promise;
+            io::AudioData audioData;
+            audioData.time = timeRange.start_time();
+            try
+            {
+                audioData = _readAudio(timeRange);
+            }
+            catch (const std::exception& e)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::raw::Read ({0}: {1})").
+                        arg(__FILE__).
+                        arg(__LINE__);
+                    logSystem->print(id, string::Format("{0}: {1}").
+                        arg(_path.get()).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+            promise.set_value(audioData);
+            return promise.get_future();
+        }
+
+        void Read::cancelRequests()
+        {}
+
+        void Read::_open()
+        {
+            TLRENDER_P();
+            const std::string fileName = _path.get();
+            p.io = !_memory.empty() ?
+                file::FileIO::create(fileName, _memory[0]) :
+                _openFile(fileName);
+
+            // Read the header.
+            if (p.io->getSize() < sizeof(Header))
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(fileName).
+                    arg("Incomplete file"));
+            }
+            p.io->read(&p.header, sizeof(Header));
+            if (memcmp(p.header.magic, magic, sizeof(magic)) != 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(fileName).
+                    arg("Bad magic number"));
+            }
+            if (p.header.version != version)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(fileName).
+                    arg("Unsupported version"));
+            }
+            if (p.header.endian != static_cast<uint32_t>(memory::getEndian()))
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(fileName).
+                    arg("Unsupported byte order"));
+            }
+
+            // Read the video information and index. The values from the
+            // header are checked before they are used, so a corrupt file
+            // is rejected instead of producing invalid information.
+            io::Info info;
+            const size_t fileSize = p.io->getSize();
+            if (p.header.videoFrameCount > 0)
+            {
+                if (p.header.videoPixelType == static_cast<uint32_t>(image::PixelType::None) ||
+                    p.header.videoPixelType >= static_cast<uint32_t>(image::PixelType::Count) ||
+                    p.header.videoLevels >= static_cast<uint32_t>(image::VideoLevels::Count) ||
+                    p.header.videoYUVCoefficients >= static_cast<uint32_t>(image::YUVCoefficients::Count) ||
+                    p.header.videoEndian >= static_cast<uint8_t>(memory::Endian::Count) ||
+                    0 == p.header.videoAlignment ||
+                    !(p.header.videoRate > 0.0) ||
+                    !std::isfinite(p.header.videoRate) ||
+                    p.header.videoIndexOffset > fileSize ||
+                    p.header.videoFrameCount > (fileSize - p.header.videoIndexOffset) / sizeof(uint64_t))
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(fileName).
+                        arg("Unsupported video"));
+                }
+                image::Info imageInfo;
+                imageInfo.size.w = p.header.videoWidth;
+                imageInfo.size.h = p.header.videoHeight;
+                imageInfo.size.pixelAspectRatio = p.header.videoPixelAspectRatio;
+                imageInfo.pixelType = static_cast<image::PixelType>(p.header.videoPixelType);
+                imageInfo.videoLevels = static_cast<image::VideoLevels>(p.header.videoLevels);
+                imageInfo.yuvCoefficients = static_cast<image::YUVCoefficients>(p.header.videoYUVCoefficients);
+                imageInfo.layout.mirror.x = p.header.videoMirrorX;
+                imageInfo.layout.mirror.y = p.header.videoMirrorY;
+                imageInfo.layout.alignment = p.header.videoAlignment;
+                imageInfo.layout.endian = static_cast<memory::Endian>(p.header.videoEndian);
+                if (image::getDataByteCount(imageInfo) != p.header.videoFrameByteCount)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(fileName).
+                        arg("Unsupported video"));
+                }
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(p.header.videoStartFrame, p.header.videoRate),
+                    otime::RationalTime(p.header.videoFrameCount, p.header.videoRate));
+
+                p.videoIndex.resize(p.header.videoFrameCount);
+                p.io->setPos(p.header.videoIndexOffset);
+                p.io->read(p.videoIndex.data(), p.videoIndex.size() * sizeof(uint64_t));
+                for (const auto offset : p.videoIndex)
+                {
+                    if (offset > 0 &&
+                        (offset > fileSize || p.header.videoFrameByteCount > fileSize - offset))
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").
+                            arg(fileName).
+                            arg("Incomplete file"));
+                    }
+                }
+            }
+
+            // Read the audio information and index.
+            if (p.header.audioChunkCount > 0)
+            {
+                if (0 == p.header.audioChannelCount ||
+                    p.header.audioChannelCount > std::numeric_limits<uint8_t>::max() ||
+                    p.header.audioDataType == static_cast<uint32_t>(audio::DataType::None) ||
+                    p.header.audioDataType >= static_cast<uint32_t>(audio::DataType::Count) ||
+                    0 == p.header.audioSampleRate ||
+                    p.header.audioIndexOffset > fileSize ||
+                    p.header.audioChunkCount > (fileSize - p.header.audioIndexOffset) / sizeof(AudioChunk))
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(fileName).
+                        arg("Unsupported audio"));
+                }
+                info.audio.channelCount = p.header.audioChannelCount;
+                info.audio.dataType = static_cast<audio::DataType>(p.header.audioDataType);
+                info.audio.sampleRate = p.header.audioSampleRate;
+
+                p.audioIndex.resize(p.header.audioChunkCount);
+                p.io->setPos(p.header.audioIndexOffset);
+                p.io->read(p.audioIndex.data(), p.audioIndex.size() * sizeof(AudioChunk));
+                const size_t sampleByteCount = info.audio.getByteCount();
+                for (const auto& chunk : p.audioIndex)
+                {
+                    if (chunk.offset > fileSize ||
+                        chunk.sampleCount > (fileSize - chunk.offset) / sampleByteCount)
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").
+                            arg(fileName).
+                            arg("Incomplete file"));
+                    }
+                }
+                const auto& first = p.audioIndex.front();
+                const auto& last = p.audioIndex.back();
+                info.audioTime = otime::TimeRange(
+                    otime::RationalTime(first.start, info.audio.sampleRate),
+                    otime::RationalTime(
+                        last.start + last.sampleCount - first.start,
+                        info.audio.sampleRate));
+            }
+
+            p.info = info;
+        }
+
+        std::shared_ptr<file::FileIO> Read::_openFile(const std::string& fileName) const
+        {
+            // Use the same staging option as the sequence readers, so the
+            // staged copy of the file is read when staging is enabled.
+            bool staging = true;
+            const auto i = _options.find("SequenceIO/Staging");
+            if (i != _options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> staging;
+            }
+            return staging ?
+                file::FileIO::createStaged(fileName) :
+                file::FileIO::create(fileName, file::Mode::Read);
+        }
+
+        io::VideoData Read::_readVideo(const otime::RationalTime& time)
+        {
+            TLRENDER_P();
+            io::VideoData out;
+            out.time = time;
+            if (!p.info.video.empty())
+            {
+                const int64_t frame = static_cast<int64_t>(std::floor(
+                    time.rescaled_to(p.header.videoRate).value())) -
+                    p.header.videoStartFrame;
+                if (frame >= 0 &&
+                    frame < static_cast<int64_t>(p.videoIndex.size()) &&
+                    p.videoIndex[frame] > 0)
+                {
+                    const uint64_t offset = p.videoIndex[frame];
+                    if (auto data = p.io->mapCopyOnWrite(offset, p.header.videoFrameByteCount))
+                    {
+                        // Reference the frame in its own copy-on-write
+                        // mapping, so the image can be modified without
+                        // changing the file or other reads of the frame.
+                        out.image = image::Image::create(
+                            p.info.video[0],
+                            data.get(),
+                            data);
+                    }
+                    else if (const uint8_t* memoryStart = p.io->getMemoryStart())
+                    {
+                        out.image = image::Image::create(p.info.video[0]);
+                        memcpy(
+                            out.image->getData(),
+                            memoryStart + offset,
+                            out.image->getDataByteCount());
+                    }
+                    else
+                    {
+                        out.image = image::Image::create(p.info.video[0]);
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        p.io->setPos(offset);
+                        p.io->read(out.image->getData(), out.image->getDataByteCount());
+                    }
+                }
+            }
+            return out;
+        }
+
+        io::AudioData Read::_readAudio(const otime::TimeRange& timeRange)
+        {
+            TLRENDER_P();
+            io::AudioData out;
+            out.time = timeRange.start_time();
+            if (p.info.audio.isValid())
+            {
+                const size_t sampleRate = p.info.audio.sampleRate;
+                const int64_t start = static_cast<int64_t>(std::floor(
+                    timeRange.start_time().rescaled_to(sampleRate).value()));
+                const int64_t sampleCount = static_cast<int64_t>(std::round(
+                    timeRange.duration().rescaled_to(sampleRate).value()));
+                out.audio = audio::Audio::create(p.info.audio, sampleCount);
+                out.audio->zero();
+                const size_t sampleByteCount = p.info.audio.getByteCount();
+                const uint8_t* memoryStart = p.io->getMemoryStart();
+                for (const auto& chunk : p.audioIndex)
+                {
+                    const int64_t chunkEnd = chunk.start + chunk.sampleCount;
+                    const int64_t copyStart = std::max(chunk.start, start);
+                    const int64_t copyEnd = std::min(chunkEnd, start + sampleCount);
+                    if (copyStart < copyEnd)
+                    {
+                        uint8_t* outP = out.audio->getData() + (copyStart - start) * sampleByteCount;
+                        const size_t offset = chunk.offset + (copyStart - chunk.start) * sampleByteCount;
+                        const size_t byteCount = (copyEnd - copyStart) * sampleByteCount;
+                        if (memoryStart)
+                        {
+                            memcpy(outP, memoryStart + offset, byteCount);
+                        }
+                        else
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex);
+                            p.io->setPos(offset);
+                            p.io->read(outP, byteCount);
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+    }
+}
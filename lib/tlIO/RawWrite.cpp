@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/Raw.h>
+
+#include <tlCore/LogSystem.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+namespace tl
+{
+    namespace raw
+    {
+        struct Write::Private
+        {
+            std::string fileName;
+            std::shared_ptr<file::FileIO> io;
+            Header header;
+            std::map<int64_t, uint64_t> videoFrames;
+            std::vector<AudioChunk> audioChunks;
+        };
+
+        void Write::_init(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            IWrite::_init(path, options, info, logSystem);
+
+            TLRENDER_P();
+
+            p.fileName = path.get();
+            if (info.video.empty() && !info.audio.isValid())
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(p.fileName).
+                    arg("No video or audio"));
+            }
+
+            memcpy(p.header.magic, magic, sizeof(magic));
+            p.header.version = version;
+            p.header.endian = static_cast<uint32_t>(memory::getEndian());
+            if (!info.video.empty())
+            {
+                const auto& videoInfo = info.video[0];
+                p.header.videoWidth = videoInfo.size.w;
+                p.header.videoHeight = videoInfo.size.h;
+                p.header.videoPixelAspectRatio = videoInfo.size.pixelAspectRatio;
+                p.header.videoPixelType = static_cast<uint32_t>(videoInfo.pixelType);
+                p.header.videoLevels = static_cast<uint32_t>(videoInfo.videoLevels);
+                p.header.videoYUVCoefficients = static_cast<uint32_t>(videoInfo.yuvCoefficients);
+                p.header.videoMirrorX = videoInfo.layout.mirror.x;
+                p.header.videoMirrorY = videoInfo.layout.mirror.y;
+                p.header.videoAlignment = videoInfo.layout.alignment;
+                p.header.videoEndian = static_cast<uint8_t>(videoInfo.layout.endian);
+                p.header.videoFrameByteCount = image::getDataByteCount(videoInfo);
+                if (!time::compareExact(info.videoTime, time::invalidTimeRange))
+                {
+                    p.header.videoRate = info.videoTime.duration().rate();
+                }
+            }
+            if (info.audio.isValid())
+            {
+                p.header.audioChannelCount = info.audio.channelCount;
+                p.header.audioDataType = static_cast<uint32_t>(info.audio.dataType);
+                p.header.audioSampleRate = info.audio.sampleRate;
+            }
+
+            // Write a placeholder header, the final header is written
+            // when the file is closed.
+            p.io = file::FileIO::create(p.fileName, file::Mode::Write);
+            p.io->write(&p.header, sizeof(Header));
+        }
+
+        Write::Write() :
+            _p(new Private)
+        {}
+
+        Write::~Write()
+        {
+            try
+            {
+                _finish();
+            }
+            catch (const std::exception& e)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id = string::Format("tl::io::raw::Write ({0}: {1})").
+                        arg(__FILE__).
+                        arg(__LINE__);
+                    logSystem->print(id, string::Format("{0}: {1}").
+                        arg(_path.get()).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+        }
+
+        std::shared_ptr<Write> Write::create(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<Write>(new Write);
+            out->_init(path, info, options, logSystem);
+            return out;
+        }
+
+        void Write::writeVideo(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image)
+        {
+            TLRENDER_P();
+            if (_info.video.empty() ||
+                image->getSize() != _info.video[0].size ||
+                image->getPixelType() != _info.video[0].pixelType ||
+                image->getInfo().layout != _info.video[0].layout ||
+                image->getDataByteCount() != p.header.videoFrameByteCount)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(p.fileName).
+                    arg("Unsupported video"));
+            }
+            if (0.0 == p.header.videoRate)
+            {
+                p.header.videoRate = time.rate();
+            }
+            const int64_t frame = static_cast<int64_t>(std::floor(
+                time.rescaled_to(p.header.videoRate).value()));
+            _align();
+            p.videoFrames[frame] = p.io->getPos();
+            p.io->write(image->getData(), image->getDataByteCount());
+        }
+
+        void Write::writeAudio(
+            const otime::TimeRange& timeRange,
+            const std::shared_ptr<audio::Audio>& audio)
+        {
+            TLRENDER_P();
+            if (!_info.audio.isValid() || audio->getInfo() != _info.audio)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(p.fileName).
+                    arg("Unsupported audio"));
+            }
+            _align();
+            AudioChunk chunk;
+            chunk.start = static_cast<int64_t>(std::floor(
+                timeRange.start_time().rescaled_to(p.header.audioSampleRate).value()));
+            chunk.sampleCount = audio->getSampleCount();
+            chunk.offset = p.io->getPos();
+            p.audioChunks.push_back(chunk);
+            p.io->write(audio->getData(), audio->getByteCount());
+        }
+
+        void Write::_align()
+        {
+            TLRENDER_P();
+            static const std::array<uint8_t, frameAlignment> zero = {};
+            const size_t pos = p.io->getPos();
+            const size_t aligned = image::getAlignedByteCount(pos, frameAlignment);
+            if (aligned > pos)
+            {
+                p.io->write(zero.data(), aligned - pos);
+            }
+        }
+
+        void Write::_finish()
+        {
+            TLRENDER_P();
+            if (!p.io)
+                return;
+
+            // Write the video index.
+            _align();
+            if (!p.videoFrames.empty())
+            {
+                const int64_t startFrame = p.videoFrames.begin()->first;
+                const int64_t endFrame = p.videoFrames.rbegin()->first;
+                std::vector<uint64_t> videoIndex(endFrame - startFrame + 1, 0);
+                for (const auto& i : p.videoFrames)
+                {
+                    videoIndex[i.first - startFrame] = i.second;
+                }
+                p.header.videoStartFrame = startFrame;
+                p.header.videoFrameCount = videoIndex.size();
+                p.header.videoIndexOffset = p.io->getPos();
+                p.io->write(videoIndex.data(), videoIndex.size() * sizeof(uint64_t));
+            }
+
+            // Write the audio index.
+            if (!p.audioChunks.empty())
+            {
+                std::sort(
+                    p.audioChunks.begin(),
+                    p.audioChunks.end(),
+                    [](const AudioChunk& a, const AudioChunk& b)
+                    {
+                        return a.start < b.start;
+                    });
+                p.header.audioChunkCount = p.audioChunks.size();
+                p.header.audioIndexOffset = p.io->getPos();
+                p.io->write(p.audioChunks.data(), p.audioChunks.size() * sizeof(AudioChunk));
+            }
+
+            // Write the final header.
+            p.io->setPos(0);
+            p.io->write(&p.header, sizeof(Header));
+            p.io.reset();
+        }
+    }
+}
@@ -111,11 +111,23 @@ namespace tl
             class File
             {
             public:
-                File(const std::string& fileName, const file::MemoryRead* memory)
+                File(
+                    const std::string& fileName,
+                    const file::MemoryRead* memory,
+                    const std::shared_ptr<file::FileIO>& io = nullptr)
                 {
-                    _io = memory ?
-                        file::FileIO::create(fileName, *memory) :
-                        file::FileIO::create(fileName, file::Mode::Read);
+                    if (memory)
+                    {
+                        _io = file::FileIO::create(fileName, *memory);
+                    }
+                    else if (io)
+                    {
+                        _io = io;
+                    }
+                    else
+                    {
+                        _io = file::FileIO::create(fileName, file::Mode::Read);
+                    }
                     _io->setEndianConversion(memory::getEndian() != memory::Endian::MSB);
                     _io->readU16(&_header.magic);
                     if (_header.magic != 474)
@@ -331,7 +343,10 @@ namespace tl
             const otime::RationalTime& time,
             uint16_t layer)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(
+                fileName,
+                memory,
+                memory ? nullptr : _openFile(fileName)).read(fileName, time);
         }
     }
 }
@@ -6,6 +6,9 @@
 
 #include <tlIO/IO.h>
 
+#include <tlCore/FileIO.h>
+#include <tlCore/Memory.h>
+
 namespace tl
 {
     namespace io
@@ -19,6 +22,33 @@ namespace tl
         //! Timeout for requests.
         const std::chrono::milliseconds sequenceRequestTimeout(5);
 
+        //! Minimum file size for direct I/O.
+        const size_t sequenceDirectIOSize = 16 * memory::megabyte;
+
+        //! Image sequence frame template.
+        //!
+        //! The layout of the first frame of a sequence is cached so that
+        //! readers can validate a few header fields of the following frames
+        //! and read the pixel data directly, instead of parsing the full
+        //! header again.
+        struct FrameTemplate
+        {
+            //! Raw header bytes used for validation.
+            std::vector<uint8_t> header;
+
+            //! File size.
+            size_t fileSize = 0;
+
+            //! Offset to the pixel data.
+            size_t dataOffset = 0;
+
+            //! Whether endian conversion is required.
+            bool endianConversion = false;
+
+            //! Image information.
+            image::Info info;
+        };
+
         //! Base class for image sequence readers.
         class ISequenceRead : public IRead
         {
@@ -36,6 +66,7 @@ namespace tl
 
             std::future<Info> getInfo() override;
             std::future<VideoData> readVideo(const otime::RationalTime&, uint16_t layer = 0) override;
+            void prefetch(const otime::TimeRange&) override;
             void cancelRequests() override;
 
         protected:
@@ -48,6 +79,22 @@ namespace tl
                 const otime::RationalTime&,
                 uint16_t layer) = 0;
 
+            //! Get the frame template. This returns null if there is no
+            //! template or templates are disabled.
+            std::shared_ptr<const FrameTemplate> _getFrameTemplate() const;
+
+            //! Set the frame template. Only the first template is kept.
+            void _setFrameTemplate(const std::shared_ptr<FrameTemplate>&);
+
+            //! Get the read type for the given file. Direct I/O is used
+            //! when it is enabled and the file is larger than the
+            //! threshold.
+            file::ReadType _getReadType(const std::string& fileName) const;
+
+            //! Open a file for reading. The staged copy of the file is
+            //! read when staging is enabled.
+            std::shared_ptr<file::FileIO> _openFile(const std::string& fileName) const;
+
             //! \bug This must be called in the sub-class destructor.
             void _finish();
 
@@ -57,6 +104,7 @@ namespace tl
 
         private:
             void _thread();
+            void _prefetchThread();
             void _finishRequests();
             void _cancelRequests();
 
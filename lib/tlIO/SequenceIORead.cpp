@@ -6,11 +6,14 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/File.h>
+#include <tlCore/FileInfo.h>
 #include <tlCore/LogSystem.h>
+#include <tlCore/StagingCache.h>
 #include <tlCore/StringFormat.h>
 
 #include <fseq.h>
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -81,6 +84,30 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> _defaultSpeed;
             }
+            i = options.find("SequenceIO/FrameTemplate");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.frameTemplateEnabled;
+            }
+            i = options.find("SequenceIO/DirectIO");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.directIO;
+            }
+            i = options.find("SequenceIO/DirectIOSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.directIOSize;
+            }
+            i = options.find("SequenceIO/Staging");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.staging;
+            }
 
             p.thread.running = true;
             p.thread.thread = std::thread(
@@ -116,6 +143,14 @@ namespace tl
                     }
                     _cancelRequests();
                 });
+            if (!_path.getNumber().empty() && _memory.empty())
+            {
+                p.prefetchThread.thread = std::thread(
+                    [this]
+                    {
+                        _prefetchThread();
+                    });
+            }
         }
 
         ISequenceRead::ISequenceRead() :
@@ -179,11 +214,71 @@ namespace tl
             return future;
         }
 
+        void ISequenceRead::prefetch(const otime::TimeRange& timeRange)
+        {
+            TLRENDER_P();
+            if (p.prefetchThread.thread.joinable())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+                    p.prefetchMutex.timeRange = timeRange;
+                    p.prefetchMutex.changed = true;
+                }
+                p.prefetchThread.cv.notify_one();
+            }
+        }
+
         void ISequenceRead::cancelRequests()
         {
             _cancelRequests();
         }
 
+        std::shared_ptr<const FrameTemplate> ISequenceRead::_getFrameTemplate() const
+        {
+            TLRENDER_P();
+            std::shared_ptr<const FrameTemplate> out;
+            if (p.frameTemplateEnabled)
+            {
+                std::unique_lock<std::mutex> lock(p.frameTemplateMutex);
+                out = p.frameTemplate;
+            }
+            return out;
+        }
+
+        void ISequenceRead::_setFrameTemplate(const std::shared_ptr<FrameTemplate>& value)
+        {
+            TLRENDER_P();
+            if (p.frameTemplateEnabled && value)
+            {
+                std::unique_lock<std::mutex> lock(p.frameTemplateMutex);
+                if (!p.frameTemplate)
+                {
+                    p.frameTemplate = value;
+                }
+            }
+        }
+
+        file::ReadType ISequenceRead::_getReadType(const std::string& fileName) const
+        {
+            TLRENDER_P();
+            file::ReadType out = file::ReadType::Normal;
+            if (p.directIO &&
+                file::FileInfo(file::Path(fileName)).getSize() >= p.directIOSize)
+            {
+                out = file::ReadType::DirectIO;
+            }
+            return out;
+        }
+
+        std::shared_ptr<file::FileIO> ISequenceRead::_openFile(const std::string& fileName) const
+        {
+            TLRENDER_P();
+            const file::ReadType readType = _getReadType(fileName);
+            return p.staging ?
+                file::FileIO::createStaged(fileName, readType) :
+                file::FileIO::create(fileName, file::Mode::Read, readType);
+        }
+
         void ISequenceRead::_finish()
         {
             TLRENDER_P();
@@ -192,6 +287,11 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+            p.prefetchThread.cv.notify_one();
+            if (p.prefetchThread.thread.joinable())
+            {
+                p.prefetchThread.thread.join();
+            }
         }
 
         void ISequenceRead::_thread()
@@ -327,6 +427,64 @@ namespace tl
             }
         }
 
+        void ISequenceRead::_prefetchThread()
+        {
+            TLRENDER_P();
+            while (p.thread.running)
+            {
+                otime::TimeRange timeRange = time::invalidTimeRange;
+                {
+                    std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+                    if (p.prefetchThread.cv.wait_for(
+                        lock,
+                        sequenceRequestTimeout,
+                        [this]
+                        {
+                            return _p->prefetchMutex.changed;
+                        }))
+                    {
+                        timeRange = p.prefetchMutex.timeRange;
+                        p.prefetchMutex.changed = false;
+                    }
+                }
+                if (timeRange != time::invalidTimeRange)
+                {
+                    // Only prefetch the files that were not included in the
+                    // previous hint.
+                    const int64_t start = std::max(
+                        static_cast<int64_t>(timeRange.start_time().value()),
+                        _startFrame);
+                    const int64_t end = std::min(
+                        static_cast<int64_t>(timeRange.end_time_inclusive().value()),
+                        _endFrame);
+                    int64_t last = start - 1;
+                    for (int64_t frame = start; frame <= end && p.thread.running; ++frame)
+                    {
+                        if (frame < p.prefetchThread.frames.first ||
+                            frame > p.prefetchThread.frames.second)
+                        {
+                            const std::string fileName = _path.get(static_cast<int>(frame));
+                            std::shared_ptr<const std::string> staged;
+                            if (p.staging)
+                            {
+                                staged = file::getStagedFile(fileName);
+                            }
+                            file::prefetch(staged ? *staged : fileName);
+                        }
+                        last = frame;
+                        {
+                            std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+                            if (p.prefetchMutex.changed)
+                            {
+                                break;
+                            }
+                        }
+                    }
+                    p.prefetchThread.frames = std::make_pair(start, last);
+                }
+            }
+        }
+
         void ISequenceRead::_finishRequests()
         {
             TLRENDER_P();
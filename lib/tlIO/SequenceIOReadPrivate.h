@@ -24,6 +24,15 @@ namespace tl
 
             Info info;
 
+            bool frameTemplateEnabled = true;
+            std::shared_ptr<const FrameTemplate> frameTemplate;
+            std::mutex frameTemplateMutex;
+
+            bool directIO = false;
+            size_t directIOSize = sequenceDirectIOSize;
+
+            bool staging = true;
+
             struct InfoRequest
             {
                 InfoRequest() {}
@@ -63,6 +72,22 @@ namespace tl
                 std::atomic<bool> running;
             };
             Thread thread;
+
+            struct PrefetchMutex
+            {
+                otime::TimeRange timeRange = time::invalidTimeRange;
+                bool changed = false;
+                std::mutex mutex;
+            };
+            PrefetchMutex prefetchMutex;
+
+            struct PrefetchThread
+            {
+                std::pair<int64_t, int64_t> frames = std::make_pair(0, -1);
+                std::condition_variable cv;
+                std::thread thread;
+            };
+            PrefetchThread prefetchThread;
         };
     }
 }
@@ -35,5 +35,20 @@ namespace tl
         {
             return file::Path(appDirPath, "settings.json").get();
         }
+
+        std::string thumbnailsPath(const std::string& appDirPath)
+        {
+            return file::Path(appDirPath, "thumbnails").get();
+        }
+
+        std::string waveformsPath(const std::string& appDirPath)
+        {
+            return file::Path(appDirPath, "waveforms").get();
+        }
+
+        std::string shadersPath(const std::string& appDirPath)
+        {
+            return file::Path(appDirPath, "shaders").get();
+        }
     }
 }
@@ -20,5 +20,14 @@ namespace tl
 
         //! Get the settings file name.
         std::string settingsName(const std::string& appDirPath);
+
+        //! Get the thumbnails directory.
+        std::string thumbnailsPath(const std::string& appDirPath);
+
+        //! Get the waveforms directory.
+        std::string waveformsPath(const std::string& appDirPath);
+
+        //! Get the shader cache directory.
+        std::string shadersPath(const std::string& appDirPath);
     }
 }
@@ -19,13 +19,21 @@
 #include <tlUI/FileBrowser.h>
 #include <tlUI/RecentFilesModel.h>
 
+#include <tlTimelineUI/TimelineWidget.h>
+#include <tlTimelineUI/WaveformCache.h>
+
+#include <tlTimeline/FrameCacheSystem.h>
+#include <tlTimeline/ThumbnailSystem.h>
 #include <tlTimeline/Util.h>
 
+#include <tlGL/ShaderCache.h>
+
 #include <tlIO/IOSystem.h>
 
 #include <tlCore/AudioSystem.h>
 #include <tlCore/File.h>
 #include <tlCore/FileLogSystem.h>
+#include <tlCore/StagingCache.h>
 #include <tlCore/StringFormat.h>
 
 #if defined(TLRENDER_USD)
@@ -62,6 +70,9 @@ namespace tl
                 size_t usdStageCache = usd::RenderOptions().stageCacheCount;
                 size_t usdDiskCache = usd::RenderOptions().diskCacheByteCount / memory::gigabyte;
 #endif // TLRENDER_USD
+                size_t frameCache = 1;
+                size_t stagingCache = 0;
+                std::string stagingDir;
                 std::string logFileName;
                 bool resetSettings = false;
                 std::string settingsFileName;
@@ -244,6 +255,20 @@ namespace tl
                     "USD disk cache size in gigabytes. A size of zero disables the disk cache.",
                     string::Format("{0}").arg(p.options.usdDiskCache)),
 #endif // TLRENDER_USD
+                app::CmdLineValueOption<size_t>::create(
+                    p.options.frameCache,
+                    { "-frameCache" },
+                    "Shared frame cache size in gigabytes. The frame cache is in addition to the player cache. A size of zero disables the cache.",
+                    string::Format("{0}").arg(p.options.frameCache)),
+                app::CmdLineValueOption<size_t>::create(
+                    p.options.stagingCache,
+                    { "-stagingCache" },
+                    "Local staging cache size in gigabytes. Files are copied to the cache in the background and then read from the local copy. A size of zero disables the cache.",
+                    string::Format("{0}").arg(p.options.stagingCache)),
+                app::CmdLineValueOption<std::string>::create(
+                    p.options.stagingDir,
+                    { "-stagingDir" },
+                    "Local staging cache directory. A temporary directory is used by default."),
                 app::CmdLineValueOption<std::string>::create(
                     p.options.logFileName,
                     { "-logFile" },
@@ -310,6 +335,26 @@ namespace tl
             auto ioSystem = context->getSystem<io::System>();
             ioSystem->setOptions(ioOptions);
 
+            // Initialize the frame cache.
+            context->getSystem<timeline::FrameCacheSystem>()->setMax(
+                p.options.frameCache * memory::gigabyte);
+
+            // Initialize the staging cache.
+            if (p.options.stagingCache > 0)
+            {
+                file::setStagingCache(file::StagingCache::create(
+                    p.options.stagingDir,
+                    p.options.stagingCache * memory::gigabyte));
+            }
+
+            // Initialize the thumbnail directory.
+            context->getSystem<timeline::ThumbnailSystem>()->setDirectory(
+                play::thumbnailsPath(appDirPath));
+
+            // Initialize the shader cache.
+            gl::setShaderCache(gl::ShaderCache::create(
+                play::shadersPath(appDirPath)));
+
             // Initialize the settings.
             p.settings = Settings::create(context);
             if (!p.options.settingsFileName.empty())
@@ -532,6 +577,10 @@ namespace tl
                 std::dynamic_pointer_cast<App>(shared_from_this()),
                 _context);
             getEventLoop()->addWidget(p.mainWindow);
+
+            // Initialize the waveform directory.
+            p.mainWindow->getTimelineWidget()->getWaveformCache()->setDirectory(
+                play::waveformsPath(appDirPath));
         }
 
         App::App() :
@@ -569,6 +618,9 @@ namespace tl
                 }
                 p.settings->write(p.settingsFileName);
             }
+
+            file::setStagingCache(nullptr);
+            gl::setShaderCache(nullptr);
         }
 
         std::shared_ptr<App> App::create(
@@ -13,6 +13,7 @@
 #include <tlQtWidget/Init.h>
 #include <tlQtWidget/FileBrowserSystem.h>
 #include <tlQtWidget/Style.h>
+#include <tlQtWidget/TimelineWidget.h>
 
 #include <tlQt/ContextObject.h>
 #include <tlQt/MetaTypes.h>
@@ -28,8 +29,14 @@
 #include <tlPlay/FilesModel.h>
 #include <tlPlay/Util.h>
 
+#include <tlTimelineUI/WaveformCache.h>
+
+#include <tlTimeline/FrameCacheSystem.h>
+#include <tlTimeline/ThumbnailSystem.h>
 #include <tlTimeline/Util.h>
 
+#include <tlGL/ShaderCache.h>
+
 #include <tlIO/IOSystem.h>
 #if defined(TLRENDER_USD)
 #include <tlIO/USD.h>
@@ -37,6 +44,7 @@
 
 #include <tlCore/AudioSystem.h>
 #include <tlCore/FileLogSystem.h>
+#include <tlCore/StagingCache.h>
 #include <tlCore/Math.h>
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
@@ -68,6 +76,9 @@ namespace tl
                 size_t usdStageCache = usd::RenderOptions().stageCacheCount;
                 size_t usdDiskCache = usd::RenderOptions().diskCacheByteCount / memory::gigabyte;
 #endif // TLRENDER_USD
+                size_t frameCache = 1;
+                size_t stagingCache = 0;
+                std::string stagingDir;
                 std::string logFileName;
                 bool resetSettings = false;
             };
@@ -237,6 +248,20 @@ namespace tl
                         "USD disk cache size in gigabytes. A size of zero disables the cache.",
                         string::Format("{0}").arg(p.options.usdDiskCache)),
 #endif // TLRENDER_USD
+                    app::CmdLineValueOption<size_t>::create(
+                        p.options.frameCache,
+                        { "-frameCache" },
+                        "Shared frame cache size in gigabytes. The frame cache is in addition to the player cache. A size of zero disables the cache.",
+                        string::Format("{0}").arg(p.options.frameCache)),
+                    app::CmdLineValueOption<size_t>::create(
+                        p.options.stagingCache,
+                        { "-stagingCache" },
+                        "Local staging cache size in gigabytes. Files are copied to the cache in the background and then read from the local copy. A size of zero disables the cache.",
+                        string::Format("{0}").arg(p.options.stagingCache)),
+                    app::CmdLineValueOption<std::string>::create(
+                        p.options.stagingDir,
+                        { "-stagingDir" },
+                        "Local staging cache directory. A temporary directory is used by default."),
                     app::CmdLineValueOption<std::string>::create(
                         p.options.logFileName,
                         { "-logFile" },
@@ -306,6 +331,26 @@ namespace tl
             auto ioSystem = context->getSystem<io::System>();
             ioSystem->setOptions(ioOptions);
 
+            // Initialize the frame cache.
+            context->getSystem<timeline::FrameCacheSystem>()->setMax(
+                p.options.frameCache * memory::gigabyte);
+
+            // Initialize the staging cache.
+            if (p.options.stagingCache > 0)
+            {
+                file::setStagingCache(file::StagingCache::create(
+                    p.options.stagingDir,
+                    p.options.stagingCache * memory::gigabyte));
+            }
+
+            // Initialize the thumbnail directory.
+            context->getSystem<timeline::ThumbnailSystem>()->setDirectory(
+                play::thumbnailsPath(appDirPath));
+
+            // Initialize the shader cache.
+            gl::setShaderCache(gl::ShaderCache::create(
+                play::shadersPath(appDirPath)));
+
             // Create models and objects.
             p.contextObject = new qt::ContextObject(context, this);
             p.timeUnitsModel = timeline::TimeUnitsModel::create(context);
@@ -503,6 +548,10 @@ namespace tl
             // Create the main window.
             p.mainWindow = new MainWindow(this);
 
+            // Initialize the waveform directory.
+            p.mainWindow->timelineWidget()->waveformCache()->setDirectory(
+                play::waveformsPath(appDirPath));
+
             // Open the input files.
             if (!p.options.fileName.empty())
             {
@@ -595,6 +644,9 @@ namespace tl
             //! \bug Why is it necessary to manually delete this to get the settings to save?
             delete p.settingsObject;
             p.settingsObject = nullptr;
+
+            file::setStagingCache(nullptr);
+            gl::setShaderCache(nullptr);
         }
 
         const std::shared_ptr<timeline::TimeUnitsModel>& App::timeUnitsModel() const
@@ -795,6 +795,11 @@ namespace tl
             _widgetUpdate();
         }
 
+        qtwidget::TimelineWidget* MainWindow::timelineWidget() const
+        {
+            return _p->timelineWidget;
+        }
+
         void MainWindow::closeEvent(QCloseEvent*)
         {
             TLRENDER_P();
@@ -10,6 +10,11 @@
 
 namespace tl
 {
+    namespace qtwidget
+    {
+        class TimelineWidget;
+    }
+
     namespace play_qt
     {
         class App;
@@ -27,6 +32,9 @@ namespace tl
             //! Set the timeline players.
             void setTimelinePlayers(const QVector<QSharedPointer<qt::TimelinePlayer> >&);
 
+            //! Get the timeline widget.
+            qtwidget::TimelineWidget* timelineWidget() const;
+
         protected:
             void closeEvent(QCloseEvent*) override;
             void dragEnterEvent(QDragEnterEvent*) override;
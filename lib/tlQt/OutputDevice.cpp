@@ -284,6 +284,16 @@ namespace tl
             p.cv.notify_one();
         }
 
+        void OutputDevice::setReadbackBufferCount(size_t value)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.readbackBufferCount = std::max(value, size_t(1));
+            }
+            p.cv.notify_one();
+        }
+
         void OutputDevice::setDeviceEnabled(bool value)
         {
             TLRENDER_P();
@@ -436,6 +446,7 @@ namespace tl
             bool mute = false;
             double audioOffset = 0.0;
             std::vector<timeline::AudioData> audioData;
+            size_t readbackBufferCount = 0;
 
             std::shared_ptr<device::IOutputDevice> device;
             std::shared_ptr<tl::gl::Shader> shader;
@@ -443,9 +454,7 @@ namespace tl
             std::shared_ptr<gl::OffscreenBuffer> offscreenBuffer2;
             std::shared_ptr<gl::VBO> vbo;
             std::shared_ptr<gl::VAO> vao;
-            std::array<GLuint, 1> pbo;
-            std::array<otime::RationalTime, 1> pboTime;
-            size_t pboIndex = 0;
+            std::shared_ptr<ReadbackRing> readbackRing;
             std::shared_ptr<OverlayTexture> overlayTexture;
             std::shared_ptr<gl::VBO> overlayVbo;
             std::shared_ptr<gl::VAO> overlayVao;
@@ -456,6 +465,7 @@ namespace tl
                 bool doRender = false;
                 bool overlayChanged = false;
                 bool audioChanged = false;
+                bool readbackChanged = false;
                 {
                     std::unique_lock<std::mutex> lock(p.mutex);
                     if (p.cv.wait_for(
@@ -465,7 +475,8 @@ namespace tl
                         deviceEnabled, colorConfigOptions, lutOptions, imageOptions,
                         displayOptions, hdrMode, hdrData, compareOptions,
                         playback, currentTime, sizes, viewPos, viewZoom, frameView,
-                        videoData, overlay, volume, mute, audioOffset, audioData]
+                        videoData, overlay, volume, mute, audioOffset, audioData,
+                        readbackBufferCount]
                         {
                             return
                                 deviceIndex != _p->deviceIndex ||
@@ -490,7 +501,8 @@ namespace tl
                                 volume != _p->volume ||
                                 mute != _p->mute ||
                                 audioOffset != _p->audioOffset ||
-                                audioData != _p->audioData;
+                                audioData != _p->audioData ||
+                                readbackBufferCount != _p->readbackBufferCount;
                         }))
                     {
                         createDevice =
@@ -541,11 +553,15 @@ namespace tl
                         audioOffset = p.audioOffset;
                         audioChanged = audioData != p.audioData;
                         audioData = p.audioData;
+
+                        readbackChanged = readbackBufferCount != p.readbackBufferCount;
+                        readbackBufferCount = p.readbackBufferCount;
                     }
                 }
 
                 if (createDevice)
                 {
+                    readbackRing.reset();
                     offscreenBuffer2.reset();
                     offscreenBuffer.reset();
                     device.reset();
@@ -582,21 +598,17 @@ namespace tl
 
                     vao.reset();
                     vbo.reset();
-
-                    glDeleteBuffers(pbo.size(), pbo.data());
-                    glGenBuffers(pbo.size(), pbo.data());
+                }
+                if (createDevice || readbackChanged)
+                {
+                    readbackRing.reset();
                     if (device)
                     {
-                        const image::Size viewportSize = device->getSize();
-                        for (size_t i = 0; i < pbo.size(); ++i)
-                        {
-                            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[i]);
-                            glBufferData(
-                                GL_PIXEL_PACK_BUFFER,
-                                device::getDataByteCount(viewportSize, pixelType),
-                                NULL,
-                                GL_STREAM_COPY);
-                        }
+                        readbackRing = ReadbackRing::create(
+                            readbackBufferCount,
+                            device->getSize(),
+                            pixelType,
+                            device);
                     }
                 }
 
@@ -805,41 +817,33 @@ namespace tl
                                 }
                             }
 
-                            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[pboIndex % pbo.size()]);
-                            pboTime[pboIndex % pbo.size()] = !videoData.empty() ? videoData[0].time : time::invalidTime;
-                            if (0 == viewportSize.w % getReadPixelsAlign(pixelType) &&
-                                !getReadPixelsSwap(pixelType))
+                            if (readbackRing)
                             {
-                                glBindTexture(GL_TEXTURE_2D, offscreenBuffer2->getColorID());
-                                glGetTexImage(
-                                    GL_TEXTURE_2D,
-                                    0,
-                                    getReadPixelsFormat(pixelType),
-                                    getReadPixelsType(pixelType),
-                                    NULL);
-                            }
-                            else
-                            {
-                                glPixelStorei(GL_PACK_ALIGNMENT, getReadPixelsAlign(pixelType));
-                                glPixelStorei(GL_PACK_SWAP_BYTES, getReadPixelsSwap(pixelType));
-                                glReadPixels(
-                                    0,
-                                    0,
-                                    viewportSize.w,
-                                    viewportSize.h,
-                                    getReadPixelsFormat(pixelType),
-                                    getReadPixelsType(pixelType),
-                                    NULL);
-                            }
-
-                            ++pboIndex;
-                            if (pbo[pboIndex % pbo.size()])
-                            {
-                                auto pixelData = device::PixelData::create(
-                                    viewportSize,
-                                    pixelType,
-                                    pboTime[pboIndex % pbo.size()]);
-                                //std::cout << "time: " << pixelData->getTime() << std::endl;
+                                readbackRing->begin();
+                                if (0 == viewportSize.w % getReadPixelsAlign(pixelType) &&
+                                    !getReadPixelsSwap(pixelType))
+                                {
+                                    glBindTexture(GL_TEXTURE_2D, offscreenBuffer2->getColorID());
+                                    glGetTexImage(
+                                        GL_TEXTURE_2D,
+                                        0,
+                                        getReadPixelsFormat(pixelType),
+                                        getReadPixelsType(pixelType),
+                                        NULL);
+                                }
+                                else
+                                {
+                                    glPixelStorei(GL_PACK_ALIGNMENT, getReadPixelsAlign(pixelType));
+                                    glPixelStorei(GL_PACK_SWAP_BYTES, getReadPixelsSwap(pixelType));
+                                    glReadPixels(
+                                        0,
+                                        0,
+                                        viewportSize.w,
+                                        viewportSize.h,
+                                        getReadPixelsFormat(pixelType),
+                                        getReadPixelsType(pixelType),
+                                        NULL);
+                                }
 
                                 std::shared_ptr<image::HDRData> hdrDataP;
                                 switch (hdrMode)
@@ -855,19 +859,9 @@ namespace tl
                                     break;
                                 default: break;
                                 }
-                                pixelData->setHDRData(hdrDataP);
-
-                                glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[pboIndex % pbo.size()]);
-                                if (void* buffer = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
-                                {
-                                    memcpy(
-                                        pixelData->getData(),
-                                        buffer,
-                                        pixelData->getDataByteCount());
-                                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-                                }
-                                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-                                device->setPixelData(pixelData);
+                                readbackRing->end(
+                                    !videoData.empty() ? videoData[0].time : time::invalidTime,
+                                    hdrDataP);
                             }
                         }
                     }
@@ -880,6 +874,10 @@ namespace tl
                     }
                 }
 
+                if (readbackRing)
+                {
+                    readbackRing->update();
+                }
                 if (device)
                 {
                     device->setPlayback(playback, currentTime);
@@ -892,7 +890,7 @@ namespace tl
                     device->setAudioData(audioData);
                 }
             }
-            glDeleteBuffers(pbo.size(), pbo.data());
+            readbackRing.reset();
         }
 
         bool OutputDevice::_isDeviceActive() const
@@ -88,6 +88,11 @@ namespace tl
             //! * QImage::Format_ARGB4444_Premultiplied
             void setOverlay(QImage*);
 
+            //! Set the number of pixel buffers used to read back rendered
+            //! frames. More buffers let the GPU run further ahead of the
+            //! output device at the cost of latency.
+            void setReadbackBufferCount(size_t);
+
         public Q_SLOTS:
             //! Set whether the output device is enabled.
             void setDeviceEnabled(bool);
@@ -4,10 +4,19 @@
 
 #include <tlQt/OutputDevicePrivate.h>
 
+#include <cstring>
+
 namespace tl
 {
     namespace qt
     {
+        namespace
+        {
+            //! Time to wait for a read back when all of the pixel buffers
+            //! are in use.
+            const GLuint64 readbackTimeout = 1000000000;
+        }
+
         image::PixelType getOffscreenType(device::PixelType value)
         {
             const std::array<image::PixelType, static_cast<size_t>(device::PixelType::Count)> data =
@@ -133,5 +142,231 @@ namespace tl
                     value.bits());
             }
         }
+
+        ReadbackRing::ReadbackRing(
+            size_t count,
+            const image::Size& size,
+            device::PixelType pixelType,
+            const std::shared_ptr<device::IOutputDevice>& device) :
+            _size(size),
+            _pixelType(pixelType),
+            _device(device),
+            _buffers(std::max(count, size_t(1)))
+        {
+            const size_t byteCount = device::getDataByteCount(size, pixelType);
+            for (auto& buffer : _buffers)
+            {
+                glGenBuffers(1, &buffer.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+                glBufferData(
+                    GL_PIXEL_PACK_BUFFER,
+                    byteCount,
+                    NULL,
+                    GL_STREAM_READ);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            _thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+        }
+
+        ReadbackRing::~ReadbackRing()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _cv.notify_all();
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+            for (auto& buffer : _buffers)
+            {
+                if (buffer.fence)
+                {
+                    glDeleteSync(buffer.fence);
+                }
+                if (buffer.data)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                }
+                glDeleteBuffers(1, &buffer.pbo);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+        std::shared_ptr<ReadbackRing> ReadbackRing::create(
+            size_t count,
+            const image::Size& size,
+            device::PixelType pixelType,
+            const std::shared_ptr<device::IOutputDevice>& device)
+        {
+            return std::shared_ptr<ReadbackRing>(new ReadbackRing(count, size, pixelType, device));
+        }
+
+        void ReadbackRing::begin()
+        {
+            Buffer& buffer = _buffers[_writeIndex];
+            State state = State::Free;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                state = buffer.state;
+            }
+            if (State::Reading == state)
+            {
+                // All of the buffers are waiting for the GPU, so wait for
+                // the oldest one.
+                _map(true);
+            }
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(
+                    lock,
+                    [&buffer]
+                    {
+                        return buffer.state != State::Copying;
+                    });
+            }
+            _unmap();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+        }
+
+        void ReadbackRing::end(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::HDRData>& hdrData)
+        {
+            Buffer& buffer = _buffers[_writeIndex];
+            buffer.time = time;
+            buffer.hdrData = hdrData;
+            buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            glFlush();
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                buffer.state = State::Reading;
+            }
+            _writeIndex = (_writeIndex + 1) % _buffers.size();
+        }
+
+        void ReadbackRing::update()
+        {
+            _unmap();
+            _map(false);
+        }
+
+        void ReadbackRing::_map(bool wait)
+        {
+            // Buffers are mapped in the order they were read so the frames
+            // are sent to the device in order.
+            while (1)
+            {
+                Buffer& buffer = _buffers[_readIndex];
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (buffer.state != State::Reading)
+                        break;
+                }
+                const GLenum result = glClientWaitSync(
+                    buffer.fence,
+                    wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                    wait ? readbackTimeout : 0);
+                if (GL_TIMEOUT_EXPIRED == result && !wait)
+                    break;
+                glDeleteSync(buffer.fence);
+                buffer.fence = nullptr;
+
+                // The frame is dropped if the read back did not finish.
+                const void* data = nullptr;
+                if (GL_ALREADY_SIGNALED == result || GL_CONDITION_SATISFIED == result)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+                    data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                }
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    buffer.data = data;
+                    if (data)
+                    {
+                        buffer.state = State::Copying;
+                        _requests.push_back(_readIndex);
+                    }
+                    else
+                    {
+                        buffer.state = State::Free;
+                    }
+                }
+                _cv.notify_all();
+                _readIndex = (_readIndex + 1) % _buffers.size();
+                if (wait)
+                    break;
+            }
+        }
+
+        void ReadbackRing::_unmap()
+        {
+            for (auto& buffer : _buffers)
+            {
+                bool copied = false;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    copied = State::Copied == buffer.state;
+                }
+                if (copied)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    buffer.data = nullptr;
+                    buffer.hdrData.reset();
+                    buffer.state = State::Free;
+                }
+            }
+        }
+
+        void ReadbackRing::_run()
+        {
+            while (1)
+            {
+                size_t index = 0;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_requests.empty() || !_running;
+                        });
+                    if (!_running)
+                        break;
+                    index = _requests.front();
+                    _requests.pop_front();
+                }
+
+                // Copy the pixel buffer to the device pixel data. This is
+                // the only access to the buffer while it is mapped, so it
+                // does not need the lock.
+                Buffer& buffer = _buffers[index];
+                auto pixelData = device::PixelData::create(_size, _pixelType, buffer.time);
+                pixelData->setHDRData(buffer.hdrData);
+                memcpy(
+                    pixelData->getData(),
+                    buffer.data,
+                    pixelData->getDataByteCount());
+                _device->setPixelData(pixelData);
+
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    buffer.state = State::Copied;
+                }
+                _cv.notify_all();
+            }
+        }
     }
 }
@@ -7,6 +7,7 @@
 #include <tlQt/OutputDevice.h>
 
 #include <tlDevice/IDeviceSystem.h>
+#include <tlDevice/IOutputDevice.h>
 
 #if defined(TLRENDER_GL_DEBUG)
 #include <tlGladDebug/gl.h>
@@ -17,6 +18,11 @@
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
 
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
 namespace tl
 {
     namespace qt
@@ -50,6 +56,78 @@ namespace tl
             GLuint _id = 0;
         };
 
+        //! Ring of pixel buffers used to read back rendered frames.
+        //!
+        //! A fence is inserted after each read back, and the buffer is only
+        //! mapped once the GPU has finished writing it, so the render thread
+        //! does not stall on the transfer. The mapped data is copied into
+        //! the device pixel data on a separate thread.
+        class ReadbackRing
+        {
+            ReadbackRing(
+                size_t count,
+                const image::Size&,
+                device::PixelType,
+                const std::shared_ptr<device::IOutputDevice>&);
+
+        public:
+            ~ReadbackRing();
+
+            static std::shared_ptr<ReadbackRing> create(
+                size_t count,
+                const image::Size&,
+                device::PixelType,
+                const std::shared_ptr<device::IOutputDevice>&);
+
+            //! Bind the next pixel buffer for reading. If the buffer is still
+            //! in use this waits for it.
+            void begin();
+
+            //! Finish reading into the pixel buffer.
+            void end(
+                const otime::RationalTime&,
+                const std::shared_ptr<image::HDRData>&);
+
+            //! Map the pixel buffers the GPU has finished writing, and unmap
+            //! the pixel buffers that have been copied to the device.
+            void update();
+
+        private:
+            void _map(bool wait);
+            void _unmap();
+            void _run();
+
+            enum class State
+            {
+                Free,
+                Reading,
+                Copying,
+                Copied
+            };
+
+            struct Buffer
+            {
+                GLuint pbo = 0;
+                GLsync fence = nullptr;
+                State state = State::Free;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::HDRData> hdrData;
+                const void* data = nullptr;
+            };
+
+            image::Size _size;
+            device::PixelType _pixelType = device::PixelType::None;
+            std::shared_ptr<device::IOutputDevice> _device;
+            std::vector<Buffer> _buffers;
+            size_t _writeIndex = 0;
+            size_t _readIndex = 0;
+            std::list<size_t> _requests;
+            bool _running = true;
+            std::condition_variable _cv;
+            std::mutex _mutex;
+            std::thread _thread;
+        };
+
         struct OutputDevice::Private
         {
             std::weak_ptr<system::Context> context;
@@ -81,6 +159,7 @@ namespace tl
             bool mute = false;
             double audioOffset = 0.0;
             std::vector<timeline::AudioData> audioData;
+            size_t readbackBufferCount = 3;
 
             std::chrono::milliseconds timeout = std::chrono::milliseconds(5);
             QScopedPointer<QOffscreenSurface> offscreenSurface;
@@ -5,6 +5,7 @@
 #include <tlQt/TimelineThumbnailObject.h>
 
 #include <tlTimeline/GLRender.h>
+#include <tlTimeline/ThumbnailSystem.h>
 
 #include <tlGL/Init.h>
 #include <tlGL/OffscreenBuffer.h>
@@ -19,6 +20,7 @@
 #include <QSurfaceFormat>
 
 #include <atomic>
+#include <cstring>
 #include <mutex>
 
 namespace tl
@@ -39,7 +41,7 @@ namespace tl
                 timeline::LUTOptions lutOptions;
 
                 std::shared_ptr<timeline::Timeline> timeline;
-                std::vector<std::future<timeline::VideoData> > futures;
+                std::vector<std::pair<otime::RationalTime, std::future<timeline::VideoData> > > futures;
             };
             std::list<Request> requests;
             std::list<Request> requestsInProgress;
@@ -210,6 +212,7 @@ namespace tl
             if (auto context = p.context.lock())
             {
                 auto render = timeline::GLRender::create(context);
+                auto thumbnailSystem = context->getSystem<timeline::ThumbnailSystem>();
 
                 std::shared_ptr<gl::OffscreenBuffer> offscreenBuffer;
                 while (p.running)
@@ -256,24 +259,74 @@ namespace tl
                         }
                     }
 
-                    // Initialize new requests.
+                    // Initialize new requests. Thumbnails that are in the
+                    // thumbnail system are returned immediately, and the
+                    // timeline is only opened for the remaining thumbnails.
+                    // A media file opened as a timeline starts at the media
+                    // start time, so the thumbnails are shared with the
+                    // timeline widget.
+                    std::vector<Private::Result> results;
                     for (auto& request : newRequests)
                     {
+                        const file::Path path(request.fileName.toUtf8().data());
+                        const image::Size size(request.size.width(), request.size.height());
+                        QList<otime::RationalTime> times;
+                        Private::Result result;
+                        result.id = request.id;
+                        for (const auto& i : request.times)
+                        {
+                            std::shared_ptr<image::Image> image;
+                            if (thumbnailSystem &&
+                                thumbnailSystem->get(
+                                    timeline::getThumbnailKey(
+                                        path,
+                                        i,
+                                        0,
+                                        size,
+                                        request.colorConfigOptions,
+                                        request.lutOptions),
+                                    image) &&
+                                image->getPixelType() == image::PixelType::RGBA_U8)
+                            {
+                                QImage qImage(size.w, size.h, QImage::Format_RGBA8888);
+                                for (int y = 0; y < size.h; ++y)
+                                {
+                                    std::memcpy(
+                                        qImage.scanLine(y),
+                                        image->getData() + y * size.w * 4,
+                                        size.w * 4);
+                                }
+                                result.thumbnails.push_back(QPair<otime::RationalTime, QImage>(i, qImage));
+                            }
+                            else
+                            {
+                                times.push_back(i);
+                            }
+                        }
+                        if (!result.thumbnails.empty())
+                        {
+                            results.push_back(result);
+                        }
+                        if (times.empty())
+                            continue;
+                        request.times = times;
+
                         timeline::Options options;
                         options.videoRequestCount = 1;
                         options.audioRequestCount = 1;
                         options.requestTimeout = std::chrono::milliseconds(25);
                         options.ioOptions["SequenceIO/ThreadCount"] = string::Format("{0}").arg(1);
+                        options.ioOptions["SequenceIO/Staging"] = string::Format("{0}").arg(0);
                         options.ioOptions["FFmpeg/ThreadCount"] = string::Format("{0}").arg(1);
                         try
                         {
                             request.timeline = timeline::Timeline::create(request.fileName.toUtf8().data(), context, options);
                             for (const auto& i : request.times)
                             {
-                                request.futures.push_back(request.timeline->getVideo(
+                                request.futures.push_back(std::make_pair(i, request.timeline->getVideo(
                                     time::isValid(i) ?
                                     i :
-                                    request.timeline->getTimeRange().start_time()));
+                                    request.timeline->getTimeRange().start_time())));
                             }
                         }
                         catch (const std::exception& e)
@@ -287,17 +340,16 @@ namespace tl
                     }
 
                     // Check for finished requests.
-                    std::vector<Private::Result> results;
                     auto requestIt = p.requestsInProgress.begin();
                     while (requestIt != p.requestsInProgress.end())
                     {
                         auto futureIt = requestIt->futures.begin();
                         while (futureIt != requestIt->futures.end())
                         {
-                            if (futureIt->valid() &&
-                                futureIt->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                            if (futureIt->second.valid() &&
+                                futureIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                             {
-                                const auto videoData = futureIt->get();
+                                const auto videoData = futureIt->second.get();
                                 const image::Info info(
                                     requestIt->size.width(),
                                     requestIt->size.height(),
@@ -306,6 +358,7 @@ namespace tl
                                     static_cast<size_t>(info.size.w) *
                                     static_cast<size_t>(info.size.h) * 4);
 
+                                bool valid = false;
                                 try
                                 {
                                     gl::OffscreenBufferOptions offscreenBufferOptions;
@@ -334,6 +387,7 @@ namespace tl
                                         GL_RGBA,
                                         GL_UNSIGNED_BYTE,
                                         pixelData.data());
+                                    valid = !videoData.layers.empty();
                                 }
                                 catch (const std::exception& e)
                                 {
@@ -349,6 +403,25 @@ namespace tl
                                     info.size.h,
                                     info.size.w * 4,
                                     QImage::Format_RGBA8888).mirrored();
+                                if (thumbnailSystem && valid)
+                                {
+                                    auto image = image::Image::create(info);
+                                    for (int y = 0; y < info.size.h; ++y)
+                                    {
+                                        std::memcpy(
+                                            image->getData() + y * info.size.w * 4,
+                                            qImage.constScanLine(y),
+                                            info.size.w * 4);
+                                    }
+                                    thumbnailSystem->addThumbnail(
+                                        file::Path(requestIt->fileName.toUtf8().data()),
+                                        futureIt->first,
+                                        0,
+                                        info.size,
+                                        image,
+                                        requestIt->colorConfigOptions,
+                                        requestIt->lutOptions);
+                                }
                                 {
                                     const auto i = std::find_if(
                                         results.begin(),
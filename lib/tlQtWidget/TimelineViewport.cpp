@@ -9,6 +9,7 @@
 #include <tlGL/Init.h>
 #include <tlGL/Mesh.h>
 #include <tlGL/OffscreenBuffer.h>
+#include <tlGL/PixelBufferRing.h>
 #include <tlGL/Shader.h>
 
 #include <tlCore/Mesh.h>
@@ -22,6 +23,26 @@ namespace tl
 {
     namespace qtwidget
     {
+        namespace
+        {
+            //! Size of the pixel buffer ring used to stage the player frames.
+            const size_t pixelBufferRingByteCount = memory::megabyte * 256;
+
+            void setImageAllocator(
+                const QVector<QSharedPointer<qt::TimelinePlayer> >& players,
+                const std::shared_ptr<gl::PixelBufferRing>& ring)
+            {
+                for (const auto& player : players)
+                {
+                    if (player)
+                    {
+                        player->player()->setImageAllocator(
+                            ring ? ring->getImageAllocator() : image::Allocator());
+                    }
+                }
+            }
+        }
+
         struct TimelineViewport::Private
         {
             std::weak_ptr<system::Context> context;
@@ -46,7 +67,8 @@ namespace tl
             math::Vector2i mousePress;
             math::Vector2i viewPosMousePress;
             std::vector<timeline::VideoData> videoData;
-            std::shared_ptr<timeline::IRender> render;
+            std::shared_ptr<timeline::GLRender> render;
+            std::weak_ptr<gl::PixelBufferRing> pixelBufferRing;
             std::shared_ptr<tl::gl::Shader> shader;
             std::shared_ptr<tl::gl::OffscreenBuffer> buffer;
             std::shared_ptr<gl::VBO> vbo;
@@ -75,7 +97,13 @@ namespace tl
         }
 
         TimelineViewport::~TimelineViewport()
-        {}
+        {
+            TLRENDER_P();
+            if (!p.pixelBufferRing.expired())
+            {
+                setImageAllocator(p.timelinePlayers, nullptr);
+            }
+        }
 
         void TimelineViewport::setColorConfigOptions(const timeline::ColorConfigOptions& value)
         {
@@ -138,6 +166,31 @@ namespace tl
                 }
             }
 
+            // The frames of the players are staged in the pixel buffer ring
+            // of the renderer. Setting the allocator clears the cache of the
+            // player, so it is only changed for players that are added or
+            // removed.
+            if (auto ring = p.pixelBufferRing.lock())
+            {
+                QVector<QSharedPointer<qt::TimelinePlayer> > removed;
+                for (const auto& player : p.timelinePlayers)
+                {
+                    if (!value.contains(player))
+                    {
+                        removed.push_back(player);
+                    }
+                }
+                setImageAllocator(removed, nullptr);
+                QVector<QSharedPointer<qt::TimelinePlayer> > added;
+                for (const auto& player : value)
+                {
+                    if (!p.timelinePlayers.contains(player))
+                    {
+                        added.push_back(player);
+                    }
+                }
+                setImageAllocator(added, ring);
+            }
             p.timelinePlayers = value;
 
             p.timelineSizes.clear();
@@ -363,10 +416,19 @@ namespace tl
                 if (p.buffer)
                 {
                     gl::OffscreenBufferBinding binding(p.buffer);
+                    timeline::RenderOptions renderOptions;
+                    renderOptions.pixelBufferRingByteCount = pixelBufferRingByteCount;
                     p.render->begin(
                         renderSize,
                         p.colorConfigOptions,
-                        p.lutOptions); 
+                        p.lutOptions,
+                        renderOptions);
+                    const auto& ring = p.render->getPixelBufferRing();
+                    if (ring != p.pixelBufferRing.lock())
+                    {
+                        p.pixelBufferRing = ring;
+                        setImageAllocator(p.timelinePlayers, ring);
+                    }
                     if (!p.videoData.empty())
                     {
                         p.render->drawVideo(
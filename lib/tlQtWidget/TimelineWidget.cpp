@@ -184,6 +184,11 @@ namespace tl
             return _p->timelineWidget->getItemOptions();
         }
 
+        const std::shared_ptr<timelineui::WaveformCache>& TimelineWidget::waveformCache() const
+        {
+            return _p->timelineWidget->getWaveformCache();
+        }
+
         void TimelineWidget::setFrameView(bool value)
         {
             _p->timelineWidget->setFrameView(value);
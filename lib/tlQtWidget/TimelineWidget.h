@@ -55,6 +55,9 @@ namespace tl
             //! Get the item options.
             const timelineui::ItemOptions& itemOptions() const;
 
+            //! Get the waveform cache.
+            const std::shared_ptr<timelineui::WaveformCache>& waveformCache() const;
+
         public Q_SLOTS:
 
             //! Set whether the to frame the view.
@@ -0,0 +1,585 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/CPURenderPrivate.h>
+
+#include <tlCore/ImageConvert.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+
+namespace tl
+{
+    namespace timeline
+    {
+        CPURenderThreads::CPURenderThreads(size_t count) :
+            _next(0)
+        {
+            for (size_t i = 1; i < count; ++i)
+            {
+                _threads.push_back(std::thread(
+                    [this]
+                    {
+                        size_t generation = 0;
+                        while (true)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                _cv.wait(
+                                    lock,
+                                    [this, generation]
+                                    {
+                                        return !_running || _generation != generation;
+                                    });
+                                if (!_running)
+                                {
+                                    break;
+                                }
+                                generation = _generation;
+                            }
+                            _work();
+                            {
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                --_pending;
+                            }
+                            _doneCV.notify_one();
+                        }
+                    }));
+            }
+        }
+
+        CPURenderThreads::~CPURenderThreads()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _cv.notify_all();
+            for (auto& thread : _threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        size_t CPURenderThreads::getCount() const
+        {
+            return _threads.size() + 1;
+        }
+
+        void CPURenderThreads::run(size_t jobCount, const std::function<void(size_t)>& job)
+        {
+            if (_threads.empty() || jobCount < 2)
+            {
+                for (size_t i = 0; i < jobCount; ++i)
+                {
+                    job(i);
+                }
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _job = &job;
+                _jobCount = jobCount;
+                _next = 0;
+                _pending = _threads.size();
+                ++_generation;
+            }
+            _cv.notify_all();
+            _work();
+            std::unique_lock<std::mutex> lock(_mutex);
+            _doneCV.wait(
+                lock,
+                [this]
+                {
+                    return 0 == _pending;
+                });
+            _job = nullptr;
+        }
+
+        void CPURenderThreads::_work()
+        {
+            for (size_t i = _next++; i < _jobCount; i = _next++)
+            {
+                (*_job)(i);
+            }
+        }
+
+        void CPURender::Private::setBuffer(const std::shared_ptr<image::Image>& value)
+        {
+            state.target = value;
+            state.viewport = math::Box2i(0, 0, value->getWidth(), value->getHeight());
+            state.clipRectEnabled = false;
+            state.transform = math::ortho(
+                0.F,
+                static_cast<float>(value->getWidth()),
+                static_cast<float>(value->getHeight()),
+                0.F,
+                -1.F,
+                1.F);
+            state.maskEnabled = false;
+        }
+
+        std::shared_ptr<image::Image> CPURender::Private::getBuffer(
+            const std::string& name,
+            const image::Size& size)
+        {
+            auto& out = buffers[name];
+            if (!out || out->getSize() != size)
+            {
+                image::Info info(size, image::PixelType::RGBA_F32);
+                info.layout.mirror.y = true;
+                out = image::Image::create(info);
+            }
+            return out;
+        }
+
+        std::shared_ptr<image::Image> CPURender::Private::getTexture(
+            const std::shared_ptr<image::Image>& value,
+            image::VideoLevels videoLevels)
+        {
+            for (auto i = textureCache.begin(); i != textureCache.end();)
+            {
+                const auto image = i->image.lock();
+                if (!image)
+                {
+                    i = textureCache.erase(i);
+                    continue;
+                }
+                if (image == value && i->videoLevels == videoLevels)
+                {
+                    textureCache.splice(textureCache.begin(), textureCache, i);
+                    return textureCache.front().texture;
+                }
+                ++i;
+            }
+
+            // Convert the image to RGBA float with the rows ordered from top
+            // to bottom. The video levels override is applied by referencing
+            // the image data with different information.
+            std::shared_ptr<image::Image> in = value;
+            if (videoLevels != value->getInfo().videoLevels)
+            {
+                image::Info info = value->getInfo();
+                info.videoLevels = videoLevels;
+                in = image::Image::create(info, value->getData(), value);
+            }
+            image::Info info(value->getSize(), image::PixelType::RGBA_F32);
+            info.layout.mirror.y = true;
+            auto texture = image::Image::create(info);
+            const int h = texture->getHeight();
+            run(
+                0,
+                h - 1,
+                texture->getWidth() * h,
+                [in, texture](int y0, int y1)
+                {
+                    image::convert(in, texture, math::SizeTRange(y0, y1));
+                });
+
+            TextureCacheItem item;
+            item.image = value;
+            item.videoLevels = videoLevels;
+            item.texture = texture;
+            textureCache.push_front(item);
+            return texture;
+        }
+
+        void CPURender::Private::run(
+            int y0,
+            int y1,
+            size_t pixelCount,
+            const std::function<void(int, int)>& func)
+        {
+            const int rows = y1 - y0 + 1;
+            if (rows <= 0)
+                return;
+            const size_t threadCount = threads ? threads->getCount() : 1;
+            size_t bandCount = 1;
+            if (threadCount > 1 && pixelCount >= 64 * 64)
+            {
+                bandCount = std::min(threadCount * 4, static_cast<size_t>(rows + 7) / 8);
+            }
+            if (bandCount < 2)
+            {
+                func(y0, y1);
+                return;
+            }
+            const int bandRows = (rows + bandCount - 1) / bandCount;
+            bandCount = (rows + bandRows - 1) / bandRows;
+            threads->run(
+                bandCount,
+                [y0, y1, bandRows, &func](size_t index)
+                {
+                    const int start = y0 + static_cast<int>(index) * bandRows;
+                    func(start, std::min(start + bandRows - 1, y1));
+                });
+        }
+
+        math::Vector2f CPURender::Private::toPixel(const math::Vector2f& value) const
+        {
+            const float* e = state.transform.e;
+            float x = e[0] * value.x + e[4] * value.y + e[12];
+            float y = e[1] * value.x + e[5] * value.y + e[13];
+            const float w = e[3] * value.x + e[7] * value.y + e[15];
+            if (w != 0.F && w != 1.F)
+            {
+                x /= w;
+                y /= w;
+            }
+            return math::Vector2f(
+                state.viewport.min.x + (x + 1.F) * .5F * state.viewport.w(),
+                state.viewport.min.y + (1.F - y) * .5F * state.viewport.h());
+        }
+
+        math::Box2i CPURender::Private::getBounds() const
+        {
+            math::Box2i out;
+            if (state.target)
+            {
+                out = math::Box2i(
+                    0,
+                    0,
+                    state.target->getWidth(),
+                    state.target->getHeight()).intersect(state.viewport);
+                if (state.clipRectEnabled)
+                {
+                    out = out.intersect(state.clipRect);
+                }
+            }
+            return out;
+        }
+
+        bool CPURender::Private::isMinified(const math::Box2i& box, const image::Size& size) const
+        {
+            const math::Vector2f p00 = toPixel(math::Vector2f(box.min.x, box.min.y));
+            const math::Vector2f p10 = toPixel(math::Vector2f(box.max.x + 1, box.min.y));
+            const math::Vector2f p01 = toPixel(math::Vector2f(box.min.x, box.max.y + 1));
+            const float w = math::length(p10 - p00);
+            const float h = math::length(p01 - p00);
+            return size.w > w || size.h > h;
+        }
+
+        void CPURender::Private::clear(const image::Color4f& color)
+        {
+            if (!state.target)
+                return;
+            math::Box2i bounds(0, 0, state.target->getWidth(), state.target->getHeight());
+            if (state.clipRectEnabled)
+            {
+                bounds = bounds.intersect(state.clipRect);
+            }
+            if (bounds.min.x > bounds.max.x || bounds.min.y > bounds.max.y)
+                return;
+            float* data = reinterpret_cast<float*>(state.target->getData());
+            const size_t width = state.target->getWidth();
+            run(
+                bounds.min.y,
+                bounds.max.y,
+                bounds.w() * bounds.h(),
+                [data, width, bounds, color](int y0, int y1)
+                {
+                    for (int y = y0; y <= y1; ++y)
+                    {
+                        float* p = data + (y * width + bounds.min.x) * 4;
+                        for (int x = bounds.min.x; x <= bounds.max.x; ++x, p += 4)
+                        {
+                            p[0] = color.r;
+                            p[1] = color.g;
+                            p[2] = color.b;
+                            p[3] = color.a;
+                        }
+                    }
+                });
+        }
+
+        void CPURender::Private::colorManagementSpan(float* data, size_t count) const
+        {
+#if defined(TLRENDER_OCIO)
+            if (colorConfigProcessor || lutProcessor)
+            {
+                OCIO::PackedImageDesc desc(data, count, 1, 4);
+                switch (lutOptions.order)
+                {
+                case LUTOrder::PreColorConfig:
+                    if (lutProcessor)
+                    {
+                        lutProcessor->apply(desc);
+                    }
+                    if (colorConfigProcessor)
+                    {
+                        colorConfigProcessor->apply(desc);
+                    }
+                    break;
+                case LUTOrder::PostColorConfig:
+                    if (colorConfigProcessor)
+                    {
+                        colorConfigProcessor->apply(desc);
+                    }
+                    if (lutProcessor)
+                    {
+                        lutProcessor->apply(desc);
+                    }
+                    break;
+                default: break;
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void CPURender::_init(const std::shared_ptr<system::Context>& context)
+        {
+            IRender::_init(context);
+            setThreadCount(0);
+        }
+
+        CPURender::CPURender() :
+            _p(new Private)
+        {}
+
+        CPURender::~CPURender()
+        {}
+
+        std::shared_ptr<CPURender> CPURender::create(const std::shared_ptr<system::Context>& context)
+        {
+            auto out = std::shared_ptr<CPURender>(new CPURender);
+            out->_init(context);
+            return out;
+        }
+
+        size_t CPURender::getThreadCount() const
+        {
+            return _p->threads ? _p->threads->getCount() : 1;
+        }
+
+        void CPURender::setThreadCount(size_t value)
+        {
+            TLRENDER_P();
+            const size_t count = value > 0 ?
+                value :
+                std::max(std::thread::hardware_concurrency(), 1U);
+            if (p.threads && count == p.threads->getCount())
+                return;
+            p.threads.reset(new CPURenderThreads(count));
+            if (auto context = _context.lock())
+            {
+                context->log(
+                    "tl::timeline::CPURender",
+                    string::Format("Render threads: {0}").arg(count));
+            }
+        }
+
+        const std::shared_ptr<image::Image>& CPURender::getImage() const
+        {
+            return _p->image;
+        }
+
+        void CPURender::begin(
+            const image::Size& renderSize,
+            const ColorConfigOptions& colorConfigOptions,
+            const LUTOptions& lutOptions,
+            const RenderOptions& renderOptions)
+        {
+            TLRENDER_P();
+
+            p.renderSize = renderSize;
+            _setColorConfig(colorConfigOptions);
+            _setLUT(lutOptions);
+            p.renderOptions = renderOptions;
+
+            if (!p.image || p.image->getSize() != renderSize)
+            {
+                image::Info info(renderSize, image::PixelType::RGBA_F32);
+                info.layout.mirror.y = true;
+                p.image = image::Image::create(info);
+                p.image->zero();
+            }
+            p.state.target = p.image;
+            p.state.maskEnabled = false;
+
+            setViewport(math::Box2i(0, 0, renderSize.w, renderSize.h));
+            if (renderOptions.clear)
+            {
+                clearViewport(renderOptions.clearColor);
+            }
+            setTransform(math::ortho(
+                0.F,
+                static_cast<float>(renderSize.w),
+                static_cast<float>(renderSize.h),
+                0.F,
+                -1.F,
+                1.F));
+        }
+
+        void CPURender::end()
+        {
+            TLRENDER_P();
+            // Converted images are only kept for the duration of a render,
+            // since RGBA float copies of large frames use a lot of memory.
+            p.textureCache.clear();
+        }
+
+        image::Size CPURender::getRenderSize() const
+        {
+            return _p->renderSize;
+        }
+
+        void CPURender::setRenderSize(const image::Size& value)
+        {
+            _p->renderSize = value;
+        }
+
+        math::Box2i CPURender::getViewport() const
+        {
+            return _p->state.viewport;
+        }
+
+        void CPURender::setViewport(const math::Box2i& value)
+        {
+            _p->state.viewport = value;
+        }
+
+        void CPURender::clearViewport(const image::Color4f& value)
+        {
+            _p->clear(value);
+        }
+
+        bool CPURender::getClipRectEnabled() const
+        {
+            return _p->state.clipRectEnabled;
+        }
+
+        void CPURender::setClipRectEnabled(bool value)
+        {
+            _p->state.clipRectEnabled = value;
+        }
+
+        math::Box2i CPURender::getClipRect() const
+        {
+            return _p->state.clipRect;
+        }
+
+        void CPURender::setClipRect(const math::Box2i& value)
+        {
+            _p->state.clipRect = value;
+        }
+
+        math::Matrix4x4f CPURender::getTransform() const
+        {
+            return _p->state.transform;
+        }
+
+        void CPURender::setTransform(const math::Matrix4x4f& value)
+        {
+            _p->state.transform = value;
+        }
+
+        void CPURender::_setColorConfig(const ColorConfigOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.colorConfigOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.colorConfigProcessor.reset();
+#endif // TLRENDER_OCIO
+
+            p.colorConfigOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.colorConfigOptions.enabled &&
+                !p.colorConfigOptions.input.empty() &&
+                !p.colorConfigOptions.display.empty() &&
+                !p.colorConfigOptions.view.empty())
+            {
+                OCIO::ConstConfigRcPtr config;
+                if (!p.colorConfigOptions.fileName.empty())
+                {
+                    config = OCIO::Config::CreateFromFile(p.colorConfigOptions.fileName.c_str());
+                }
+                else
+                {
+                    config = OCIO::GetCurrentConfig();
+                }
+                if (!config)
+                {
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+
+                auto transform = OCIO::DisplayViewTransform::Create();
+                if (!transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                transform->setSrc(p.colorConfigOptions.input.c_str());
+                transform->setDisplay(p.colorConfigOptions.display.c_str());
+                transform->setView(p.colorConfigOptions.view.c_str());
+
+                auto lvp = OCIO::LegacyViewingPipeline::Create();
+                if (!lvp)
+                {
+                    throw std::runtime_error("Cannot create OCIO viewing pipeline");
+                }
+                lvp->setDisplayViewTransform(transform);
+                lvp->setLooksOverrideEnabled(true);
+                lvp->setLooksOverride(p.colorConfigOptions.look.c_str());
+
+                auto processor = lvp->getProcessor(config, config->getCurrentContext());
+                if (!processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                p.colorConfigProcessor = processor->getDefaultCPUProcessor();
+                if (!p.colorConfigProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void CPURender::_setLUT(const LUTOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.lutOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.lutProcessor.reset();
+#endif // TLRENDER_OCIO
+
+            p.lutOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
+            {
+                auto config = OCIO::Config::CreateRaw();
+                if (!config)
+                {
+                    throw std::runtime_error("Cannot create OCIO configuration");
+                }
+                auto transform = OCIO::FileTransform::Create();
+                if (!transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                transform->setSrc(p.lutOptions.fileName.c_str());
+                transform->validate();
+                auto processor = config->getProcessor(transform);
+                if (!processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                p.lutProcessor = processor->getDefaultCPUProcessor();
+                if (!p.lutProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+    }
+}
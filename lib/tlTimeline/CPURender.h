@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/IRender.h>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Software renderer.
+        //!
+        //! The renderer draws into an image in memory, so it can be used on
+        //! machines without a GPU. The results match the OpenGL renderer
+        //! within a small tolerance. Rows of pixels are split across a
+        //! pool of threads, and the blending kernels use SSE2 where it is
+        //! available.
+        //!
+        //! Differences from the OpenGL renderer:
+        //! - OpenGL textures cannot be drawn, so drawTexture() does nothing.
+        //! - Images are filtered with nearest or bilinear sampling without
+        //!   mipmaps.
+        //! - Color configurations and LUTs are applied with the OpenColorIO
+        //!   CPU processors.
+        class CPURender : public IRender
+        {
+            TLRENDER_NON_COPYABLE(CPURender);
+
+        protected:
+            void _init(const std::shared_ptr<system::Context>&);
+            CPURender();
+
+        public:
+            virtual ~CPURender();
+
+            //! Create a new renderer.
+            static std::shared_ptr<CPURender> create(const std::shared_ptr<system::Context>&);
+
+            //! Get the number of threads used for rendering.
+            size_t getThreadCount() const;
+
+            //! Set the number of threads used for rendering. A value of zero
+            //! uses the number of hardware threads.
+            void setThreadCount(size_t);
+
+            //! Get the rendered image. The image has the render size and the
+            //! pixel type RGBA_F32, and the rows are ordered from top to
+            //! bottom. The image is re-used between renders.
+            const std::shared_ptr<image::Image>& getImage() const;
+
+            void begin(
+                const image::Size&,
+                const ColorConfigOptions& = ColorConfigOptions(),
+                const LUTOptions& = LUTOptions(),
+                const RenderOptions& = RenderOptions()) override;
+            void end() override;
+
+            image::Size getRenderSize() const override;
+            void setRenderSize(const image::Size&) override;
+            math::Box2i getViewport() const override;
+            void setViewport(const math::Box2i&) override;
+            void clearViewport(const image::Color4f&) override;
+            bool getClipRectEnabled() const override;
+            void setClipRectEnabled(bool) override;
+            math::Box2i getClipRect() const override;
+            void setClipRect(const math::Box2i&) override;
+            math::Matrix4x4f getTransform() const override;
+            void setTransform(const math::Matrix4x4f&) override;
+
+            void drawRect(
+                const math::Box2i&,
+                const image::Color4f&) override;
+            void drawMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawColorMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawText(
+                const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawTexture(
+                unsigned int,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F)) override;
+            void drawImage(
+                const std::shared_ptr<image::Image>&,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F),
+                const ImageOptions& = ImageOptions()) override;
+            void drawVideo(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>& = {},
+                const std::vector<DisplayOptions>& = {},
+                const CompareOptions& = CompareOptions()) override;
+
+        private:
+            void _setColorConfig(const ColorConfigOptions&);
+            void _setLUT(const LUTOptions&);
+            void _drawVideoA(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideoB(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideoWipe(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideoOverlay(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideoDifference(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideoTile(
+                const std::vector<VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<ImageOptions>&,
+                const std::vector<DisplayOptions>&,
+                const CompareOptions&);
+            void _drawVideo(
+                const VideoData&,
+                const math::Box2i&,
+                const std::shared_ptr<ImageOptions>&,
+                const DisplayOptions&);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
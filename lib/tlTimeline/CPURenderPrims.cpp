@@ -0,0 +1,622 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/CPURenderPrivate.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TLRENDER_CPU_RENDER_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+#if defined(TLRENDER_CPU_RENDER_SSE2)
+            inline __m128 select(__m128 mask, __m128 a, __m128 b)
+            {
+                return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+            }
+
+            inline __m128 lerp(__m128 a, __m128 b, __m128 t)
+            {
+                return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+            }
+#endif // TLRENDER_CPU_RENDER_SSE2
+
+            inline int clampIndex(int value, int size)
+            {
+                return value < 0 ? 0 : (value >= size ? size - 1 : value);
+            }
+
+            bool getSpan(const CPUTriangle& triangle, float y, float& left, float& right)
+            {
+                size_t count = 0;
+                float x[2] = { 0.F, 0.F };
+                for (size_t i = 0; i < 3 && count < 2; ++i)
+                {
+                    const math::Vector2f& a = triangle[i];
+                    const math::Vector2f& b = triangle[(i + 1) % 3];
+                    if ((a.y <= y && y < b.y) || (b.y <= y && y < a.y))
+                    {
+                        x[count] = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+                        ++count;
+                    }
+                }
+                if (count < 2)
+                    return false;
+                left = std::min(x[0], x[1]);
+                right = std::max(x[0], x[1]);
+                return true;
+            }
+        }
+
+        void blendSpan(float* dst, const float* src, size_t count, CPUBlend blend)
+        {
+#if defined(TLRENDER_CPU_RENDER_SSE2)
+            const __m128 one = _mm_set1_ps(1.F);
+            const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+            switch (blend)
+            {
+            case CPUBlend::Replace:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const __m128 s = _mm_loadu_ps(src);
+                    const __m128 d = _mm_loadu_ps(dst);
+                    _mm_storeu_ps(dst, _mm_add_ps(s, _mm_and_ps(d, alphaMask)));
+                }
+                break;
+            case CPUBlend::Straight:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const __m128 s = _mm_loadu_ps(src);
+                    const __m128 d = _mm_loadu_ps(dst);
+                    const __m128 sa = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                    const __m128 sf = select(alphaMask, sa, one);
+                    const __m128 df = select(alphaMask, _mm_sub_ps(one, sa), one);
+                    _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(s, sf), _mm_mul_ps(d, df)));
+                }
+                break;
+            case CPUBlend::Premultiplied:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const __m128 s = _mm_loadu_ps(src);
+                    const __m128 d = _mm_loadu_ps(dst);
+                    const __m128 sa = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                    const __m128 df = select(alphaMask, _mm_sub_ps(one, sa), one);
+                    _mm_storeu_ps(dst, _mm_add_ps(s, _mm_mul_ps(d, df)));
+                }
+                break;
+            case CPUBlend::Over:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const __m128 s = _mm_loadu_ps(src);
+                    const __m128 d = _mm_loadu_ps(dst);
+                    const __m128 sa = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                    _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(s, sa), _mm_mul_ps(d, _mm_sub_ps(one, sa))));
+                }
+                break;
+            default: break;
+            }
+#else // TLRENDER_CPU_RENDER_SSE2
+            switch (blend)
+            {
+            case CPUBlend::Replace:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    dst[0] = src[0];
+                    dst[1] = src[1];
+                    dst[2] = src[2];
+                    dst[3] = src[3] + dst[3];
+                }
+                break;
+            case CPUBlend::Straight:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const float sa = src[3];
+                    dst[0] = src[0] * sa + dst[0] * (1.F - sa);
+                    dst[1] = src[1] * sa + dst[1] * (1.F - sa);
+                    dst[2] = src[2] * sa + dst[2] * (1.F - sa);
+                    dst[3] = src[3] + dst[3];
+                }
+                break;
+            case CPUBlend::Premultiplied:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const float sa = src[3];
+                    dst[0] = src[0] + dst[0] * (1.F - sa);
+                    dst[1] = src[1] + dst[1] * (1.F - sa);
+                    dst[2] = src[2] + dst[2] * (1.F - sa);
+                    dst[3] = src[3] + dst[3];
+                }
+                break;
+            case CPUBlend::Over:
+                for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+                {
+                    const float sa = src[3];
+                    dst[0] = src[0] * sa + dst[0] * (1.F - sa);
+                    dst[1] = src[1] * sa + dst[1] * (1.F - sa);
+                    dst[2] = src[2] * sa + dst[2] * (1.F - sa);
+                    dst[3] = src[3] * sa + dst[3] * (1.F - sa);
+                }
+                break;
+            default: break;
+            }
+#endif // TLRENDER_CPU_RENDER_SSE2
+        }
+
+        void sampleSpan(
+            const image::Image& texture,
+            ImageFilter filter,
+            float u,
+            float v,
+            float dudx,
+            float dvdx,
+            size_t count,
+            float* out)
+        {
+            const int w = texture.getWidth();
+            const int h = texture.getHeight();
+            const float* data = reinterpret_cast<const float*>(texture.getData());
+            switch (filter)
+            {
+            case ImageFilter::Nearest:
+                for (size_t i = 0; i < count; ++i, out += 4)
+                {
+                    const int x = clampIndex(static_cast<int>(std::floor((u + dudx * i) * w)), w);
+                    const int y = clampIndex(static_cast<int>(std::floor((v + dvdx * i) * h)), h);
+                    const float* p = data + (y * w + x) * 4;
+                    out[0] = p[0];
+                    out[1] = p[1];
+                    out[2] = p[2];
+                    out[3] = p[3];
+                }
+                break;
+            case ImageFilter::Linear:
+                for (size_t i = 0; i < count; ++i, out += 4)
+                {
+                    const float fx = (u + dudx * i) * w - .5F;
+                    const float fy = (v + dvdx * i) * h - .5F;
+                    const float x0f = std::floor(fx);
+                    const float y0f = std::floor(fy);
+                    const float ax = fx - x0f;
+                    const float ay = fy - y0f;
+                    const int x0 = clampIndex(static_cast<int>(x0f), w);
+                    const int x1 = clampIndex(static_cast<int>(x0f) + 1, w);
+                    const int y0 = clampIndex(static_cast<int>(y0f), h);
+                    const int y1 = clampIndex(static_cast<int>(y0f) + 1, h);
+                    const float* p00 = data + (y0 * w + x0) * 4;
+                    const float* p10 = data + (y0 * w + x1) * 4;
+                    const float* p01 = data + (y1 * w + x0) * 4;
+                    const float* p11 = data + (y1 * w + x1) * 4;
+#if defined(TLRENDER_CPU_RENDER_SSE2)
+                    const __m128 tx = _mm_set1_ps(ax);
+                    _mm_storeu_ps(out, lerp(
+                        lerp(_mm_loadu_ps(p00), _mm_loadu_ps(p10), tx),
+                        lerp(_mm_loadu_ps(p01), _mm_loadu_ps(p11), tx),
+                        _mm_set1_ps(ay)));
+#else // TLRENDER_CPU_RENDER_SSE2
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        const float a = p00[c] + (p10[c] - p00[c]) * ax;
+                        const float b = p01[c] + (p11[c] - p01[c]) * ax;
+                        out[c] = a + (b - a) * ay;
+                    }
+#endif // TLRENDER_CPU_RENDER_SSE2
+                }
+                break;
+            default: break;
+            }
+        }
+
+        void multiplySpan(float* data, size_t count, const image::Color4f& color)
+        {
+            if (1.F == color.r && 1.F == color.g && 1.F == color.b && 1.F == color.a)
+                return;
+#if defined(TLRENDER_CPU_RENDER_SSE2)
+            const __m128 c = _mm_setr_ps(color.r, color.g, color.b, color.a);
+            for (size_t i = 0; i < count; ++i, data += 4)
+            {
+                _mm_storeu_ps(data, _mm_mul_ps(_mm_loadu_ps(data), c));
+            }
+#else // TLRENDER_CPU_RENDER_SSE2
+            for (size_t i = 0; i < count; ++i, data += 4)
+            {
+                data[0] *= color.r;
+                data[1] *= color.g;
+                data[2] *= color.b;
+                data[3] *= color.a;
+            }
+#endif // TLRENDER_CPU_RENDER_SSE2
+        }
+
+        void CPURender::Private::fill(
+            const std::vector<CPUTriangle>& triangles,
+            const SpanFunc& spanFunc,
+            CPUBlend blend)
+        {
+            const math::Box2i bounds = getBounds();
+            if (triangles.empty() ||
+                bounds.min.x > bounds.max.x ||
+                bounds.min.y > bounds.max.y)
+                return;
+
+            float minX = std::numeric_limits<float>::max();
+            float maxX = std::numeric_limits<float>::lowest();
+            float minY = std::numeric_limits<float>::max();
+            float maxY = std::numeric_limits<float>::lowest();
+            for (const auto& triangle : triangles)
+            {
+                for (const auto& v : triangle)
+                {
+                    minX = std::min(minX, v.x);
+                    maxX = std::max(maxX, v.x);
+                    minY = std::min(minY, v.y);
+                    maxY = std::max(maxY, v.y);
+                }
+            }
+            const int x0 = static_cast<int>(std::floor(std::max(minX, static_cast<float>(bounds.min.x))));
+            const int x1 = static_cast<int>(std::ceil(std::min(maxX, static_cast<float>(bounds.max.x))));
+            const int y0 = static_cast<int>(std::floor(std::max(minY, static_cast<float>(bounds.min.y))));
+            const int y1 = static_cast<int>(std::ceil(std::min(maxY, static_cast<float>(bounds.max.y))));
+            if (x0 > x1 || y0 > y1)
+                return;
+
+            float* data = reinterpret_cast<float*>(state.target->getData());
+            const size_t width = state.target->getWidth();
+            const State& s = state;
+            run(
+                y0,
+                y1,
+                (x1 - x0 + 1) * (y1 - y0 + 1),
+                [&triangles, &spanFunc, blend, data, width, x0, x1, &s](int start, int end)
+                {
+                    std::vector<float> row((x1 - x0 + 1) * 4);
+                    for (int y = start; y <= end; ++y)
+                    {
+                        const float yc = y + .5F;
+                        float* dst = data + y * width * 4;
+                        for (size_t i = 0; i < triangles.size(); ++i)
+                        {
+                            float left = 0.F;
+                            float right = 0.F;
+                            if (!getSpan(triangles[i], yc, left, right))
+                                continue;
+
+                            // Pixels are covered when their centers are inside
+                            // the triangle.
+                            int sx0 = static_cast<int>(std::ceil(
+                                std::min(std::max(left - .5F, static_cast<float>(x0)), x1 + 1.F)));
+                            int sx1 = static_cast<int>(std::ceil(
+                                std::max(std::min(right - .5F, x1 + 1.F), static_cast<float>(x0))));
+
+                            if (s.maskEnabled)
+                            {
+                                const float a = s.mask.x;
+                                const float k = s.mask.y * yc + s.mask.z;
+                                const auto inside = [a, k, &s](int x)
+                                {
+                                    const float v = a * (x + .5F) + k;
+                                    return s.maskStrict ? v > 0.F : v >= 0.F;
+                                };
+                                if (0.F == a)
+                                {
+                                    if (!inside(sx0))
+                                        continue;
+                                }
+                                else
+                                {
+                                    const float b = std::min(
+                                        std::max(-k / a - .5F, static_cast<float>(sx0)),
+                                        static_cast<float>(sx1));
+                                    if (a > 0.F)
+                                    {
+                                        const int start = sx0;
+                                        sx0 = static_cast<int>(std::ceil(b));
+                                        while (sx0 < sx1 && !inside(sx0))
+                                            ++sx0;
+                                        while (sx0 > start && inside(sx0 - 1))
+                                            --sx0;
+                                    }
+                                    else
+                                    {
+                                        const int end = sx1;
+                                        sx1 = static_cast<int>(std::floor(b)) + 1;
+                                        while (sx1 > sx0 && !inside(sx1 - 1))
+                                            --sx1;
+                                        while (sx1 < end && inside(sx1))
+                                            ++sx1;
+                                    }
+                                }
+                            }
+
+                            if (sx1 > sx0)
+                            {
+                                spanFunc(i, y, sx0, sx1, row.data());
+                                blendSpan(dst + sx0 * 4, row.data(), sx1 - sx0, blend);
+                            }
+                        }
+                    }
+                });
+        }
+
+        void CPURender::Private::fillQuad(
+            const math::Box2i& box,
+            const QuadFunc& quadFunc,
+            CPUBlend blend)
+        {
+            // The texture coordinates are interpolated linearly, so the
+            // transform should not contain a perspective projection.
+            const math::Vector2f p00 = toPixel(math::Vector2f(box.min.x, box.min.y));
+            const math::Vector2f p10 = toPixel(math::Vector2f(box.max.x + 1, box.min.y));
+            const math::Vector2f p11 = toPixel(math::Vector2f(box.max.x + 1, box.max.y + 1));
+            const math::Vector2f p01 = toPixel(math::Vector2f(box.min.x, box.max.y + 1));
+            const math::Vector2f e1 = p10 - p00;
+            const math::Vector2f e2 = p01 - p00;
+            const float det = e1.x * e2.y - e1.y * e2.x;
+            if (0.F == det)
+                return;
+            const float dudx = e2.y / det;
+            const float dudy = -e2.x / det;
+            const float dvdx = -e1.y / det;
+            const float dvdy = e1.x / det;
+            fill(
+                { { p00, p10, p11 }, { p11, p01, p00 } },
+                [&quadFunc, p00, dudx, dudy, dvdx, dvdy](size_t, int y, int x0, int x1, float* out)
+                {
+                    const float dx = x0 + .5F - p00.x;
+                    const float dy = y + .5F - p00.y;
+                    quadFunc(
+                        dx * dudx + dy * dudy,
+                        dx * dvdx + dy * dvdy,
+                        dudx,
+                        dvdx,
+                        x1 - x0,
+                        out);
+                },
+                blend);
+        }
+
+        void CPURender::drawRect(
+            const math::Box2i& box,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            const math::Vector2f p00 = p.toPixel(math::Vector2f(box.min.x, box.min.y));
+            const math::Vector2f p10 = p.toPixel(math::Vector2f(box.max.x + 1, box.min.y));
+            const math::Vector2f p11 = p.toPixel(math::Vector2f(box.max.x + 1, box.max.y + 1));
+            const math::Vector2f p01 = p.toPixel(math::Vector2f(box.min.x, box.max.y + 1));
+            p.fill(
+                { { p00, p10, p11 }, { p11, p01, p00 } },
+                [color](size_t, int, int x0, int x1, float* out)
+                {
+                    for (int x = x0; x < x1; ++x, out += 4)
+                    {
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a;
+                    }
+                },
+                CPUBlend::Over);
+        }
+
+        void CPURender::drawMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            std::vector<CPUTriangle> triangles;
+            triangles.reserve(mesh.triangles.size());
+            const math::Vector2f offset(position.x, position.y);
+            for (const auto& triangle : mesh.triangles)
+            {
+                triangles.push_back({
+                    p.toPixel(mesh.v[triangle.v[0].v - 1] + offset),
+                    p.toPixel(mesh.v[triangle.v[1].v - 1] + offset),
+                    p.toPixel(mesh.v[triangle.v[2].v - 1] + offset) });
+            }
+            p.fill(
+                triangles,
+                [color](size_t, int, int x0, int x1, float* out)
+                {
+                    for (int x = x0; x < x1; ++x, out += 4)
+                    {
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a;
+                    }
+                },
+                CPUBlend::Over);
+        }
+
+        void CPURender::drawColorMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+
+            // Compute the color gradients of each triangle in pixel space.
+            struct Gradient
+            {
+                math::Vector2f origin;
+                math::Vector4f c;
+                math::Vector4f dcdx;
+                math::Vector4f dcdy;
+            };
+            std::vector<CPUTriangle> triangles;
+            std::vector<Gradient> gradients;
+            triangles.reserve(mesh.triangles.size());
+            gradients.reserve(mesh.triangles.size());
+            const math::Vector2f offset(position.x, position.y);
+            for (const auto& triangle : mesh.triangles)
+            {
+                CPUTriangle t;
+                math::Vector4f c[3];
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    t[i] = p.toPixel(mesh.v[triangle.v[i].v - 1] + offset);
+                    const size_t index = triangle.v[i].c;
+                    c[i] = index ?
+                        mesh.c[index - 1] :
+                        math::Vector4f(1.F, 1.F, 1.F, 1.F);
+                    c[i].x *= color.r;
+                    c[i].y *= color.g;
+                    c[i].z *= color.b;
+                    c[i].w *= color.a;
+                }
+                const math::Vector2f e1 = t[1] - t[0];
+                const math::Vector2f e2 = t[2] - t[0];
+                const float det = e1.x * e2.y - e1.y * e2.x;
+                Gradient gradient;
+                gradient.origin = t[0];
+                gradient.c = c[0];
+                if (det != 0.F)
+                {
+                    const math::Vector4f d1 = c[1] - c[0];
+                    const math::Vector4f d2 = c[2] - c[0];
+                    gradient.dcdx = (d1 * e2.y - d2 * e1.y) * (1.F / det);
+                    gradient.dcdy = (d2 * e1.x - d1 * e2.x) * (1.F / det);
+                }
+                triangles.push_back(t);
+                gradients.push_back(gradient);
+            }
+            p.fill(
+                triangles,
+                [&gradients](size_t triangle, int y, int x0, int x1, float* out)
+                {
+                    const Gradient& g = gradients[triangle];
+                    const float dy = y + .5F - g.origin.y;
+                    for (int x = x0; x < x1; ++x, out += 4)
+                    {
+                        const float dx = x + .5F - g.origin.x;
+                        out[0] = g.c.x + g.dcdx.x * dx + g.dcdy.x * dy;
+                        out[1] = g.c.y + g.dcdx.y * dx + g.dcdy.y * dy;
+                        out[2] = g.c.z + g.dcdx.z * dx + g.dcdy.z * dy;
+                        out[3] = g.c.w + g.dcdx.w * dx + g.dcdy.w * dy;
+                    }
+                },
+                CPUBlend::Over);
+        }
+
+        void CPURender::drawText(
+            const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+            const math::Vector2i& pos,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            int x = 0;
+            int32_t rsbDeltaPrev = 0;
+            for (const auto& glyph : glyphs)
+            {
+                if (glyph)
+                {
+                    if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                    {
+                        x -= 1;
+                    }
+                    else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                    {
+                        x += 1;
+                    }
+                    rsbDeltaPrev = glyph->rsbDelta;
+
+                    if (glyph->image && glyph->image->isValid())
+                    {
+                        const math::Vector2i& offset = glyph->offset;
+                        const math::Box2i box(
+                            pos.x + x + offset.x,
+                            pos.y - offset.y,
+                            glyph->image->getWidth(),
+                            glyph->image->getHeight());
+                        const image::Image& image = *glyph->image;
+                        const int w = image.getWidth();
+                        const int h = image.getHeight();
+                        const size_t rowByteCount = image::getAlignedByteCount(
+                            w,
+                            image.getInfo().layout.alignment);
+                        const uint8_t* data = image.getData();
+                        p.fillQuad(
+                            box,
+                            [color, w, h, rowByteCount, data](
+                                float u, float v, float dudx, float dvdx, size_t count, float* out)
+                            {
+                                for (size_t i = 0; i < count; ++i, out += 4)
+                                {
+                                    const int tx = clampIndex(static_cast<int>(std::floor((u + dudx * i) * w)), w);
+                                    const int ty = clampIndex(static_cast<int>(std::floor((v + dvdx * i) * h)), h);
+                                    out[0] = color.r;
+                                    out[1] = color.g;
+                                    out[2] = color.b;
+                                    out[3] = color.a * data[ty * rowByteCount + tx] / 255.F;
+                                }
+                            },
+                            CPUBlend::Over);
+                    }
+
+                    x += glyph->advance;
+                }
+            }
+        }
+
+        void CPURender::drawTexture(
+            unsigned int,
+            const math::Box2i&,
+            const image::Color4f&)
+        {
+            // OpenGL textures are not available to the software renderer.
+        }
+
+        void CPURender::drawImage(
+            const std::shared_ptr<image::Image>& image,
+            const math::Box2i& box,
+            const image::Color4f& color,
+            const ImageOptions& imageOptions)
+        {
+            TLRENDER_P();
+            if (!image || !image->isValid())
+                return;
+
+            const auto& info = image->getInfo();
+            image::VideoLevels videoLevels = info.videoLevels;
+            switch (imageOptions.videoLevels)
+            {
+            case InputVideoLevels::FullRange:  videoLevels = image::VideoLevels::FullRange;  break;
+            case InputVideoLevels::LegalRange: videoLevels = image::VideoLevels::LegalRange; break;
+            default: break;
+            }
+            const auto texture = p.getTexture(image, videoLevels);
+
+            const ImageFilter filter = p.isMinified(box, info.size) ?
+                imageOptions.imageFilters.minify :
+                imageOptions.imageFilters.magnify;
+            CPUBlend blend = CPUBlend::Straight;
+            switch (imageOptions.alphaBlend)
+            {
+            case AlphaBlend::None: blend = CPUBlend::Replace; break;
+            case AlphaBlend::Straight: blend = CPUBlend::Straight; break;
+            case AlphaBlend::Premultiplied: blend = CPUBlend::Premultiplied; break;
+            default: break;
+            }
+            p.fillQuad(
+                box,
+                [&texture, filter, color](
+                    float u, float v, float dudx, float dvdx, size_t count, float* out)
+                {
+                    sampleSpan(*texture, filter, u, v, dudx, dvdx, count, out);
+                    multiplySpan(out, count, color);
+                },
+                blend);
+        }
+    }
+}
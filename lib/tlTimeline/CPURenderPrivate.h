@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/CPURender.h>
+
+#if defined(TLRENDER_OCIO)
+#include <OpenColorIO/OpenColorIO.h>
+#endif // TLRENDER_OCIO
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(TLRENDER_OCIO)
+namespace OCIO = OCIO_NAMESPACE;
+#endif // TLRENDER_OCIO
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Software blending modes. These match the OpenGL blend functions
+        //! used by the OpenGL renderer.
+        enum class CPUBlend
+        {
+            Replace,       //!< (ONE, ZERO) and (ONE, ONE) for alpha
+            Straight,      //!< (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) and (ONE, ONE) for alpha
+            Premultiplied, //!< (ONE, ONE_MINUS_SRC_ALPHA) and (ONE, ONE) for alpha
+            Over           //!< (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+        };
+
+        //! Blend a span of RGBA float pixels.
+        void blendSpan(float* dst, const float* src, size_t count, CPUBlend);
+
+        //! Sample a span of pixels from an RGBA float image. The texture
+        //! coordinates are normalized and the rows of the image are ordered
+        //! from top to bottom.
+        void sampleSpan(
+            const image::Image&,
+            ImageFilter,
+            float u,
+            float v,
+            float dudx,
+            float dvdx,
+            size_t count,
+            float* out);
+
+        //! Multiply a span of RGBA float pixels by a color.
+        void multiplySpan(float*, size_t count, const image::Color4f&);
+
+        //! Display pipeline values.
+        struct CPUDisplay
+        {
+            CPUDisplay(const DisplayOptions&);
+
+            Channels           channels          = Channels::Color;
+            bool               colorEnabled      = false;
+            math::Vector3f     colorAdd;
+            math::Matrix4x4f   colorMatrix;
+            bool               colorInvert       = false;
+            bool               levelsEnabled     = false;
+            Levels             levels;
+            float              levelsGamma       = 1.F;
+            bool               exrDisplayEnabled = false;
+            float              exrDisplayV       = 0.F;
+            float              exrDisplayD       = 0.F;
+            float              exrDisplayK       = 0.F;
+            float              exrDisplayF       = 0.F;
+            float              softClip          = 0.F;
+            image::VideoLevels videoLevels       = image::VideoLevels::FullRange;
+        };
+
+        //! Apply the display pipeline to a span of RGBA float pixels. Color
+        //! management is applied separately.
+        void displaySpan(float*, size_t count, const CPUDisplay&);
+
+        //! Pixel space triangle.
+        typedef std::array<math::Vector2f, 3> CPUTriangle;
+
+        //! Thread pool for rendering rows of pixels.
+        class CPURenderThreads
+        {
+        public:
+            //! Create a pool with the given number of threads, including the
+            //! calling thread.
+            explicit CPURenderThreads(size_t);
+
+            ~CPURenderThreads();
+
+            //! Get the number of threads, including the calling thread.
+            size_t getCount() const;
+
+            //! Run the jobs and wait for them to finish. The calling thread
+            //! also runs jobs.
+            void run(size_t jobCount, const std::function<void(size_t)>&);
+
+        private:
+            void _work();
+
+            std::vector<std::thread> _threads;
+            std::mutex _mutex;
+            std::condition_variable _cv;
+            std::condition_variable _doneCV;
+            bool _running = true;
+            size_t _generation = 0;
+            size_t _pending = 0;
+            const std::function<void(size_t)>* _job = nullptr;
+            size_t _jobCount = 0;
+            std::atomic<size_t> _next;
+        };
+
+        struct CPURender::Private
+        {
+            image::Size renderSize;
+            ColorConfigOptions colorConfigOptions;
+            LUTOptions lutOptions;
+            RenderOptions renderOptions;
+#if defined(TLRENDER_OCIO)
+            OCIO::ConstCPUProcessorRcPtr colorConfigProcessor;
+            OCIO::ConstCPUProcessorRcPtr lutProcessor;
+#endif // TLRENDER_OCIO
+
+            std::shared_ptr<image::Image> image;
+
+            //! The render target and the state that applies to it.
+            struct State
+            {
+                std::shared_ptr<image::Image> target;
+                math::Box2i viewport;
+                bool clipRectEnabled = false;
+                math::Box2i clipRect;
+                math::Matrix4x4f transform;
+
+                //! Half-plane mask used for wipes. Pixels are drawn where
+                //! a * x + b * y + c >= 0, or > 0 when the mask is strict.
+                bool maskEnabled = false;
+                bool maskStrict = false;
+                math::Vector3f mask;
+            };
+            State state;
+
+            //! Set the render target to an offscreen buffer.
+            void setBuffer(const std::shared_ptr<image::Image>&);
+
+            std::map<std::string, std::shared_ptr<image::Image> > buffers;
+            std::shared_ptr<image::Image> getBuffer(const std::string&, const image::Size&);
+
+            //! Images converted to RGBA float, kept until the end of the
+            //! render.
+            struct TextureCacheItem
+            {
+                std::weak_ptr<image::Image> image;
+                image::VideoLevels videoLevels = image::VideoLevels::FullRange;
+                std::shared_ptr<image::Image> texture;
+            };
+            std::list<TextureCacheItem> textureCache;
+            std::shared_ptr<image::Image> getTexture(
+                const std::shared_ptr<image::Image>&,
+                image::VideoLevels);
+
+            std::unique_ptr<CPURenderThreads> threads;
+
+            //! Split a range of rows across the threads. Small ranges are
+            //! run on the calling thread.
+            void run(
+                int y0,
+                int y1,
+                size_t pixelCount,
+                const std::function<void(int, int)>&);
+
+            math::Vector2f toPixel(const math::Vector2f&) const;
+            math::Box2i getBounds() const;
+            bool isMinified(const math::Box2i&, const image::Size&) const;
+
+            void clear(const image::Color4f&);
+
+            //! Fill triangles in pixel space. The span function fills the
+            //! RGBA source pixels for [x0, x1) on row y of the given triangle.
+            typedef std::function<void(size_t triangle, int y, int x0, int x1, float* out)> SpanFunc;
+            void fill(const std::vector<CPUTriangle>&, const SpanFunc&, CPUBlend);
+
+            //! Fill a box with texture coordinates. The quad function fills
+            //! the RGBA source pixels of a span given the texture coordinates
+            //! of the first pixel and their derivatives along the span.
+            typedef std::function<void(float u, float v, float dudx, float dvdx, size_t count, float* out)> QuadFunc;
+            void fillQuad(const math::Box2i&, const QuadFunc&, CPUBlend);
+
+            //! Apply color management to a span of RGBA float pixels.
+            void colorManagementSpan(float*, size_t count) const;
+        };
+    }
+}
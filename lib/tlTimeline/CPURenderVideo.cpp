@@ -0,0 +1,596 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/CPURenderPrivate.h>
+
+#include <tlCore/Math.h>
+
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return logf(x * f + 1.F) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.F;
+                float f1 = 1.F;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.F;
+                }
+                for (size_t i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.F;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.F;
+            }
+        }
+
+        CPUDisplay::CPUDisplay(const DisplayOptions& value) :
+            channels(value.channels),
+            colorEnabled(value.color != Color() && value.color.enabled),
+            colorAdd(value.color.add),
+            colorInvert(value.color.enabled ? value.color.invert : false),
+            levelsEnabled(value.levels.enabled),
+            levels(value.levels),
+            levelsGamma(value.levels.gamma > 0.F ? (1.F / value.levels.gamma) : 1000000.F),
+            exrDisplayEnabled(value.exrDisplay.enabled),
+            softClip(value.softClip.enabled ? value.softClip.value : 0.F),
+            videoLevels(value.videoLevels)
+        {
+            if (colorEnabled)
+            {
+                colorMatrix = color(value.color);
+            }
+            if (exrDisplayEnabled)
+            {
+                exrDisplayV = powf(2.F, value.exrDisplay.exposure + 2.47393F);
+                exrDisplayD = value.exrDisplay.defog;
+                exrDisplayK = powf(2.F, value.exrDisplay.kneeLow);
+                exrDisplayF = knee2(
+                    powf(2.F, value.exrDisplay.kneeHigh) - exrDisplayK,
+                    powf(2.F, 3.5F) - exrDisplayK);
+            }
+        }
+
+        void displaySpan(float* data, size_t count, const CPUDisplay& display)
+        {
+            const float* m = display.colorMatrix.e;
+            const float exrDisplayS = powf(2.F, -3.5F * display.levelsGamma);
+            for (size_t i = 0; i < count; ++i, data += 4)
+            {
+                float c[4] = { data[0], data[1], data[2], data[3] };
+
+                // Apply color transformations.
+                if (display.colorEnabled)
+                {
+                    const float t0 = c[0] + display.colorAdd.x;
+                    const float t1 = c[1] + display.colorAdd.y;
+                    const float t2 = c[2] + display.colorAdd.z;
+                    c[0] = m[0] * t0 + m[1] * t1 + m[2] * t2 + m[3];
+                    c[1] = m[4] * t0 + m[5] * t1 + m[6] * t2 + m[7];
+                    c[2] = m[8] * t0 + m[9] * t1 + m[10] * t2 + m[11];
+                }
+                if (display.colorInvert)
+                {
+                    c[0] = 1.F - c[0];
+                    c[1] = 1.F - c[1];
+                    c[2] = 1.F - c[2];
+                }
+                if (display.levelsEnabled)
+                {
+                    const Levels& levels = display.levels;
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        float t = (c[j] - levels.inLow) / levels.inHigh;
+                        if (t >= 0.F)
+                        {
+                            t = powf(t, display.levelsGamma);
+                        }
+                        c[j] = t * levels.outHigh + levels.outLow;
+                    }
+                }
+                if (display.exrDisplayEnabled)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        float t = std::max(0.F, c[j] - display.exrDisplayD) * display.exrDisplayV;
+                        if (t > display.exrDisplayK)
+                        {
+                            t = display.exrDisplayK + knee(t - display.exrDisplayK, display.exrDisplayF);
+                        }
+                        if (t > 0.F)
+                        {
+                            t = powf(t, display.levelsGamma);
+                        }
+                        c[j] = t * exrDisplayS;
+                    }
+                }
+                if (display.softClip > 0.F)
+                {
+                    const float t = 1.F - display.softClip;
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        if (c[j] > t)
+                        {
+                            c[j] = t + (1.F - expf(-(c[j] - t) / display.softClip)) * display.softClip;
+                        }
+                    }
+                }
+
+                // Swizzle for the channels display.
+                switch (display.channels)
+                {
+                case Channels::Red:   c[1] = c[2] = c[0]; break;
+                case Channels::Green: c[0] = c[2] = c[1]; break;
+                case Channels::Blue:  c[0] = c[1] = c[2]; break;
+                case Channels::Alpha: c[0] = c[1] = c[2] = c[3]; break;
+                default: break;
+                }
+
+                // Video levels.
+                if (image::VideoLevels::LegalRange == display.videoLevels)
+                {
+                    const float scale = (940.F - 64.F) / 1023.F;
+                    const float offset = 64.F / 1023.F;
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        c[j] = c[j] * scale + offset;
+                    }
+                }
+
+                data[0] = c[0];
+                data[1] = c[1];
+                data[2] = c[2];
+                data[3] = c[3];
+            }
+        }
+
+        void CPURender::drawVideo(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            switch (compareOptions.mode)
+            {
+            case CompareMode::A:
+                _drawVideoA(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case CompareMode::B:
+                _drawVideoB(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case CompareMode::Wipe:
+                _drawVideoWipe(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case CompareMode::Overlay:
+                _drawVideoOverlay(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case CompareMode::Difference:
+                if (videoData.size() > 1)
+                {
+                    _drawVideoDifference(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                else
+                {
+                    _drawVideoA(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                break;
+            case CompareMode::Horizontal:
+            case CompareMode::Vertical:
+            case CompareMode::Tile:
+                _drawVideoTile(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            default: break;
+            }
+        }
+
+        void CPURender::_drawVideoA(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : DisplayOptions());
+            }
+        }
+
+        void CPURender::_drawVideoB(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : DisplayOptions());
+            }
+        }
+
+        void CPURender::_drawVideoWipe(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            float radius = 0.F;
+            float x = 0.F;
+            float y = 0.F;
+            if (!boxes.empty())
+            {
+                radius = std::max(boxes[0].w(), boxes[0].h()) * 2.5F;
+                x = boxes[0].w() * compareOptions.wipeCenter.x;
+                y = boxes[0].h() * compareOptions.wipeCenter.y;
+            }
+            const float rotation = compareOptions.wipeRotation;
+            math::Vector2f pts[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                float rad = math::deg2rad(rotation + 90.F * i + 90.F);
+                pts[i].x = cos(rad) * radius + x;
+                pts[i].y = sin(rad) * radius + y;
+            }
+
+            // The OpenGL renderer uses the stencil buffer to draw A in the
+            // triangle (0, 1, 2) and B in the triangle (2, 3, 0). The
+            // triangles split the plane along the line from point 0 to point
+            // 2, so a half-plane mask is used instead.
+            const math::Vector2f a = p.toPixel(pts[0]);
+            const math::Vector2f b = p.toPixel(pts[1]);
+            const math::Vector2f c = p.toPixel(pts[2]);
+            math::Vector3f mask(
+                -(c.y - a.y),
+                c.x - a.x,
+                (c.y - a.y) * a.x - (c.x - a.x) * a.y);
+            if (mask.x * b.x + mask.y * b.y + mask.z < 0.F)
+            {
+                mask = math::Vector3f(-mask.x, -mask.y, -mask.z);
+            }
+            const Private::State state = p.state;
+
+            p.state.maskEnabled = true;
+            p.state.maskStrict = false;
+            p.state.mask = mask;
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : DisplayOptions());
+            }
+
+            p.state.maskStrict = true;
+            p.state.mask = math::Vector3f(-mask.x, -mask.y, -mask.z);
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : DisplayOptions());
+            }
+
+            p.state = state;
+        }
+
+        void CPURender::_drawVideoOverlay(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : DisplayOptions());
+            }
+            if (!videoData.empty() && !boxes.empty())
+            {
+                const image::Size size(boxes[0].w(), boxes[0].h());
+                auto buffer = p.getBuffer("overlay", size);
+
+                const Private::State state = p.state;
+                p.setBuffer(buffer);
+                p.clear(image::Color4f(0.F, 0.F, 0.F, 0.F));
+                _drawVideo(
+                    videoData[0],
+                    math::Box2i(0, 0, size.w, size.h),
+                    !imageOptions.empty() ? std::make_shared<ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : DisplayOptions());
+                p.state = state;
+
+                const ImageFilters imageFilters = !displayOptions.empty() ?
+                    displayOptions[0].imageFilters :
+                    ImageFilters();
+                const ImageFilter filter = p.isMinified(boxes[0], size) ?
+                    imageFilters.minify :
+                    imageFilters.magnify;
+                const image::Color4f color(1.F, 1.F, 1.F, compareOptions.overlay);
+                p.fillQuad(
+                    boxes[0],
+                    [&buffer, filter, color](
+                        float u, float v, float dudx, float dvdx, size_t count, float* out)
+                    {
+                        sampleSpan(*buffer, filter, u, v, dudx, dvdx, count, out);
+                        multiplySpan(out, count, color);
+                    },
+                    CPUBlend::Straight);
+            }
+        }
+
+        void CPURender::_drawVideoDifference(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+            if (videoData.size() > 1 && !boxes.empty())
+            {
+                const image::Size size(boxes[0].w(), boxes[0].h());
+                auto buffer0 = p.getBuffer("difference0", size);
+                auto buffer1 = p.getBuffer("difference1", size);
+
+                const Private::State state = p.state;
+                p.setBuffer(buffer0);
+                p.clear(image::Color4f(0.F, 0.F, 0.F, 0.F));
+                _drawVideo(
+                    videoData[0],
+                    math::Box2i(0, 0, size.w, size.h),
+                    !imageOptions.empty() ? std::make_shared<ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : DisplayOptions());
+                p.setBuffer(buffer1);
+                p.clear(image::Color4f(0.F, 0.F, 0.F, 0.F));
+                _drawVideo(
+                    videoData[1],
+                    math::Box2i(0, 0, size.w, size.h),
+                    imageOptions.size() > 1 ? std::make_shared<ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : DisplayOptions());
+                p.state = state;
+
+                // The buffers have the same size, so the difference can be
+                // computed before the result is drawn.
+                float* data0 = reinterpret_cast<float*>(buffer0->getData());
+                const float* data1 = reinterpret_cast<const float*>(buffer1->getData());
+                const size_t w = size.w;
+                p.run(
+                    0,
+                    size.h - 1,
+                    size.w * size.h,
+                    [data0, data1, w](int y0, int y1)
+                    {
+                        float* a = data0 + y0 * w * 4;
+                        const float* b = data1 + y0 * w * 4;
+                        const size_t count = (y1 - y0 + 1) * w;
+                        for (size_t i = 0; i < count; ++i, a += 4, b += 4)
+                        {
+                            a[0] = std::fabs(a[0] - b[0]);
+                            a[1] = std::fabs(a[1] - b[1]);
+                            a[2] = std::fabs(a[2] - b[2]);
+                            a[3] = std::max(a[3], b[3]);
+                        }
+                    });
+
+                const ImageFilters imageFilters = !displayOptions.empty() ?
+                    displayOptions[0].imageFilters :
+                    ImageFilters();
+                const ImageFilter filter = p.isMinified(boxes[0], size) ?
+                    imageFilters.minify :
+                    imageFilters.magnify;
+                p.fillQuad(
+                    boxes[0],
+                    [&buffer0, filter](
+                        float u, float v, float dudx, float dvdx, size_t count, float* out)
+                    {
+                        sampleSpan(*buffer0, filter, u, v, dudx, dvdx, count, out);
+                    },
+                    CPUBlend::Premultiplied);
+            }
+        }
+
+        void CPURender::_drawVideoTile(
+            const std::vector<VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<ImageOptions>& imageOptions,
+            const std::vector<DisplayOptions>& displayOptions,
+            const CompareOptions& compareOptions)
+        {
+            for (size_t i = 0; i < videoData.size() && i < boxes.size(); ++i)
+            {
+                _drawVideo(
+                    videoData[i],
+                    boxes[i],
+                    i < imageOptions.size() ? std::make_shared<ImageOptions>(imageOptions[i]) : nullptr,
+                    i < displayOptions.size() ? displayOptions[i] : DisplayOptions());
+            }
+        }
+
+        void CPURender::_drawVideo(
+            const VideoData& videoData,
+            const math::Box2i& box,
+            const std::shared_ptr<ImageOptions>& imageOptions,
+            const DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+            if (box.w() <= 0 || box.h() <= 0)
+                return;
+
+            const image::Size size(box.w(), box.h());
+            const math::Box2i bufferBox(0, 0, size.w, size.h);
+            auto buffer = p.getBuffer("video", size);
+
+            const Private::State state = p.state;
+            p.setBuffer(buffer);
+            p.clear(image::Color4f(0.F, 0.F, 0.F, 0.F));
+            for (const auto& layer : videoData.layers)
+            {
+                switch (layer.transition)
+                {
+                case Transition::Dissolve:
+                {
+                    if (layer.image && layer.imageB)
+                    {
+                        auto dissolveBuffer = p.getBuffer("dissolve", size);
+                        p.setBuffer(dissolveBuffer);
+                        p.clear(image::Color4f(0.F, 0.F, 0.F, 0.F));
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                        drawImage(
+                            layer.imageB,
+                            image::getBox(layer.imageB->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptionsB);
+
+                        p.setBuffer(buffer);
+                        p.fillQuad(
+                            bufferBox,
+                            [&dissolveBuffer](
+                                float u, float v, float dudx, float dvdx, size_t count, float* out)
+                            {
+                                sampleSpan(*dissolveBuffer, ImageFilter::Nearest, u, v, dudx, dvdx, count, out);
+                            },
+                            CPUBlend::Premultiplied);
+                    }
+                    else if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    else if (layer.imageB)
+                    {
+                        drawImage(
+                            layer.imageB,
+                            image::getBox(layer.imageB->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptionsB);
+                    }
+                    break;
+                }
+                default:
+                    if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    break;
+                }
+            }
+            p.state = state;
+
+            // Draw the video with the display options.
+            const CPUDisplay display(displayOptions);
+            const ImageFilter filter = p.isMinified(box, size) ?
+                displayOptions.imageFilters.minify :
+                displayOptions.imageFilters.magnify;
+            const bool mirrorX = displayOptions.mirror.x;
+            const bool mirrorY = displayOptions.mirror.y;
+            const Private& pc = p;
+            p.fillQuad(
+                box,
+                [&buffer, &display, &pc, filter, mirrorX, mirrorY](
+                    float u, float v, float dudx, float dvdx, size_t count, float* out)
+                {
+                    if (mirrorX)
+                    {
+                        u = 1.F - u;
+                        dudx = -dudx;
+                    }
+                    if (mirrorY)
+                    {
+                        v = 1.F - v;
+                        dvdx = -dvdx;
+                    }
+                    sampleSpan(*buffer, filter, u, v, dudx, dvdx, count, out);
+                    pc.colorManagementSpan(out, count);
+                    displaySpan(out, count, display);
+                },
+                CPUBlend::Premultiplied);
+        }
+    }
+}
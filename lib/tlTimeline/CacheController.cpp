@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/CacheController.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            // The cache is considered full when it holds this much of the
+            // read ahead.
+            const double cacheFull = .9;
+
+            // The latency increase that signals the readers are saturated.
+            const double latencyIncrease = 1.5;
+        }
+
+        bool CacheControllerOptions::operator == (const CacheControllerOptions& other) const
+        {
+            return
+                videoRequestCount == other.videoRequestCount &&
+                readAhead == other.readAhead &&
+                headroom == other.headroom &&
+                stableCount == other.stableCount &&
+                readAheadStep == other.readAheadStep;
+        }
+
+        bool CacheControllerOptions::operator != (const CacheControllerOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        CacheController::CacheController()
+        {
+            reset();
+        }
+
+        const CacheControllerOptions& CacheController::getOptions() const
+        {
+            return _options;
+        }
+
+        void CacheController::setOptions(const CacheControllerOptions& value)
+        {
+            _options = value;
+            _videoRequestCount = std::min(
+                std::max(_videoRequestCount, _options.videoRequestCount.getMin()),
+                _options.videoRequestCount.getMax());
+            _readAhead = std::min(
+                std::max(_readAhead, _options.readAhead.getMin()),
+                _options.readAhead.getMax());
+        }
+
+        void CacheController::reset()
+        {
+            _videoRequestCount = _options.videoRequestCount.getMax();
+            _readAhead = _options.readAhead.getMax();
+            _videoThroughput = 0.0;
+            _videoLatency = 0.0;
+            _timeValid = false;
+            _stats = RequestStats();
+            _stable = 0;
+        }
+
+        bool CacheController::update(
+            const std::chrono::steady_clock::time_point& time,
+            const RequestStats& stats,
+            double rate,
+            double cached,
+            bool stalled)
+        {
+            if (!_timeValid || stats.videoCount < _stats.videoCount)
+            {
+                _timeValid = true;
+                _time = time;
+                _stats = stats;
+                return false;
+            }
+            const std::chrono::duration<double> diff = time - _time;
+            if (diff.count() <= 0.0)
+                return false;
+
+            // Measure the throughput and latency since the last update.
+            const size_t count = stats.videoCount - _stats.videoCount;
+            const double prevThroughput = _videoThroughput;
+            const double prevLatency = _videoLatency;
+            _videoThroughput = count / diff.count();
+            if (count > 0)
+            {
+                _videoLatency = (stats.videoSeconds - _stats.videoSeconds) / count;
+            }
+            _time = time;
+            _stats = stats;
+            if (rate <= 0.0)
+            {
+                _stable = 0;
+                return false;
+            }
+
+            const size_t videoRequestCount = _videoRequestCount;
+            const double readAhead = _readAhead;
+            const size_t videoRequestCountMin = _options.videoRequestCount.getMin();
+            const size_t videoRequestCountMax = _options.videoRequestCount.getMax();
+            const double required = rate * _options.headroom;
+            const bool full = cached >= _readAhead * cacheFull;
+
+            // Update the request count. While the cache is full the
+            // throughput is limited by playback, so it cannot be used to
+            // tell whether more requests would help.
+            if (!full && _videoThroughput < required)
+            {
+                if (count > 0 &&
+                    prevLatency > 0.0 &&
+                    _videoLatency > prevLatency * latencyIncrease &&
+                    _videoThroughput <= prevThroughput)
+                {
+                    _videoRequestCount = std::max(_videoRequestCount / 2, videoRequestCountMin);
+                }
+                else
+                {
+                    _videoRequestCount = std::min(_videoRequestCount + 1, videoRequestCountMax);
+                }
+            }
+            else if (full && count > 0)
+            {
+                // The number of requests needed to cover the latency at the
+                // required rate.
+                const size_t needed = static_cast<size_t>(std::ceil(required * _videoLatency));
+                if (_videoRequestCount > std::max(needed + 1, videoRequestCountMin))
+                {
+                    --_videoRequestCount;
+                }
+            }
+
+            // Update the read ahead. The read ahead is kept large enough
+            // to hold the requests in progress.
+            if (stalled)
+            {
+                _readAhead = std::min(_readAhead * 2.0, _options.readAhead.getMax());
+                _stable = 0;
+            }
+            else if (full)
+            {
+                ++_stable;
+                if (_stable >= _options.stableCount)
+                {
+                    _stable = 0;
+                    const double min = std::max(
+                        _options.readAhead.getMin(),
+                        std::max(_videoLatency * 2.0, _videoRequestCount / rate));
+                    _readAhead = std::max(
+                        _readAhead - _options.readAheadStep,
+                        std::min(min, _options.readAhead.getMax()));
+                }
+            }
+            else
+            {
+                _stable = 0;
+            }
+
+            return _videoRequestCount != videoRequestCount || _readAhead != readAhead;
+        }
+
+        size_t CacheController::getVideoRequestCount() const
+        {
+            return _videoRequestCount;
+        }
+
+        double CacheController::getReadAhead() const
+        {
+            return _readAhead;
+        }
+
+        double CacheController::getVideoThroughput() const
+        {
+            return _videoThroughput;
+        }
+
+        double CacheController::getVideoLatency() const
+        {
+            return _videoLatency;
+        }
+    }
+}
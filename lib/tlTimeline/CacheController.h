@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Timeline.h>
+
+#include <tlCore/Range.h>
+
+#include <chrono>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Adaptive cache controller options.
+        struct CacheControllerOptions
+        {
+            //! Range for the number of video requests in progress.
+            math::SizeTRange videoRequestCount = math::SizeTRange(1, 16);
+
+            //! Range for the read ahead in seconds.
+            math::DoubleRange readAhead = math::DoubleRange(.5, 4.0);
+
+            //! Throughput required relative to the playback rate.
+            double headroom = 1.2;
+
+            //! Number of updates without a stall before the read ahead is
+            //! reduced.
+            size_t stableCount = 4;
+
+            //! Amount the read ahead is reduced in seconds.
+            double readAheadStep = .25;
+
+            bool operator == (const CacheControllerOptions&) const;
+            bool operator != (const CacheControllerOptions&) const;
+        };
+
+        //! Adaptive cache controller.
+        //!
+        //! The controller measures the video throughput and latency of a
+        //! timeline, and chooses the number of video requests in progress
+        //! and the cache read ahead needed to sustain the playback rate
+        //! with as little memory as possible.
+        //!
+        //! The request count uses additive increase and multiplicative
+        //! decrease: it is increased by one while playback is falling
+        //! behind, and halved when the latency rises without the
+        //! throughput improving, which means the readers are saturated.
+        //! When the cache is full it is reduced towards the count needed
+        //! to cover the latency at the playback rate.
+        //!
+        //! The read ahead is doubled when playback stalls, and reduced by
+        //! a small step after playback has been stable for a while.
+        class CacheController
+        {
+        public:
+            CacheController();
+
+            //! Get the options.
+            const CacheControllerOptions& getOptions() const;
+
+            //! Set the options. The current values are clamped to the new
+            //! ranges.
+            void setOptions(const CacheControllerOptions&);
+
+            //! Reset the controller to the maximum values.
+            void reset();
+
+            //! Update the controller.
+            //!
+            //! \param time The current time.
+            //! \param stats The timeline request statistics.
+            //! \param rate The playback rate in frames per second, or zero
+            //! when playback is stopped.
+            //! \param cached The amount of video cached ahead of the
+            //! current time in seconds.
+            //! \param stalled Whether playback stalled since the last update.
+            //!
+            //! Returns true if the request count or read ahead changed.
+            bool update(
+                const std::chrono::steady_clock::time_point& time,
+                const RequestStats& stats,
+                double rate,
+                double cached,
+                bool stalled);
+
+            //! Get the number of video requests in progress.
+            size_t getVideoRequestCount() const;
+
+            //! Get the read ahead in seconds.
+            double getReadAhead() const;
+
+            //! Get the measured video throughput in frames per second.
+            double getVideoThroughput() const;
+
+            //! Get the measured video latency in seconds.
+            double getVideoLatency() const;
+
+        private:
+            CacheControllerOptions _options;
+            size_t _videoRequestCount = 0;
+            double _readAhead = 0.0;
+            double _videoThroughput = 0.0;
+            double _videoLatency = 0.0;
+            bool _timeValid = false;
+            std::chrono::steady_clock::time_point _time;
+            RequestStats _stats;
+            size_t _stable = 0;
+        };
+    }
+}
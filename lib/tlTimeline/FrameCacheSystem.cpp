@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/FrameCacheSystem.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/FileInfo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            const size_t frameCacheMax = memory::gigabyte;
+        }
+
+        std::string getFrameCacheKey(
+            const file::Path& path,
+            const otime::RationalTime& time,
+            uint16_t layer,
+            const io::Options& options)
+        {
+            const file::FileInfo fileInfo(file::Path(!path.getNumber().empty() ?
+                path.get(static_cast<int>(time.value())) :
+                path.get()));
+            std::stringstream ss;
+            ss << path.get() << '@' << fileInfo.getTime() << '@' << fileInfo.getSize() <<
+                '@' << time << '@' << layer;
+            for (const auto& i : options)
+            {
+                ss << '@' << i.first << '=' << i.second;
+            }
+            return ss.str();
+        }
+
+        struct FrameCacheSystem::Private
+        {
+            struct Item
+            {
+                std::shared_ptr<image::Image> image;
+                size_t byteCount = 0;
+                std::set<uint64_t> clients;
+                std::list<std::string>::iterator lru;
+            };
+
+            size_t max = frameCacheMax;
+            size_t size = 0;
+            std::map<std::string, Item> items;
+            std::list<std::string> lru;
+            uint64_t clientId = 0;
+            std::map<uint64_t, double> clients;
+            mutable std::mutex mutex;
+
+            void charge(const Item&, double sign);
+            void addClient(Item&, uint64_t client);
+            std::map<std::string, Item>::iterator remove(std::map<std::string, Item>::iterator);
+            void evict();
+        };
+
+        void FrameCacheSystem::_init(const std::shared_ptr<system::Context>& context)
+        {
+            ISystem::_init("tl::timeline::FrameCacheSystem", context);
+        }
+
+        FrameCacheSystem::FrameCacheSystem() :
+            _p(new Private)
+        {}
+
+        FrameCacheSystem::~FrameCacheSystem()
+        {}
+
+        std::shared_ptr<FrameCacheSystem> FrameCacheSystem::create(const std::shared_ptr<system::Context>& context)
+        {
+            auto out = std::shared_ptr<FrameCacheSystem>(new FrameCacheSystem);
+            out->_init(context);
+            return out;
+        }
+
+        size_t FrameCacheSystem::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
+        }
+
+        void FrameCacheSystem::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.max = value;
+            p.evict();
+        }
+
+        size_t FrameCacheSystem::getSize() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.size;
+        }
+
+        size_t FrameCacheSystem::getCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.items.size();
+        }
+
+        uint64_t FrameCacheSystem::addClient()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const uint64_t out = ++p.clientId;
+            p.clients[out] = 0.0;
+            return out;
+        }
+
+        void FrameCacheSystem::removeClient(uint64_t client)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            auto i = p.items.begin();
+            while (i != p.items.end())
+            {
+                if (i->second.clients.find(client) != i->second.clients.end())
+                {
+                    if (1 == i->second.clients.size())
+                    {
+                        i = p.remove(i);
+                        continue;
+                    }
+                    p.charge(i->second, -1.0);
+                    i->second.clients.erase(client);
+                    p.charge(i->second, 1.0);
+                }
+                ++i;
+            }
+            p.clients.erase(client);
+        }
+
+        size_t FrameCacheSystem::getClientCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.clients.size();
+        }
+
+        size_t FrameCacheSystem::getClientSize(uint64_t client) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.clients.find(client);
+            return i != p.clients.end() ? static_cast<size_t>(std::round(i->second)) : 0;
+        }
+
+        bool FrameCacheSystem::get(
+            const std::string& key,
+            uint64_t client,
+            std::shared_ptr<image::Image>& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.items.find(key);
+            if (i != p.items.end())
+            {
+                p.lru.splice(p.lru.begin(), p.lru, i->second.lru);
+                p.addClient(i->second, client);
+                value = i->second.image;
+                return true;
+            }
+            return false;
+        }
+
+        void FrameCacheSystem::add(
+            const std::string& key,
+            uint64_t client,
+            const std::shared_ptr<image::Image>& value)
+        {
+            TLRENDER_P();
+            if (!value)
+                return;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.items.find(key);
+            if (i != p.items.end())
+            {
+                p.lru.splice(p.lru.begin(), p.lru, i->second.lru);
+                p.addClient(i->second, client);
+            }
+            else if (p.clients.find(client) != p.clients.end())
+            {
+                const size_t byteCount = value->getDataByteCount();
+                if (byteCount <= p.max)
+                {
+                    p.lru.push_front(key);
+                    Private::Item& item = p.items[key];
+                    item.image = value;
+                    item.byteCount = byteCount;
+                    item.clients.insert(client);
+                    item.lru = p.lru.begin();
+                    p.charge(item, 1.0);
+                    p.size += byteCount;
+                    p.evict();
+                }
+            }
+        }
+
+        void FrameCacheSystem::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.items.clear();
+            p.lru.clear();
+            p.size = 0;
+            for (auto& i : p.clients)
+            {
+                i.second = 0.0;
+            }
+        }
+
+        void FrameCacheSystem::Private::charge(const Item& item, double sign)
+        {
+            const double share = sign * item.byteCount / item.clients.size();
+            for (auto client : item.clients)
+            {
+                auto i = clients.find(client);
+                if (i != clients.end())
+                {
+                    i->second = std::max(i->second + share, 0.0);
+                }
+            }
+        }
+
+        void FrameCacheSystem::Private::addClient(Item& item, uint64_t client)
+        {
+            if (item.clients.find(client) == item.clients.end() &&
+                clients.find(client) != clients.end())
+            {
+                charge(item, -1.0);
+                item.clients.insert(client);
+                charge(item, 1.0);
+            }
+        }
+
+        std::map<std::string, FrameCacheSystem::Private::Item>::iterator FrameCacheSystem::Private::remove(
+            std::map<std::string, Item>::iterator i)
+        {
+            charge(i->second, -1.0);
+            size -= i->second.byteCount;
+            lru.erase(i->second.lru);
+            return items.erase(i);
+        }
+
+        void FrameCacheSystem::Private::evict()
+        {
+            while (size > max && !items.empty())
+            {
+                // Find the client that uses the most memory.
+                uint64_t client = 0;
+                double clientSize = -1.0;
+                for (const auto& i : clients)
+                {
+                    if (i.second > clientSize)
+                    {
+                        client = i.first;
+                        clientSize = i.second;
+                    }
+                }
+
+                // Remove the least recently used frame of that client.
+                auto i = items.end();
+                for (auto j = lru.rbegin(); j != lru.rend(); ++j)
+                {
+                    auto k = items.find(*j);
+                    if (k->second.clients.find(client) != k->second.clients.end())
+                    {
+                        i = k;
+                        break;
+                    }
+                }
+                if (i == items.end())
+                {
+                    i = items.find(lru.back());
+                }
+                remove(i);
+            }
+        }
+    }
+}
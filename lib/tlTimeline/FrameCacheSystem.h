@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/IO.h>
+
+#include <tlCore/ISystem.h>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Get a frame cache key. The key includes the modification time
+        //! and size of the file that holds the frame, so frames are not
+        //! reused after the file changes. This reads the file information
+        //! from disk, and should not be used for media in memory.
+        std::string getFrameCacheKey(
+            const file::Path&,
+            const otime::RationalTime&,
+            uint16_t layer,
+            const io::Options&);
+
+        //! Frame cache system.
+        //!
+        //! Decoded frames are shared by all of the timelines in the
+        //! application, so media that is referenced by more than one
+        //! timeline is only decoded and stored once.
+        //!
+        //! Each timeline is a client of the cache, and the memory budget is
+        //! shared fairly between the clients: frames are charged equally
+        //! to the clients that use them, and when the cache is full frames
+        //! are removed from the client that uses the most memory.
+        //!
+        //! The cache is in addition to the video cache of each player, so
+        //! applications should size it to fit with the player cache, or
+        //! disable it.
+        class FrameCacheSystem : public system::ISystem
+        {
+            TLRENDER_NON_COPYABLE(FrameCacheSystem);
+
+        protected:
+            void _init(const std::shared_ptr<system::Context>&);
+
+            FrameCacheSystem();
+
+        public:
+            virtual ~FrameCacheSystem();
+
+            //! Create a new system.
+            static std::shared_ptr<FrameCacheSystem> create(const std::shared_ptr<system::Context>&);
+
+            //! Get the maximum cache size in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum cache size in bytes. A value of zero
+            //! disables the cache.
+            void setMax(size_t);
+
+            //! Get the cache size in bytes.
+            size_t getSize() const;
+
+            //! Get the number of frames in the cache.
+            size_t getCount() const;
+
+            //! \name Clients
+            ///@{
+
+            //! Add a client.
+            uint64_t addClient();
+
+            //! Remove a client. Frames that are not used by another client
+            //! are removed from the cache.
+            void removeClient(uint64_t);
+
+            //! Get the number of clients.
+            size_t getClientCount() const;
+
+            //! Get the memory charged to a client in bytes.
+            size_t getClientSize(uint64_t) const;
+
+            ///@}
+
+            //! Get a frame from the cache.
+            bool get(const std::string& key, uint64_t client, std::shared_ptr<image::Image>&);
+
+            //! Add a frame to the cache.
+            void add(const std::string& key, uint64_t client, const std::shared_ptr<image::Image>&);
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
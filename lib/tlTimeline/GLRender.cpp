@@ -29,10 +29,30 @@ namespace tl
 {
     namespace timeline
     {
+        namespace
+        {
+            void copyTexture(
+                const uint8_t* data,
+                const image::Info& info,
+                const std::shared_ptr<gl::Texture>& texture,
+                const std::shared_ptr<gl::PixelBufferRing>& ring)
+            {
+                // Only data that was created in the ring is copied through
+                // it, other data uses the texture pixel buffer.
+                if (!ring ||
+                    !ring->contains(data, image::getDataByteCount(info)) ||
+                    !ring->copy(data, info, *texture))
+                {
+                    texture->copy(data, info);
+                }
+            }
+        }
+
         void copyTextures(
             const std::shared_ptr<image::Image>& image,
             const std::vector<std::shared_ptr<gl::Texture> >& textures,
-            size_t offset)
+            size_t offset,
+            const std::shared_ptr<gl::PixelBufferRing>& ring)
         {
             std::vector<std::shared_ptr<gl::Texture> > out;
             const auto& info = image->getInfo();
@@ -41,100 +61,111 @@ namespace tl
             case image::PixelType::YUV_420P_U8:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
                 const std::size_t w2 = w / 2;
                 const std::size_t h2 = h / 2;
-                textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h), textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) + (w2 * h2), textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) + (w2 * h2), textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             case image::PixelType::YUV_422P_U8:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
                 const std::size_t w2 = w / 2;
-                textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h), textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) + (w2 * h), textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) + (w2 * h), textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             case image::PixelType::YUV_444P_U8:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
-                textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h), textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) + (w * h), textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) + (w * h), textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             case image::PixelType::YUV_420P_U16:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
                 const std::size_t w2 = w / 2;
                 const std::size_t h2 = h / 2;
-                textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2, textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h2) * 2, textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2 + (w2 * h2) * 2, textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             case image::PixelType::YUV_422P_U16:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
                 const std::size_t w2 = w / 2;
-                textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2, textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h) * 2, textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2 + (w2 * h) * 2, textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             case image::PixelType::YUV_444P_U16:
             {
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(image->getData(), textures[0]->getInfo());
+                copyTexture(image->getData(), textures[0]->getInfo(), textures[0], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
                 const std::size_t w = info.size.w;
                 const std::size_t h = info.size.h;
-                textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2, textures[1]->getInfo(), textures[1], ring);
 
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                textures[2]->copy(image->getData() + (w * h) * 2 + (w * h) * 2, textures[2]->getInfo());
+                copyTexture(image->getData() + (w * h) * 2 + (w * h) * 2, textures[2]->getInfo(), textures[2], ring);
                 break;
             }
             default:
                 glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                textures[0]->copy(*image);
+                copyTexture(image->getData(), info, textures[0], ring);
                 break;
             }
         }
 
+        void bindTextures(
+            const std::vector<std::shared_ptr<gl::Texture> >& textures,
+            size_t offset)
+        {
+            for (size_t i = 0; i < textures.size(); ++i)
+            {
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset + i));
+                textures[i]->bind();
+            }
+        }
+
         namespace
         {
             std::vector<std::shared_ptr<gl::Texture> > getTextures(
@@ -262,31 +293,81 @@ namespace tl
             }
         }
 
-        void TextureCache::setSize(size_t value)
+        void TextureCache::setMax(size_t value)
         {
-            if (value == _size)
+            if (value == _max)
                 return;
-            _size = value;
+            _max = value;
             _cacheUpdate();
         }
 
+        size_t TextureCache::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        void TextureCache::begin()
+        {
+            ++_render;
+        }
+
         std::vector<std::shared_ptr<gl::Texture> > TextureCache::get(
-            const image::Info& info,
+            const std::shared_ptr<image::Image>& image,
             const ImageFilters& imageFilters,
+            bool& upload,
             size_t offset)
         {
             std::vector<std::shared_ptr<gl::Texture> > out;
-            const auto i = std::find_if(
+            const auto& info = image->getInfo();
+
+            // Look for the textures of the same image.
+            auto i = std::find_if(
                 _cache.begin(),
                 _cache.end(),
-                [info, imageFilters](const TextureData& value)
+                [&image, &imageFilters](const TextureData& value)
                 {
-                    return info == value.info &&
+                    return !value.image.owner_before(image) &&
+                        !image.owner_before(value.image) &&
                         imageFilters == value.imageFilters;
                 });
+            upload = i == _cache.end();
+
+            // Look for textures that can be recycled, starting with the
+            // least recently used.
+            if (upload)
+            {
+                auto j = std::find_if(
+                    _cache.rbegin(),
+                    _cache.rend(),
+                    [&info, &imageFilters](const TextureData& value)
+                    {
+                        return value.image.expired() &&
+                            info == value.info &&
+                            imageFilters == value.imageFilters;
+                    });
+                if (j == _cache.rend())
+                {
+                    const size_t render = _render;
+                    j = std::find_if(
+                        _cache.rbegin(),
+                        _cache.rend(),
+                        [&info, &imageFilters, render](const TextureData& value)
+                        {
+                            return render != value.render &&
+                                info == value.info &&
+                                imageFilters == value.imageFilters;
+                        });
+                }
+                if (j != _cache.rend())
+                {
+                    i = std::next(j).base();
+                }
+            }
+
             if (i != _cache.end())
             {
                 out = i->texture;
+                _byteCount -= i->byteCount;
                 _cache.erase(i);
             }
             else
@@ -297,18 +378,27 @@ namespace tl
         }
 
         void TextureCache::add(
-            const image::Info& info,
+            const std::shared_ptr<image::Image>& image,
             const ImageFilters& imageFilters,
             const std::vector<std::shared_ptr<gl::Texture> >& textures)
         {
-            _cache.push_front({ info, imageFilters, textures });
+            TextureData data;
+            data.image = image;
+            data.info = image->getInfo();
+            data.imageFilters = imageFilters;
+            data.texture = textures;
+            data.byteCount = image::getDataByteCount(data.info);
+            data.render = _render;
+            _cache.push_front(data);
+            _byteCount += data.byteCount;
             _cacheUpdate();
         }
 
         void TextureCache::_cacheUpdate()
         {
-            while (_cache.size() > _size)
+            while (_byteCount > _max && !_cache.empty())
             {
+                _byteCount -= _cache.back().byteCount;
                 _cache.pop_back();
             }
         }
@@ -370,6 +460,16 @@ namespace tl
             return out;
         }
 
+        const std::shared_ptr<gl::PixelBufferRing>& GLRender::getPixelBufferRing() const
+        {
+            return _p->pixelBufferRing;
+        }
+
+        GLRenderStats GLRender::getStats() const
+        {
+            return !_p->stats.empty() ? _p->stats.back() : GLRenderStats();
+        }
+
         void GLRender::begin(
             const image::Size& renderSize,
             const ColorConfigOptions& colorConfigOptions,
@@ -377,6 +477,7 @@ namespace tl
             const RenderOptions& renderOptions)
         {
             TLRENDER_P();
+            p.flush();
 
             p.timer = std::chrono::steady_clock::now();
 
@@ -384,23 +485,66 @@ namespace tl
             _setColorConfig(colorConfigOptions);
             _setLUT(lutOptions);
             p.renderOptions = renderOptions;
-            p.textureCache.setSize(renderOptions.textureCacheSize);
-
-            glEnable(GL_BLEND);
-            glBlendEquation(GL_FUNC_ADD);
+            p.textureCache.setMax(renderOptions.textureCacheByteCount);
+            p.textureCache.begin();
 
-            if (!p.shaders["rect"])
+            // Images created in the pixel buffer ring are uploaded without
+            // another copy. The old rings are kept in a list and destroyed
+            // here on the render thread once their images are gone.
+            if (renderOptions.pixelBufferRingByteCount != p.pixelBufferRingByteCount)
             {
-                p.shaders["rect"] = gl::Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
+                p.pixelBufferRingByteCount = renderOptions.pixelBufferRingByteCount;
+                if (p.pixelBufferRing)
+                {
+                    p.pixelBufferRingsOld.push_back(p.pixelBufferRing);
+                    p.pixelBufferRing.reset();
+                }
+                if (p.pixelBufferRingByteCount > 0 && gl::PixelBufferRing::isSupported())
+                {
+                    try
+                    {
+                        p.pixelBufferRing = gl::PixelBufferRing::create(p.pixelBufferRingByteCount);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        if (auto context = _context.lock())
+                        {
+                            context->log(
+                                string::Format("tl::timeline::GLRender {0}").arg(this),
+                                e.what(),
+                                log::Type::Error);
+                        }
+                    }
+                }
             }
-            if (!p.shaders["mesh"])
+            if (p.pixelBufferRing)
             {
-                p.shaders["mesh"] = gl::Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
+                p.pixelBufferRing->update();
+            }
+            auto i = p.pixelBufferRingsOld.begin();
+            while (i != p.pixelBufferRingsOld.end())
+            {
+                if (1 == i->use_count() && 0 == (*i)->getImageCount())
+                {
+                    i = p.pixelBufferRingsOld.erase(i);
+                }
+                else
+                {
+                    (*i)->update();
+                    ++i;
+                }
             }
+
+            // The framebuffer may have been bound outside of the offscreen
+            // buffers, so the tracked binding is updated at the start of
+            // each render.
+            GLint framebuffer = 0;
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+            gl::setFramebufferBinding(framebuffer);
+
+            glEnable(GL_BLEND);
+            glBlendEquation(GL_FUNC_ADD);
+
             if (!p.shaders["colorMesh"])
             {
                 p.shaders["colorMesh"] = gl::Shader::create(
@@ -506,8 +650,6 @@ namespace tl
             }
 #endif // TLRENDER_OCIO
 
-            p.vbos["rect"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32);
-            p.vaos["rect"] = gl::VAO::create(p.vbos["rect"]->getType(), p.vbos["rect"]->getID());
             p.vbos["texture"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
             p.vaos["texture"] = gl::VAO::create(p.vbos["texture"]->getType(), p.vbos["texture"]->getID());
             p.vbos["image"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
@@ -534,6 +676,7 @@ namespace tl
         void GLRender::end()
         {
             TLRENDER_P();
+            p.flush();
 
             //! \bug Should these be reset periodically?
             //p.glyphIDs.clear();
@@ -546,7 +689,7 @@ namespace tl
             const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - p.timer);
             p.currentStats.time = diff.count();
             p.stats.push_back(p.currentStats);
-            p.currentStats = Private::Stats();
+            p.currentStats = GLRenderStats();
             while (p.stats.size() > 60)
             {
                 p.stats.pop_front();
@@ -558,7 +701,7 @@ namespace tl
                 p.logTimer = now;
                 if (auto context = _context.lock())
                 {
-                    Private::Stats average;
+                    GLRenderStats average;
                     const size_t size = p.stats.size();
                     if (size > 0)
                     {
@@ -572,6 +715,8 @@ namespace tl
                             average.textTriangles += i.textTriangles;
                             average.textures += i.textures;
                             average.images += i.images;
+                            average.imageUploads += i.imageUploads;
+                            average.drawCalls += i.drawCalls;
                         }
                         average.time /= p.stats.size();
                         average.rects /= p.stats.size();
@@ -581,6 +726,8 @@ namespace tl
                         average.textTriangles /= p.stats.size();
                         average.textures /= p.stats.size();
                         average.images /= p.stats.size();
+                        average.imageUploads /= p.stats.size();
+                        average.drawCalls /= p.stats.size();
                     }
 
                     context->log(
@@ -595,8 +742,11 @@ namespace tl
                             "    Average text triangles: {5}\n"
                             "    Average texture count: {6}\n"
                             "    Average image count: {7}\n"
-                            "    Glyph texture atlas: {8}%\n"
-                            "    Glyph IDs: {9}").
+                            "    Average image uploads: {8}\n"
+                            "    Average draw calls: {9}\n"
+                            "    Texture cache: {10}MB\n"
+                            "    Glyph texture atlas: {11}%\n"
+                            "    Glyph IDs: {12}").
                         arg(average.time).
                         arg(average.rects).
                         arg(average.meshes).
@@ -605,6 +755,9 @@ namespace tl
                         arg(average.textTriangles).
                         arg(average.textures).
                         arg(average.images).
+                        arg(average.imageUploads).
+                        arg(average.drawCalls).
+                        arg(p.textureCache.getByteCount() / memory::megabyte).
                         arg(p.glyphTextureAtlas->getPercentageUsed()).
                         arg(p.glyphIDs.size()));
                 }
@@ -618,7 +771,9 @@ namespace tl
 
         void GLRender::setRenderSize(const image::Size& value)
         {
-            _p->renderSize = value;
+            TLRENDER_P();
+            p.flush();
+            p.renderSize = value;
         }
 
         math::Box2i GLRender::getViewport() const
@@ -629,6 +784,7 @@ namespace tl
         void GLRender::setViewport(const math::Box2i& value)
         {
             TLRENDER_P();
+            p.flush();
             p.viewport = value;
             glViewport(
                 value.x(),
@@ -639,6 +795,7 @@ namespace tl
 
         void GLRender::clearViewport(const image::Color4f& value)
         {
+            _p->flush();
             glClearColor(value.r, value.g, value.b, value.a);
             glClear(GL_COLOR_BUFFER_BIT);
         }
@@ -651,6 +808,7 @@ namespace tl
         void GLRender::setClipRectEnabled(bool value)
         {
             TLRENDER_P();
+            p.flush();
             p.clipRectEnabled = value;
             if (p.clipRectEnabled)
             {
@@ -670,6 +828,7 @@ namespace tl
         void GLRender::setClipRect(const math::Box2i& value)
         {
             TLRENDER_P();
+            p.flush();
             p.clipRect = value;
             if (value.w() > 0 && value.h() > 0)
             {
@@ -689,6 +848,7 @@ namespace tl
         void GLRender::setTransform(const math::Matrix4x4f& value)
         {
             TLRENDER_P();
+            p.flush();
             p.transform = value;
             for (auto i : p.shaders)
             {
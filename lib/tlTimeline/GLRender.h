@@ -8,8 +8,28 @@
 
 namespace tl
 {
+    namespace gl
+    {
+        class PixelBufferRing;
+    }
+
     namespace timeline
     {
+        //! OpenGL renderer statistics.
+        struct GLRenderStats
+        {
+            int time = 0;
+            size_t rects = 0;
+            size_t meshes = 0;
+            size_t meshTriangles = 0;
+            size_t text = 0;
+            size_t textTriangles = 0;
+            size_t textures = 0;
+            size_t images = 0;
+            size_t imageUploads = 0;
+            size_t drawCalls = 0;
+        };
+
         //! OpenGL renderer.
         class GLRender : public IRender
         {
@@ -25,6 +45,15 @@ namespace tl
             //! Create a new renderer.
             static std::shared_ptr<GLRender> create(const std::shared_ptr<system::Context>&);
 
+            //! Get the pixel buffer ring used for texture uploads. Images
+            //! created from the ring are drawn without copying the data
+            //! again. A null pointer is returned if the ring is disabled (the
+            //! default) or not supported. The ring is created by begin().
+            const std::shared_ptr<gl::PixelBufferRing>& getPixelBufferRing() const;
+
+            //! Get the statistics of the last render.
+            GLRenderStats getStats() const;
+
             void begin(
                 const image::Size&,
                 const ColorConfigOptions& = ColorConfigOptions(),
@@ -16,144 +16,182 @@ namespace tl
 {
     namespace timeline
     {
-        void GLRender::drawRect(
-            const math::Box2i& box,
+        void GLRender::Private::batchBegin(
+            BatchType type,
+            unsigned int texture,
             const image::Color4f& color)
         {
-            TLRENDER_P();
-            ++(p.currentStats.rects);
-
-            p.shaders["rect"]->bind();
-            p.shaders["rect"]->setUniform("color", color);
-
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            if (p.vbos["rect"])
+            if (batch.vertexCount > 0 &&
+                (type != batch.type ||
+                    texture != batch.texture ||
+                    (BatchType::Text == type && color != batch.color) ||
+                    gl::getFramebufferBinding() != batch.framebuffer))
             {
-                p.vbos["rect"]->copy(convert(geom::box(box), p.vbos["rect"]->getType()));
+                flush();
             }
-            if (p.vaos["rect"])
+            if (0 == batch.vertexCount)
             {
-                p.vaos["rect"]->bind();
-                p.vaos["rect"]->draw(GL_TRIANGLES, 0, p.vbos["rect"]->getSize());
+                // Remember the framebuffer so the batch is drawn to the
+                // right place even if the binding changes before it is
+                // flushed.
+                batch.framebuffer = gl::getFramebufferBinding();
             }
+            batch.type = type;
+            batch.texture = texture;
+            batch.color = color;
         }
 
-        void GLRender::drawMesh(
+        void GLRender::Private::batchMesh(
             const geom::TriangleMesh2& mesh,
             const math::Vector2i& position,
-            const image::Color4f& color)
+            const image::Color4f& color,
+            bool vertexColors)
         {
-            TLRENDER_P();
-            ++(p.currentStats.meshes);
             const size_t size = mesh.triangles.size();
-            p.currentStats.meshTriangles += mesh.triangles.size();
             if (size > 0)
             {
-                p.shaders["mesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    math::translate(math::Vector3f(
-                        position.x,
-                        position.y,
-                        0.F));
-                p.shaders["mesh"]->setUniform("transform.mvp", transform);
-                p.shaders["mesh"]->setUniform("color", color);
-
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-                if (!p.vbos["mesh"] || (p.vbos["mesh"] && p.vbos["mesh"]->getSize() < size * 3))
+                batchBegin(BatchType::Mesh);
+
+                // The position and color are applied to the vertices so that
+                // meshes with different values can share the batch.
+                const size_t offset = batch.data.size();
+                batch.data.resize(offset + size * 3 * gl::getByteCount(gl::VBOType::Pos2_F32_Color_F32));
+                float* pf = reinterpret_cast<float*>(batch.data.data() + offset);
+                for (const auto& triangle : mesh.triangles)
                 {
-                    p.vbos["mesh"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32);
-                    p.vaos["mesh"].reset();
-                }
-                if (p.vbos["mesh"])
-                {
-                    p.vbos["mesh"]->copy(convert(mesh, gl::VBOType::Pos2_F32));
-                }
-
-                if (!p.vaos["mesh"] && p.vbos["mesh"])
-                {
-                    p.vaos["mesh"] = gl::VAO::create(p.vbos["mesh"]->getType(), p.vbos["mesh"]->getID());
-                }
-                if (p.vaos["mesh"] && p.vbos["mesh"])
-                {
-                    p.vaos["mesh"]->bind();
-                    p.vaos["mesh"]->draw(GL_TRIANGLES, 0, size * 3);
+                    for (const auto& vertex : triangle.v)
+                    {
+                        const size_t v = vertex.v;
+                        pf[0] = (v ? mesh.v[v - 1].x : 0.F) + position.x;
+                        pf[1] = (v ? mesh.v[v - 1].y : 0.F) + position.y;
+                        const size_t c = vertexColors ? vertex.c : 0;
+                        pf[2] = c ? mesh.c[c - 1].x * color.r : color.r;
+                        pf[3] = c ? mesh.c[c - 1].y * color.g : color.g;
+                        pf[4] = c ? mesh.c[c - 1].z * color.b : color.b;
+                        pf[5] = c ? mesh.c[c - 1].w * color.a : color.a;
+                        pf += 6;
+                    }
                 }
+                batch.vertexCount += size * 3;
             }
         }
 
-        void GLRender::drawColorMesh(
+        void GLRender::Private::batchText(
             const geom::TriangleMesh2& mesh,
-            const math::Vector2i& position,
+            unsigned int texture,
             const image::Color4f& color)
         {
-            TLRENDER_P();
-            ++(p.currentStats.meshes);
             const size_t size = mesh.triangles.size();
-            p.currentStats.meshTriangles += mesh.triangles.size();
+            currentStats.textTriangles += size;
             if (size > 0)
             {
-                p.shaders["colorMesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    math::translate(math::Vector3f(
-                        position.x,
-                        position.y,
-                        0.F));
-                p.shaders["colorMesh"]->setUniform("transform.mvp", transform);
-                p.shaders["colorMesh"]->setUniform("color", color);
-
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-                if (!p.vbos["colorMesh"] || (p.vbos["colorMesh"] && p.vbos["colorMesh"]->getSize() < size * 3))
-                {
-                    p.vbos["colorMesh"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32_Color_F32);
-                    p.vaos["colorMesh"].reset();
-                }
-                if (p.vbos["colorMesh"])
-                {
-                    p.vbos["colorMesh"]->copy(convert(mesh, gl::VBOType::Pos2_F32_Color_F32));
-                }
-
-                if (!p.vaos["colorMesh"] && p.vbos["colorMesh"])
-                {
-                    p.vaos["colorMesh"] = gl::VAO::create(p.vbos["colorMesh"]->getType(), p.vbos["colorMesh"]->getID());
-                }
-                if (p.vaos["colorMesh"] && p.vbos["colorMesh"])
-                {
-                    p.vaos["colorMesh"]->bind();
-                    p.vaos["colorMesh"]->draw(GL_TRIANGLES, 0, size * 3);
-                }
+                batchBegin(BatchType::Text, texture, color);
+                const auto data = convert(mesh, gl::VBOType::Pos2_F32_UV_U16);
+                batch.data.insert(batch.data.end(), data.begin(), data.end());
+                batch.vertexCount += size * 3;
             }
         }
 
-        void GLRender::Private::drawTextMesh(const geom::TriangleMesh2& mesh)
+        void GLRender::Private::flush()
         {
-            const size_t size = mesh.triangles.size();
-            currentStats.textTriangles += size;
-            if (size > 0)
+            if (0 == batch.vertexCount)
+                return;
+
+            const unsigned int framebuffer = gl::getFramebufferBinding();
+            if (framebuffer != batch.framebuffer)
             {
-                if (!vbos["text"] || (vbos["text"] && vbos["text"]->getSize() < size * 3))
-                {
-                    vbos["text"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32_UV_U16);
-                    vaos["text"].reset();
-                }
-                if (vbos["text"])
-                {
-                    vbos["text"]->copy(convert(mesh, vbos["text"]->getType()));
-                }
-                if (!vaos["text"] && vbos["text"])
-                {
-                    vaos["text"] = gl::VAO::create(vbos["text"]->getType(), vbos["text"]->getID());
-                }
-                if (vaos["text"] && vbos["text"])
-                {
-                    vaos["text"]->bind();
-                    vaos["text"]->draw(GL_TRIANGLES, 0, size * 3);
-                }
+                glBindFramebuffer(GL_FRAMEBUFFER, batch.framebuffer);
+            }
+
+            std::string name;
+            gl::VBOType vboType = gl::VBOType::Pos2_F32_Color_F32;
+            switch (batch.type)
+            {
+            case BatchType::Mesh:
+                name = "colorMesh";
+                vboType = gl::VBOType::Pos2_F32_Color_F32;
+                shaders["colorMesh"]->bind();
+                shaders["colorMesh"]->setUniform("color", image::Color4f(1.F, 1.F, 1.F));
+                break;
+            case BatchType::Text:
+                name = "text";
+                vboType = gl::VBOType::Pos2_F32_UV_U16;
+                shaders["text"]->bind();
+                shaders["text"]->setUniform("color", batch.color);
+                shaders["text"]->setUniform("textureSampler", 0);
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
+                glBindTexture(GL_TEXTURE_2D, batch.texture);
+                break;
+            default: break;
+            }
+
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            // Append the vertices to the vertex buffer, growing it or
+            // starting again from the beginning when it is full.
+            size_t& offset = batchOffsets[name];
+            if (!vbos[name] || vbos[name]->getSize() < batch.vertexCount)
+            {
+                const size_t size = vbos[name] ? vbos[name]->getSize() * 2 : 0;
+                vbos[name] = gl::VBO::create(std::max(size, batch.vertexCount), vboType);
+                vaos[name].reset();
+                offset = 0;
+            }
+            else if (offset + batch.vertexCount > vbos[name]->getSize())
+            {
+                offset = 0;
+            }
+            if (!vaos[name])
+            {
+                vaos[name] = gl::VAO::create(vboType, vbos[name]->getID());
             }
+            vbos[name]->copy(
+                batch.data,
+                offset * gl::getByteCount(vboType),
+                batch.data.size());
+            vaos[name]->bind();
+            vaos[name]->draw(GL_TRIANGLES, offset, batch.vertexCount);
+            ++(currentStats.drawCalls);
+            offset += batch.vertexCount;
+
+            if (framebuffer != batch.framebuffer)
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            }
+            batch.type = BatchType::None;
+            batch.data.clear();
+            batch.vertexCount = 0;
+        }
+
+        void GLRender::drawRect(
+            const math::Box2i& box,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.rects);
+            p.batchMesh(geom::box(box), math::Vector2i(), color, false);
+        }
+
+        void GLRender::drawMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.batchMesh(mesh, position, color, false);
+        }
+
+        void GLRender::drawColorMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.batchMesh(mesh, position, color, true);
         }
 
         void GLRender::drawText(
@@ -164,16 +202,8 @@ namespace tl
             TLRENDER_P();
             ++(p.currentStats.text);
 
-            p.shaders["text"]->bind();
-            p.shaders["text"]->setUniform("color", color);
-            p.shaders["text"]->setUniform("textureSampler", 0);
-
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
             uint8_t textureIndex = 0;
             const auto textures = p.glyphTextureAtlas->getTextures();
-            glBindTexture(GL_TEXTURE_2D, textures[textureIndex]);
 
             int x = 0;
             int32_t rsbDeltaPrev = 0;
@@ -204,17 +234,23 @@ namespace tl
                         gl::TextureAtlasItem item;
                         if (!p.glyphTextureAtlas->getItem(id, item))
                         {
+                            // Adding an item may replace glyphs that are
+                            // still waiting to be drawn.
+                            p.batchText(mesh, textures[textureIndex], color);
+                            mesh = geom::TriangleMesh2();
+                            meshIndex = 0;
+                            p.flush();
+
                             id = p.glyphTextureAtlas->addItem(glyph->image, item);
                             p.glyphIDs[glyph->info] = id;
                         }
                         if (item.textureIndex != textureIndex)
                         {
-                            textureIndex = item.textureIndex;
-                            glBindTexture(GL_TEXTURE_2D, textures[textureIndex]);
-
-                            p.drawTextMesh(mesh);
+                            p.batchText(mesh, textures[textureIndex], color);
                             mesh = geom::TriangleMesh2();
                             meshIndex = 0;
+
+                            textureIndex = item.textureIndex;
                         }
 
                         const math::Vector2i& offset = glyph->offset;
@@ -257,7 +293,7 @@ namespace tl
                     x += glyph->advance;
                 }
             }
-            p.drawTextMesh(mesh);
+            p.batchText(mesh, textures[textureIndex], color);
         }
 
         void GLRender::drawTexture(
@@ -267,6 +303,7 @@ namespace tl
         {
             TLRENDER_P();
             ++(p.currentStats.textures);
+            p.flush();
 
             p.shaders["texture"]->bind();
             p.shaders["texture"]->setUniform("color", color);
@@ -285,6 +322,7 @@ namespace tl
             {
                 p.vaos["texture"]->bind();
                 p.vaos["texture"]->draw(GL_TRIANGLES, 0, p.vbos["texture"]->getSize());
+                ++(p.currentStats.drawCalls);
             }
         }
 
@@ -296,10 +334,20 @@ namespace tl
         {
             TLRENDER_P();
             ++(p.currentStats.images);
+            p.flush();
 
             const auto& info = image->getInfo();
-            auto textures = p.textureCache.get(info, imageOptions.imageFilters);
-            copyTextures(image, textures);
+            bool upload = true;
+            auto textures = p.textureCache.get(image, imageOptions.imageFilters, upload);
+            if (upload)
+            {
+                ++(p.currentStats.imageUploads);
+                copyTextures(image, textures, 0, p.pixelBufferRing);
+            }
+            else
+            {
+                bindTextures(textures);
+            }
 
             p.shaders["image"]->bind();
             p.shaders["image"]->setUniform("color", color);
@@ -353,9 +401,10 @@ namespace tl
             {
                 p.vaos["image"]->bind();
                 p.vaos["image"]->draw(GL_TRIANGLES, 0, p.vbos["image"]->getSize());
+                ++(p.currentStats.drawCalls);
             }
 
-            p.textureCache.add(info, imageOptions.imageFilters, textures);
+            p.textureCache.add(image, imageOptions.imageFilters, textures);
         }
     }
 }
@@ -8,6 +8,7 @@
 
 #include <tlGL/Mesh.h>
 #include <tlGL/OffscreenBuffer.h>
+#include <tlGL/PixelBufferRing.h>
 #include <tlGL/Shader.h>
 #include <tlGL/Texture.h>
 #include <tlGL/TextureAtlas.h>
@@ -43,34 +44,63 @@ namespace tl
 
         void copyTextures(
             const std::shared_ptr<image::Image>&,
+            const std::vector<std::shared_ptr<gl::Texture> >&,
+            size_t offset = 0,
+            const std::shared_ptr<gl::PixelBufferRing>& = nullptr);
+
+        void bindTextures(
             const std::vector<std::shared_ptr<gl::Texture> >&,
             size_t offset = 0);
 
+        //! Image texture cache.
+        //!
+        //! Textures are re-used without copying the data when the same
+        //! image is drawn again. Images are identified by their shared
+        //! pointer, so images must not be modified after they are drawn.
+        //! Textures of images that have been destroyed, or that were not
+        //! drawn in the current render, are recycled for new images with
+        //! the same information.
         class TextureCache
         {
         public:
-            void setSize(size_t);
+            //! Set the maximum size of the cache in bytes.
+            void setMax(size_t);
+
+            //! Get the size of the cache in bytes.
+            size_t getByteCount() const;
 
+            //! Start a new render.
+            void begin();
+
+            //! Get the textures for an image. The upload flag is set when
+            //! the image data needs to be copied to the textures.
             std::vector<std::shared_ptr<gl::Texture> > get(
-                const image::Info&,
+                const std::shared_ptr<image::Image>&,
                 const ImageFilters&,
+                bool& upload,
                 size_t offset = 0);
 
+            //! Add the textures for an image to the cache.
             void add(
-                const image::Info&,
+                const std::shared_ptr<image::Image>&,
                 const ImageFilters&,
                 const std::vector<std::shared_ptr<gl::Texture> >&);
 
         private:
             void _cacheUpdate();
 
-            size_t _size = 6;
+            size_t _max = 0;
+            size_t _byteCount = 0;
+            size_t _render = 0;
 
             struct TextureData
             {
+                std::weak_ptr<image::Image> image;
                 image::Info info;
                 ImageFilters imageFilters;
                 std::vector<std::shared_ptr<gl::Texture> > texture;
+                size_t byteCount = 0;
+                size_t render = 0;
             };
 
             std::list<TextureData> _cache;
@@ -137,28 +167,57 @@ namespace tl
             std::map<std::string, std::shared_ptr<gl::Shader> > shaders;
             std::map<std::string, std::shared_ptr<gl::OffscreenBuffer> > buffers;
             TextureCache textureCache;
+            std::shared_ptr<gl::PixelBufferRing> pixelBufferRing;
+            size_t pixelBufferRingByteCount = 0;
+            std::list<std::shared_ptr<gl::PixelBufferRing> > pixelBufferRingsOld;
             std::shared_ptr<gl::TextureAtlas> glyphTextureAtlas;
             std::map<image::GlyphInfo, gl::TextureAtlasID> glyphIDs;
             std::map<std::string, std::shared_ptr<gl::VBO> > vbos;
             std::map<std::string, std::shared_ptr<gl::VAO> > vaos;
 
-            std::chrono::steady_clock::time_point timer;
-            struct Stats
+            //! Rectangles, meshes, and text are accumulated into batches
+            //! that are drawn with a single call. The batch is flushed when
+            //! the shader, texture, color, framebuffer, or any other render
+            //! state changes. The vertex data is appended to one dynamic
+            //! vertex buffer for each vertex type, wrapping around when it
+            //! is full.
+            enum class BatchType
             {
-                int time = 0;
-                size_t rects = 0;
-                size_t meshes = 0;
-                size_t meshTriangles = 0;
-                size_t text = 0;
-                size_t textTriangles = 0;
-                size_t textures = 0;
-                size_t images = 0;
+                None,
+                Mesh,
+                Text
             };
-            Stats currentStats;
-            std::list<Stats> stats;
+            struct Batch
+            {
+                BatchType type = BatchType::None;
+                unsigned int texture = 0;
+                image::Color4f color;
+                unsigned int framebuffer = 0;
+                std::vector<uint8_t> data;
+                size_t vertexCount = 0;
+            };
+            Batch batch;
+            std::map<std::string, size_t> batchOffsets;
+
+            std::chrono::steady_clock::time_point timer;
+            GLRenderStats currentStats;
+            std::list<GLRenderStats> stats;
             std::chrono::steady_clock::time_point logTimer;
 
-            void drawTextMesh(const geom::TriangleMesh2&);
+            void batchBegin(
+                BatchType,
+                unsigned int texture = 0,
+                const image::Color4f& = image::Color4f());
+            void batchMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&,
+                bool vertexColors);
+            void batchText(
+                const geom::TriangleMesh2&,
+                unsigned int texture,
+                const image::Color4f&);
+            void flush();
         };
     }
 }
@@ -26,6 +26,7 @@ namespace tl
             const std::vector<DisplayOptions>& displayOptions,
             const CompareOptions& compareOptions)
         {
+            _p->flush();
             switch (compareOptions.mode)
             {
             case CompareMode::A:
@@ -186,6 +187,7 @@ namespace tl
                 {
                     p.vaos["wipe"]->bind();
                     p.vaos["wipe"]->draw(GL_TRIANGLES, 0, p.vbos["wipe"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
             glStencilFunc(GL_EQUAL, 1, 0xFF);
@@ -227,6 +229,7 @@ namespace tl
                 {
                     p.vaos["wipe"]->bind();
                     p.vaos["wipe"]->draw(GL_TRIANGLES, 0, p.vbos["wipe"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
             glStencilFunc(GL_EQUAL, 1, 0xFF);
@@ -340,6 +343,7 @@ namespace tl
                     {
                         p.vaos["video"]->bind();
                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                        ++(p.currentStats.drawCalls);
                     }
                 }
             }
@@ -492,6 +496,7 @@ namespace tl
                     {
                         p.vaos["video"]->bind();
                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                        ++(p.currentStats.drawCalls);
                     }
                 }
             }
@@ -654,6 +659,7 @@ namespace tl
                                     {
                                         p.vaos["video"]->bind();
                                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                                        ++(p.currentStats.drawCalls);
                                     }
                                 }
                             }
@@ -794,6 +800,7 @@ namespace tl
                 {
                     p.vaos["video"]->bind();
                     p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
 
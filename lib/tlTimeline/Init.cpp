@@ -4,7 +4,9 @@
 
 #include <tlTimeline/Init.h>
 
+#include <tlTimeline/FrameCacheSystem.h>
 #include <tlTimeline/MemoryReference.h>
+#include <tlTimeline/ThumbnailSystem.h>
 
 #include <tlIO/Init.h>
 
@@ -24,6 +26,14 @@ namespace tl
             {
                 context->addSystem(System::create(context));
             }
+            if (!context->getSystem<FrameCacheSystem>())
+            {
+                context->addSystem(FrameCacheSystem::create(context));
+            }
+            if (!context->getSystem<ThumbnailSystem>())
+            {
+                context->addSystem(ThumbnailSystem::create(context));
+            }
         }
 
         void System::_init(const std::shared_ptr<system::Context>& context)
@@ -71,6 +71,10 @@ namespace tl
                     arg(playerOptions.cache.readAhead));
                 lines.push_back(string::Format("    Cache read behind: {0}").
                     arg(playerOptions.cache.readBehind));
+                lines.push_back(string::Format("    Cache prefetch: {0}").
+                    arg(playerOptions.cache.prefetch));
+                lines.push_back(string::Format("    Cache adaptive: {0}").
+                    arg(playerOptions.cache.adaptive));
                 lines.push_back(string::Format("    Timer mode: {0}").
                     arg(playerOptions.timerMode));
                 lines.push_back(string::Format("    Audio buffer frame count: {0}").
@@ -92,6 +96,8 @@ namespace tl
             p.speed = observer::Value<double>::create(p.timeline->getTimeRange().duration().rate());
             p.playback = observer::Value<Playback>::create(Playback::Stop);
             p.loop = observer::Value<Loop>::create(Loop::Loop);
+            p.dropFrames = observer::Value<bool>::create(false);
+            p.droppedFrames = observer::Value<size_t>::create(0);
             p.currentTime = observer::Value<otime::RationalTime>::create(
                 playerOptions.currentTime != time::invalidTime ?
                 playerOptions.currentTime :
@@ -105,6 +111,7 @@ namespace tl
             p.currentAudioData = observer::List<AudioData>::create();
             p.cacheOptions = observer::Value<PlayerCacheOptions>::create(playerOptions.cache);
             p.cacheInfo = observer::Value<PlayerCacheInfo>::create();
+            p.stats = observer::Value<PlayerStats>::create();
             auto weak = std::weak_ptr<Player>(shared_from_this());
             p.timelineObserver = observer::ValueObserver<bool>::create(
                 p.timeline->observeTimelineChanges(),
@@ -122,7 +129,7 @@ namespace tl
             p.mutex.audioOffset = p.audioOffset->get();
             p.mutex.cacheOptions = p.cacheOptions->get();
             p.mutex.cacheInfo = p.cacheInfo->get();
-            p.audioMutex.speed = p.speed->get();
+            p.audioThread.speed = p.speed->get();
             p.thread.running = true;
             p.thread.thread = std::thread(
                 [this]
@@ -159,6 +166,11 @@ namespace tl
                                         _p.get(),
                                         nullptr,
                                         p.rtAudioErrorCallback);
+                                    p.audioThread.buffer = audio::AudioRingBuffer::create(
+                                        p.audioThread.info,
+                                        std::max(
+                                            static_cast<size_t>(rtBufferFrames),
+                                            p.playerOptions.audioBufferFrameCount) * 4);
                                     p.thread.rtAudio->startStream();
                                 }
                                 catch (const std::exception& e)
@@ -187,6 +199,7 @@ namespace tl
                         bool clearCache = false;
                         CacheDirection cacheDirection = CacheDirection::Forward;
                         PlayerCacheOptions cacheOptions;
+                        bool dropFrames = false;
                         {
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             playback = p.mutex.playback;
@@ -200,6 +213,11 @@ namespace tl
                             p.mutex.clearCache = false;
                             cacheDirection = p.mutex.cacheDirection;
                             cacheOptions = p.mutex.cacheOptions;
+                            if (clearCache)
+                            {
+                                p.thread.imageAllocator = p.mutex.imageAllocator;
+                            }
+                            dropFrames = p.mutex.dropFrames;
                         }
 
                         // Clear requests.
@@ -208,12 +226,14 @@ namespace tl
                             p.timeline->cancelRequests();
                             p.thread.videoDataRequests.clear();
                             p.thread.audioDataRequests.clear();
+                            p.thread.prefetchRanges.clear();
+                            p.thread.videoAvailable = false;
                         }
 
                         // Clear the cache.
                         if (clearCache)
                         {
-                            p.thread.videoDataCache.clear();
+                            p.thread.videoCache.clear();
                             {
                                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                                 p.mutex.cacheInfo = PlayerCacheInfo();
@@ -226,25 +246,68 @@ namespace tl
 
                         // Update the cache.
                         p.cacheUpdate(
+                            playback,
                             currentTime,
                             inOutRange,
                             videoLayer,
                             audioOffset,
                             cacheDirection,
-                            cacheOptions);
+                            cacheOptions,
+                            dropFrames);
 
                         // Update the current video data.
                         if (!p.ioInfo.video.empty())
                         {
                             const auto& timeRange = p.timeline->getTimeRange();
-                            const auto i = p.thread.videoDataCache.find(currentTime);
-                            if (i != p.thread.videoDataCache.end())
+                            VideoData videoData;
+                            const bool cached = p.thread.videoCache.get(currentTime, videoData);
+                            if (playback != Playback::Stop && currentTime != p.thread.statsTime)
+                            {
+                                p.thread.statsTime = currentTime;
+                                if (cached)
+                                {
+                                    ++p.thread.stats.videoCacheHits;
+                                }
+                                else
+                                {
+                                    ++p.thread.stats.videoCacheMisses;
+                                }
+                            }
+                            if (cached)
                             {
+                                p.thread.videoAvailable = true;
                                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                                p.mutex.currentVideoData = i->second;
+                                p.mutex.currentVideoData = videoData;
+                            }
+                            else if (playback != Playback::Stop && dropFrames)
+                            {
+                                // Keep playing and leave the previous frame
+                                // on screen.
+                                if (p.thread.drop.drop(currentTime))
+                                {
+                                    if (p.thread.drop.isStride(currentTime))
+                                    {
+                                        ++p.thread.stats.lateFrames;
+                                        if (p.thread.videoAvailable)
+                                        {
+                                            p.thread.videoStalled = true;
+                                        }
+                                    }
+                                    ++p.thread.stats.droppedFrames;
+                                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                    ++p.mutex.droppedFrames;
+                                }
+                                p.thread.videoAvailable = false;
                             }
                             else if (playback != Playback::Stop)
                             {
+                                // Playback has stalled if the previous frame
+                                // was available.
+                                if (p.thread.videoAvailable)
+                                {
+                                    p.thread.videoStalled = true;
+                                }
+                                p.thread.videoAvailable = false;
                                 {
                                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                                     p.mutex.playbackStartTime = currentTime;
@@ -257,8 +320,8 @@ namespace tl
                                 p.resetAudioTime();
                                 {
                                     const auto now = std::chrono::steady_clock::now();
-                                    std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
-                                    p.audioMutex.muteTimeout = now + p.playerOptions.muteTimeout;
+                                    p.audioThread.muteTimeout = (now + p.playerOptions.muteTimeout).
+                                        time_since_epoch().count();
                                 }
                             }
                             else
@@ -271,6 +334,9 @@ namespace tl
                             }
                         }
 
+                        // Update the audio buffer.
+                        p.audioUpdate();
+
                         // Update the current audio data.
                         if (p.ioInfo.audio.isValid())
                         {
@@ -418,10 +484,7 @@ namespace tl
                     }
                     p.resetAudioTime();
                 }
-                {
-                    std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
-                    p.audioMutex.speed = value;
-                }
+                p.audioThread.speed = value;
             }
         }
 
@@ -495,6 +558,7 @@ namespace tl
                             CacheDirection::Forward :
                             CacheDirection::Reverse;
                         p.mutex.clearRequests = true;
+                        p.mutex.droppedFrames = 0;
                     }
                     p.resetAudioTime();
                 }
@@ -522,6 +586,31 @@ namespace tl
             _p->loop->setIfChanged(value);
         }
 
+        bool Player::isDropFrames() const
+        {
+            return _p->dropFrames->get();
+        }
+
+        std::shared_ptr<observer::IValue<bool> > Player::observeDropFrames() const
+        {
+            return _p->dropFrames;
+        }
+
+        void Player::setDropFrames(bool value)
+        {
+            TLRENDER_P();
+            if (p.dropFrames->setIfChanged(value))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.dropFrames = value;
+            }
+        }
+
+        std::shared_ptr<observer::IValue<size_t> > Player::observeDroppedFrames() const
+        {
+            return _p->droppedFrames;
+        }
+
         otime::RationalTime Player::getCurrentTime() const
         {
             return _p->currentTime->get();
@@ -677,10 +766,7 @@ namespace tl
                 p.externalTime.playbackObserver.reset();
                 p.externalTime.currentTimeObserver.reset();
             }
-            {
-                std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                p.mutex.externalTime = p.externalTime.player.get();
-            }
+            p.audioThread.externalTime = p.externalTime.player.get() != nullptr;
         }
 
         otime::TimeRange Player::getInOutRange() const
@@ -778,8 +864,7 @@ namespace tl
             TLRENDER_P();
             if (p.volume->setIfChanged(math::clamp(value, 0.F, 1.F)))
             {
-                std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
-                p.audioMutex.volume = value;
+                p.audioThread.volume = p.volume->get();
             }
         }
 
@@ -798,8 +883,7 @@ namespace tl
             TLRENDER_P();
             if (p.mute->setIfChanged(value))
             {
-                std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
-                p.audioMutex.mute = value;
+                p.audioThread.mute = value;
             }
         }
 
@@ -853,6 +937,19 @@ namespace tl
             return _p->cacheInfo;
         }
 
+        std::shared_ptr<observer::IValue<PlayerStats> > Player::observeStats() const
+        {
+            return _p->stats;
+        }
+
+        void Player::setImageAllocator(const image::Allocator& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.imageAllocator = value;
+            p.mutex.clearCache = true;
+        }
+
         void Player::clearCache()
         {
             TLRENDER_P();
@@ -917,16 +1014,22 @@ namespace tl
             VideoData currentVideoData;
             std::vector<AudioData> currentAudioData;
             PlayerCacheInfo cacheInfo;
+            size_t droppedFrames = 0;
+            PlayerStats stats;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 p.mutex.currentTime = p.currentTime->get();
                 currentVideoData = p.mutex.currentVideoData;
                 currentAudioData = p.mutex.currentAudioData;
                 cacheInfo = p.mutex.cacheInfo;
+                droppedFrames = p.mutex.droppedFrames;
+                stats = p.mutex.stats;
             }
             p.currentVideoData->setIfChanged(currentVideoData);
             p.currentAudioData->setIfChanged(currentAudioData);
             p.cacheInfo->setIfChanged(cacheInfo);
+            p.droppedFrames->setIfChanged(droppedFrames);
+            p.stats->setIfChanged(stats);
         }
     }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlTimeline/PlayerOptions.h>
+#include <tlTimeline/PlayerStats.h>
 #include <tlTimeline/Timeline.h>
 
 #include <tlCore/ListObserver.h>
@@ -25,6 +26,19 @@ namespace tl
             //! Cached audio frames.
             std::vector<otime::TimeRange> audioFrames;
 
+            //! Cache read ahead. This is chosen by the player when adaptive
+            //! caching is enabled.
+            otime::RationalTime readAhead = time::invalidTime;
+
+            //! Maximum number of video requests in progress.
+            size_t videoRequestCount = 0;
+
+            //! Measured video throughput in frames per second.
+            double videoThroughput = 0.0;
+
+            //! Measured video latency in seconds.
+            double videoLatency = 0.0;
+
             bool operator == (const PlayerCacheInfo&) const;
             bool operator != (const PlayerCacheInfo&) const;
         };
@@ -162,6 +176,23 @@ namespace tl
             //! Set the playback loop mode.
             void setLoop(Loop);
 
+            //! Get whether frames are dropped when playback cannot keep up.
+            bool isDropFrames() const;
+
+            //! Observe whether frames are dropped when playback cannot keep
+            //! up.
+            std::shared_ptr<observer::IValue<bool> > observeDropFrames() const;
+
+            //! Set whether frames are dropped when playback cannot keep up.
+            //! Normally playback waits for frames that are not cached.
+            //! When frames are dropped, playback and audio keep going, the
+            //! previous frame stays on screen, and only the frames that can
+            //! arrive in time are requested.
+            void setDropFrames(bool);
+
+            //! Observe the number of frames dropped since playback started.
+            std::shared_ptr<observer::IValue<size_t> > observeDroppedFrames() const;
+
             ///@}
 
             //! \name Time
@@ -289,11 +320,28 @@ namespace tl
             //! Observe the cache information.
             std::shared_ptr<observer::IValue<PlayerCacheInfo> > observeCacheInfo() const;
 
+            //! Set the function used to allocate the cached video frames.
+            //! The frames are copied into the allocated images on the cache
+            //! thread, for example to stage them in a pixel buffer ring so
+            //! the render does not copy them again. Frames are cached as
+            //! they are when the allocator returns a null pointer. Setting
+            //! the allocator clears the cache.
+            void setImageAllocator(const image::Allocator&);
+
             //! Clear the cache.
             void clearCache();
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Observe the playback statistics. The statistics are updated
+            //! about twice a second.
+            std::shared_ptr<observer::IValue<PlayerStats> > observeStats() const;
+
+            ///@}
+
             //! Tick the timeline player.
             void tick();
 
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/PlayerAudio.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace tl
+{
+    namespace timeline
+    {
+        void PlayerAudio::output(void* outputBuffer, size_t nFrames, double rate)
+        {
+            // The audio is mixed and converted by the player thread, and
+            // only copied here.
+
+            // Zero output audio data.
+            std::memset(outputBuffer, 0, nFrames * info.getByteCount());
+
+            if (!buffer)
+                return;
+
+            // Flush the buffer when requested by the player thread.
+            const size_t flushValue = flush.load();
+            if (flushValue != flushAck.load(std::memory_order_relaxed))
+            {
+                buffer->clear();
+                dropCount = 0;
+                flushAck.store(flushValue);
+            }
+
+            // Output silence while a reset is pending.
+            if (reset.load() != flushValue)
+                return;
+
+            if (Playback::Forward == playback.load())
+            {
+                // Discard audio for frames that have already been played.
+                dropCount -= buffer->discard(dropCount);
+
+                if (buffer->getReadAvailable() >= nFrames)
+                {
+                    // Copy audio data to the output.
+                    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+                    if (speed.load() == rate &&
+                        !externalTime.load() &&
+                        !mute.load() &&
+                        now >= muteTimeout.load())
+                    {
+                        buffer->read(
+                            reinterpret_cast<uint8_t*>(outputBuffer),
+                            nFrames,
+                            volume.load());
+                    }
+                    else
+                    {
+                        buffer->discard(nFrames);
+                    }
+                }
+                else
+                {
+                    // The buffer has run dry, discard the audio for these
+                    // frames when it arrives to stay in sync.
+                    dropCount += nFrames;
+                    ++underruns;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Player.h>
+
+#include <tlCore/AudioConvert.h>
+#include <tlCore/AudioRingBuffer.h>
+
+#include <atomic>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Audio state shared between the player thread and the audio
+        //! callback.
+        struct PlayerAudio
+        {
+            //! Copy audio from the buffer to the output. This runs on the
+            //! real-time audio thread, so it must not allocate memory or
+            //! take locks.
+            void output(void* outputBuffer, size_t nFrames, double rate);
+
+            audio::Info info;
+
+            // Values shared with the audio callback.
+            std::atomic<Playback> playback = { Playback::Stop };
+            std::atomic<bool> externalTime = { false };
+            std::atomic<double> speed = { 0.0 };
+            std::atomic<float> volume = { 1.F };
+            std::atomic<bool> mute = { false };
+            std::atomic<int64_t> muteTimeout = { 0 };
+            std::atomic<size_t> reset = { 0 };
+            std::atomic<size_t> flush = { 0 };
+            std::atomic<size_t> flushAck = { 0 };
+            std::atomic<size_t> underruns = { 0 };
+            std::shared_ptr<audio::AudioRingBuffer> buffer;
+
+            // Values used by the player thread to fill the buffer.
+            std::shared_ptr<audio::AudioConvert> convert;
+            std::shared_ptr<audio::Audio> convertBuffer;
+            size_t convertBufferOffset = 0;
+            size_t fillReset = 0;
+            int64_t fillFrame = 0;
+
+            // Values used only by the audio callback.
+            size_t dropCount = 0;
+        };
+    }
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/PlayerDrop.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            // The drop stride is decreased when this much of the read ahead
+            // is cached...
+            const double dropCached = .5;
+
+            // ...for this many cache updates.
+            const size_t dropStableCount = 4;
+        }
+
+        bool PlayerDrop::isStride(const otime::RationalTime& time) const
+        {
+            const int64_t stride = this->stride;
+            const int64_t frame = static_cast<int64_t>(time.value());
+            return 0 == ((frame % stride) + stride) % stride;
+        }
+
+        bool PlayerDrop::isRequest(
+            const otime::RationalTime& time,
+            const otime::RationalTime& currentTime,
+            CacheDirection cacheDirection,
+            double lead,
+            double readBehind,
+            double inOutDuration) const
+        {
+            double offset = CacheDirection::Forward == cacheDirection ?
+                (time - currentTime).value() :
+                (currentTime - time).value();
+            if (offset < 0.0 && -offset > readBehind)
+            {
+                // The cache window wrapped around the in/out range.
+                offset += inOutDuration;
+            }
+            return offset >= lead && isStride(time);
+        }
+
+        bool PlayerDrop::drop(const otime::RationalTime& currentTime)
+        {
+            bool out = false;
+            if (currentTime != dropTime)
+            {
+                dropTime = currentTime;
+                if (isStride(currentTime))
+                {
+                    // Frames at the stride were requested, so they are
+                    // late.
+                    ++lateFrames;
+                }
+                out = true;
+            }
+            return out;
+        }
+
+        void PlayerDrop::update(
+            double speed,
+            double throughput,
+            double cached,
+            double readAhead)
+        {
+            const size_t strideMax = std::max(static_cast<size_t>(speed), size_t(1));
+            if (lateFrames > 0)
+            {
+                size_t value = stride + 1;
+                if (throughput > 0.0)
+                {
+                    value = std::max(value, static_cast<size_t>(std::ceil(speed / throughput)));
+                }
+                stride = std::min(value, strideMax);
+                stable = 0;
+            }
+            else if (stride > 1 &&
+                cached >= readAhead * dropCached &&
+                ++stable >= dropStableCount)
+            {
+                --stride;
+                stable = 0;
+            }
+            lateFrames = 0;
+        }
+
+        void PlayerDrop::reset()
+        {
+            stride = 1;
+            stable = 0;
+            lateFrames = 0;
+        }
+    }
+}
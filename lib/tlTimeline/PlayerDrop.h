@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Time.h>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Cache direction.
+        enum class CacheDirection
+        {
+            Forward,
+            Reverse
+        };
+
+        //! Frame dropping state used by the player thread.
+        struct PlayerDrop
+        {
+            //! Get whether the time is at the drop stride.
+            bool isStride(const otime::RationalTime&) const;
+
+            //! Get whether an uncached frame should be requested. Frames
+            //! that are not at the stride, or that are closer to the
+            //! current time than the lead, are skipped. The read behind and
+            //! in/out duration are used when the cache window wraps around
+            //! the in/out range.
+            bool isRequest(
+                const otime::RationalTime& time,
+                const otime::RationalTime& currentTime,
+                CacheDirection,
+                double lead,
+                double readBehind,
+                double inOutDuration) const;
+
+            //! Drop the current frame because it is not cached. Returns
+            //! true the first time the frame is dropped.
+            bool drop(const otime::RationalTime& currentTime);
+
+            //! Update the stride after a cache update. The stride is
+            //! increased when frames at the stride arrived late, and
+            //! decreased again after enough of the read ahead has been
+            //! cached for a while.
+            void update(
+                double speed,
+                double throughput,
+                double cached,
+                double readAhead);
+
+            //! Reset the stride.
+            void reset();
+
+            size_t stride = 1;
+            size_t stable = 0;
+            size_t lateFrames = 0;
+            otime::RationalTime dropTime = time::invalidTime;
+        };
+    }
+}
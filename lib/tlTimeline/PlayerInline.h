@@ -11,7 +11,11 @@ namespace tl
             return
                 videoPercentage == other.videoPercentage &&
                 videoFrames == other.videoFrames &&
-                audioFrames == other.audioFrames;
+                audioFrames == other.audioFrames &&
+                readAhead == other.readAhead &&
+                videoRequestCount == other.videoRequestCount &&
+                videoThroughput == other.videoThroughput &&
+                videoLatency == other.videoLatency;
         }
 
         inline bool PlayerCacheInfo::operator != (const PlayerCacheInfo& other) const
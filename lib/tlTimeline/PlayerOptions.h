@@ -31,6 +31,17 @@ namespace tl
             //! Cache read behind.
             otime::RationalTime readBehind = otime::RationalTime(0.5, 1.0);
 
+            //! Prefetch hint passed to the readers for the time just beyond
+            //! the read ahead.
+            otime::RationalTime prefetch = otime::RationalTime(2.0, 1.0);
+
+            //! Adapt the read ahead and the number of video requests to the
+            //! measured throughput and latency of the timeline. The read
+            //! ahead is used as the maximum, and the timeline option
+            //! Options::videoRequestCount as the maximum number of
+            //! requests.
+            bool adaptive = false;
+
             bool operator == (const PlayerCacheOptions&) const;
             bool operator != (const PlayerCacheOptions&) const;
         };
@@ -10,7 +10,9 @@ namespace tl
         {
             return
                 readAhead == other.readAhead &&
-                readBehind == other.readBehind;
+                readBehind == other.readBehind &&
+                prefetch == other.prefetch &&
+                adaptive == other.adaptive;
         }
 
         inline bool PlayerCacheOptions::operator != (const PlayerCacheOptions& other) const
@@ -8,10 +8,33 @@
 
 #include <tlCore/StringFormat.h>
 
+#include <cmath>
+#include <cstring>
+
 namespace tl
 {
     namespace timeline
     {
+        namespace
+        {
+            std::shared_ptr<image::Image> allocateImage(
+                const image::Allocator& allocator,
+                const std::shared_ptr<image::Image>& image)
+            {
+                std::shared_ptr<image::Image> out = image;
+                if (image)
+                {
+                    if (auto tmp = allocator(image->getInfo()))
+                    {
+                        memcpy(tmp->getData(), image->getData(), image->getDataByteCount());
+                        tmp->setTags(image->getTags());
+                        out = tmp;
+                    }
+                }
+                return out;
+            }
+        }
+
         otime::RationalTime Player::Private::loopPlayback(const otime::RationalTime& time)
         {
             otime::RationalTime out = time;
@@ -101,17 +124,51 @@ namespace tl
         }
 
         void Player::Private::cacheUpdate(
+            Playback playback,
             const otime::RationalTime& currentTime,
             const otime::TimeRange& inOutRange,
             size_t videoLayer,
             double audioOffset,
             CacheDirection cacheDirection,
-            const PlayerCacheOptions& cacheOptions)
+            const PlayerCacheOptions& cacheOptions,
+            bool dropFrames)
         {
+            // Update the adaptive cache controller options. The cache
+            // options and the timeline options are used as the maximums.
+            if (cacheOptions.adaptive)
+            {
+                CacheControllerOptions controllerOptions = thread.cacheController.getOptions();
+                controllerOptions.videoRequestCount = math::SizeTRange(
+                    1,
+                    std::max(timeline->getOptions().videoRequestCount, size_t(1)));
+                const double readAheadMax = cacheOptions.readAhead.rescaled_to(1.0).value();
+                controllerOptions.readAhead = math::DoubleRange(
+                    std::min(CacheControllerOptions().readAhead.getMin(), readAheadMax),
+                    readAheadMax);
+                if (controllerOptions != thread.cacheController.getOptions())
+                {
+                    thread.cacheController.setOptions(controllerOptions);
+                }
+                if (!thread.cacheAdaptive)
+                {
+                    thread.cacheAdaptive = true;
+                    thread.cacheController.reset();
+                    timeline->setVideoRequestCount(thread.cacheController.getVideoRequestCount());
+                }
+            }
+            else if (thread.cacheAdaptive)
+            {
+                thread.cacheAdaptive = false;
+                timeline->setVideoRequestCount(timeline->getOptions().videoRequestCount);
+            }
+            const otime::RationalTime readAhead = cacheOptions.adaptive ?
+                otime::RationalTime(thread.cacheController.getReadAhead(), 1.0) :
+                cacheOptions.readAhead;
+
             // Get the video ranges to be cached.
             const otime::TimeRange& timeRange = timeline->getTimeRange();
             const otime::RationalTime readAheadRescaled =
-                time::floor(cacheOptions.readAhead.rescaled_to(timeRange.duration().rate()));
+                time::floor(readAhead.rescaled_to(timeRange.duration().rate()));
             const otime::RationalTime readBehindRescaled =
                 time::floor(cacheOptions.readBehind.rescaled_to(timeRange.duration().rate()));
             otime::TimeRange videoRange = time::invalidTimeRange;
@@ -137,6 +194,31 @@ namespace tl
             //    std::cout << "video ranges: " << i << std::endl;
             //}
 
+            // Get the video ranges to be prefetched.
+            std::vector<otime::TimeRange> prefetchRanges;
+            const otime::RationalTime prefetchRescaled =
+                time::floor(cacheOptions.prefetch.rescaled_to(timeRange.duration().rate()));
+            if (prefetchRescaled.value() > 0.0)
+            {
+                const otime::RationalTime one(1.0, timeRange.duration().rate());
+                otime::TimeRange prefetchRange = time::invalidTimeRange;
+                switch (cacheDirection)
+                {
+                case CacheDirection::Forward:
+                    prefetchRange = otime::TimeRange::range_from_start_end_time_inclusive(
+                        currentTime + readAheadRescaled + one,
+                        currentTime + readAheadRescaled + prefetchRescaled);
+                    break;
+                case CacheDirection::Reverse:
+                    prefetchRange = otime::TimeRange::range_from_start_end_time_inclusive(
+                        currentTime - readAheadRescaled - prefetchRescaled,
+                        currentTime - readAheadRescaled - one);
+                    break;
+                default: break;
+                }
+                prefetchRanges = timeline::loop(prefetchRange, inOutRange);
+            }
+
             // Get the audio ranges to be cached.
             const otime::RationalTime audioOffsetTime = otime::RationalTime(audioOffset, 1.0).
                 rescaled_to(timeRange.duration().rate());
@@ -171,25 +253,7 @@ namespace tl
             const auto audioRanges = timeline::loop(audioRange, inOutAudioRange);
 
             // Remove old video from the cache.
-            auto videoDataCacheIt = thread.videoDataCache.begin();
-            while (videoDataCacheIt != thread.videoDataCache.end())
-            {
-                bool old = true;
-                for (const auto& i : videoRanges)
-                {
-                    if (i.contains(videoDataCacheIt->second.time))
-                    {
-                        old = false;
-                        break;
-                    }
-                }
-                if (old)
-                {
-                    videoDataCacheIt = thread.videoDataCache.erase(videoDataCacheIt);
-                    continue;
-                }
-                ++videoDataCacheIt;
-            }
+            thread.videoCache.setWindow(videoRanges, inOutRange);
 
             // Remove old audio from the cache.
             {
@@ -218,25 +282,39 @@ namespace tl
                 }
             }
 
-            // Get uncached video.
+            // Get uncached video. When dropping frames during playback,
+            // only frames at the drop stride are requested, and frames that
+            // cannot arrive before they are displayed are skipped.
+            const bool drop = dropFrames && playback != Playback::Stop;
             if (!ioInfo.video.empty())
             {
-                for (const auto& range : videoRanges)
+                const double lead = drop ?
+                    std::ceil(thread.cacheController.getVideoLatency() * audioThread.speed.load()) :
+                    0.0;
+                for (const auto& range : thread.videoCache.getUncachedRanges())
                 {
                     const auto start = range.start_time();
                     const auto end = range.end_time_exclusive();
                     const auto inc = otime::RationalTime(1.0, range.duration().rate());
                     for (auto time = start; time < end; time += inc)
                     {
-                        const auto i = thread.videoDataCache.find(time);
-                        if (i == thread.videoDataCache.end())
+                        if (drop && !thread.drop.isRequest(
+                            time,
+                            currentTime,
+                            cacheDirection,
+                            lead,
+                            readBehindRescaled.value(),
+                            inOutRange.duration().value()))
                         {
-                            const auto j = thread.videoDataRequests.find(time);
-                            if (j == thread.videoDataRequests.end())
-                            {
-                                //std::cout << this << " video request: " << time << std::endl;
-                                thread.videoDataRequests[time] = timeline->getVideo(time, videoLayer);
-                            }
+                            continue;
+                        }
+                        const auto i = thread.videoDataRequests.find(time);
+                        if (i == thread.videoDataRequests.end())
+                        {
+                            //std::cout << this << " video request: " << time << std::endl;
+                            thread.videoDataRequests[time] = {
+                                timeline->getVideo(time, videoLayer),
+                                std::chrono::steady_clock::now() };
                         }
                     }
                 }
@@ -288,16 +366,38 @@ namespace tl
                 }*/
             }
 
+            // Pass the prefetch hints to the timeline.
+            if (!ioInfo.video.empty() && prefetchRanges != thread.prefetchRanges)
+            {
+                thread.prefetchRanges = prefetchRanges;
+                for (const auto& range : prefetchRanges)
+                {
+                    timeline->prefetch(range);
+                }
+            }
+
             // Check for finished video.
             auto videoDataRequestsIt = thread.videoDataRequests.begin();
             while (videoDataRequestsIt != thread.videoDataRequests.end())
             {
-                if (videoDataRequestsIt->second.valid() &&
-                    videoDataRequestsIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                auto& future = videoDataRequestsIt->second.future;
+                if (future.valid() &&
+                    future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    auto data = videoDataRequestsIt->second.get();
+                    auto data = future.get();
                     data.time = videoDataRequestsIt->first;
-                    thread.videoDataCache[data.time] = data;
+                    const std::chrono::duration<double, std::milli> latency =
+                        std::chrono::steady_clock::now() - videoDataRequestsIt->second.time;
+                    ++thread.stats.videoLatency[getLatencyBucket(latency.count())];
+                    if (thread.imageAllocator)
+                    {
+                        for (auto& layer : data.layers)
+                        {
+                            layer.image = allocateImage(thread.imageAllocator, layer.image);
+                            layer.imageB = allocateImage(thread.imageAllocator, layer.imageB);
+                        }
+                    }
+                    thread.videoCache.add(data);
                     videoDataRequestsIt = thread.videoDataRequests.erase(videoDataRequestsIt);
                     continue;
                 }
@@ -329,13 +429,9 @@ namespace tl
             if (diff.count() > .5F)
             {
                 thread.cacheTimer = now;
-                std::vector<otime::RationalTime> cachedVideoFrames;
-                for (const auto& i : thread.videoDataCache)
-                {
-                    cachedVideoFrames.push_back(i.second.time);
-                }
-                const float cachedVideoPercentage = cachedVideoFrames.size() /
-                    static_cast<float>(cacheOptions.readAhead.rescaled_to(timeRange.duration().rate()).value() +
+                const RequestStats requestStats = timeline->getRequestStats();
+                const float cachedVideoPercentage = thread.videoCache.getCount() /
+                    static_cast<float>(readAhead.rescaled_to(timeRange.duration().rate()).value() +
                         cacheOptions.readBehind.rescaled_to(timeRange.duration().rate()).value()) *
                     100.F;
                 std::vector<otime::RationalTime> cachedAudioFrames;
@@ -346,7 +442,7 @@ namespace tl
                         cachedAudioFrames.push_back(otime::RationalTime(i.second.seconds, 1.0));
                     }
                 }
-                auto cachedVideoRanges = toRanges(cachedVideoFrames);
+                const auto cachedVideoRanges = thread.videoCache.getCachedRanges();
                 auto cachedAudioRanges = toRanges(cachedAudioFrames);
                 for (auto& i : cachedAudioRanges)
                 {
@@ -355,21 +451,225 @@ namespace tl
                         time::ceil(i.duration().rescaled_to(timeRange.duration().rate())));
                 }
                 float cachedAudioPercentage = 0.F;
+
+                // Get the amount of video cached ahead of the current time,
+                // counting only the frames at the drop stride.
+                const size_t stride = drop ? thread.drop.stride : 1;
+                const otime::RationalTime strideTime(
+                    CacheDirection::Forward == cacheDirection ? stride : -static_cast<double>(stride),
+                    timeRange.duration().rate());
+                otime::RationalTime cachedTime = currentTime;
+                while (drop && !thread.drop.isStride(cachedTime))
+                {
+                    cachedTime += otime::RationalTime(
+                        CacheDirection::Forward == cacheDirection ? 1.0 : -1.0,
+                        timeRange.duration().rate());
+                }
+                size_t cachedCount = 0;
+                for (; thread.videoCache.contains(cachedTime); cachedTime += strideTime)
+                {
+                    ++cachedCount;
+                }
+                const double cached = cachedCount * stride / timeRange.duration().rate();
+
+                // Update the adaptive cache controller. The throughput and
+                // latency are measured when the controller is not enabled,
+                // but nothing is adjusted.
+                const double rate = cacheOptions.adaptive && playback != Playback::Stop ?
+                    audioThread.speed.load() :
+                    0.0;
+                if (thread.cacheController.update(
+                    now,
+                    requestStats,
+                    rate,
+                    cached,
+                    thread.videoStalled))
+                {
+                    timeline->setVideoRequestCount(thread.cacheController.getVideoRequestCount());
+                }
+                thread.videoStalled = false;
+
+                // Update the drop stride.
+                if (drop)
+                {
+                    thread.drop.update(
+                        audioThread.speed.load(),
+                        thread.cacheController.getVideoThroughput(),
+                        cached,
+                        readAhead.rescaled_to(1.0).value());
+                }
+                else
+                {
+                    thread.drop.reset();
+                }
+
+                // Update the statistics.
+                thread.stats.frameCacheHits = requestStats.frameCacheHits;
+                thread.stats.frameCacheMisses = requestStats.frameCacheMisses;
+                thread.stats.videoRequests = thread.videoDataRequests.size();
+                thread.stats.audioRequests = thread.audioDataRequests.size();
+                thread.stats.timelineVideoRequests = requestStats.videoRequests;
+                thread.stats.timelineVideoRequestsInProgress = requestStats.videoRequestsInProgress;
+                thread.stats.timelineAudioRequests = requestStats.audioRequests;
+                thread.stats.timelineAudioRequestsInProgress = requestStats.audioRequestsInProgress;
+                thread.stats.readBytesPerSecond.clear();
+                for (const auto& i : requestStats.readBytes)
+                {
+                    const auto j = thread.readBytes.find(i.first);
+                    const size_t bytes = j != thread.readBytes.end() && i.second >= j->second ?
+                        i.second - j->second :
+                        i.second;
+                    thread.stats.readBytesPerSecond[i.first] = bytes / diff.count();
+                }
+                thread.readBytes = requestStats.readBytes;
+                thread.stats.audioUnderruns = audioThread.underruns.load();
+
                 {
                     std::unique_lock<std::mutex> lock(mutex.mutex);
+                    mutex.stats = thread.stats;
                     mutex.cacheInfo.videoPercentage = cachedVideoPercentage;
                     mutex.cacheInfo.videoFrames = cachedVideoRanges;
                     mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                    mutex.cacheInfo.readAhead = readAhead;
+                    mutex.cacheInfo.videoRequestCount = timeline->getVideoRequestCount();
+                    mutex.cacheInfo.videoThroughput = thread.cacheController.getVideoThroughput();
+                    mutex.cacheInfo.videoLatency = thread.cacheController.getVideoLatency();
                 }
             }
         }
 
-        void Player::Private::resetAudioTime()
+        void Player::Private::audioUpdate()
         {
+            if (!audioThread.buffer)
+                return;
+
+            // When the audio time is reset, flush the converter and ask the
+            // audio callback to flush the buffer. Nothing is written to the
+            // buffer until the audio callback has acknowledged the flush,
+            // so stale audio is never played.
+            const size_t reset = audioThread.reset.load();
+            if (reset != audioThread.fillReset)
             {
-                std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                audioMutex.reset = true;
+                audioThread.fillReset = reset;
+                if (audioThread.convert)
+                {
+                    audioThread.convert->flush();
+                }
+                audioThread.convertBuffer.reset();
+                audioThread.convertBufferOffset = 0;
+                audioThread.fillFrame = 0;
+                audioThread.flush.store(reset);
+            }
+
+            // Get mutex protected values. These are read after the reset
+            // count, since the playback start time is set before the
+            // audio time is reset.
+            Playback playback = Playback::Stop;
+            otime::RationalTime playbackStartTime = time::invalidTime;
+            double audioOffset = 0.0;
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                playback = mutex.playback;
+                playbackStartTime = mutex.playbackStartTime;
+                audioOffset = mutex.audioOffset;
+            }
+            audioThread.playback = playback;
+
+            if (audioThread.flushAck.load() != audioThread.fillReset ||
+                playback != Playback::Forward ||
+                !ioInfo.audio.isValid())
+                return;
+
+            // Create the audio converter.
+            if (!audioThread.convert ||
+                (audioThread.convert && audioThread.convert->getInputInfo() != ioInfo.audio))
+            {
+                audioThread.convert = audio::AudioConvert::create(
+                    ioInfo.audio,
+                    audioThread.info);
+            }
+
+            // Fill the buffer with mixed and converted audio.
+            const size_t sampleRate = ioInfo.audio.sampleRate;
+            const int64_t playbackStartFrame =
+                playbackStartTime.rescaled_to(sampleRate).value() -
+                otime::RationalTime(audioOffset, 1.0).rescaled_to(sampleRate).value();
+            const size_t outputByteCount = audioThread.info.getByteCount();
+            while (true)
+            {
+                // Write the converted audio that did not fit last time.
+                if (audioThread.convertBuffer)
+                {
+                    const size_t sampleCount =
+                        audioThread.convertBuffer->getSampleCount() -
+                        audioThread.convertBufferOffset;
+                    const size_t count = audioThread.buffer->write(
+                        audioThread.convertBuffer->getData() +
+                        audioThread.convertBufferOffset * outputByteCount,
+                        sampleCount);
+                    audioThread.convertBufferOffset += count;
+                    if (count < sampleCount)
+                        break;
+                    audioThread.convertBuffer.reset();
+                    audioThread.convertBufferOffset = 0;
+                }
+
+                const int64_t frame = playbackStartFrame + audioThread.fillFrame;
+                const int64_t seconds = frame / static_cast<int64_t>(sampleRate);
+                const int64_t offset = frame - seconds * sampleRate;
+                const size_t size = std::min(
+                    playerOptions.audioBufferFrameCount,
+                    static_cast<size_t>(sampleRate - offset));
+                const size_t convertedSize = otime::RationalTime(size, sampleRate).
+                    rescaled_to(audioThread.info.sampleRate).value();
+                if (audioThread.buffer->getWriteAvailable() < convertedSize)
+                    break;
+
+                AudioData audioData;
+                {
+                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                    const auto i = audioMutex.audioDataCache.find(seconds);
+                    if (i != audioMutex.audioDataCache.end())
+                    {
+                        audioData = i->second;
+                    }
+                }
+                if (audioData.layers.empty())
+                    break;
+                std::vector<const uint8_t*> audioDataP;
+                for (const auto& layer : audioData.layers)
+                {
+                    if (layer.audio && layer.audio->getInfo() == ioInfo.audio)
+                    {
+                        audioDataP.push_back(
+                            layer.audio->getData() +
+                            (offset * ioInfo.audio.getByteCount()));
+                    }
+                }
+
+                // The volume is applied by the audio callback so that
+                // changes are heard immediately.
+                auto tmp = audio::Audio::create(ioInfo.audio, size);
+                tmp->zero();
+                audio::mix(
+                    audioDataP.data(),
+                    audioDataP.size(),
+                    tmp->getData(),
+                    1.F,
+                    size,
+                    ioInfo.audio.channelCount,
+                    ioInfo.audio.dataType);
+                audioThread.convertBuffer = audioThread.convert->convert(tmp);
+                audioThread.convertBufferOffset = 0;
+                if (!audioThread.convertBuffer)
+                    break;
+                audioThread.fillFrame += size;
             }
+        }
+
+        void Player::Private::resetAudioTime()
+        {
+            ++audioThread.reset;
 #if defined(TLRENDER_AUDIO)
             if (thread.rtAudio &&
                 thread.rtAudio->isStreamRunning())
@@ -396,160 +696,10 @@ namespace tl
             void* userData)
         {
             auto p = reinterpret_cast<Player::Private*>(userData);
-            
-            // Get mutex protected values.
-            Playback playback = Playback::Stop;
-            int64_t playbackStartFrame = 0;
-            bool externalTime = false;
-            {
-                std::unique_lock<std::mutex> lock(p->mutex.mutex);
-                playback = p->mutex.playback;
-                playbackStartFrame =
-                    p->mutex.playbackStartTime.rescaled_to(p->ioInfo.audio.sampleRate).value() -
-                    otime::RationalTime(p->mutex.audioOffset, 1.0).rescaled_to(p->ioInfo.audio.sampleRate).value();
-                externalTime = p->mutex.externalTime;
-            }
-            double speed = 0.0;
-            float volume = 1.F;
-            bool mute = false;
-            std::chrono::steady_clock::time_point muteTimeout;
-            bool reset = false;
-            {
-                std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                speed = p->audioMutex.speed;
-                volume = p->audioMutex.volume;
-                mute = p->audioMutex.mute;
-                muteTimeout = p->audioMutex.muteTimeout;
-                reset = p->audioMutex.reset;
-                p->audioMutex.reset = false;
-            }
-            //std::cout << "playback: " << playback << std::endl;
-            //std::cout << "playbackStartTime: " << playbackStartTime << std::endl;
-            //std::cout << "reset: " << reset << std::endl;
-
-            // Zero output audio data.
-            std::memset(outputBuffer, 0, nFrames * p->audioThread.info.getByteCount());
-
-            switch (playback)
-            {
-            case Playback::Forward:
-            {
-                // Flush the audio converter and buffer when the RtAudio
-                // playback is reset.
-                if (reset)
-                {
-                    if (p->audioThread.convert)
-                    {
-                        p->audioThread.convert->flush();
-                    }
-                    p->audioThread.buffer.clear();
-                    p->audioThread.rtAudioCurrentFrame = 0;
-                }
-
-                // Create the audio converter.
-                if (!p->audioThread.convert ||
-                    (p->audioThread.convert && p->audioThread.convert->getInputInfo() != p->ioInfo.audio))
-                {
-                    p->audioThread.convert = audio::AudioConvert::create(
-                        p->ioInfo.audio,
-                        p->audioThread.info);
-                }
-
-                // Fill the audio buffer.
-                if (p->ioInfo.audio.sampleRate > 0)
-                {
-                    int64_t frame = playbackStartFrame +
-                        otime::RationalTime(
-                            p->audioThread.rtAudioCurrentFrame + audio::getSampleCount(p->audioThread.buffer),
-                            p->audioThread.info.sampleRate).rescaled_to(p->ioInfo.audio.sampleRate).value();
-                    int64_t seconds = p->ioInfo.audio.sampleRate > 0 ? (frame / p->ioInfo.audio.sampleRate) : 0;
-                    int64_t offset = frame - seconds * p->ioInfo.audio.sampleRate;
-                    while (audio::getSampleCount(p->audioThread.buffer) < nFrames)
-                    {
-                        //std::cout << "frame: " << frame << std::endl;
-                        //std::cout << "seconds: " << seconds << std::endl;
-                        //std::cout << "offset: " << offset << std::endl;
-                        AudioData audioData;
-                        {
-                            std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                            const auto j = p->audioMutex.audioDataCache.find(seconds);
-                            if (j != p->audioMutex.audioDataCache.end())
-                            {
-                                audioData = j->second;
-                            }
-                        }
-                        if (audioData.layers.empty())
-                        {
-                            break;
-                        }
-                        std::vector<const uint8_t*> audioDataP;
-                        for (const auto& layer : audioData.layers)
-                        {
-                            if (layer.audio && layer.audio->getInfo() == p->ioInfo.audio)
-                            {
-                                audioDataP.push_back(
-                                    layer.audio->getData() +
-                                    (offset * p->ioInfo.audio.getByteCount()));
-                            }
-                        }
-
-                        const size_t size = std::min(
-                            p->playerOptions.audioBufferFrameCount,
-                            static_cast<size_t>(p->ioInfo.audio.sampleRate - offset));
-                        //std::cout << "size: " << size << std::endl;
-                        auto tmp = audio::Audio::create(p->ioInfo.audio, size);
-                        tmp->zero();
-                        audio::mix(
-                            audioDataP.data(),
-                            audioDataP.size(),
-                            tmp->getData(),
-                            volume,
-                            size,
-                            p->ioInfo.audio.channelCount,
-                            p->ioInfo.audio.dataType);
-
-                        if (p->audioThread.convert)
-                        {
-                            p->audioThread.buffer.push_back(p->audioThread.convert->convert(tmp));
-                        }
-
-                        offset += size;
-                        if (offset >= p->ioInfo.audio.sampleRate)
-                        {
-                            offset -= p->ioInfo.audio.sampleRate;
-                            seconds += 1;
-                        }
-
-                        //std::cout << std::endl;
-                    }
-                }
-
-                // Copy audio data to RtAudio.
-                const auto now = std::chrono::steady_clock::now();
-                if (speed == p->timeline->getTimeRange().duration().rate() &&
-                    !externalTime &&
-                    !mute &&
-                    now >= muteTimeout &&
-                    nFrames <= getSampleCount(p->audioThread.buffer))
-                {
-                    audio::copy(
-                        p->audioThread.buffer,
-                        reinterpret_cast<uint8_t*>(outputBuffer),
-                        nFrames);
-                }
-
-                // Update the audio frame.
-                p->audioThread.rtAudioCurrentFrame += nFrames;
-
-                break;
-            }
-            case Playback::Reverse:
-                // Update the audio frame.
-                p->audioThread.rtAudioCurrentFrame += nFrames;
-                break;
-            default: break;
-            }
-
+            p->audioThread.output(
+                outputBuffer,
+                nFrames,
+                p->timeline->getTimeRange().duration().rate());
             return 0;
         }
 
@@ -634,20 +784,23 @@ namespace tl
                 "    In/out range: {2}\n"
                 "    Video layer: {3}\n"
                 "    Cache: {4} read ahead, {5} read behind\n"
-                "    Video: {6} requests, {7} cached\n"
-                "    Audio: {8} requests, {9} cached\n"
-                "    {10}\n"
-                "    {11}\n"
-                "    {12}\n"
+                "    Video: {6} requests, {7} cached, {8} in-progress max, {9} fps, {10}ms latency\n"
+                "    Audio: {11} requests, {12} cached\n"
+                "    {13}\n"
+                "    {14}\n"
+                "    {15}\n"
                 "    (T=current time, V=cached video, A=cached audio)").
                 arg(timeline->getPath().get()).
                 arg(currentTime).
                 arg(inOutRange).
                 arg(videoLayer).
-                arg(cacheOptions->get().readAhead).
+                arg(cacheInfo.readAhead).
                 arg(cacheOptions->get().readBehind).
                 arg(thread.videoDataRequests.size()).
-                arg(thread.videoDataCache.size()).
+                arg(thread.videoCache.getCount()).
+                arg(cacheInfo.videoRequestCount).
+                arg(cacheInfo.videoThroughput, 2).
+                arg(cacheInfo.videoLatency * 1000.0, 2).
                 arg(thread.audioDataRequests.size()).
                 arg(audioDataCacheSize).
                 arg(currentTimeDisplay).
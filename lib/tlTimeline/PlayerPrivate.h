@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <tlTimeline/CacheController.h>
 #include <tlTimeline/Player.h>
+#include <tlTimeline/PlayerAudio.h>
+#include <tlTimeline/PlayerDrop.h>
+#include <tlTimeline/VideoCache.h>
 
-#include <tlCore/AudioConvert.h>
 #include <tlCore/LRUCache.h>
 
 #if defined(TLRENDER_AUDIO)
@@ -21,23 +24,21 @@ namespace tl
 {
     namespace timeline
     {
-        enum class CacheDirection
-        {
-            Forward,
-            Reverse
-        };
-
         struct Player::Private
         {
             otime::RationalTime loopPlayback(const otime::RationalTime&);
 
             void cacheUpdate(
+                Playback,
                 const otime::RationalTime& currentTime,
                 const otime::TimeRange& inOutRange,
                 size_t videoLayer,
                 double audioOffset,
                 CacheDirection,
-                const PlayerCacheOptions&);
+                const PlayerCacheOptions&,
+                bool dropFrames);
+
+            void audioUpdate();
 
             void resetAudioTime();
 #if defined(TLRENDER_AUDIO)
@@ -62,6 +63,8 @@ namespace tl
             std::shared_ptr<observer::Value<double> > speed;
             std::shared_ptr<observer::Value<Playback> > playback;
             std::shared_ptr<observer::Value<Loop> > loop;
+            std::shared_ptr<observer::Value<bool> > dropFrames;
+            std::shared_ptr<observer::Value<size_t> > droppedFrames;
             std::shared_ptr<observer::Value<otime::RationalTime> > currentTime;
             std::shared_ptr<observer::Value<otime::TimeRange> > inOutRange;
             std::shared_ptr<observer::Value<size_t> > videoLayer;
@@ -72,6 +75,7 @@ namespace tl
             std::shared_ptr<observer::List<AudioData> > currentAudioData;
             std::shared_ptr<observer::Value<PlayerCacheOptions> > cacheOptions;
             std::shared_ptr<observer::Value<PlayerCacheInfo> > cacheInfo;
+            std::shared_ptr<observer::Value<PlayerStats> > stats;
             std::shared_ptr<observer::ValueObserver<bool> > timelineObserver;
 
             struct ExternalTime
@@ -89,7 +93,6 @@ namespace tl
                 otime::RationalTime playbackStartTime = time::invalidTime;
                 std::chrono::steady_clock::time_point playbackStartTimer;
                 otime::RationalTime currentTime = time::invalidTime;
-                bool externalTime = false;
                 otime::TimeRange inOutRange = time::invalidTimeRange;
                 size_t videoLayer = 0;
                 VideoData currentVideoData;
@@ -100,26 +103,40 @@ namespace tl
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
                 PlayerCacheInfo cacheInfo;
+                image::Allocator imageAllocator;
+                bool dropFrames = false;
+                size_t droppedFrames = 0;
+                PlayerStats stats;
                 std::mutex mutex;
             };
             Mutex mutex;
 
             struct AudioMutex
             {
-                double speed = 0.0;
-                float volume = 1.F;
-                bool mute = false;
-                std::chrono::steady_clock::time_point muteTimeout;
                 std::map<int64_t, AudioData> audioDataCache;
-                bool reset = false;
                 std::mutex mutex;
             };
             AudioMutex audioMutex;
 
             struct Thread
             {
-                std::map<otime::RationalTime, std::future<VideoData> > videoDataRequests;
-                std::map<otime::RationalTime, VideoData> videoDataCache;
+                struct VideoDataRequest
+                {
+                    std::future<VideoData> future;
+                    std::chrono::steady_clock::time_point time;
+                };
+                std::map<otime::RationalTime, VideoDataRequest> videoDataRequests;
+                VideoCache videoCache;
+                std::vector<otime::TimeRange> prefetchRanges;
+                image::Allocator imageAllocator;
+                CacheController cacheController;
+                bool cacheAdaptive = false;
+                bool videoAvailable = false;
+                bool videoStalled = false;
+                PlayerDrop drop;
+                PlayerStats stats;
+                otime::RationalTime statsTime = time::invalidTime;
+                std::map<std::string, size_t> readBytes;
 #if defined(TLRENDER_AUDIO)
                 std::unique_ptr<RtAudio> rtAudio;
 #endif // TLRENDER_AUDIO
@@ -131,14 +148,7 @@ namespace tl
             };
             Thread thread;
 
-            struct AudioThread
-            {
-                audio::Info info;
-                std::shared_ptr<audio::AudioConvert> convert;
-                std::list<std::shared_ptr<audio::Audio> > buffer;
-                size_t rtAudioCurrentFrame = 0;
-            };
-            AudioThread audioThread;
+            PlayerAudio audioThread;
         };
     }
 }
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/PlayerStats.h>
+
+namespace tl
+{
+    namespace timeline
+    {
+        size_t getLatencyBucket(double value)
+        {
+            size_t out = 0;
+            double max = 1.0;
+            while (value >= max && out < latencyHistogramSize - 1)
+            {
+                ++out;
+                max *= 2.0;
+            }
+            return out;
+        }
+
+        bool PlayerStats::operator == (const PlayerStats& other) const
+        {
+            return
+                videoLatency == other.videoLatency &&
+                videoCacheHits == other.videoCacheHits &&
+                videoCacheMisses == other.videoCacheMisses &&
+                frameCacheHits == other.frameCacheHits &&
+                frameCacheMisses == other.frameCacheMisses &&
+                droppedFrames == other.droppedFrames &&
+                lateFrames == other.lateFrames &&
+                videoRequests == other.videoRequests &&
+                audioRequests == other.audioRequests &&
+                timelineVideoRequests == other.timelineVideoRequests &&
+                timelineVideoRequestsInProgress == other.timelineVideoRequestsInProgress &&
+                timelineAudioRequests == other.timelineAudioRequests &&
+                timelineAudioRequestsInProgress == other.timelineAudioRequestsInProgress &&
+                readBytesPerSecond == other.readBytesPerSecond &&
+                audioUnderruns == other.audioUnderruns;
+        }
+
+        bool PlayerStats::operator != (const PlayerStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        void to_json(nlohmann::json& json, const PlayerStats& value)
+        {
+            json = nlohmann::json
+            {
+                { "videoLatency", value.videoLatency },
+                { "videoCacheHits", value.videoCacheHits },
+                { "videoCacheMisses", value.videoCacheMisses },
+                { "frameCacheHits", value.frameCacheHits },
+                { "frameCacheMisses", value.frameCacheMisses },
+                { "droppedFrames", value.droppedFrames },
+                { "lateFrames", value.lateFrames },
+                { "videoRequests", value.videoRequests },
+                { "audioRequests", value.audioRequests },
+                { "timelineVideoRequests", value.timelineVideoRequests },
+                { "timelineVideoRequestsInProgress", value.timelineVideoRequestsInProgress },
+                { "timelineAudioRequests", value.timelineAudioRequests },
+                { "timelineAudioRequestsInProgress", value.timelineAudioRequestsInProgress },
+                { "readBytesPerSecond", value.readBytesPerSecond },
+                { "audioUnderruns", value.audioUnderruns }
+            };
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Number of buckets in the latency histogram.
+        const size_t latencyHistogramSize = 12;
+
+        //! Get the latency histogram bucket for a latency in milliseconds.
+        //! Bucket zero holds latencies below one millisecond, bucket N
+        //! holds latencies below 2^N milliseconds, and the last bucket holds
+        //! the rest.
+        size_t getLatencyBucket(double);
+
+        //! Player statistics.
+        //!
+        //! The counts are totals since the player was created, and the
+        //! request queues are the current sizes.
+        struct PlayerStats
+        {
+            //! Histogram of the time from a video request to the frame being
+            //! ready.
+            std::vector<size_t> videoLatency = std::vector<size_t>(latencyHistogramSize, 0);
+
+            //! Number of frames displayed from the video cache.
+            size_t videoCacheHits = 0;
+
+            //! Number of frames that were not in the video cache when they
+            //! were needed.
+            size_t videoCacheMisses = 0;
+
+            //! Number of frames found in the frame cache.
+            size_t frameCacheHits = 0;
+
+            //! Number of frames not found in the frame cache.
+            size_t frameCacheMisses = 0;
+
+            //! Number of frames dropped.
+            size_t droppedFrames = 0;
+
+            //! Number of frames that were requested but arrived late.
+            size_t lateFrames = 0;
+
+            //! Number of video requests made by the player.
+            size_t videoRequests = 0;
+
+            //! Number of audio requests made by the player.
+            size_t audioRequests = 0;
+
+            //! Number of video requests waiting in the timeline.
+            size_t timelineVideoRequests = 0;
+
+            //! Number of video requests in progress in the timeline.
+            size_t timelineVideoRequestsInProgress = 0;
+
+            //! Number of audio requests waiting in the timeline.
+            size_t timelineAudioRequests = 0;
+
+            //! Number of audio requests in progress in the timeline.
+            size_t timelineAudioRequestsInProgress = 0;
+
+            //! Bytes of video decoded per second, for each reader path.
+            std::map<std::string, double> readBytesPerSecond;
+
+            //! Number of times the audio buffer ran dry.
+            size_t audioUnderruns = 0;
+
+            bool operator == (const PlayerStats&) const;
+            bool operator != (const PlayerStats&) const;
+        };
+
+        //! \name Serialize
+        ///@{
+
+        void to_json(nlohmann::json&, const PlayerStats&);
+
+        ///@}
+    }
+}
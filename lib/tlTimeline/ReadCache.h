@@ -15,6 +15,7 @@ namespace tl
         {
             std::shared_ptr<io::IRead> read;
             io::Info ioInfo;
+            bool memory = false;
         };
 
         //! I/O read cache.
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlCore/Color.h>
+#include <tlCore/Memory.h>
 
 namespace tl
 {
@@ -19,8 +20,15 @@ namespace tl
             //! Clear color.
             image::Color4f clearColor;
 
-            //! Texture cache size.
-            size_t textureCacheSize = 6;
+            //! Maximum size of the texture cache in bytes.
+            size_t textureCacheByteCount = memory::megabyte * 256;
+
+            //! Size of the pixel buffer ring used for texture uploads in
+            //! bytes. A value of zero disables the ring. The ring is only
+            //! used for images that are created in it, see
+            //! GLRender::getPixelBufferRing() and
+            //! Player::setImageAllocator().
+            size_t pixelBufferRingByteCount = 0;
 
             bool operator == (const RenderOptions&) const;
             bool operator != (const RenderOptions&) const;
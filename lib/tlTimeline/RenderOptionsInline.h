@@ -11,7 +11,8 @@ namespace tl
             return
                 clear == other.clear &&
                 clearColor == other.clearColor &&
-                textureCacheSize == other.textureCacheSize;
+                textureCacheByteCount == other.textureCacheByteCount &&
+                pixelBufferRingByteCount == other.pixelBufferRingByteCount;
         }
 
         inline bool RenderOptions::operator != (const RenderOptions& other) const
@@ -0,0 +1,487 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/ThumbnailSystem.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <zlib.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            const size_t thumbnailsMax = 128 * memory::megabyte;
+            const char thumbnailMagic[] = "tlThumb";
+            const uint32_t thumbnailVersion = 1;
+        }
+
+        std::string getThumbnailKey(
+            const file::Path& path,
+            const otime::RationalTime& time,
+            uint16_t layer,
+            const image::Size& size,
+            const ColorConfigOptions& colorConfigOptions,
+            const LUTOptions& lutOptions)
+        {
+            const file::FileInfo fileInfo(path);
+            std::stringstream ss;
+            if (colorConfigOptions.enabled)
+            {
+                ss << colorConfigOptions.fileName << "," <<
+                    colorConfigOptions.input << "," <<
+                    colorConfigOptions.display << "," <<
+                    colorConfigOptions.view << "," <<
+                    colorConfigOptions.look;
+            }
+            ss << ";";
+            if (lutOptions.enabled)
+            {
+                ss << lutOptions.fileName << "," << lutOptions.order;
+            }
+            return string::Format("{0}@{1}@{2}@{3}@{4}x{5}@{6}").
+                arg(path.get()).
+                arg(fileInfo.getTime()).
+                arg(time).
+                arg(layer).
+                arg(size.w).
+                arg(size.h).
+                arg(ss.str());
+        }
+
+        struct ThumbnailSystem::Private
+        {
+            std::string directory;
+            memory::LRUCache<std::string, std::shared_ptr<image::Image> > cache;
+            mutable std::mutex mutex;
+
+            struct Request
+            {
+                file::Path path;
+                otime::RationalTime time = time::invalidTime;
+                uint16_t layer = 0;
+                image::Size size;
+                ColorConfigOptions colorConfigOptions;
+                LUTOptions lutOptions;
+
+                // The image to add, or null to get the thumbnail.
+                std::shared_ptr<image::Image> image;
+                std::promise<std::shared_ptr<image::Image> > promise;
+            };
+
+            struct Requests
+            {
+                std::list<std::shared_ptr<Request> > list;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Requests requests;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+            Thread thread;
+
+            std::string getFileName(const std::string& directory, const std::string& key) const;
+            std::shared_ptr<image::Image> read(const std::string& fileName, const std::string& key) const;
+            void write(
+                const std::string& fileName,
+                const std::string& key,
+                const std::shared_ptr<image::Image>&) const;
+        };
+
+        void ThumbnailSystem::_init(const std::shared_ptr<system::Context>& context)
+        {
+            ISystem::_init("tl::timeline::ThumbnailSystem", context);
+            TLRENDER_P();
+            p.cache.setMax(thumbnailsMax);
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this]
+                {
+                    TLRENDER_P();
+                    _run();
+                    std::list<std::shared_ptr<Private::Request> > requests;
+                    {
+                        std::unique_lock<std::mutex> lock(p.requests.mutex);
+                        p.requests.stopped = true;
+                        requests = std::move(p.requests.list);
+                    }
+                    for (const auto& request : requests)
+                    {
+                        if (!request->image)
+                        {
+                            request->promise.set_value(nullptr);
+                        }
+                    }
+                });
+        }
+
+        ThumbnailSystem::ThumbnailSystem() :
+            _p(new Private)
+        {}
+
+        ThumbnailSystem::~ThumbnailSystem()
+        {
+            TLRENDER_P();
+            p.thread.running = false;
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+        }
+
+        std::shared_ptr<ThumbnailSystem> ThumbnailSystem::create(const std::shared_ptr<system::Context>& context)
+        {
+            auto out = std::shared_ptr<ThumbnailSystem>(new ThumbnailSystem);
+            out->_init(context);
+            return out;
+        }
+
+        std::string ThumbnailSystem::getDirectory() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.directory;
+        }
+
+        void ThumbnailSystem::setDirectory(const std::string& value)
+        {
+            TLRENDER_P();
+            if (!value.empty() && !file::exists(value))
+            {
+                file::mkdir(value);
+            }
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.directory = value;
+        }
+
+        size_t ThumbnailSystem::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getMax();
+        }
+
+        void ThumbnailSystem::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.setMax(value);
+        }
+
+        size_t ThumbnailSystem::getSize() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getSize();
+        }
+
+        std::future<std::shared_ptr<image::Image> > ThumbnailSystem::getThumbnail(
+            const file::Path& path,
+            const otime::RationalTime& time,
+            uint16_t layer,
+            const image::Size& size,
+            const ColorConfigOptions& colorConfigOptions,
+            const LUTOptions& lutOptions)
+        {
+            TLRENDER_P();
+            auto request = std::make_shared<Private::Request>();
+            request->path = path;
+            request->time = time;
+            request->layer = layer;
+            request->size = size;
+            request->colorConfigOptions = colorConfigOptions;
+            request->lutOptions = lutOptions;
+            auto future = request->promise.get_future();
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.requests.mutex);
+                if (!p.requests.stopped)
+                {
+                    valid = true;
+                    p.requests.list.push_back(request);
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+            else
+            {
+                request->promise.set_value(nullptr);
+            }
+            return future;
+        }
+
+        void ThumbnailSystem::addThumbnail(
+            const file::Path& path,
+            const otime::RationalTime& time,
+            uint16_t layer,
+            const image::Size& size,
+            const std::shared_ptr<image::Image>& image,
+            const ColorConfigOptions& colorConfigOptions,
+            const LUTOptions& lutOptions)
+        {
+            TLRENDER_P();
+            if (!image)
+                return;
+            auto request = std::make_shared<Private::Request>();
+            request->path = path;
+            request->time = time;
+            request->layer = layer;
+            request->size = size;
+            request->colorConfigOptions = colorConfigOptions;
+            request->lutOptions = lutOptions;
+            request->image = image;
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.requests.mutex);
+                if (!p.requests.stopped)
+                {
+                    valid = true;
+                    p.requests.list.push_back(request);
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+        }
+
+        bool ThumbnailSystem::get(const std::string& key, std::shared_ptr<image::Image>& value)
+        {
+            TLRENDER_P();
+            std::string directory;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.cache.get(key, value))
+                {
+                    return true;
+                }
+                directory = p.directory;
+            }
+            bool out = false;
+            const std::string fileName = p.getFileName(directory, key);
+            if (!fileName.empty() && file::exists(fileName))
+            {
+                try
+                {
+                    if (auto image = p.read(fileName, key))
+                    {
+                        value = image;
+                        out = true;
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        p.cache.add(key, image, image->getDataByteCount());
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), log::Type::Error);
+                }
+            }
+            return out;
+        }
+
+        void ThumbnailSystem::add(const std::string& key, const std::shared_ptr<image::Image>& value)
+        {
+            TLRENDER_P();
+            if (!value)
+                return;
+            std::string directory;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cache.add(key, value, value->getDataByteCount());
+                directory = p.directory;
+            }
+            const std::string fileName = p.getFileName(directory, key);
+            if (!fileName.empty())
+            {
+                // Write to a temporary file first so that a partial file
+                // is never read.
+                const std::string tmpFileName = fileName + ".tmp";
+                try
+                {
+                    p.write(tmpFileName, key, value);
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        file::rm(tmpFileName);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    file::rm(tmpFileName);
+                    _log(e.what(), log::Type::Error);
+                }
+            }
+        }
+
+        void ThumbnailSystem::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.clear();
+        }
+
+        void ThumbnailSystem::_run()
+        {
+            TLRENDER_P();
+            while (p.thread.running)
+            {
+                // Get the next request. Requests are handled in order so
+                // that a thumbnail can be found after it is added.
+                std::shared_ptr<Private::Request> request;
+                {
+                    std::unique_lock<std::mutex> lock(p.requests.mutex);
+                    if (p.thread.cv.wait_for(
+                        lock,
+                        std::chrono::milliseconds(5),
+                        [this]
+                        {
+                            return !_p->requests.list.empty();
+                        }))
+                    {
+                        request = p.requests.list.front();
+                        p.requests.list.pop_front();
+                    }
+                }
+
+                // Handle the request.
+                if (request)
+                {
+                    const std::string key = getThumbnailKey(
+                        request->path,
+                        request->time,
+                        request->layer,
+                        request->size,
+                        request->colorConfigOptions,
+                        request->lutOptions);
+                    if (request->image)
+                    {
+                        add(key, request->image);
+                    }
+                    else
+                    {
+                        std::shared_ptr<image::Image> image;
+                        get(key, image);
+                        request->promise.set_value(image);
+                    }
+                }
+            }
+        }
+
+        std::string ThumbnailSystem::Private::getFileName(
+            const std::string& directory,
+            const std::string& key) const
+        {
+            std::string out;
+            if (!directory.empty())
+            {
+                std::stringstream ss;
+                ss << std::hex << std::hash<std::string>()(key);
+                out = string::Format("{0}/{1}.thumb").arg(directory).arg(ss.str());
+            }
+            return out;
+        }
+
+        std::shared_ptr<image::Image> ThumbnailSystem::Private::read(
+            const std::string& fileName,
+            const std::string& key) const
+        {
+            std::shared_ptr<image::Image> out;
+            auto io = file::FileIO::create(fileName, file::Mode::Read);
+            char magic[sizeof(thumbnailMagic)];
+            io->read(magic, sizeof(thumbnailMagic));
+            uint32_t header[6] = { 0, 0, 0, 0, 0, 0 };
+            io->readU32(header, 6);
+            const uint32_t version = header[0];
+            const uint32_t keySize = header[1];
+            const uint32_t w = header[2];
+            const uint32_t h = header[3];
+            const uint32_t pixelType = header[4];
+            const uint32_t compressedSize = header[5];
+            if (std::memcmp(magic, thumbnailMagic, sizeof(thumbnailMagic)) != 0 ||
+                version != thumbnailVersion ||
+                pixelType >= static_cast<uint32_t>(image::PixelType::Count) ||
+                static_cast<size_t>(keySize) + compressedSize > io->getSize() - io->getPos())
+            {
+                throw std::runtime_error(string::Format("{0}: Invalid thumbnail file").
+                    arg(fileName));
+            }
+
+            // The file name is a hash of the key, so check the key in
+            // case of collisions.
+            std::string fileKey(keySize, 0);
+            io->read(&fileKey[0], keySize);
+            if (fileKey == key)
+            {
+                std::vector<uint8_t> compressed(compressedSize);
+                io->read(compressed.data(), compressedSize);
+                const image::Info info(w, h, static_cast<image::PixelType>(pixelType));
+                out = image::Image::create(info);
+                uLongf size = out->getDataByteCount();
+                if (uncompress(out->getData(), &size, compressed.data(), compressedSize) != Z_OK ||
+                    size != out->getDataByteCount())
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot decompress thumbnail").
+                        arg(fileName));
+                }
+            }
+            return out;
+        }
+
+        void ThumbnailSystem::Private::write(
+            const std::string& fileName,
+            const std::string& key,
+            const std::shared_ptr<image::Image>& image) const
+        {
+            std::vector<uint8_t> compressed(compressBound(image->getDataByteCount()));
+            uLongf compressedSize = compressed.size();
+            if (compress2(
+                compressed.data(),
+                &compressedSize,
+                image->getData(),
+                image->getDataByteCount(),
+                Z_DEFAULT_COMPRESSION) != Z_OK)
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot compress thumbnail").
+                    arg(fileName));
+            }
+            auto io = file::FileIO::create(fileName, file::Mode::Write);
+            io->write(thumbnailMagic, sizeof(thumbnailMagic));
+            const uint32_t header[] =
+            {
+                thumbnailVersion,
+                static_cast<uint32_t>(key.size()),
+                image->getWidth(),
+                image->getHeight(),
+                static_cast<uint32_t>(image->getPixelType()),
+                static_cast<uint32_t>(compressedSize)
+            };
+            io->writeU32(header, 6);
+            io->write(key.data(), key.size());
+            io->write(compressed.data(), compressedSize);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/ColorConfigOptions.h>
+#include <tlTimeline/LUTOptions.h>
+
+#include <tlCore/ISystem.h>
+#include <tlCore/Image.h>
+#include <tlCore/Path.h>
+#include <tlCore/Time.h>
+
+#include <future>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Get a thumbnail key. The key identifies a frame of a media file
+        //! by the file path and the media time. The key includes the
+        //! modification time of the file so that out of date thumbnails
+        //! are not used, and the color options so that thumbnails with
+        //! different color transforms are not shared.
+        std::string getThumbnailKey(
+            const file::Path&,
+            const otime::RationalTime&,
+            uint16_t layer,
+            const image::Size&,
+            const ColorConfigOptions& = ColorConfigOptions(),
+            const LUTOptions& = LUTOptions());
+
+        //! Thumbnail system.
+        //!
+        //! Thumbnails are shared by all of the thumbnail views in the
+        //! application. They are kept in a memory cache, and if a
+        //! directory is set, are also stored there as small compressed
+        //! files so they are available the next time the application is
+        //! run.
+        class ThumbnailSystem : public system::ISystem
+        {
+            TLRENDER_NON_COPYABLE(ThumbnailSystem);
+
+        protected:
+            void _init(const std::shared_ptr<system::Context>&);
+
+            ThumbnailSystem();
+
+        public:
+            virtual ~ThumbnailSystem();
+
+            //! Create a new system.
+            static std::shared_ptr<ThumbnailSystem> create(const std::shared_ptr<system::Context>&);
+
+            //! Get the directory used to store thumbnails.
+            std::string getDirectory() const;
+
+            //! Set the directory used to store thumbnails. The directory
+            //! is created if it does not exist. An empty directory
+            //! disables storing thumbnails.
+            void setDirectory(const std::string&);
+
+            //! Get the maximum memory cache size in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum memory cache size in bytes.
+            void setMax(size_t);
+
+            //! Get the memory cache size in bytes.
+            size_t getSize() const;
+
+            //! Get a thumbnail. The memory cache and the directory are
+            //! searched on a worker thread, and a null image is returned if
+            //! the thumbnail is not found.
+            std::future<std::shared_ptr<image::Image> > getThumbnail(
+                const file::Path&,
+                const otime::RationalTime&,
+                uint16_t layer,
+                const image::Size&,
+                const ColorConfigOptions& = ColorConfigOptions(),
+                const LUTOptions& = LUTOptions());
+
+            //! Add a thumbnail. The thumbnail is added to the memory cache
+            //! and the directory on a worker thread.
+            void addThumbnail(
+                const file::Path&,
+                const otime::RationalTime&,
+                uint16_t layer,
+                const image::Size&,
+                const std::shared_ptr<image::Image>&,
+                const ColorConfigOptions& = ColorConfigOptions(),
+                const LUTOptions& = LUTOptions());
+
+            //! Get a thumbnail from the memory cache, or from the directory
+            //! if it is not in the memory cache. This function blocks while
+            //! the directory is searched.
+            bool get(const std::string& key, std::shared_ptr<image::Image>&);
+
+            //! Add a thumbnail to the memory cache and the directory. This
+            //! function blocks while the thumbnail is written.
+            void add(const std::string& key, const std::shared_ptr<image::Image>&);
+
+            //! Clear the memory cache.
+            void clear();
+
+        private:
+            void _run();
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
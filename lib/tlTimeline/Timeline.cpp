@@ -64,6 +64,24 @@ namespace tl
             return !(*this == other);
         }
 
+        bool RequestStats::operator == (const RequestStats& other) const
+        {
+            return videoCount == other.videoCount &&
+                videoSeconds == other.videoSeconds &&
+                frameCacheHits == other.frameCacheHits &&
+                frameCacheMisses == other.frameCacheMisses &&
+                readBytes == other.readBytes &&
+                videoRequests == other.videoRequests &&
+                videoRequestsInProgress == other.videoRequestsInProgress &&
+                audioRequests == other.audioRequests &&
+                audioRequestsInProgress == other.audioRequestsInProgress;
+        }
+
+        bool RequestStats::operator != (const RequestStats& other) const
+        {
+            return !(*this == other);
+        }
+
         void Timeline::_init(
             const otio::SerializableObject::Retainer<otio::Timeline>& otioTimeline,
             const std::shared_ptr<system::Context>& context,
@@ -103,6 +121,11 @@ namespace tl
 
             p.context = context;
             p.options = options;
+            p.frameCache = context->getSystem<FrameCacheSystem>();
+            if (p.frameCache)
+            {
+                p.frameCacheClient = p.frameCache->addClient();
+            }
             p.otioTimeline = otioTimeline;
             const auto i = otioTimeline->metadata().find("tl::timeline");
             if (i != otioTimeline->metadata().end())
@@ -176,6 +199,7 @@ namespace tl
 
             // Create a new thread.
             p.mutex.otioTimeline = p.otioTimeline;
+            p.mutex.videoRequestCount = options.videoRequestCount;
             p.thread.running = true;
             p.thread.thread = std::thread(
                 [this]
@@ -202,6 +226,10 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+            if (p.frameCache)
+            {
+                p.frameCache->removeClient(p.frameCacheClient);
+            }
         }
 
         const std::weak_ptr<system::Context>& Timeline::getContext() const
@@ -308,6 +336,24 @@ namespace tl
             return future;
         }
 
+        void Timeline::prefetch(const otime::TimeRange& timeRange)
+        {
+            TLRENDER_P();
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.stopped)
+                {
+                    valid = true;
+                    p.mutex.prefetchRanges.push_back(timeRange);
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+        }
+
         void Timeline::cancelRequests()
         {
             TLRENDER_P();
@@ -317,6 +363,7 @@ namespace tl
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 videoRequests = std::move(p.mutex.videoRequests);
                 audioRequests = std::move(p.mutex.audioRequests);
+                p.mutex.prefetchRanges.clear();
             }
             for (auto& request : videoRequests)
             {
@@ -329,6 +376,33 @@ namespace tl
             p.readCache->cancelRequests();
         }
 
+        size_t Timeline::getVideoRequestCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.videoRequestCount;
+        }
+
+        void Timeline::setVideoRequestCount(size_t value)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.videoRequestCount = std::max(value, size_t(1));
+            }
+            p.thread.cv.notify_one();
+        }
+
+        RequestStats Timeline::getRequestStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            RequestStats out = p.mutex.requestStats;
+            out.videoRequests = p.mutex.videoRequests.size();
+            out.audioRequests = p.mutex.audioRequests.size();
+            return out;
+        }
+
         void Timeline::tick()
         {
             TLRENDER_P();
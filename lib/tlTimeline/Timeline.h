@@ -56,6 +56,43 @@ namespace tl
             bool operator != (const Options&) const;
         };
 
+        //! Timeline request statistics. The counts are totals since the
+        //! timeline was created, and the request queues are the current
+        //! sizes.
+        struct RequestStats
+        {
+            //! Number of finished video requests.
+            size_t videoCount = 0;
+
+            //! Total time in seconds that the finished video requests were
+            //! in progress.
+            double videoSeconds = 0.0;
+
+            //! Number of video frames found in the frame cache.
+            size_t frameCacheHits = 0;
+
+            //! Number of video frames not found in the frame cache.
+            size_t frameCacheMisses = 0;
+
+            //! Number of bytes of video read, for each reader path.
+            std::map<std::string, size_t> readBytes;
+
+            //! Number of video requests waiting to start.
+            size_t videoRequests = 0;
+
+            //! Number of video requests in progress.
+            size_t videoRequestsInProgress = 0;
+
+            //! Number of audio requests waiting to start.
+            size_t audioRequests = 0;
+
+            //! Number of audio requests in progress.
+            size_t audioRequestsInProgress = 0;
+
+            bool operator == (const RequestStats&) const;
+            bool operator != (const RequestStats&) const;
+        };
+
         //! Create a new timeline from a file name. The file name can point
         //! to an .otio file, movie file, or image sequence.
         otio::SerializableObject::Retainer<otio::Timeline> create(
@@ -156,11 +193,31 @@ namespace tl
             //! Get audio data.
             std::future<AudioData> getAudio(int64_t seconds);
 
+            //! Hint that video in the given time range will be requested
+            //! soon, so that the readers can prefetch it.
+            void prefetch(const otime::TimeRange&);
+
             //! Cancel requests.
             void cancelRequests();
 
             ///@}
 
+            //! \name Requests
+            ///@{
+
+            //! Get the maximum number of video requests in progress.
+            size_t getVideoRequestCount() const;
+
+            //! Set the maximum number of video requests in progress. This
+            //! overrides Options::videoRequestCount, and can be changed
+            //! while requests are in progress.
+            void setVideoRequestCount(size_t);
+
+            //! Get the request statistics.
+            RequestStats getRequestStats() const;
+
+            ///@}
+
             //! Tick the timeline.
             void tick();
 
@@ -95,10 +95,12 @@ namespace tl
                 {
                     size_t videoRequestsSize = 0;
                     size_t audioRequestsSize = 0;
+                    size_t videoRequestCount = 0;
                     {
                         std::unique_lock<std::mutex> lock(mutex.mutex);
                         videoRequestsSize = mutex.videoRequests.size();
                         audioRequestsSize = mutex.audioRequests.size();
+                        videoRequestCount = mutex.videoRequestCount;
                     }
                     auto logSystem = context->getLogSystem();
                     logSystem->print(
@@ -112,7 +114,7 @@ namespace tl
                         arg(path.get()).
                         arg(videoRequestsSize).
                         arg(thread.videoRequestsInProgress.size()).
-                        arg(options.videoRequestCount).
+                        arg(videoRequestCount).
                         arg(audioRequestsSize).
                         arg(thread.audioRequestsInProgress.size()).
                         arg(options.audioRequestCount).
@@ -129,6 +131,7 @@ namespace tl
             // Gather requests.
             std::list<std::shared_ptr<VideoRequest> > newVideoRequests;
             std::list<std::shared_ptr<AudioRequest> > newAudioRequests;
+            std::vector<otime::TimeRange> prefetchRanges;
             {
                 std::unique_lock<std::mutex> lock(mutex.mutex);
                 thread.cv.wait_for(
@@ -141,7 +144,8 @@ namespace tl
                             !mutex.videoRequests.empty() ||
                             !thread.videoRequestsInProgress.empty() ||
                             !mutex.audioRequests.empty() ||
-                            !thread.audioRequestsInProgress.empty();
+                            !thread.audioRequestsInProgress.empty() ||
+                            !mutex.prefetchRanges.empty();
                     });
                 if (mutex.otioTimeline.value)
                 {
@@ -150,7 +154,7 @@ namespace tl
                     mutex.otioTimelineChanged = true;
                 }
                 while (!mutex.videoRequests.empty() &&
-                    (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < options.videoRequestCount)
+                    (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < mutex.videoRequestCount)
                 {
                     newVideoRequests.push_back(mutex.videoRequests.front());
                     mutex.videoRequests.pop_front();
@@ -161,6 +165,7 @@ namespace tl
                     newAudioRequests.push_back(mutex.audioRequests.front());
                     mutex.audioRequests.pop_front();
                 }
+                prefetchRanges = std::move(mutex.prefetchRanges);
             }
 
             // Traverse the timeline for new video requests.
@@ -182,7 +187,7 @@ namespace tl
                                     VideoLayerData videoData;
                                     if (auto otioClip = dynamic_cast<const otio::Clip*>(otioItem))
                                     {
-                                        videoData.image = readVideo(otioTrack, otioClip, requestTime, request->videoLayer);
+                                        videoData.image = readVideo(otioTrack, otioClip, requestTime, request->videoLayer, videoData.imagePath, videoData.imageKey);
                                     }
                                     const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
                                     if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
@@ -197,7 +202,7 @@ namespace tl
                                             const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
                                             if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
                                             {
-                                                videoData.imageB = readVideo(otioTrack, otioClipB, requestTime, request->videoLayer);
+                                                videoData.imageB = readVideo(otioTrack, otioClipB, requestTime, request->videoLayer, videoData.imageBPath, videoData.imageBKey);
                                             }
                                         }
                                     }
@@ -206,6 +211,8 @@ namespace tl
                                         if (requestTime < range.value().start_time() + otioTransition->out_offset())
                                         {
                                             std::swap(videoData.image, videoData.imageB);
+                                            std::swap(videoData.imagePath, videoData.imageBPath);
+                                            std::swap(videoData.imageKey, videoData.imageBKey);
                                             videoData.transition = toTransition(otioTransition->transition_type());
                                             videoData.transitionValue = transitionValue(
                                                 requestTime.value(),
@@ -214,7 +221,7 @@ namespace tl
                                             const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
                                             if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
                                             {
-                                                videoData.image = readVideo(otioTrack, otioClipB, requestTime, request->videoLayer);
+                                                videoData.image = readVideo(otioTrack, otioClipB, requestTime, request->videoLayer, videoData.imagePath, videoData.imageKey);
                                             }
                                         }
                                     }
@@ -229,6 +236,7 @@ namespace tl
                     //! \todo How should this be handled?
                 }
 
+                request->startTime = std::chrono::steady_clock::now();
                 thread.videoRequestsInProgress.push_back(request);
             }
 
@@ -278,7 +286,14 @@ namespace tl
                 thread.audioRequestsInProgress.push_back(request);
             }
 
+            // Pass prefetch hints to the readers.
+            if (!prefetchRanges.empty())
+            {
+                prefetch(prefetchRanges);
+            }
+
             // Check for finished video requests.
+            const auto now = std::chrono::steady_clock::now();
             auto videoRequestIt = thread.videoRequestsInProgress.begin();
             while (videoRequestIt != thread.videoRequestsInProgress.end())
             {
@@ -306,10 +321,14 @@ namespace tl
                             if (j.image.valid())
                             {
                                 layer.image = j.image.get().image;
+                                addReadStats(j.imagePath, layer.image);
+                                addFrameCache(j.imageKey, layer.image);
                             }
                             if (j.imageB.valid())
                             {
                                 layer.imageB = j.imageB.get().image;
+                                addReadStats(j.imageBPath, layer.imageB);
+                                addFrameCache(j.imageBKey, layer.imageB);
                             }
                             layer.transition = j.transition;
                             layer.transitionValue = j.transitionValue;
@@ -321,6 +340,10 @@ namespace tl
                         //! \todo How should this be handled?
                     }
                     (*videoRequestIt)->promise.set_value(data);
+                    const std::chrono::duration<double> diff = now - (*videoRequestIt)->startTime;
+                    thread.requestStats.videoCount += 1;
+                    thread.requestStats.videoSeconds += diff.count();
+                    thread.requestStatsChanged = true;
                     videoRequestIt = thread.videoRequestsInProgress.erase(videoRequestIt);
                     continue;
                 }
@@ -370,6 +393,69 @@ namespace tl
                 }
                 ++audioRequestIt;
             }
+
+            // Update the request statistics.
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                if (thread.requestStatsChanged)
+                {
+                    thread.requestStatsChanged = false;
+                    mutex.requestStats = thread.requestStats;
+                }
+                mutex.requestStats.videoRequestsInProgress = thread.videoRequestsInProgress.size();
+                mutex.requestStats.audioRequestsInProgress = thread.audioRequestsInProgress.size();
+            }
+        }
+
+        void Timeline::Private::prefetch(const std::vector<otime::TimeRange>& ranges)
+        {
+            try
+            {
+                for (const auto& otioTrack : thread.otioTimeline->video_tracks())
+                {
+                    for (const auto& otioChild : otioTrack->children())
+                    {
+                        if (auto otioClip = dynamic_cast<const otio::Clip*>(otioChild.value))
+                        {
+                            const auto rangeOptional = otioClip->trimmed_range_in_parent();
+                            if (rangeOptional.has_value())
+                            {
+                                for (const auto& range : ranges)
+                                {
+                                    const otime::TimeRange prefetchRange(
+                                        range.start_time() - timeRange.start_time(),
+                                        range.duration());
+                                    if (prefetchRange.intersects(rangeOptional.value()))
+                                    {
+                                        const auto clampedRange = prefetchRange.clamped(rangeOptional.value());
+                                        ReadCacheItem item = getRead(otioClip, options.ioOptions);
+                                        if (item.read)
+                                        {
+                                            const auto start = timeline::toVideoMediaTime(
+                                                clampedRange.start_time(),
+                                                otioTrack,
+                                                otioClip,
+                                                item.ioInfo);
+                                            const auto end = timeline::toVideoMediaTime(
+                                                clampedRange.end_time_inclusive(),
+                                                otioTrack,
+                                                otioClip,
+                                                item.ioInfo);
+                                            item.read->prefetch(otime::TimeRange::range_from_start_end_time_inclusive(
+                                                std::min(start, end),
+                                                std::max(start, end)));
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                //! \todo How should this be handled?
+            }
         }
 
         void Timeline::Private::finishRequests()
@@ -469,6 +555,7 @@ namespace tl
                     if (out.read)
                     {
                         out.ioInfo = out.read->getInfo().get();
+                        out.memory = !memoryRead.empty();
                         readCache->add(out);
                         context->log(
                             string::Format("tl::timeline::Timeline {0}").arg(this),
@@ -497,7 +584,9 @@ namespace tl
             const otio::Track* track,
             const otio::Clip* clip,
             const otime::RationalTime& time,
-            uint16_t videoLayer)
+            uint16_t videoLayer,
+            std::string& readPath,
+            std::string& frameCacheKey)
         {
             std::future<io::VideoData> out;
             ReadCacheItem item = getRead(clip, options.ioOptions);
@@ -508,11 +597,56 @@ namespace tl
                     track,
                     clip,
                     item.ioInfo);
+
+                // Check the frame cache before reading. Frames that are
+                // read are added to the cache when they are finished. Media
+                // in memory is not cached.
+                if (frameCache && !item.memory && frameCache->getMax() > 0)
+                {
+                    const std::string key = getFrameCacheKey(
+                        item.read->getPath(),
+                        mediaTime,
+                        videoLayer,
+                        options.ioOptions);
+                    std::shared_ptr<image::Image> image;
+                    thread.requestStatsChanged = true;
+                    if (frameCache->get(key, frameCacheClient, image))
+                    {
+                        ++thread.requestStats.frameCacheHits;
+                        std::promise<io::VideoData> promise;
+                        promise.set_value(io::VideoData(mediaTime, videoLayer, image));
+                        return promise.get_future();
+                    }
+                    ++thread.requestStats.frameCacheMisses;
+                    frameCacheKey = key;
+                }
+
+                readPath = item.read->getPath().get();
                 out = item.read->readVideo(mediaTime, videoLayer);
             }
             return out;
         }
 
+        void Timeline::Private::addReadStats(
+            const std::string& path,
+            const std::shared_ptr<image::Image>& image)
+        {
+            if (!path.empty() && image)
+            {
+                thread.requestStats.readBytes[path] += image->getDataByteCount();
+            }
+        }
+
+        void Timeline::Private::addFrameCache(
+            const std::string& key,
+            const std::shared_ptr<image::Image>& image)
+        {
+            if (frameCache && !key.empty() && image)
+            {
+                frameCache->add(key, frameCacheClient, image);
+            }
+        }
+
         std::future<io::AudioData> Timeline::Private::readAudio(
             const otio::Track* track,
             const otio::Clip* clip,
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tlTimeline/FrameCacheSystem.h>
 #include <tlTimeline/Timeline.h>
 
 #include <opentimelineio/clip.h>
@@ -26,6 +27,7 @@ namespace tl
 
             void tick();
             void requests();
+            void prefetch(const std::vector<otime::TimeRange>&);
             void finishRequests();
 
             ReadCacheItem getRead(
@@ -35,7 +37,11 @@ namespace tl
                 const otio::Track*,
                 const otio::Clip*,
                 const otime::RationalTime&,
-                uint16_t videoLayer);
+                uint16_t videoLayer,
+                std::string& readPath,
+                std::string& frameCacheKey);
+            void addReadStats(const std::string& path, const std::shared_ptr<image::Image>&);
+            void addFrameCache(const std::string& key, const std::shared_ptr<image::Image>&);
             std::future<io::AudioData> readAudio(
                 const otio::Track*,
                 const otio::Clip*,
@@ -53,6 +59,8 @@ namespace tl
             file::Path audioPath;
             Options options;
             std::shared_ptr<ReadCache> readCache;
+            std::shared_ptr<FrameCacheSystem> frameCache;
+            uint64_t frameCacheClient = 0;
             otime::TimeRange timeRange = time::invalidTimeRange;
             io::Info ioInfo;
 
@@ -63,6 +71,10 @@ namespace tl
 
                 std::future<io::VideoData> image;
                 std::future<io::VideoData> imageB;
+                std::string imagePath;
+                std::string imageBPath;
+                std::string imageKey;
+                std::string imageBKey;
                 Transition transition = Transition::None;
                 float transitionValue = 0.F;
             };
@@ -74,6 +86,7 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 uint16_t videoLayer = 0;
                 std::promise<VideoData> promise;
+                std::chrono::steady_clock::time_point startTime;
 
                 std::vector<VideoLayerData> layerData;
             };
@@ -104,6 +117,9 @@ namespace tl
                 bool otioTimelineChanged = false;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 std::list<std::shared_ptr<AudioRequest> > audioRequests;
+                std::vector<otime::TimeRange> prefetchRanges;
+                size_t videoRequestCount = 0;
+                RequestStats requestStats;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -113,6 +129,8 @@ namespace tl
                 otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
                 std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
                 std::list<std::shared_ptr<AudioRequest> > audioRequestsInProgress;
+                RequestStats requestStats;
+                bool requestStatsChanged = false;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -9,12 +9,15 @@
 #include <tlIO/IOSystem.h>
 
 #include <tlCore/FileInfo.h>
+#include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
 #include <opentimelineio/clip.h>
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/imageSequenceReference.h>
 
+#include <algorithm>
+
 namespace tl
 {
     namespace timeline
@@ -111,6 +114,45 @@ namespace tl
             return out;
         }
 
+        void parseChunk(const std::string& value, size_t& index, size_t& count)
+        {
+            index = 0;
+            count = 0;
+            const auto pieces = string::split(value, '/');
+            const auto isNumber = [](const std::string& value)
+            {
+                return !value.empty() &&
+                    std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; });
+            };
+            if (pieces.size() == 2 && isNumber(pieces[0]) && isNumber(pieces[1]))
+            {
+                string::fromString(pieces[0].c_str(), pieces[0].size(), index);
+                string::fromString(pieces[1].c_str(), pieces[1].size(), count);
+            }
+            if (pieces.size() != 2 || index < 1 || index > count)
+            {
+                throw std::runtime_error(string::Format("{0}: Invalid chunk").arg(value));
+            }
+            --index;
+        }
+
+        otime::TimeRange getChunkRange(const otime::TimeRange& range, size_t index, size_t count)
+        {
+            const int64_t frames = static_cast<int64_t>(range.duration().value());
+            if (0 == count || index >= count || count > static_cast<size_t>(frames))
+            {
+                throw std::runtime_error(string::Format("Invalid chunk: {0}/{1}").
+                    arg(index + 1).
+                    arg(count));
+            }
+            const int64_t start = frames * index / count;
+            const int64_t end = frames * (index + 1) / count;
+            const double rate = range.duration().rate();
+            return otime::TimeRange(
+                range.start_time() + otime::RationalTime(start, rate),
+                otime::RationalTime(end - start, rate));
+        }
+
         const otio::Composable* getRoot(const otio::Composable* composable)
         {
             const otio::Composable* out = composable;
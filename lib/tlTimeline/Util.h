@@ -26,6 +26,20 @@ namespace tl
             const otime::TimeRange&,
             const otime::TimeRange&);
 
+        //! Parse a chunk given as "i/K", where i is from one to K. The
+        //! returned index is zero based.
+        //!
+        //! Throws:
+        //! - std::exception
+        void parseChunk(const std::string&, size_t& index, size_t& count);
+
+        //! Get the time range of a chunk. The frames are split as evenly as
+        //! possible between the chunks.
+        //!
+        //! Throws:
+        //! - std::exception
+        otime::TimeRange getChunkRange(const otime::TimeRange&, size_t index, size_t count);
+
         //! Get the root (highest parent).
         const otio::Composable* getRoot(const otio::Composable*);
 
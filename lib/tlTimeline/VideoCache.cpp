@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/VideoCache.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace tl
+{
+    namespace timeline
+    {
+        void VideoCache::setWindow(
+            const std::vector<otime::TimeRange>& ranges,
+            const otime::TimeRange& inOutRange)
+        {
+            if (ranges.empty())
+            {
+                _window.clear();
+                _windowSize = 0;
+                _slots.clear();
+                _count = 0;
+                _cached.clear();
+                return;
+            }
+
+            const double rate = ranges.front().duration().rate();
+            if (rate != _rate)
+            {
+                clear();
+                _rate = rate;
+            }
+
+            std::vector<FrameRange> window;
+            size_t windowSize = 0;
+            for (const auto& range : ranges)
+            {
+                const int64_t start = _toFrame(range.start_time());
+                const int64_t end = _toFrame(range.end_time_inclusive());
+                if (end >= start)
+                {
+                    window.push_back(FrameRange(start, end));
+                    windowSize += end - start + 1;
+                }
+            }
+            const int64_t inOutStart = _toFrame(inOutRange.start_time());
+            const int64_t inOutDuration = std::max(_toFrame(inOutRange.duration()), int64_t(0));
+
+            if (windowSize != _windowSize ||
+                inOutStart != _inOutStart ||
+                inOutDuration != _inOutDuration)
+            {
+                // Find the number of slots. When the window wraps around
+                // the end of the in/out range, frames from both ends of
+                // the range must not share a slot. This is true when the
+                // in/out duration modulo the number of slots is either
+                // zero or not less than the window size.
+                const size_t duration = static_cast<size_t>(inOutDuration);
+                size_t slotCount = std::max(windowSize, size_t(1));
+                while (slotCount < duration &&
+                    duration % slotCount != 0 &&
+                    duration % slotCount < windowSize)
+                {
+                    ++slotCount;
+                }
+
+                // Move the video that is still within the window to the
+                // new slots.
+                std::vector<Slot> slots = std::move(_slots);
+                _window = window;
+                _windowSize = windowSize;
+                _inOutStart = inOutStart;
+                _inOutDuration = inOutDuration;
+                _slots = std::vector<Slot>(slotCount);
+                _count = 0;
+                _cached.clear();
+                for (auto& slot : slots)
+                {
+                    if (slot.valid && _inWindow(slot.frame))
+                    {
+                        Slot& newSlot = _slots[_toSlot(slot.frame)];
+                        if (!newSlot.valid)
+                        {
+                            newSlot = std::move(slot);
+                            ++_count;
+                            _addCached(newSlot.frame);
+                        }
+                    }
+                }
+                return;
+            }
+
+            // Remove the video that has left the window.
+            for (const auto& i : _window)
+            {
+                std::vector<FrameRange> removed = { i };
+                for (const auto& j : window)
+                {
+                    std::vector<FrameRange> tmp;
+                    for (const auto& k : removed)
+                    {
+                        if (j.second < k.first || j.first > k.second)
+                        {
+                            tmp.push_back(k);
+                        }
+                        else
+                        {
+                            if (k.first < j.first)
+                            {
+                                tmp.push_back(FrameRange(k.first, j.first - 1));
+                            }
+                            if (k.second > j.second)
+                            {
+                                tmp.push_back(FrameRange(j.second + 1, k.second));
+                            }
+                        }
+                    }
+                    removed = tmp;
+                }
+                for (const auto& k : removed)
+                {
+                    _removeFrames(k.first, k.second);
+                }
+            }
+            _window = window;
+        }
+
+        size_t VideoCache::getWindowSize() const
+        {
+            return _windowSize;
+        }
+
+        size_t VideoCache::getSlotCount() const
+        {
+            return _slots.size();
+        }
+
+        bool VideoCache::contains(const otime::RationalTime& time) const
+        {
+            bool out = false;
+            if (!_slots.empty())
+            {
+                const int64_t frame = _toFrame(time);
+                const Slot& slot = _slots[_toSlot(frame)];
+                out = slot.valid && slot.frame == frame;
+            }
+            return out;
+        }
+
+        bool VideoCache::get(const otime::RationalTime& time, VideoData& value) const
+        {
+            bool out = false;
+            if (!_slots.empty())
+            {
+                const int64_t frame = _toFrame(time);
+                const Slot& slot = _slots[_toSlot(frame)];
+                if (slot.valid && slot.frame == frame)
+                {
+                    value = slot.videoData;
+                    out = true;
+                }
+            }
+            return out;
+        }
+
+        void VideoCache::add(const VideoData& value)
+        {
+            if (_slots.empty())
+                return;
+            const int64_t frame = _toFrame(value.time);
+            if (!_inWindow(frame))
+                return;
+            Slot& slot = _slots[_toSlot(frame)];
+            if (slot.valid && slot.frame != frame)
+            {
+                _removeCached(slot.frame, slot.frame);
+                --_count;
+                slot.valid = false;
+            }
+            if (!slot.valid)
+            {
+                ++_count;
+                _addCached(frame);
+            }
+            slot.frame = frame;
+            slot.valid = true;
+            slot.videoData = value;
+        }
+
+        void VideoCache::clear()
+        {
+            for (auto& slot : _slots)
+            {
+                slot = Slot();
+            }
+            _count = 0;
+            _cached.clear();
+        }
+
+        size_t VideoCache::getCount() const
+        {
+            return _count;
+        }
+
+        std::vector<otime::TimeRange> VideoCache::getCachedRanges() const
+        {
+            std::vector<otime::TimeRange> out;
+            for (const auto& i : _cached)
+            {
+                out.push_back(otime::TimeRange(
+                    otime::RationalTime(i.first, _rate),
+                    otime::RationalTime(i.second - i.first + 1, _rate)));
+            }
+            return out;
+        }
+
+        std::vector<otime::TimeRange> VideoCache::getUncachedRanges() const
+        {
+            std::vector<otime::TimeRange> out;
+            for (const auto& i : _window)
+            {
+                int64_t frame = i.first;
+                auto j = _cached.upper_bound(frame);
+                if (j != _cached.begin())
+                {
+                    const auto prev = std::prev(j);
+                    if (prev->second >= frame)
+                    {
+                        frame = prev->second + 1;
+                    }
+                }
+                while (frame <= i.second)
+                {
+                    const bool next = j != _cached.end() && j->first <= i.second;
+                    const int64_t end = next ? j->first - 1 : i.second;
+                    out.push_back(otime::TimeRange(
+                        otime::RationalTime(frame, _rate),
+                        otime::RationalTime(end - frame + 1, _rate)));
+                    if (!next)
+                        break;
+                    frame = j->second + 1;
+                    ++j;
+                }
+            }
+            return out;
+        }
+
+        int64_t VideoCache::_toFrame(const otime::RationalTime& value) const
+        {
+            return static_cast<int64_t>(time::round(value.rescaled_to(_rate)).value());
+        }
+
+        size_t VideoCache::_toSlot(int64_t frame) const
+        {
+            const int64_t slotCount = static_cast<int64_t>(_slots.size());
+            return static_cast<size_t>(((frame - _inOutStart) % slotCount + slotCount) % slotCount);
+        }
+
+        bool VideoCache::_inWindow(int64_t frame) const
+        {
+            for (const auto& i : _window)
+            {
+                if (frame >= i.first && frame <= i.second)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void VideoCache::_addCached(int64_t frame)
+        {
+            int64_t start = frame;
+            int64_t end = frame;
+            auto next = _cached.upper_bound(frame);
+            if (next != _cached.begin())
+            {
+                const auto prev = std::prev(next);
+                if (prev->second >= frame)
+                    return;
+                if (prev->second == frame - 1)
+                {
+                    start = prev->first;
+                    _cached.erase(prev);
+                }
+            }
+            if (next != _cached.end() && next->first == frame + 1)
+            {
+                end = next->second;
+                _cached.erase(next);
+            }
+            _cached[start] = end;
+        }
+
+        void VideoCache::_removeCached(int64_t start, int64_t end)
+        {
+            auto i = _cached.upper_bound(start);
+            if (i != _cached.begin())
+            {
+                const auto prev = std::prev(i);
+                if (prev->second >= start)
+                {
+                    i = prev;
+                }
+            }
+            while (i != _cached.end() && i->first <= end)
+            {
+                const int64_t first = i->first;
+                const int64_t second = i->second;
+                i = _cached.erase(i);
+                if (first < start)
+                {
+                    _cached[first] = start - 1;
+                }
+                if (second > end)
+                {
+                    _cached[end + 1] = second;
+                }
+            }
+        }
+
+        void VideoCache::_removeFrames(int64_t start, int64_t end)
+        {
+            if (0 == _count)
+                return;
+            if (static_cast<size_t>(end - start + 1) >= _slots.size())
+            {
+                for (auto& slot : _slots)
+                {
+                    if (slot.valid && slot.frame >= start && slot.frame <= end)
+                    {
+                        slot = Slot();
+                        --_count;
+                    }
+                }
+            }
+            else
+            {
+                for (int64_t frame = start; frame <= end; ++frame)
+                {
+                    Slot& slot = _slots[_toSlot(frame)];
+                    if (slot.valid && slot.frame == frame)
+                    {
+                        slot = Slot();
+                        --_count;
+                    }
+                }
+            }
+            _removeCached(start, end);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <map>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Frame indexed video cache.
+        //!
+        //! Video data is stored in a ring of slots indexed by frame number
+        //! and sized to the cache window, so lookups, additions, and
+        //! removals are constant time. The ranges of cached frames are
+        //! maintained incrementally as video is added and removed.
+        class VideoCache
+        {
+        public:
+            //! \name Window
+            ///@{
+
+            //! Set the cache window. The window ranges should be within
+            //! the in/out range, as returned by timeline::loop(). Video
+            //! outside of the new window is removed from the cache.
+            void setWindow(
+                const std::vector<otime::TimeRange>&,
+                const otime::TimeRange& inOutRange);
+
+            //! Get the number of frames in the window.
+            size_t getWindowSize() const;
+
+            //! Get the number of slots.
+            size_t getSlotCount() const;
+
+            ///@}
+
+            //! \name Contents
+            ///@{
+
+            bool contains(const otime::RationalTime&) const;
+            bool get(const otime::RationalTime&, VideoData&) const;
+
+            //! Add video data to the cache. Video data outside of the
+            //! window is ignored.
+            void add(const VideoData&);
+
+            void clear();
+
+            //! Get the number of cached frames.
+            size_t getCount() const;
+
+            //! Get the ranges of cached frames.
+            std::vector<otime::TimeRange> getCachedRanges() const;
+
+            //! Get the ranges of uncached frames within the window.
+            std::vector<otime::TimeRange> getUncachedRanges() const;
+
+            ///@}
+
+        private:
+            typedef std::pair<int64_t, int64_t> FrameRange;
+
+            int64_t _toFrame(const otime::RationalTime&) const;
+            size_t _toSlot(int64_t) const;
+            bool _inWindow(int64_t) const;
+            void _addCached(int64_t);
+            void _removeCached(int64_t, int64_t);
+            void _removeFrames(int64_t, int64_t);
+
+            struct Slot
+            {
+                int64_t frame = 0;
+                bool valid = false;
+                VideoData videoData;
+            };
+
+            double _rate = 0.0;
+            std::vector<FrameRange> _window;
+            size_t _windowSize = 0;
+            int64_t _inOutStart = 0;
+            int64_t _inOutDuration = 0;
+            std::vector<Slot> _slots;
+            size_t _count = 0;
+            std::map<int64_t, int64_t> _cached;
+        };
+    }
+}
@@ -9,7 +9,6 @@
 #include <tlTimeline/RenderUtil.h>
 #include <tlTimeline/Util.h>
 
-#include <tlCore/AudioConvert.h>
 #include <tlCore/Mesh.h>
 
 #include <opentimelineio/track.h>
@@ -37,24 +36,16 @@ namespace tl
             };
             SizeData size;
 
-            struct AudioFuture
+            std::shared_ptr<audio::PeakPyramid> peaks;
+            bool peaksRequest = false;
+            struct WaveformData
             {
-                std::future<io::AudioData> future;
                 math::Vector2i size;
-            };
-            std::map<otime::RationalTime, AudioFuture> audioDataFutures;
-            struct AudioData
-            {
-                io::AudioData audio;
-                math::Vector2i size;
-                std::future<std::shared_ptr<geom::TriangleMesh2> > meshFuture;
                 std::shared_ptr<geom::TriangleMesh2> mesh;
-                std::future<std::shared_ptr<image::Image> > imageFuture;
                 std::shared_ptr<image::Image> image;
                 std::chrono::steady_clock::time_point time;
             };
-            std::map<otime::RationalTime, AudioData> audioData;
-            std::shared_ptr<observer::ValueObserver<bool> > cancelObserver;
+            std::map<otime::RationalTime, WaveformData> waveformData;
         };
 
         void AudioClipItem::_init(
@@ -99,13 +90,6 @@ namespace tl
             {
                 p.availableRange = clip->source_range().value();
             }
-
-            p.cancelObserver = observer::ValueObserver<bool>::create(
-                _data.ioManager->observeCancelRequests(),
-                [this](bool)
-                {
-                    _p->audioDataFutures.clear();
-                });
         }
 
         AudioClipItem::AudioClipItem() :
@@ -133,8 +117,7 @@ namespace tl
             TLRENDER_P();
             if (changed)
             {
-                _data.ioManager->cancelRequests();
-                p.audioData.clear();
+                p.waveformData.clear();
                 _updates |= ui::Update::Draw;
             }
         }
@@ -150,126 +133,58 @@ namespace tl
             TLRENDER_P();
             if (thumbnailsChanged)
             {
-                _data.ioManager->cancelRequests();
-                p.audioData.clear();
+                p.waveformData.clear();
                 _updates |= ui::Update::Draw;
             }
         }
 
         namespace
         {
-            std::shared_ptr<geom::TriangleMesh2> audioMesh(
-                const std::shared_ptr<audio::Audio>& audio,
+            std::shared_ptr<geom::TriangleMesh2> waveformMesh(
+                const std::vector<audio::Peak>& peaks,
                 const math::Vector2i& size)
             {
                 auto out = std::shared_ptr<geom::TriangleMesh2>(new geom::TriangleMesh2);
-                const auto& info = audio->getInfo();
-                const size_t sampleCount = audio->getSampleCount();
-                if (sampleCount > 0)
+                const int h2 = size.y / 2;
+                for (int x = 0; x < size.x && x < static_cast<int>(peaks.size()); ++x)
                 {
-                    switch (info.dataType)
-                    {
-                    case audio::DataType::F32:
+                    const math::Box2i box(
+                        math::Vector2i(
+                            x,
+                            h2 - h2 * peaks[x].max),
+                        math::Vector2i(
+                            x + 1,
+                            h2 - h2 * peaks[x].min));
+                    if (box.isValid())
                     {
-                        const audio::F32_T* data = reinterpret_cast<const audio::F32_T*>(
-                            audio->getData());
-                        for (int x = 0; x < size.x; ++x)
-                        {
-                            const int x0 = std::min(
-                                static_cast<size_t>((x + 0) / static_cast<double>(size.x - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            const int x1 = std::min(
-                                static_cast<size_t>((x + 1) / static_cast<double>(size.x - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            //std::cout << x << ": " << x0 << " " << x1 << std::endl;
-                            audio::F32_T min = 0.F;
-                            audio::F32_T max = 0.F;
-                            if (x0 < x1)
-                            {
-                                min = audio::F32Range.getMax();
-                                max = audio::F32Range.getMin();
-                                for (int i = x0; i < x1; ++i)
-                                {
-                                    const audio::F32_T v = *(data + i * info.channelCount);
-                                    min = std::min(min, v);
-                                    max = std::max(max, v);
-                                }
-                            }
-                            const int h2 = size.y / 2;
-                            const math::Box2i box(
-                                math::Vector2i(
-                                    x,
-                                    h2 - h2 * max),
-                                math::Vector2i(
-                                    x + 1,
-                                    h2 - h2 * min));
-                            if (box.isValid())
-                            {
-                                const size_t j = 1 + out->v.size();
-                                out->v.push_back(math::Vector2f(box.x(), box.y()));
-                                out->v.push_back(math::Vector2f(box.x() + box.w(), box.y()));
-                                out->v.push_back(math::Vector2f(box.x() + box.w(), box.y() + box.h()));
-                                out->v.push_back(math::Vector2f(box.x(), box.y() + box.h()));
-                                out->triangles.push_back(geom::Triangle2({ j + 0, j + 1, j + 2 }));
-                                out->triangles.push_back(geom::Triangle2({ j + 2, j + 3, j + 0 }));
-                            }
-                        }
-                        break;
-                    }
-                    default: break;
+                        const size_t j = 1 + out->v.size();
+                        out->v.push_back(math::Vector2f(box.x(), box.y()));
+                        out->v.push_back(math::Vector2f(box.x() + box.w(), box.y()));
+                        out->v.push_back(math::Vector2f(box.x() + box.w(), box.y() + box.h()));
+                        out->v.push_back(math::Vector2f(box.x(), box.y() + box.h()));
+                        out->triangles.push_back(geom::Triangle2({ j + 0, j + 1, j + 2 }));
+                        out->triangles.push_back(geom::Triangle2({ j + 2, j + 3, j + 0 }));
                     }
                 }
                 return out;
             }
 
-            std::shared_ptr<image::Image> audioImage(
-                const std::shared_ptr<audio::Audio>& audio,
+            std::shared_ptr<image::Image> waveformImage(
+                const std::vector<audio::Peak>& peaks,
                 const math::Vector2i& size)
             {
                 auto out = image::Image::create(size.x, size.y, image::PixelType::L_U8);
-                const auto& info = audio->getInfo();
-                const size_t sampleCount = audio->getSampleCount();
-                if (sampleCount > 0)
+                for (int x = 0; x < size.x; ++x)
                 {
-                    switch (info.dataType)
+                    const audio::Peak peak = x < static_cast<int>(peaks.size()) ?
+                        peaks[x] :
+                        audio::Peak();
+                    uint8_t* p = out->getData() + x;
+                    for (int y = 0; y < size.y; ++y)
                     {
-                    case audio::DataType::F32:
-                    {
-                        const audio::F32_T* data = reinterpret_cast<const audio::F32_T*>(
-                            audio->getData());
-                        for (int x = 0; x < size.x; ++x)
-                        {
-                            const int x0 = std::min(
-                                static_cast<size_t>((x + 0) / static_cast<double>(size.x - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            const int x1 = std::min(
-                                static_cast<size_t>((x + 1) / static_cast<double>(size.x - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            //std::cout << x << ": " << x0 << " " << x1 << std::endl;
-                            audio::F32_T min = 0.F;
-                            audio::F32_T max = 0.F;
-                            if (x0 < x1)
-                            {
-                                min = audio::F32Range.getMax();
-                                max = audio::F32Range.getMin();
-                                for (int i = x0; i < x1; ++i)
-                                {
-                                    const audio::F32_T v = *(data + i * info.channelCount);
-                                    min = std::min(min, v);
-                                    max = std::max(max, v);
-                                }
-                            }
-                            uint8_t* p = out->getData() + x;
-                            for (int y = 0; y < size.y; ++y)
-                            {
-                                const float v = y / static_cast<float>(size.y - 1) * 2.F - 1.F;
-                                *p = (v > min && v < max) ? 255 : 0;
-                                p += size.x;
-                            }
-                        }
-                        break;
-                    }
-                    default: break;
+                        const float v = y / static_cast<float>(size.y - 1) * 2.F - 1.F;
+                        *p = (v > peak.min && v < peak.max) ? 255 : 0;
+                        p += size.x;
                     }
                 }
                 return out;
@@ -283,84 +198,22 @@ namespace tl
         {
             IWidget::tickEvent(parentsVisible, parentsEnabled, event);
             TLRENDER_P();
-            auto i = p.audioDataFutures.begin();
-            while (i != p.audioDataFutures.end())
+            if (p.peaksRequest && !p.peaks)
             {
-                if (i->second.future.valid() &&
-                    i->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                p.peaks = _data.waveformCache->getPeaks(
+                    p.path,
+                    p.memoryRead,
+                    p.availableRange.start_time());
+                if (p.peaks)
                 {
-                    const auto audio = i->second.future.get();
-                    const auto size = i->second.size;
-                    Private::AudioData audioData;
-                    audioData.audio = audio;
-                    audioData.size = size;
-                    if (audio.audio)
-                    {
-                        switch (_options.waveformPrim)
-                        {
-                        case WaveformPrim::Mesh:
-                            audioData.meshFuture = std::async(
-                                std::launch::async,
-                                [audio, size]
-                                {
-                                    auto convert = audio::AudioConvert::create(
-                                        audio.audio->getInfo(),
-                                        audio::Info(1, audio::DataType::F32, audio.audio->getSampleRate()));
-                                const auto convertedAudio = convert->convert(audio.audio);
-                                return audioMesh(convertedAudio, size);
-                                });
-                            break;
-                        case WaveformPrim::Image:
-                            audioData.imageFuture = std::async(
-                                std::launch::async,
-                                [audio, size]
-                                {
-                                    auto convert = audio::AudioConvert::create(
-                                        audio.audio->getInfo(),
-                                        audio::Info(1, audio::DataType::F32, audio.audio->getSampleRate()));
-                                const auto convertedAudio = convert->convert(audio.audio);
-                                return audioImage(convertedAudio, size);
-                                });
-                            break;
-                        default: break;
-                        }
-                    }
-                    p.audioData[i->first] = std::move(audioData);
-                    i = p.audioDataFutures.erase(i);
-                }
-                else
-                {
-                    ++i;
+                    _updates |= ui::Update::Draw;
                 }
             }
 
             const auto now = std::chrono::steady_clock::now();
-            for (auto& audioData : p.audioData)
+            for (const auto& waveformData : p.waveformData)
             {
-                switch (_options.waveformPrim)
-                {
-                case WaveformPrim::Mesh:
-                    if (audioData.second.meshFuture.valid() &&
-                        audioData.second.meshFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                    {
-                        const auto mesh = audioData.second.meshFuture.get();
-                        audioData.second.mesh = mesh;
-                        audioData.second.time = now;
-                        _updates |= ui::Update::Draw;
-                    }
-                    break;
-                case WaveformPrim::Image:
-                    if (audioData.second.imageFuture.valid() &&
-                        audioData.second.imageFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                    {
-                        const auto image = audioData.second.imageFuture.get();
-                        audioData.second.image = image;
-                        audioData.second.time = now;
-                        _updates |= ui::Update::Draw;
-                    }
-                    break;
-                }
-                const std::chrono::duration<float> diff = now - audioData.second.time;
+                const std::chrono::duration<float> diff = now - waveformData.second.time;
                 if (diff.count() < _options.thumbnailFade)
                 {
                     _updates |= ui::Update::Draw;
@@ -427,10 +280,10 @@ namespace tl
             event.render->setClipRectEnabled(true);
             event.render->setClipRect(box.intersect(clipRectState.getClipRect()));
 
-            std::set<otime::RationalTime> audioDataDelete;
-            for (const auto& audioData : p.audioData)
+            std::set<otime::RationalTime> waveformDataDelete;
+            for (const auto& waveformData : p.waveformData)
             {
-                audioDataDelete.insert(audioData.first);
+                waveformDataDelete.insert(waveformData.first);
             }
 
             const math::Box2i clipRect = _getClipRect(
@@ -448,11 +301,23 @@ namespace tl
                     _updates |= ui::Update::Size;
                     _updates |= ui::Update::Draw;
                 }
+                if (!p.peaksRequest && p.ioInfo.audio.isValid())
+                {
+                    p.peaksRequest = true;
+                    p.peaks = _data.waveformCache->getPeaks(
+                        p.path,
+                        p.memoryRead,
+                        p.availableRange.start_time());
+                }
             }
 
-            if (_options.waveformWidth > 0)
+            if (_options.waveformWidth > 0 && p.peaks)
             {
                 const int w = _sizeHint.x;
+                const double sampleRate = p.ioInfo.audio.sampleRate;
+                const int64_t audioStart = time::isValid(p.ioInfo.audioTime) ?
+                    p.ioInfo.audioTime.start_time().rescaled_to(sampleRate).value() :
+                    0;
                 for (int x = 0; x < w; x += _options.waveformWidth)
                 {
                     const math::Box2i box(
@@ -469,69 +334,76 @@ namespace tl
                             (w > 0 ? (x / static_cast<double>(w)) : 0) *
                             p.timeRange.duration().value(),
                             p.timeRange.duration().rate()));
-                        auto i = p.audioData.find(time);
-                        if (i != p.audioData.end())
+                        auto i = p.waveformData.find(time);
+                        if (i == p.waveformData.end())
                         {
+                            // Get the peaks for the waveform from the
+                            // pyramid.
+                            const otime::RationalTime time2 = time::round(otime::RationalTime(
+                                p.timeRange.start_time().value() +
+                                (w > 0 ? ((x + _options.waveformWidth) / static_cast<double>(w)) : 0) *
+                                p.timeRange.duration().value(),
+                                p.timeRange.duration().rate()));
+                            const otime::TimeRange mediaRange = timeline::toAudioMediaTime(
+                                otime::TimeRange::range_from_start_end_time(time, time2),
+                                p.track,
+                                p.clip,
+                                p.ioInfo);
+                            const int64_t start = mediaRange.start_time().value() - audioStart;
+                            const auto peaks = p.peaks->getPeaks(
+                                start,
+                                start + mediaRange.duration().value(),
+                                box.w());
+                            Private::WaveformData waveformData;
+                            waveformData.size = box.getSize();
                             switch (_options.waveformPrim)
                             {
                             case WaveformPrim::Mesh:
-                                if (i->second.mesh)
-                                {
-                                    const std::chrono::duration<float> diff = now - i->second.time;
-                                    const float a = std::min(diff.count() / _options.thumbnailFade, 1.F);
-                                    event.render->drawMesh(
-                                        *i->second.mesh,
-                                        box.min,
-                                        image::Color4f(1.F, 1.F, 1.F, a));
-                                }
+                                waveformData.mesh = waveformMesh(peaks, box.getSize());
                                 break;
                             case WaveformPrim::Image:
-                                if (i->second.image)
-                                {
-                                    const std::chrono::duration<float> diff = now - i->second.time;
-                                    const float a = std::min(diff.count() / _options.thumbnailFade, 1.F);
-                                    event.render->drawImage(
-                                        (i->second).image,
-                                        box,
-                                        image::Color4f(1.F, 1.F, 1.F, a));
-                                }
+                                waveformData.image = waveformImage(peaks, box.getSize());
                                 break;
+                            default: break;
                             }
-                            audioDataDelete.erase(time);
+                            waveformData.time = now;
+                            i = p.waveformData.insert(std::make_pair(time, std::move(waveformData))).first;
                         }
-                        else if (p.ioInfo.audio.isValid())
+                        const std::chrono::duration<float> diff = now - i->second.time;
+                        const float a = std::min(diff.count() / _options.thumbnailFade, 1.F);
+                        switch (_options.waveformPrim)
                         {
-                            const auto j = p.audioDataFutures.find(time);
-                            if (j == p.audioDataFutures.end())
+                        case WaveformPrim::Mesh:
+                            if (i->second.mesh)
                             {
-                                const otime::RationalTime time2 = time::round(otime::RationalTime(
-                                    p.timeRange.start_time().value() +
-                                    (w > 0 ? ((x + _options.waveformWidth) / static_cast<double>(w)) : 0) *
-                                    p.timeRange.duration().value(),
-                                    p.timeRange.duration().rate()));
-                                const otime::TimeRange mediaRange = timeline::toAudioMediaTime(
-                                    otime::TimeRange::range_from_start_end_time(time, time2),
-                                    p.track,
-                                    p.clip,
-                                    p.ioInfo);
-                                p.audioDataFutures[time].future = _data.ioManager->readAudio(
-                                    p.path,
-                                    p.memoryRead,
-                                    p.availableRange.start_time(),
-                                    mediaRange);
-                                p.audioDataFutures[time].size = box.getSize();
+                                event.render->drawMesh(
+                                    *i->second.mesh,
+                                    box.min,
+                                    image::Color4f(1.F, 1.F, 1.F, a));
                             }
+                            break;
+                        case WaveformPrim::Image:
+                            if (i->second.image)
+                            {
+                                event.render->drawImage(
+                                    i->second.image,
+                                    box,
+                                    image::Color4f(1.F, 1.F, 1.F, a));
+                            }
+                            break;
+                        default: break;
                         }
+                        waveformDataDelete.erase(time);
                     }
                 }
             }
 
-            for (auto i : audioDataDelete)
+            for (auto i : waveformDataDelete)
             {
-                const auto j = p.audioData.find(i);
-                if (j != p.audioData.end())
+                const auto j = p.waveformData.find(i);
+                if (j != p.waveformData.end())
                 {
-                    p.audioData.erase(j);
+                    p.waveformData.erase(j);
                 }
             }
         }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlTimelineUI/IOManager.h>
+#include <tlTimelineUI/WaveformCache.h>
 
 #include <tlUI/IWidget.h>
 
@@ -24,6 +25,7 @@ namespace tl
             std::string directory;
             timeline::Options options;
             std::shared_ptr<IOManager> ioManager;
+            std::shared_ptr<WaveformCache> waveformCache;
             std::shared_ptr<timeline::ITimeUnitsModel> timeUnitsModel;
         };
 
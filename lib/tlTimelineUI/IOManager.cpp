@@ -86,6 +86,8 @@ namespace tl
                 ss << otime::RationalTime(1.0, 1.0);
                 p.ioOptions["ffmpeg/AudioBufferSize"] = ss.str();
             }
+            // Thumbnails and waveforms are not staged.
+            p.ioOptions["SequenceIO/Staging"] = "0";
             p.cancelRequests = observer::Value<bool>::create(false);
             
             p.thread.running = true;
@@ -22,6 +22,7 @@ namespace tl
             float mouseWheelScale = 1.1F;
             double scale = 500.0;
             std::shared_ptr<observer::Value<ItemOptions> > itemOptions;
+            std::shared_ptr<WaveformCache> waveformCache;
             bool sizeInit = true;
 
             std::shared_ptr<ui::ScrollWidget> scrollWidget;
@@ -55,6 +56,7 @@ namespace tl
             p.frameView = observer::Value<bool>::create(true);
             p.stopOnScrub = observer::Value<bool>::create(true);
             p.itemOptions = observer::Value<ItemOptions>::create();
+            p.waveformCache = WaveformCache::create(io::Options(), context);
 
             p.scrollWidget = ui::ScrollWidget::create(
                 context,
@@ -238,6 +240,11 @@ namespace tl
             }
         }
 
+        const std::shared_ptr<WaveformCache>& TimelineWidget::getWaveformCache() const
+        {
+            return _p->waveformCache;
+        }
+
         void TimelineWidget::setGeometry(const math::Box2i& value)
         {
             const bool changed = value != _geometry;
@@ -522,6 +529,8 @@ namespace tl
                     itemData.ioManager = IOManager::create(
                         p.player->getOptions().ioOptions,
                         context);
+                    p.waveformCache->setIOOptions(p.player->getOptions().ioOptions);
+                    itemData.waveformCache = p.waveformCache;
                     itemData.timeUnitsModel = p.timeUnitsModel;
 
                     p.timelineItem = TimelineItem::create(p.player, itemData, context);
@@ -93,6 +93,9 @@ namespace tl
             //! Set the item options.
             void setItemOptions(const ItemOptions&);
 
+            //! Get the waveform cache.
+            const std::shared_ptr<WaveformCache>& getWaveformCache() const;
+
             void setGeometry(const math::Box2i&) override;
             void setVisible(bool) override;
             void setEnabled(bool) override;
@@ -9,16 +9,106 @@
 #include <tlGL/OffscreenBuffer.h>
 
 #include <tlTimeline/RenderUtil.h>
+#include <tlTimeline/ThumbnailSystem.h>
 #include <tlTimeline/Util.h>
 
+#if defined(TLRENDER_GL_DEBUG)
+#include <tlGladDebug/gl.h>
+#else // TLRENDER_GL_DEBUG
+#include <tlGlad/gl.h>
+#endif // TLRENDER_GL_DEBUG
+
 #include <opentimelineio/track.h>
 
+#include <algorithm>
+#include <cstring>
+#include <list>
 #include <sstream>
 
 namespace tl
 {
     namespace timelineui
     {
+        namespace
+        {
+            // Read back a rendered thumbnail without waiting for the GPU.
+            class Readback
+            {
+            public:
+                Readback(
+                    const otime::RationalTime& time,
+                    const image::Size& size,
+                    bool valid) :
+                    time(time),
+                    size(size),
+                    valid(valid)
+                {
+                    glGenBuffers(1, &_pbo);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER,
+                        static_cast<GLsizeiptr>(size.w) * size.h * 4,
+                        NULL,
+                        GL_STREAM_READ);
+                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                    glReadPixels(
+                        0,
+                        0,
+                        size.w,
+                        size.h,
+                        GL_RGBA,
+                        GL_UNSIGNED_BYTE,
+                        NULL);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    _fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                }
+
+                ~Readback()
+                {
+                    if (_fence)
+                    {
+                        glDeleteSync(_fence);
+                    }
+                    if (_pbo)
+                    {
+                        glDeleteBuffers(1, &_pbo);
+                    }
+                }
+
+                const otime::RationalTime time;
+                const image::Size size;
+                const bool valid = false;
+
+                bool isReady() const
+                {
+                    const GLenum result = glClientWaitSync(
+                        _fence,
+                        GL_SYNC_FLUSH_COMMANDS_BIT,
+                        0);
+                    return
+                        GL_ALREADY_SIGNALED == result ||
+                        GL_CONDITION_SATISFIED == result;
+                }
+
+                std::shared_ptr<image::Image> getImage() const
+                {
+                    auto out = image::Image::create(size, image::PixelType::RGBA_U8);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
+                    if (void* p = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
+                    {
+                        std::memcpy(out->getData(), p, out->getDataByteCount());
+                        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    }
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    return out;
+                }
+
+            private:
+                GLuint _pbo = 0;
+                GLsync _fence = nullptr;
+            };
+        }
+
         struct VideoClipItem::Private
         {
             otio::SerializableObject::Retainer<otio::Clip> clip;
@@ -37,16 +127,22 @@ namespace tl
             };
             SizeData size;
 
+            std::map<otime::RationalTime, std::future<std::shared_ptr<image::Image> > > thumbnailFutures;
             std::map<otime::RationalTime, std::future<io::VideoData> > videoDataFutures;
             std::map<otime::RationalTime, io::VideoData> videoData;
+            std::list<std::unique_ptr<Readback> > readbacks;
             struct Thumbnail
             {
-                std::shared_ptr<gl::OffscreenBuffer> buffer;
+                std::shared_ptr<image::Image> image;
                 std::chrono::steady_clock::time_point time;
             };
             std::map<otime::RationalTime, Thumbnail> thumbnails;
-            std::list<std::shared_ptr<gl::OffscreenBuffer> > bufferPool;
+            std::shared_ptr<gl::OffscreenBuffer> buffer;
+            std::weak_ptr<timeline::ThumbnailSystem> thumbnailSystem;
             std::shared_ptr<observer::ValueObserver<bool> > cancelObserver;
+
+            otime::RationalTime getMediaTime(const otime::RationalTime&) const;
+            void clearThumbnails();
         };
 
         void VideoClipItem::_init(
@@ -77,6 +173,13 @@ namespace tl
             p.path = path;
             p.memoryRead = timeline::getMemoryRead(clip->media_reference());
 
+            // Thumbnails of media in memory are not shared since the path
+            // does not identify the media.
+            if (p.memoryRead.empty())
+            {
+                p.thumbnailSystem = context->getSystem<timeline::ThumbnailSystem>();
+            }
+
             if (rangeOpt.has_value())
             {
                 p.timeRange = rangeOpt.value();
@@ -96,10 +199,25 @@ namespace tl
                 _data.ioManager->observeCancelRequests(),
                 [this](bool)
                 {
+                    _p->thumbnailFutures.clear();
                     _p->videoDataFutures.clear();
                 });
         }
 
+        otime::RationalTime VideoClipItem::Private::getMediaTime(const otime::RationalTime& value) const
+        {
+            return timeline::toVideoMediaTime(value, track, clip, ioInfo);
+        }
+
+        void VideoClipItem::Private::clearThumbnails()
+        {
+            thumbnailFutures.clear();
+            videoData.clear();
+            readbacks.clear();
+            thumbnails.clear();
+            buffer.reset();
+        }
+
         VideoClipItem::VideoClipItem() :
             _p(new Private)
         {}
@@ -128,9 +246,7 @@ namespace tl
                 _data.ioManager->cancelRequests();
                 if (!_options.thumbnails)
                 {
-                    p.videoData.clear();
-                    p.thumbnails.clear();
-                    p.bufferPool.clear();
+                    p.clearThumbnails();
                 }
             }
         }
@@ -147,9 +263,7 @@ namespace tl
                 _data.ioManager->cancelRequests();
                 if (!_options.thumbnails)
                 {
-                    p.videoData.clear();
-                    p.thumbnails.clear();
-                    p.bufferPool.clear();
+                    p.clearThumbnails();
                 }
                 _updates |= ui::Update::Draw;
             }
@@ -163,6 +277,36 @@ namespace tl
             IWidget::tickEvent(parentsVisible, parentsEnabled, event);
             TLRENDER_P();
 
+            // Check if any shared thumbnails are finished. Thumbnails that
+            // were not found are read from the video.
+            auto thumbnailIt = p.thumbnailFutures.begin();
+            while (thumbnailIt != p.thumbnailFutures.end())
+            {
+                if (thumbnailIt->second.valid() &&
+                    thumbnailIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    if (const auto image = thumbnailIt->second.get())
+                    {
+                        // Shared thumbnails are not faded in.
+                        p.thumbnails[thumbnailIt->first] = { image, std::chrono::steady_clock::time_point() };
+                        _updates |= ui::Update::Draw;
+                    }
+                    else
+                    {
+                        p.videoDataFutures[thumbnailIt->first] = _data.ioManager->readVideo(
+                            p.path,
+                            p.memoryRead,
+                            p.availableRange.start_time(),
+                            p.getMediaTime(thumbnailIt->first));
+                    }
+                    thumbnailIt = p.thumbnailFutures.erase(thumbnailIt);
+                }
+                else
+                {
+                    ++thumbnailIt;
+                }
+            }
+
             // Check if any thumbnail reads are finished.
             auto i = p.videoDataFutures.begin();
             while (i != p.videoDataFutures.end())
@@ -181,6 +325,12 @@ namespace tl
                 }
             }
 
+            // Check if any thumbnail read backs are pending.
+            if (!p.readbacks.empty())
+            {
+                _updates |= ui::Update::Draw;
+            }
+
             // Check if any thumbnails need to be redrawn.
             const auto now = std::chrono::steady_clock::now();
             for (const auto& thumbnail : p.thumbnails)
@@ -204,9 +354,7 @@ namespace tl
             {
                 p.size.thumbnailWidth = thumbnailWidth;
                 _data.ioManager->cancelRequests();
-                p.videoData.clear();
-                p.thumbnails.clear();
-                p.bufferPool.clear();
+                p.clearThumbnails();
                 _updates |= ui::Update::Draw;
             }
             if (_options.thumbnails)
@@ -227,9 +375,7 @@ namespace tl
             p.size.clipRect = clipRect;
             if (clipped)
             {
-                p.videoData.clear();
-                p.thumbnails.clear();
-                p.bufferPool.clear();
+                p.clearThumbnails();
             }
             _data.ioManager->cancelRequests();
             _updates |= ui::Update::Draw;
@@ -295,6 +441,34 @@ namespace tl
 
             if (p.size.thumbnailWidth > 0)
             {
+                // Finish the thumbnail read backs that are ready, and share
+                // the thumbnails with the thumbnail system.
+                auto thumbnailSystem = p.thumbnailSystem.lock();
+                auto readbackIt = p.readbacks.begin();
+                while (readbackIt != p.readbacks.end())
+                {
+                    const auto& readback = *readbackIt;
+                    if (readback->isReady())
+                    {
+                        const auto image = readback->getImage();
+                        p.thumbnails[readback->time] = { image, now };
+                        if (thumbnailSystem && readback->valid)
+                        {
+                            thumbnailSystem->addThumbnail(
+                                p.path,
+                                p.getMediaTime(readback->time),
+                                0,
+                                readback->size,
+                                image);
+                        }
+                        readbackIt = p.readbacks.erase(readbackIt);
+                    }
+                    else
+                    {
+                        ++readbackIt;
+                    }
+                }
+
                 if (!p.videoData.empty())
                 {
                     const timeline::ViewportState viewportState(event.render);
@@ -302,26 +476,22 @@ namespace tl
                     const timeline::ClipRectState clipRectState(event.render);
                     const timeline::TransformState transformState(event.render);
                     const timeline::RenderSizeState renderSizeState(event.render);
+                    const image::Size size(
+                        p.size.thumbnailWidth,
+                        _options.thumbnailHeight);
+                    gl::OffscreenBufferOptions options;
+                    options.colorType = image::PixelType::RGBA_U8;
+                    if (gl::doCreate(p.buffer, size, options))
+                    {
+                        p.buffer = gl::OffscreenBuffer::create(size, options);
+                    }
                     for (const auto& i : p.videoData)
                     {
-                        const image::Size size(
-                            p.size.thumbnailWidth,
-                            _options.thumbnailHeight);
-                        std::shared_ptr<gl::OffscreenBuffer> buffer;
-                        if (p.bufferPool.size())
+                        // Render the thumbnail and read it back, so that
+                        // it can be shared with the thumbnail system.
+                        if (p.buffer)
                         {
-                            buffer = p.bufferPool.front();
-                            p.bufferPool.pop_front();
-                        }
-                        else
-                        {
-                            gl::OffscreenBufferOptions options;
-                            options.colorType = image::PixelType::RGB_F32;
-                            buffer = gl::OffscreenBuffer::create(size, options);
-                        }
-                        if (buffer)
-                        {
-                            gl::OffscreenBufferBinding binding(buffer);
+                            gl::OffscreenBufferBinding binding(p.buffer);
                             event.render->setRenderSize(size);
                             event.render->setViewport(math::Box2i(0, 0, size.w, size.h));
                             event.render->setClipRectEnabled(false);
@@ -340,8 +510,13 @@ namespace tl
                                     i.second.image,
                                     math::Box2i(0, 0, size.w, size.h));
                             }
+                            p.readbacks.push_back(std::unique_ptr<Readback>(
+                                new Readback(i.first, size, i.second.image != nullptr)));
+                        }
+                        else
+                        {
+                            p.thumbnails[i.first] = { nullptr, now };
                         }
-                        p.thumbnails[i.first] = { buffer, now };
                     }
                 }
                 p.videoData.clear();
@@ -364,51 +539,62 @@ namespace tl
                             p.timeRange.duration().value(),
                             p.timeRange.duration().rate()));
 
-                        const auto i = p.thumbnails.find(time);
-                        if (i != p.thumbnails.end())
+                        auto i = p.thumbnails.find(time);
+                        if (i == p.thumbnails.end() &&
+                            !p.ioInfo.video.empty() &&
+                            p.thumbnailFutures.find(time) == p.thumbnailFutures.end() &&
+                            p.videoDataFutures.find(time) == p.videoDataFutures.end() &&
+                            std::find_if(
+                                p.readbacks.begin(),
+                                p.readbacks.end(),
+                                [time](const std::unique_ptr<Readback>& value)
+                                {
+                                    return time == value->time;
+                                }) == p.readbacks.end())
                         {
-                            const unsigned int id = i->second.buffer->getColorID();
-                            const std::chrono::duration<float> diff = now - i->second.time;
-                            float a = 1.F;
-                            if (_options.thumbnailFade > 0.F)
+                            // Request the shared thumbnail if there is a
+                            // thumbnail system, otherwise read the video.
+                            if (thumbnailSystem)
                             {
-                                a = std::min(diff.count() / _options.thumbnailFade, 1.F);
+                                p.thumbnailFutures[time] = thumbnailSystem->getThumbnail(
+                                    p.path,
+                                    p.getMediaTime(time),
+                                    0,
+                                    image::Size(p.size.thumbnailWidth, _options.thumbnailHeight));
                             }
-                            event.render->drawTexture(
-                                id,
-                                box,
-                                image::Color4f(1.F, 1.F, 1.F, a));
-                            thumbnailsDelete.erase(time);
-                        }
-                        else if (!p.ioInfo.video.empty())
-                        {
-                            const auto k = p.videoDataFutures.find(time);
-                            if (k == p.videoDataFutures.end())
+                            else
                             {
-                                const auto mediaTime = timeline::toVideoMediaTime(
-                                    time,
-                                    p.track,
-                                    p.clip,
-                                    p.ioInfo);
                                 p.videoDataFutures[time] = _data.ioManager->readVideo(
                                     p.path,
                                     p.memoryRead,
                                     p.availableRange.start_time(),
-                                    mediaTime);
+                                    p.getMediaTime(time));
                             }
                         }
+                        if (i != p.thumbnails.end())
+                        {
+                            if (i->second.image)
+                            {
+                                const std::chrono::duration<float> diff = now - i->second.time;
+                                float a = 1.F;
+                                if (_options.thumbnailFade > 0.F)
+                                {
+                                    a = std::min(diff.count() / _options.thumbnailFade, 1.F);
+                                }
+                                event.render->drawImage(
+                                    i->second.image,
+                                    box,
+                                    image::Color4f(1.F, 1.F, 1.F, a));
+                            }
+                            thumbnailsDelete.erase(time);
+                        }
                     }
                 }
             }
 
             for (auto i : thumbnailsDelete)
             {
-                const auto j = p.thumbnails.find(i);
-                if (j != p.thumbnails.end())
-                {
-                    p.bufferPool.push_back(j->second.buffer);
-                    p.thumbnails.erase(j);
-                }
+                p.thumbnails.erase(i);
             }
         }
     }
@@ -0,0 +1,377 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineUI/WaveformCache.h>
+
+#include <tlIO/IOSystem.h>
+
+#include <tlCore/AudioConvert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace tl
+{
+    namespace timelineui
+    {
+        namespace
+        {
+            const size_t peaksMax = 256 * memory::megabyte;
+            const std::chrono::milliseconds requestTimeout(5);
+            const double readSeconds = 10.0;
+        }
+
+        struct WaveformCache::Private
+        {
+            std::weak_ptr<system::Context> context;
+            std::string tmpFileNamePrefix;
+            uint64_t tmpFileNameCounter = 0;
+
+            struct Request
+            {
+                file::Path path;
+                std::vector<file::MemoryRead> memoryRead;
+                otime::RationalTime startTime = time::invalidTime;
+                io::Options ioOptions;
+            };
+
+            struct Mutex
+            {
+                io::Options ioOptions;
+                std::string directory;
+                memory::LRUCache<std::string, std::shared_ptr<audio::PeakPyramid> > cache;
+                std::list<Request> requests;
+                std::set<std::string> pending;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+            Thread thread;
+
+            std::string getFileName(const std::string& directory, const file::Path&) const;
+            std::shared_ptr<audio::PeakPyramid> build(const Request&);
+        };
+
+        void WaveformCache::_init(
+            const io::Options& ioOptions,
+            const std::shared_ptr<system::Context>& context)
+        {
+            TLRENDER_P();
+
+            p.context = context;
+            p.mutex.ioOptions = ioOptions;
+            p.mutex.cache.setMax(peaksMax);
+
+            // Temporary files are named with a random prefix and a counter,
+            // so they do not collide with other processes or caches.
+            std::random_device rd;
+            std::stringstream ss;
+            ss << std::hex << ((static_cast<uint64_t>(rd()) << 32) | rd());
+            p.tmpFileNamePrefix = ss.str();
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+        }
+
+        WaveformCache::WaveformCache() :
+            _p(new Private)
+        {}
+
+        WaveformCache::~WaveformCache()
+        {
+            TLRENDER_P();
+            p.thread.running = false;
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+        }
+
+        std::shared_ptr<WaveformCache> WaveformCache::create(
+            const io::Options& ioOptions,
+            const std::shared_ptr<system::Context>& context)
+        {
+            auto out = std::shared_ptr<WaveformCache>(new WaveformCache);
+            out->_init(ioOptions, context);
+            return out;
+        }
+
+        io::Options WaveformCache::getIOOptions() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.ioOptions;
+        }
+
+        void WaveformCache::setIOOptions(const io::Options& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.ioOptions = value;
+        }
+
+        std::string WaveformCache::getDirectory() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.directory;
+        }
+
+        void WaveformCache::setDirectory(const std::string& value)
+        {
+            TLRENDER_P();
+            if (!value.empty() && !file::exists(value))
+            {
+                file::mkdir(value);
+            }
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.directory = value;
+        }
+
+        size_t WaveformCache::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.cache.getMax();
+        }
+
+        void WaveformCache::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cache.setMax(value);
+        }
+
+        std::shared_ptr<audio::PeakPyramid> WaveformCache::getPeaks(
+            const file::Path& path,
+            const std::vector<file::MemoryRead>& memoryRead,
+            const otime::RationalTime& startTime)
+        {
+            TLRENDER_P();
+            std::shared_ptr<audio::PeakPyramid> out;
+            const std::string& key = path.get();
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.cache.get(key, out) &&
+                    p.mutex.pending.insert(key).second)
+                {
+                    Private::Request request;
+                    request.path = path;
+                    request.memoryRead = memoryRead;
+                    request.startTime = startTime;
+                    request.ioOptions = p.mutex.ioOptions;
+                    p.mutex.requests.push_back(request);
+                    valid = true;
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+            return out;
+        }
+
+        void WaveformCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cache.clear();
+        }
+
+        void WaveformCache::_run()
+        {
+            TLRENDER_P();
+            while (p.thread.running)
+            {
+                Private::Request request;
+                std::string directory;
+                bool valid = false;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.thread.cv.wait_for(
+                        lock,
+                        requestTimeout,
+                        [this]
+                        {
+                            return !_p->mutex.requests.empty();
+                        }))
+                    {
+                        request = p.mutex.requests.front();
+                        p.mutex.requests.pop_front();
+                        directory = p.mutex.directory;
+                        valid = true;
+                    }
+                }
+                if (!valid)
+                    continue;
+
+                // Use the saved peaks if they are available, otherwise
+                // build and save them.
+                std::shared_ptr<audio::PeakPyramid> peaks;
+                const std::string fileName = request.memoryRead.empty() ?
+                    p.getFileName(directory, request.path) :
+                    std::string();
+                if (!fileName.empty() && file::exists(fileName))
+                {
+                    try
+                    {
+                        peaks = std::make_shared<audio::PeakPyramid>();
+                        peaks->read(fileName);
+                    }
+                    catch (const std::exception&)
+                    {
+                        peaks.reset();
+                    }
+                }
+                if (!peaks)
+                {
+                    try
+                    {
+                        peaks = p.build(request);
+                    }
+                    catch (const std::exception&)
+                    {}
+                    if (peaks && peaks->isFinished() && !fileName.empty())
+                    {
+                        // Write to a temporary file first so that a
+                        // partial file is never read.
+                        const std::string tmpFileName = string::Format("{0}.{1}_{2}.tmp").
+                            arg(fileName).
+                            arg(p.tmpFileNamePrefix).
+                            arg(++p.tmpFileNameCounter);
+                        try
+                        {
+                            peaks->write(tmpFileName);
+                            if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                            {
+                                file::rm(tmpFileName);
+                            }
+                        }
+                        catch (const std::exception&)
+                        {
+                            file::rm(tmpFileName);
+                        }
+                    }
+                }
+
+                // Media without audio, or that cannot be read, are cached
+                // with empty peaks so they are not requested again.
+                if (!peaks || !peaks->isFinished())
+                {
+                    peaks = std::make_shared<audio::PeakPyramid>();
+                    peaks->finish();
+                }
+
+                const std::string& key = request.path.get();
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.cache.add(key, peaks, std::max(peaks->getByteCount(), size_t(1)));
+                p.mutex.pending.erase(key);
+            }
+        }
+
+        std::string WaveformCache::Private::getFileName(
+            const std::string& directory,
+            const file::Path& path) const
+        {
+            std::string out;
+            if (!directory.empty())
+            {
+                // The file name includes the size and modification time
+                // of the media so that out of date peaks are not used.
+                const file::FileInfo fileInfo(path);
+                if (fileInfo.getSize() > 0)
+                {
+                    std::stringstream ss;
+                    ss << std::hex << std::hash<std::string>()(path.get());
+                    out = string::Format("{0}/{1}_{2}_{3}.peaks").
+                        arg(directory).
+                        arg(ss.str()).
+                        arg(fileInfo.getSize()).
+                        arg(fileInfo.getTime());
+                }
+            }
+            return out;
+        }
+
+        std::shared_ptr<audio::PeakPyramid> WaveformCache::Private::build(const Request& request)
+        {
+            std::shared_ptr<audio::PeakPyramid> out;
+            auto context = this->context.lock();
+            if (!context)
+                return out;
+            auto ioSystem = context->getSystem<io::System>();
+            io::Options options = request.ioOptions;
+            options["FFmpeg/StartTime"] = string::Format("{0}").arg(request.startTime);
+            auto read = ioSystem->read(request.path, request.memoryRead, options);
+            if (!read)
+                return out;
+            const io::Info info = read->getInfo().get();
+            if (!info.audio.isValid() || !time::isValid(info.audioTime))
+                return out;
+
+            // Read the audio in pieces, converting it to mono.
+            const double sampleRate = info.audio.sampleRate;
+            auto convert = audio::AudioConvert::create(
+                info.audio,
+                audio::Info(1, audio::DataType::F32, info.audio.sampleRate));
+            out = std::make_shared<audio::PeakPyramid>(info.audio.sampleRate);
+            const int64_t start = info.audioTime.start_time().rescaled_to(sampleRate).value();
+            const int64_t end = start + info.audioTime.duration().rescaled_to(sampleRate).value();
+            const int64_t readSize = static_cast<int64_t>(readSeconds * sampleRate);
+            std::vector<float> zeros;
+            for (int64_t t = start; t < end && thread.running; t += readSize)
+            {
+                const int64_t size = std::min(readSize, end - t);
+                const otime::TimeRange range(
+                    otime::RationalTime(t, sampleRate),
+                    otime::RationalTime(size, sampleRate));
+                const auto audioData = read->readAudio(range).get();
+                size_t sampleCount = 0;
+                if (audioData.audio)
+                {
+                    const auto mono = convert->convert(audioData.audio);
+                    sampleCount = std::min(mono->getSampleCount(), static_cast<size_t>(size));
+                    out->add(
+                        reinterpret_cast<const float*>(mono->getData()),
+                        sampleCount);
+                }
+
+                // Add silence for audio that is missing, so the peaks stay
+                // aligned with the timeline.
+                if (sampleCount < static_cast<size_t>(size))
+                {
+                    zeros.resize(size - sampleCount, 0.F);
+                    out->add(zeros.data(), zeros.size());
+                }
+            }
+            if (thread.running)
+            {
+                out->finish();
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/IO.h>
+
+#include <tlCore/AudioPeaks.h>
+#include <tlCore/Context.h>
+
+namespace tl
+{
+    namespace timelineui
+    {
+        //! Waveform cache.
+        //!
+        //! The waveform cache builds audio peak pyramids for media files
+        //! in the background, so that waveforms can be drawn at any zoom
+        //! level without reading the audio again. The peaks can also be
+        //! saved to a directory and re-used between sessions.
+        class WaveformCache : public std::enable_shared_from_this<WaveformCache>
+        {
+            TLRENDER_NON_COPYABLE(WaveformCache);
+
+        protected:
+            void _init(
+                const io::Options&,
+                const std::shared_ptr<system::Context>&);
+
+            WaveformCache();
+
+        public:
+            ~WaveformCache();
+
+            //! Create a new waveform cache.
+            static std::shared_ptr<WaveformCache> create(
+                const io::Options&,
+                const std::shared_ptr<system::Context>&);
+
+            //! Get the I/O options.
+            io::Options getIOOptions() const;
+
+            //! Set the I/O options used to read the audio. The options
+            //! apply to new requests.
+            void setIOOptions(const io::Options&);
+
+            //! Get the directory used to save the peaks.
+            std::string getDirectory() const;
+
+            //! Set the directory used to save the peaks. If the directory
+            //! is empty the peaks are not saved.
+            void setDirectory(const std::string&);
+
+            //! Get the maximum size of the peaks in memory, in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum size of the peaks in memory, in bytes.
+            void setMax(size_t);
+
+            //! Get the peaks for a media file. If the peaks are not
+            //! available they are built in the background and null is
+            //! returned.
+            std::shared_ptr<audio::PeakPyramid> getPeaks(
+                const file::Path&,
+                const std::vector<file::MemoryRead>&,
+                const otime::RationalTime& startTime);
+
+            //! Clear the peaks in memory.
+            void clear();
+
+        private:
+            void _run();
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlAppTest/BakeAppTest.h>
+
+#include <tlBakeApp/App.h>
+
+#include <tlTimeline/Init.h>
+
+#include <tlIO/IOSystem.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/ImageConvert.h>
+#include <tlCore/StringFormat.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace tl
+{
+    namespace app_tests
+    {
+        BakeAppTest::BakeAppTest(const std::shared_ptr<system::Context>& context) :
+            ITest("AppTest::BakeAppTest", context)
+        {}
+
+        std::shared_ptr<BakeAppTest> BakeAppTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<BakeAppTest>(new BakeAppTest(context));
+        }
+
+        void BakeAppTest::run()
+        {
+            _passthrough();
+            _renderers();
+        }
+
+        namespace
+        {
+            class Args
+            {
+            public:
+                Args(const std::vector<std::string>& args)
+                {
+                    argc = args.size();
+                    argv = new char*[argc];
+                    for (int i = 0; i < argc; ++i)
+                    {
+                        const size_t size = args[i].size();
+                        argv[i] = new char[size + 1];
+                        memcpy(argv[i], args[i].c_str(), size);
+                        argv[i][size] = 0;
+                    };
+                }
+
+                ~Args()
+                {
+                    for (int i = 0; i < argc; ++i)
+                    {
+                        delete [] argv[i];
+                    }
+                    delete [] argv;
+                }
+
+                int argc = 0;
+                char** argv = nullptr;
+            };
+
+            void writeGradient(
+                const std::shared_ptr<io::System>& ioSystem,
+                const std::string& fileName,
+                image::PixelType pixelType)
+            {
+                // Write a vertical gradient from black at the top to white
+                // at the bottom.
+                auto plugin = ioSystem->getPlugin(file::Path(fileName));
+                TLRENDER_ASSERT(plugin);
+                const auto info = plugin->getWriteInfo(
+                    image::Info(image::Size(16, 16), pixelType));
+                TLRENDER_ASSERT(info.pixelType == pixelType);
+                image::Info gradientInfo(info.size, image::PixelType::RGB_F32);
+                gradientInfo.layout.mirror.y = true;
+                auto gradient = image::Image::create(gradientInfo);
+                float* p = reinterpret_cast<float*>(gradient->getData());
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < info.size.w; ++x, p += 3)
+                    {
+                        p[0] = p[1] = p[2] = y / static_cast<float>(info.size.h - 1);
+                    }
+                }
+                image::Info imageInfo = info;
+                imageInfo.layout.mirror.y = false;
+                auto image = image::Image::create(imageInfo);
+                image::convert(gradient, image);
+                io::Info ioInfo;
+                ioInfo.video.push_back(info);
+                ioInfo.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(1.0, 24.0));
+                auto write = plugin->write(file::Path(fileName), ioInfo);
+                write->writeVideo(otime::RationalTime(0.0, 24.0), image);
+            }
+
+            std::shared_ptr<image::Image> readImage(
+                const std::shared_ptr<io::System>& ioSystem,
+                const std::string& fileName)
+            {
+                auto read = ioSystem->read(file::Path(fileName));
+                TLRENDER_ASSERT(read);
+                const auto image = read->readVideo(otime::RationalTime(0.0, 24.0)).get().image;
+                TLRENDER_ASSERT(image);
+                return image;
+            }
+
+            std::shared_ptr<image::Image> toFloat(const std::shared_ptr<image::Image>& image)
+            {
+                // Convert the image to floating point with the rows ordered
+                // bottom-up.
+                auto out = image::Image::create(image->getSize().w, image->getSize().h, image::PixelType::RGB_F32);
+                image::convert(image, out);
+                return out;
+            }
+
+            void bake(
+                const std::shared_ptr<system::Context>& context,
+                const std::vector<std::string>& args)
+            {
+                const Args appArgs(args);
+                auto app = bake::App::create(appArgs.argc, appArgs.argv, context);
+                TLRENDER_ASSERT(0 == app->getExit());
+                app->run();
+                TLRENDER_ASSERT(0 == app->getExit());
+            }
+        }
+
+        void BakeAppTest::_passthrough()
+        {
+            // The application changes the I/O and cache settings, so it is
+            // given its own context.
+            auto context = system::Context::create();
+            timeline::init(context);
+            auto ioSystem = context->getSystem<io::System>();
+
+            // Frames that are passed from the reader to the writer must keep
+            // their row order.
+            std::vector<std::pair<std::string, image::PixelType> > formats =
+            {
+                { ".dpx", image::PixelType::RGB_U10 }
+            };
+#if defined(TLRENDER_PNG)
+            formats.push_back({ ".png", image::PixelType::RGB_U8 });
+#endif // TLRENDER_PNG
+            for (const auto& format : formats)
+            {
+                const std::string input = "BakeAppTest_Input.0" + format.first;
+                const std::string output = "BakeAppTest_Output.0" + format.first;
+                _print(string::Format("Passthrough: {0}").arg(format.first));
+
+                writeGradient(ioSystem, input, format.second);
+                bake(context, { "tlbake", input, output });
+                const auto inputImage = readImage(ioSystem, input);
+                const auto outputImage = readImage(ioSystem, output);
+                TLRENDER_ASSERT(outputImage->getInfo() == inputImage->getInfo());
+                TLRENDER_ASSERT(0 == memcmp(
+                    outputImage->getData(),
+                    inputImage->getData(),
+                    inputImage->getDataByteCount()));
+            }
+        }
+
+        void BakeAppTest::_renderers()
+        {
+            auto context = system::Context::create();
+            timeline::init(context);
+            auto ioSystem = context->getSystem<io::System>();
+
+            // The OpenGL and software renderers must write the same image.
+            // The render size is changed so the frames are not passed
+            // through.
+            const std::string input = "BakeAppTest_Renderers.0.dpx";
+            writeGradient(ioSystem, input, image::PixelType::RGB_U10);
+            std::vector<std::shared_ptr<image::Image> > images;
+            for (const auto& renderer : bake::getRendererLabels())
+            {
+                _print(string::Format("Renderer: {0}").arg(renderer));
+                const std::string output = string::Format("BakeAppTest_{0}.0.dpx").arg(renderer);
+                bake(context, { "tlbake", input, output, "-renderer", renderer, "-renderSize", "32x32" });
+                auto image = toFloat(readImage(ioSystem, output));
+                TLRENDER_ASSERT(image::Size(32, 32) == image->getSize());
+
+                // The bottom row is white.
+                TLRENDER_ASSERT(reinterpret_cast<const float*>(image->getData())[0] > .9F);
+                images.push_back(image);
+            }
+            TLRENDER_ASSERT(2 == images.size());
+            const size_t pixelCount = static_cast<size_t>(images[0]->getWidth()) * images[0]->getHeight();
+            const float* a = reinterpret_cast<const float*>(images[0]->getData());
+            const float* b = reinterpret_cast<const float*>(images[1]->getData());
+            size_t count = 0;
+            for (size_t i = 0; i < pixelCount; ++i, a += 3, b += 3)
+            {
+                if (std::fabs(a[0] - b[0]) > .1F ||
+                    std::fabs(a[1] - b[1]) > .1F ||
+                    std::fabs(a[2] - b[2]) > .1F)
+                {
+                    ++count;
+                }
+            }
+            _print(string::Format("Renderers: {0} pixels differ").arg(count));
+            TLRENDER_ASSERT(count <= pixelCount / 50);
+        }
+    }
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/AudioPeaksTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/AudioPeaks.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Math.h>
+#include <tlCore/Path.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace tl::audio;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        AudioPeaksTest::AudioPeaksTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::AudioPeaksTest", context)
+        {}
+
+        std::shared_ptr<AudioPeaksTest> AudioPeaksTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<AudioPeaksTest>(new AudioPeaksTest(context));
+        }
+
+        void AudioPeaksTest::run()
+        {
+            _pyramid();
+            _peaks();
+            _io();
+        }
+
+        namespace
+        {
+            std::vector<float> getSamples(size_t count)
+            {
+                std::vector<float> out(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out[i] = std::sin(i / 10.F) * (i / static_cast<float>(count));
+                }
+                return out;
+            }
+
+            Peak getPeak(const std::vector<float>& samples, size_t start, size_t end)
+            {
+                Peak out;
+                out.min = samples[start];
+                out.max = samples[start];
+                double sumSq = 0.0;
+                for (size_t i = start; i < end; ++i)
+                {
+                    out.min = std::min(out.min, samples[i]);
+                    out.max = std::max(out.max, samples[i]);
+                    sumSq += static_cast<double>(samples[i]) * samples[i];
+                }
+                out.rms = std::sqrt(sumSq / (end - start));
+                return out;
+            }
+        }
+
+        void AudioPeaksTest::_pyramid()
+        {
+            {
+                const PeakPyramid pyramid;
+                TLRENDER_ASSERT(0 == pyramid.getSampleCount());
+                TLRENDER_ASSERT(0 == pyramid.getLevelCount());
+                TLRENDER_ASSERT(!pyramid.isFinished());
+            }
+            {
+                const auto samples = getSamples(1000);
+                PeakPyramid pyramid(48000, 16);
+                pyramid.add(samples.data(), 500);
+                pyramid.add(samples.data() + 500, 500);
+                TLRENDER_ASSERT(!pyramid.isFinished());
+                pyramid.finish();
+                TLRENDER_ASSERT(pyramid.isFinished());
+                TLRENDER_ASSERT(48000 == pyramid.getSampleRate());
+                TLRENDER_ASSERT(16 == pyramid.getBinSize());
+                TLRENDER_ASSERT(1000 == pyramid.getSampleCount());
+
+                // 1000 samples / 16 = 63 peaks, then 32, 16, 8, 4, 2, 1.
+                TLRENDER_ASSERT(7 == pyramid.getLevelCount());
+                TLRENDER_ASSERT(63 == pyramid.getLevel(0).size());
+                TLRENDER_ASSERT(1 == pyramid.getLevel(6).size());
+                TLRENDER_ASSERT(pyramid.getByteCount() == (63 + 32 + 16 + 8 + 4 + 2 + 1) * sizeof(Peak));
+
+                for (size_t level = 0; level < pyramid.getLevelCount(); ++level)
+                {
+                    const size_t binSize = 16 << level;
+                    const auto& peaks = pyramid.getLevel(level);
+                    for (size_t i = 0; i < peaks.size(); ++i)
+                    {
+                        const Peak peak = getPeak(
+                            samples,
+                            i * binSize,
+                            std::min((i + 1) * binSize, samples.size()));
+                        TLRENDER_ASSERT(peak.min == peaks[i].min);
+                        TLRENDER_ASSERT(peak.max == peaks[i].max);
+                        TLRENDER_ASSERT(math::fuzzyCompare(peak.rms, peaks[i].rms, .0001F));
+                    }
+                }
+            }
+        }
+
+        void AudioPeaksTest::_peaks()
+        {
+            const auto samples = getSamples(48000);
+            PeakPyramid pyramid(48000, 64);
+            pyramid.add(samples.data(), samples.size());
+            pyramid.finish();
+            {
+                // Ranges aligned to the pyramid levels are exact.
+                const auto peaks = pyramid.getPeaks(0, 48000, 375);
+                TLRENDER_ASSERT(375 == peaks.size());
+                for (size_t i = 0; i < peaks.size(); ++i)
+                {
+                    const Peak peak = getPeak(samples, i * 128, (i + 1) * 128);
+                    TLRENDER_ASSERT(peak.min == peaks[i].min);
+                    TLRENDER_ASSERT(peak.max == peaks[i].max);
+                    TLRENDER_ASSERT(math::fuzzyCompare(peak.rms, peaks[i].rms, .0001F));
+                }
+            }
+            {
+                // Unaligned ranges contain the samples of the range.
+                const auto peaks = pyramid.getPeaks(1000, 41000, 333);
+                for (size_t i = 0; i < peaks.size(); ++i)
+                {
+                    const size_t s0 = 1000 + 40000 * i / 333;
+                    const size_t s1 = 1000 + 40000 * (i + 1) / 333;
+                    const Peak peak = getPeak(samples, s0, s1);
+                    TLRENDER_ASSERT(peaks[i].min <= peak.min);
+                    TLRENDER_ASSERT(peaks[i].max >= peak.max);
+                }
+            }
+            {
+                // Ranges outside of the samples are empty.
+                const auto peaks = pyramid.getPeaks(-100, 0, 10);
+                TLRENDER_ASSERT(10 == peaks.size());
+                for (const auto& peak : peaks)
+                {
+                    TLRENDER_ASSERT(Peak() == peak);
+                }
+                TLRENDER_ASSERT(Peak() == pyramid.getPeaks(48000, 49000, 1)[0]);
+                TLRENDER_ASSERT(pyramid.getPeaks(0, 0, 10).size() == 10);
+            }
+            {
+                // More divisions than samples.
+                const auto peaks = pyramid.getPeaks(0, 10, 100);
+                TLRENDER_ASSERT(100 == peaks.size());
+                TLRENDER_ASSERT(peaks[0] == pyramid.getLevel(0)[0]);
+            }
+        }
+
+        void AudioPeaksTest::_io()
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName = file::Path(dir, "AudioPeaksTest.peaks").get();
+            const auto samples = getSamples(10000);
+            PeakPyramid pyramid(44100, 32);
+            pyramid.add(samples.data(), samples.size());
+            pyramid.finish();
+            pyramid.write(fileName);
+
+            PeakPyramid pyramid2;
+            pyramid2.read(fileName);
+            TLRENDER_ASSERT(pyramid2.isFinished());
+            TLRENDER_ASSERT(44100 == pyramid2.getSampleRate());
+            TLRENDER_ASSERT(32 == pyramid2.getBinSize());
+            TLRENDER_ASSERT(10000 == pyramid2.getSampleCount());
+            TLRENDER_ASSERT(pyramid.getLevelCount() == pyramid2.getLevelCount());
+            for (size_t i = 0; i < pyramid.getLevelCount(); ++i)
+            {
+                TLRENDER_ASSERT(pyramid.getLevel(i) == pyramid2.getLevel(i));
+            }
+
+            // Corrupt the level count and the size of the first level.
+            std::vector<uint8_t> data;
+            {
+                auto io = file::FileIO::create(fileName, file::Mode::Read);
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+            }
+            const size_t levelCountOffset = 8 + sizeof(uint32_t) + 3 * sizeof(uint64_t);
+            for (const auto& corruption : std::vector<std::pair<size_t, uint64_t> >({
+                { levelCountOffset, 1000 },
+                { levelCountOffset, std::numeric_limits<uint64_t>::max() },
+                { levelCountOffset + sizeof(uint64_t), std::numeric_limits<uint64_t>::max() / 4 } }))
+            {
+                std::vector<uint8_t> data2 = data;
+                std::memcpy(data2.data() + corruption.first, &corruption.second, sizeof(uint64_t));
+                {
+                    auto io = file::FileIO::create(fileName, file::Mode::Write);
+                    io->write(data2.data(), data2.size());
+                }
+                try
+                {
+                    pyramid2.read(fileName);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            }
+
+            file::writeLines(fileName, { "invalid" });
+            try
+            {
+                pyramid2.read(fileName);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            file::rm(fileName);
+            file::rmdir(dir);
+        }
+    }
+}
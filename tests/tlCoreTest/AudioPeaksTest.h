@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class AudioPeaksTest : public tests::ITest
+        {
+        protected:
+            AudioPeaksTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<AudioPeaksTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _pyramid();
+            void _peaks();
+            void _io();
+        };
+    }
+}
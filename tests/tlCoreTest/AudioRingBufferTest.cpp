@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/AudioRingBufferTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/AudioRingBuffer.h>
+
+#include <tlTestLib/AllocationCheck.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace tl::audio;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        AudioRingBufferTest::AudioRingBufferTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::AudioRingBufferTest", context)
+        {}
+
+        std::shared_ptr<AudioRingBufferTest> AudioRingBufferTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<AudioRingBufferTest>(new AudioRingBufferTest(context));
+        }
+
+        void AudioRingBufferTest::run()
+        {
+            _ringBuffer();
+            _threads();
+        }
+
+        void AudioRingBufferTest::_ringBuffer()
+        {
+            {
+                const Info info(2, DataType::S16, 48000);
+                auto buffer = AudioRingBuffer::create(info, 100);
+                TLRENDER_ASSERT(info == buffer->getInfo());
+                TLRENDER_ASSERT(100 == buffer->getSampleCount());
+                TLRENDER_ASSERT(0 == buffer->getReadAvailable());
+                TLRENDER_ASSERT(100 == buffer->getWriteAvailable());
+
+                std::vector<int16_t> in(120 * 2);
+                for (size_t i = 0; i < in.size(); ++i)
+                {
+                    in[i] = i;
+                }
+                const uint8_t* inP = reinterpret_cast<const uint8_t*>(in.data());
+                TLRENDER_ASSERT(60 == buffer->write(inP, 60));
+                TLRENDER_ASSERT(60 == buffer->getReadAvailable());
+                TLRENDER_ASSERT(40 == buffer->write(inP + 60 * 4, 60));
+                TLRENDER_ASSERT(0 == buffer->getWriteAvailable());
+                TLRENDER_ASSERT(0 == buffer->write(inP, 1));
+
+                std::vector<int16_t> out(120 * 2);
+                uint8_t* outP = reinterpret_cast<uint8_t*>(out.data());
+                TLRENDER_ASSERT(50 == buffer->read(outP, 50));
+                TLRENDER_ASSERT(0 == memcmp(out.data(), in.data(), 50 * 4));
+                TLRENDER_ASSERT(10 == buffer->discard(10));
+                TLRENDER_ASSERT(60 == buffer->write(inP, 60));
+                TLRENDER_ASSERT(100 == buffer->getReadAvailable());
+
+                // Read across the end of the buffer.
+                TLRENDER_ASSERT(40 == buffer->read(outP, 40));
+                TLRENDER_ASSERT(0 == memcmp(out.data(), in.data() + 60 * 2, 40 * 2 * 2));
+                TLRENDER_ASSERT(60 == buffer->read(outP, 100));
+                TLRENDER_ASSERT(0 == memcmp(out.data(), in.data(), 60 * 2 * 2));
+                TLRENDER_ASSERT(0 == buffer->read(outP, 1));
+
+                TLRENDER_ASSERT(10 == buffer->write(inP, 10));
+                buffer->clear();
+                TLRENDER_ASSERT(0 == buffer->getReadAvailable());
+                TLRENDER_ASSERT(100 == buffer->getWriteAvailable());
+            }
+            {
+                const Info info(1, DataType::F32, 48000);
+                auto buffer = AudioRingBuffer::create(info, 10);
+                const std::vector<float> in(10, 1.F);
+                buffer->write(reinterpret_cast<const uint8_t*>(in.data()), in.size());
+                std::vector<float> out(10, 0.F);
+                TLRENDER_ASSERT(10 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), out.size(), .5F));
+                for (const auto i : out)
+                {
+                    TLRENDER_ASSERT(.5F == i);
+                }
+            }
+        }
+
+        void AudioRingBufferTest::_threads()
+        {
+            TLRENDER_ASSERT(std::atomic<size_t>().is_lock_free());
+            TLRENDER_ASSERT(std::atomic<bool>().is_lock_free());
+            TLRENDER_ASSERT(std::atomic<float>().is_lock_free());
+
+            const Info info(1, DataType::S32, 48000);
+            auto buffer = AudioRingBuffer::create(info, 1000);
+            const int32_t sampleCount = 100000;
+            std::thread producer(
+                [buffer, sampleCount]
+                {
+                    std::vector<int32_t> data(sampleCount);
+                    for (int32_t i = 0; i < sampleCount; ++i)
+                    {
+                        data[i] = i;
+                    }
+                    size_t pos = 0;
+                    size_t size = 1;
+                    while (pos < data.size())
+                    {
+                        pos += buffer->write(
+                            reinterpret_cast<const uint8_t*>(data.data() + pos),
+                            std::min(size, data.size() - pos));
+                        size = size % 313 + 1;
+                    }
+                });
+
+            std::vector<int32_t> out(512);
+            int32_t next = 0;
+            size_t size = 1;
+            size_t errors = 0;
+            size_t allocationCount = 0;
+            {
+                tests::AllocationCheck allocationCheck;
+                while (next < sampleCount)
+                {
+                    const size_t count = buffer->read(
+                        reinterpret_cast<uint8_t*>(out.data()),
+                        size);
+                    for (size_t i = 0; i < count; ++i, ++next)
+                    {
+                        if (out[i] != next)
+                        {
+                            ++errors;
+                        }
+                    }
+                    buffer->getReadAvailable();
+                    size = size % 511 + 1;
+                }
+                allocationCount = allocationCheck.getCount();
+            }
+            producer.join();
+            TLRENDER_ASSERT(0 == errors);
+            TLRENDER_ASSERT(0 == allocationCount);
+        }
+    }
+}
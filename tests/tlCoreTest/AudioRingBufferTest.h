@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class AudioRingBufferTest : public tests::ITest
+        {
+        protected:
+            AudioRingBufferTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<AudioRingBufferTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _ringBuffer();
+            void _threads();
+        };
+    }
+}
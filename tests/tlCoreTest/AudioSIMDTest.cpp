@@ -0,0 +1,369 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/AudioSIMDTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/AudioSIMD.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+using namespace tl::audio;
+using namespace tl::audio::simd;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        AudioSIMDTest::AudioSIMDTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::AudioSIMDTest", context)
+        {}
+
+        std::shared_ptr<AudioSIMDTest> AudioSIMDTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<AudioSIMDTest>(new AudioSIMDTest(context));
+        }
+
+        void AudioSIMDTest::run()
+        {
+            _enums();
+            _instructions();
+            _mix();
+            _convert();
+            _interleave();
+            _benchmark();
+        }
+
+        void AudioSIMDTest::_enums()
+        {
+            _enum<Instructions>("Instructions", getInstructionsEnums);
+        }
+
+        void AudioSIMDTest::_instructions()
+        {
+            for (auto i : getInstructionsEnums())
+            {
+                std::stringstream ss;
+                ss << i << " supported: " << isSupported(i);
+                _print(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << "Best instructions: " << getBestInstructions();
+                _print(ss.str());
+            }
+            TLRENDER_ASSERT(isSupported(Instructions::Scalar));
+            TLRENDER_ASSERT(isSupported(getBestInstructions()));
+            TLRENDER_ASSERT(getBestInstructions() == getInstructions());
+            setInstructions(Instructions::Scalar);
+            TLRENDER_ASSERT(Instructions::Scalar == getInstructions());
+            setInstructions(getBestInstructions());
+            for (auto i : getInstructionsEnums())
+            {
+                if (!isSupported(i))
+                {
+                    try
+                    {
+                        setInstructions(i);
+                        TLRENDER_ASSERT(false);
+                    }
+                    catch (const std::exception&)
+                    {}
+                }
+            }
+        }
+
+        namespace
+        {
+            // Generate random audio data, starting with the edge cases.
+            std::vector<uint8_t> getData(DataType type, size_t size, std::mt19937& rng)
+            {
+                std::vector<uint8_t> out(size * getByteCount(type));
+                switch (type)
+                {
+                case DataType::S8:
+                {
+                    std::uniform_int_distribution<int> dist(S8Range.getMin(), S8Range.getMax());
+                    S8_T* p = reinterpret_cast<S8_T*>(out.data());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        p[i] = dist(rng);
+                    }
+                    const std::vector<S8_T> edges = { S8Range.getMin(), S8Range.getMax(), 0, -1, 1 };
+                    for (size_t i = 0; i < edges.size() && i < size; ++i)
+                    {
+                        p[i] = edges[i];
+                    }
+                    break;
+                }
+                case DataType::S16:
+                {
+                    std::uniform_int_distribution<int> dist(S16Range.getMin(), S16Range.getMax());
+                    S16_T* p = reinterpret_cast<S16_T*>(out.data());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        p[i] = dist(rng);
+                    }
+                    const std::vector<S16_T> edges = { S16Range.getMin(), S16Range.getMax(), 0, -1, 1 };
+                    for (size_t i = 0; i < edges.size() && i < size; ++i)
+                    {
+                        p[i] = edges[i];
+                    }
+                    break;
+                }
+                case DataType::S32:
+                {
+                    std::uniform_int_distribution<S32_T> dist(S32Range.getMin(), S32Range.getMax());
+                    S32_T* p = reinterpret_cast<S32_T*>(out.data());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        p[i] = dist(rng);
+                    }
+                    const std::vector<S32_T> edges =
+                    {
+                        S32Range.getMin(), S32Range.getMax(), 0, -1, 1, -65536, -65537
+                    };
+                    for (size_t i = 0; i < edges.size() && i < size; ++i)
+                    {
+                        p[i] = edges[i];
+                    }
+                    break;
+                }
+                case DataType::F32:
+                {
+                    std::uniform_real_distribution<F32_T> dist(-1.5F, 1.5F);
+                    F32_T* p = reinterpret_cast<F32_T*>(out.data());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        p[i] = dist(rng);
+                    }
+                    const std::vector<F32_T> edges = { -1.F, 1.F, 0.F, -0.F, 2.F, -2.F, 1.0e-30F };
+                    for (size_t i = 0; i < edges.size() && i < size; ++i)
+                    {
+                        p[i] = edges[i];
+                    }
+                    break;
+                }
+                case DataType::F64:
+                {
+                    std::uniform_real_distribution<F64_T> dist(-1.5, 1.5);
+                    F64_T* p = reinterpret_cast<F64_T*>(out.data());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        p[i] = dist(rng);
+                    }
+                    const std::vector<F64_T> edges = { -1.0, 1.0, 0.0, -0.0, 2.0, -2.0, 1.0e-300 };
+                    for (size_t i = 0; i < edges.size() && i < size; ++i)
+                    {
+                        p[i] = edges[i];
+                    }
+                    break;
+                }
+                default: break;
+                }
+                return out;
+            }
+
+            const std::vector<DataType> dataTypes =
+            {
+                DataType::S8,
+                DataType::S16,
+                DataType::S32,
+                DataType::F32,
+                DataType::F64
+            };
+
+            const std::vector<size_t> sizes = { 1, 7, 16, 33, 1001 };
+        }
+
+        void AudioSIMDTest::_mix()
+        {
+            std::mt19937 rng(1);
+            const auto& scalar = getKernels(Instructions::Scalar);
+            for (auto instructions : getInstructionsEnums())
+            {
+                if (!isSupported(instructions))
+                    continue;
+                const auto& kernels = getKernels(instructions);
+                for (auto type : dataTypes)
+                {
+                    for (size_t inCount : { 1, 2, 4 })
+                    {
+                        for (size_t size : sizes)
+                        {
+                            std::vector<std::vector<uint8_t> > data;
+                            std::vector<const uint8_t*> in;
+                            for (size_t i = 0; i < inCount; ++i)
+                            {
+                                data.push_back(getData(type, size, rng));
+                                in.push_back(data.back().data());
+                            }
+                            for (float volume : { 0.F, .3F, 1.F, 1.5F })
+                            {
+                                std::vector<uint8_t> out0(size * getByteCount(type));
+                                std::vector<uint8_t> out1(size * getByteCount(type));
+                                const size_t t = static_cast<size_t>(type);
+                                scalar.mix[t](in.data(), inCount, out0.data(), volume, size);
+                                kernels.mix[t](in.data(), inCount, out1.data(), volume, size);
+                                TLRENDER_ASSERT(0 == std::memcmp(out0.data(), out1.data(), out0.size()));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void AudioSIMDTest::_convert()
+        {
+            std::mt19937 rng(1);
+            const auto& scalar = getKernels(Instructions::Scalar);
+            for (auto instructions : getInstructionsEnums())
+            {
+                if (!isSupported(instructions))
+                    continue;
+                const auto& kernels = getKernels(instructions);
+                for (auto inType : dataTypes)
+                {
+                    for (auto outType : dataTypes)
+                    {
+                        const size_t i = static_cast<size_t>(inType);
+                        const size_t o = static_cast<size_t>(outType);
+                        if (inType == outType)
+                        {
+                            TLRENDER_ASSERT(!kernels.convert[i][o]);
+                            continue;
+                        }
+                        for (size_t size : sizes)
+                        {
+                            const auto in = getData(inType, size, rng);
+                            std::vector<uint8_t> out0(size * getByteCount(outType));
+                            std::vector<uint8_t> out1(size * getByteCount(outType));
+                            scalar.convert[i][o](in.data(), out0.data(), size);
+                            kernels.convert[i][o](in.data(), out1.data(), size);
+                            TLRENDER_ASSERT(0 == std::memcmp(out0.data(), out1.data(), out0.size()));
+                        }
+                    }
+                }
+            }
+        }
+
+        void AudioSIMDTest::_interleave()
+        {
+            std::mt19937 rng(1);
+            const auto& scalar = getKernels(Instructions::Scalar);
+            for (auto instructions : getInstructionsEnums())
+            {
+                if (!isSupported(instructions))
+                    continue;
+                const auto& kernels = getKernels(instructions);
+                for (auto type : dataTypes)
+                {
+                    const size_t t = static_cast<size_t>(type);
+                    for (size_t size : sizes)
+                    {
+                        const auto in0 = getData(type, size, rng);
+                        const auto in1 = getData(type, size, rng);
+                        std::vector<uint8_t> out0(size * 2 * getByteCount(type));
+                        std::vector<uint8_t> out1(size * 2 * getByteCount(type));
+                        scalar.interleave2[t](in0.data(), in1.data(), out0.data(), size);
+                        kernels.interleave2[t](in0.data(), in1.data(), out1.data(), size);
+                        TLRENDER_ASSERT(0 == std::memcmp(out0.data(), out1.data(), out0.size()));
+
+                        std::vector<uint8_t> planar0(in0.size());
+                        std::vector<uint8_t> planar1(in1.size());
+                        kernels.deinterleave2[t](out1.data(), planar0.data(), planar1.data(), size);
+                        TLRENDER_ASSERT(in0 == planar0);
+                        TLRENDER_ASSERT(in1 == planar1);
+                    }
+                }
+            }
+        }
+
+        void AudioSIMDTest::_benchmark()
+        {
+            // Benchmark one second of audio at 48kHz, through the public
+            // functions so the dispatch overhead is included.
+            const size_t sampleCount = 48000;
+            const size_t iterations = 10;
+            const size_t inCount = 4;
+            std::mt19937 rng(1);
+            for (auto instructions : getInstructionsEnums())
+            {
+                if (!isSupported(instructions))
+                    continue;
+                setInstructions(instructions);
+                for (uint8_t channelCount : { 1, 2, 6, 16 })
+                {
+                    const size_t size = sampleCount * channelCount;
+                    auto print = [this, instructions, channelCount](
+                        const std::string& name,
+                        const std::chrono::steady_clock::time_point& t0)
+                    {
+                        const std::chrono::duration<double, std::milli> diff =
+                            std::chrono::steady_clock::now() - t0;
+                        _print(string::Format("{0} {1}ch {2}: {3}ms").
+                            arg(name).
+                            arg(static_cast<int>(channelCount)).
+                            arg(getLabel(instructions)).
+                            arg(diff.count() / iterations, 3));
+                    };
+                    for (auto type : dataTypes)
+                    {
+                        const Info info(channelCount, type, 48000);
+
+                        std::vector<std::vector<uint8_t> > data;
+                        std::vector<const uint8_t*> in;
+                        for (size_t i = 0; i < inCount; ++i)
+                        {
+                            data.push_back(getData(type, size, rng));
+                            in.push_back(data.back().data());
+                        }
+                        std::vector<uint8_t> out(size * getByteCount(type));
+                        auto t0 = std::chrono::steady_clock::now();
+                        for (size_t i = 0; i < iterations; ++i)
+                        {
+                            mix(in.data(), inCount, out.data(), .5F, sampleCount, channelCount, type);
+                        }
+                        print(string::Format("mix {0}x{1}").arg(getLabel(type)).arg(inCount), t0);
+
+                        auto audio = Audio::create(info, sampleCount);
+                        std::memcpy(audio->getData(), data[0].data(), data[0].size());
+                        for (auto outType : { DataType::S16, DataType::F32 })
+                        {
+                            if (outType != type)
+                            {
+                                t0 = std::chrono::steady_clock::now();
+                                for (size_t i = 0; i < iterations; ++i)
+                                {
+                                    convert(audio, outType);
+                                }
+                                print(string::Format("convert {0} to {1}").
+                                    arg(getLabel(type)).
+                                    arg(getLabel(outType)), t0);
+                            }
+                        }
+
+                        t0 = std::chrono::steady_clock::now();
+                        for (size_t i = 0; i < iterations; ++i)
+                        {
+                            planarInterleave(audio);
+                        }
+                        print(string::Format("interleave {0}").arg(getLabel(type)), t0);
+
+                        t0 = std::chrono::steady_clock::now();
+                        for (size_t i = 0; i < iterations; ++i)
+                        {
+                            planarDeinterleave(audio);
+                        }
+                        print(string::Format("deinterleave {0}").arg(getLabel(type)), t0);
+                    }
+                }
+            }
+            setInstructions(getBestInstructions());
+        }
+    }
+}
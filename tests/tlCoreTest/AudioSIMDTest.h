@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class AudioSIMDTest : public tests::ITest
+        {
+        protected:
+            AudioSIMDTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<AudioSIMDTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _instructions();
+            void _mix();
+            void _convert();
+            void _interleave();
+            void _benchmark();
+        };
+    }
+}
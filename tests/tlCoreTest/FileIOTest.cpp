@@ -9,6 +9,7 @@
 #include <tlCore/FileIO.h>
 #include <tlCore/Path.h>
 
+#include <cstring>
 #include <limits>
 #include <sstream>
 
@@ -39,6 +40,7 @@ namespace tl
         void FileIOTest::_enums()
         {
             _enum<Mode>("Mode", getModeEnums);
+            _enum<ReadType>("ReadType", getReadTypeEnums);
         }
         
         void FileIOTest::_tests()
@@ -172,6 +174,48 @@ namespace tl
                 TLRENDER_ASSERT(_text == lines[0]);
                 TLRENDER_ASSERT(_text2 == lines[2]);
             }
+            {
+                const std::string fileName = Path(createTempDir(), _fileName).get();
+                writeLines(fileName, { _text });
+                prefetch(fileName);
+                prefetch(Path(createTempDir(), "prefetch").get());
+                const auto lines = readLines(fileName);
+                TLRENDER_ASSERT(_text == lines[0]);
+            }
+            {
+                const std::string fileName = Path(createTempDir(), _fileName).get();
+                auto io = FileIO::create(fileName, Mode::Write);
+                io->write(_text + "\n" + _text2);
+                io.reset();
+
+                io = FileIO::create(fileName, Mode::Read, ReadType::DirectIO);
+                TLRENDER_ASSERT((_text.size() + 1 + _text2.size()) == io->getSize());
+                char buf[string::cBufferSize];
+                readLine(io, buf);
+                TLRENDER_ASSERT(_text == buf);
+                readLine(io, buf);
+                TLRENDER_ASSERT(_text2 == buf);
+            }
+            {
+                const std::string fileName = Path(createTempDir(), _fileName).get();
+                writeLines(fileName, { _text });
+
+                auto io = FileIO::create(fileName, Mode::Read);
+                TLRENDER_ASSERT(!io->mapCopyOnWrite(0, io->getSize() + 1));
+                auto a = io->mapCopyOnWrite(1, _text.size() - 1);
+                auto b = io->mapCopyOnWrite(1, _text.size() - 1);
+                if (a && b)
+                {
+                    TLRENDER_ASSERT(0 == memcmp(a.get(), _text.data() + 1, _text.size() - 1));
+                    a.get()[0] = '_';
+                    TLRENDER_ASSERT('_' == a.get()[0]);
+                    TLRENDER_ASSERT(_text[1] == b.get()[0]);
+                }
+                io.reset();
+                a.reset();
+                const auto lines = readLines(fileName);
+                TLRENDER_ASSERT(_text == lines[0]);
+            }
             {
                 const std::string fileName = Path(createTempDir(), _fileName).get();
                 auto io = FileIO::create(fileName, Mode::Write);
@@ -6,6 +6,7 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/Image.h>
+#include <tlCore/ImageConvert.h>
 
 using namespace tl::image;
 
@@ -30,6 +31,7 @@ namespace tl
             _info();
             _image();
             _serialize();
+            _convert();
         }
 
         void ImageTest::_size()
@@ -193,6 +195,23 @@ namespace tl
                 TLRENDER_ASSERT(image->getData());
                 TLRENDER_ASSERT(static_cast<const Image*>(image.get())->getData());
             }
+            {
+                const Info info(2, 1, PixelType::L_U8);
+                auto owner = std::shared_ptr<uint8_t>(new uint8_t[2], std::default_delete<uint8_t[]>());
+                auto image = Image::create(info, owner.get(), owner);
+                TLRENDER_ASSERT(image->getData() == owner.get());
+                TLRENDER_ASSERT(2 == owner.use_count());
+                image.reset();
+                TLRENDER_ASSERT(1 == owner.use_count());
+            }
+            try
+            {
+                uint8_t data[2] = {};
+                Image::create(Info(2, 1, PixelType::L_U8), data, nullptr);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
         }
 
         void ImageTest::_serialize()
@@ -231,5 +250,80 @@ namespace tl
             catch (const std::exception&)
             {}
         }
+
+        void ImageTest::_convert()
+        {
+            TLRENDER_ASSERT(canConvert(PixelType::RGBA_U8, PixelType::RGB_F32));
+            TLRENDER_ASSERT(canConvert(PixelType::YUV_420P_U8, PixelType::RGB_U8));
+            TLRENDER_ASSERT(!canConvert(PixelType::RGB_U8, PixelType::YUV_420P_U8));
+            TLRENDER_ASSERT(!canConvert(PixelType::None, PixelType::RGB_U8));
+            {
+                auto in = Image::create(2, 1, PixelType::RGBA_U8);
+                const uint8_t data[] = { 255, 0, 0, 255, 0, 255, 0, 0 };
+                memcpy(in->getData(), data, sizeof(data));
+                auto out = Image::create(2, 1, PixelType::RGB_F32);
+                convert(in, out);
+                const float* p = reinterpret_cast<const float*>(out->getData());
+                TLRENDER_ASSERT(1.F == p[0] && 0.F == p[1] && 0.F == p[2]);
+                TLRENDER_ASSERT(0.F == p[3] && 1.F == p[4] && 0.F == p[5]);
+                auto in2 = Image::create(2, 1, PixelType::RGBA_U8);
+                convert(out, in2);
+                const uint8_t data2[] = { 255, 0, 0, 255, 0, 255, 0, 255 };
+                TLRENDER_ASSERT(0 == memcmp(in2->getData(), data2, sizeof(data2)));
+            }
+            {
+                auto in = Image::create(1, 2, PixelType::L_U8);
+                in->getData()[0] = 0;
+                in->getData()[1] = 255;
+                Info info(1, 2, PixelType::RGB_U8);
+                info.layout.mirror.y = true;
+                auto out = Image::create(info);
+                convert(in, out);
+                const uint8_t data[] = { 255, 255, 255, 0, 0, 0 };
+                TLRENDER_ASSERT(0 == memcmp(out->getData(), data, sizeof(data)));
+            }
+            {
+                Info info(2, 2, PixelType::YUV_420P_U8);
+                info.videoLevels = VideoLevels::LegalRange;
+                auto in = Image::create(info);
+                memset(in->getData(), 128, in->getDataByteCount());
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    in->getData()[i] = 235;
+                }
+                auto out = Image::create(2, 2, PixelType::RGB_U8);
+                convert(in, out);
+                for (size_t i = 0; i < 12; ++i)
+                {
+                    TLRENDER_ASSERT(out->getData()[i] >= 254);
+                }
+            }
+            {
+                auto in = Image::create(1, 3, PixelType::L_U8);
+                in->getData()[0] = 10;
+                in->getData()[1] = 20;
+                in->getData()[2] = 30;
+                auto out = Image::create(1, 3, PixelType::L_U8);
+                out->zero();
+                convert(in, out, math::SizeTRange(1, 2));
+                TLRENDER_ASSERT(0 == out->getData()[0]);
+                TLRENDER_ASSERT(20 == out->getData()[1]);
+                TLRENDER_ASSERT(30 == out->getData()[2]);
+                auto out2 = Image::create(1, 3, PixelType::RGB_U8);
+                out2->zero();
+                convert(in, out2, math::SizeTRange(0, 0));
+                TLRENDER_ASSERT(10 == out2->getData()[0]);
+                TLRENDER_ASSERT(0 == out2->getData()[3]);
+            }
+            try
+            {
+                convert(
+                    Image::create(1, 1, PixelType::RGB_U8),
+                    Image::create(2, 2, PixelType::RGB_U8));
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
     }
 }
@@ -27,6 +27,7 @@ namespace tl
             void _util();
             void _image();
             void _serialize();
+            void _convert();
         };
     }
 }
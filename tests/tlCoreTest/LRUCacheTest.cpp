@@ -86,6 +86,31 @@ namespace tl
                 const auto l = c.getKeys();
                 TLRENDER_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
                 TLRENDER_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
+                TLRENDER_ASSERT(3 * memory::megabyte == c.getSize());
+            }
+            {
+                LRUCache<int, int> c;
+                c.setMax(10);
+                c.add(0, 1, 2);
+                c.add(1, 2, 3);
+                TLRENDER_ASSERT(5 == c.getSize());
+                c.add(0, 3, 4);
+                TLRENDER_ASSERT(7 == c.getSize());
+                c.remove(1);
+                TLRENDER_ASSERT(4 == c.getSize());
+                c.remove(1);
+                TLRENDER_ASSERT(4 == c.getSize());
+                c.clear();
+                TLRENDER_ASSERT(0 == c.getSize());
+                TLRENDER_ASSERT(0 == c.getCount());
+                c.add(2, 1, 6);
+                c.add(3, 2, 6);
+                TLRENDER_ASSERT(!c.contains(2));
+                TLRENDER_ASSERT(c.contains(3));
+                TLRENDER_ASSERT(6 == c.getSize());
+                c.setMax(5);
+                TLRENDER_ASSERT(0 == c.getCount());
+                TLRENDER_ASSERT(0 == c.getSize());
             }
         }
     }
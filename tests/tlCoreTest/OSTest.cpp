@@ -82,6 +82,22 @@ namespace tl
                 std::vector<std::string> value;
                 TLRENDER_ASSERT(!getEnv(env, value));
             }
+            {
+#if defined(_WINDOWS)
+                TLRENDER_ASSERT(0 == runProcess("cmd", { "/c", "exit 0" }));
+                TLRENDER_ASSERT(3 == runProcess("cmd", { "/c", "exit 3" }));
+#else // _WINDOWS
+                TLRENDER_ASSERT(0 == runProcess("sh", { "-c", "exit 0" }));
+                TLRENDER_ASSERT(3 == runProcess("sh", { "-c", "exit 3" }));
+#endif // _WINDOWS
+                try
+                {
+                    runProcess("tlRenderOSTestMissingProgram", {});
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
         }
     }
 }
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/StagingCacheTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Memory.h>
+#include <tlCore/Path.h>
+#include <tlCore/StagingCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <thread>
+
+using namespace tl::file;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        StagingCacheTest::StagingCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::StagingCacheTest", context)
+        {}
+
+        std::shared_ptr<StagingCacheTest> StagingCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<StagingCacheTest>(new StagingCacheTest(context));
+        }
+
+        void StagingCacheTest::run()
+        {
+            const std::string text = "Hello world!";
+            const std::string fileName = Path(createTempDir(), "StagingCacheTest.txt").get();
+            writeLines(fileName, { text });
+            {
+                auto stagingCache = StagingCache::create(std::string(), memory::megabyte);
+                TLRENDER_ASSERT(!stagingCache->getDirectory().empty());
+                TLRENDER_ASSERT(memory::megabyte == stagingCache->getMax());
+                TLRENDER_ASSERT(0 == stagingCache->getSize());
+                TLRENDER_ASSERT(!stagingCache->get(fileName));
+
+                setStagingCache(stagingCache);
+                TLRENDER_ASSERT(stagingCache == getStagingCache());
+                TLRENDER_ASSERT(!getStagedFile(fileName));
+                std::shared_ptr<const std::string> staged;
+                for (size_t i = 0; i < 100 && !staged; ++i)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    staged = stagingCache->get(fileName);
+                }
+                TLRENDER_ASSERT(staged);
+                _print(string::Format("Staged: {0}").arg(*staged));
+                TLRENDER_ASSERT(*staged == *getStagedFile(fileName));
+                TLRENDER_ASSERT(stagingCache->getSize() > 0);
+                {
+                    auto io = FileIO::createStaged(fileName);
+                    TLRENDER_ASSERT(fileName == io->getFileName());
+                    TLRENDER_ASSERT(text.size() <= io->getSize());
+                }
+                {
+                    auto io = FileIO::create(fileName, Mode::Read);
+                    TLRENDER_ASSERT(fileName == io->getFileName());
+                }
+                const auto lines = readLines(fileName);
+                TLRENDER_ASSERT(text == lines[0]);
+
+                // The staged copy is kept while it is in use.
+                stagingCache->clear();
+                TLRENDER_ASSERT(0 == stagingCache->getSize());
+                TLRENDER_ASSERT(exists(*staged));
+                const std::string stagedFileName = *staged;
+                staged.reset();
+                TLRENDER_ASSERT(!exists(stagedFileName));
+                setStagingCache(nullptr);
+            }
+            {
+                // Orphaned copies in a persistent directory are removed by
+                // age, other files are kept.
+                const std::string directory = createTempDir();
+                const std::string orphan = Path(directory, "0123abcd_1.exr").get();
+                const std::string orphanTmp = Path(directory, "0123abcd_2.exr.tmp").get();
+                const std::string other = Path(directory, "StagingCacheTest_1.exr").get();
+                for (const auto& i : { orphan, orphanTmp, other })
+                {
+                    writeLines(i, { text });
+                }
+                StagingCache::create(directory, memory::megabyte);
+                TLRENDER_ASSERT(exists(orphan));
+                TLRENDER_ASSERT(exists(orphanTmp));
+                StagingCache::create(directory, memory::megabyte, std::chrono::seconds(0));
+                TLRENDER_ASSERT(!exists(orphan));
+                TLRENDER_ASSERT(!exists(orphanTmp));
+                TLRENDER_ASSERT(exists(other));
+            }
+        }
+    }
+}
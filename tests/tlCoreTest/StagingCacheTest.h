@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class StagingCacheTest : public tests::ITest
+        {
+        protected:
+            StagingCacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<StagingCacheTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+        };
+    }
+}
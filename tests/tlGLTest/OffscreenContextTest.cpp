@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/OffscreenContextTest.h>
+
+#include <tlGL/OffscreenContext.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        OffscreenContextTest::OffscreenContextTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::OffscreenContextTest", context)
+        {}
+
+        std::shared_ptr<OffscreenContextTest> OffscreenContextTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<OffscreenContextTest>(new OffscreenContextTest(context));
+        }
+
+        void OffscreenContextTest::run()
+        {
+            _enums();
+            _create();
+        }
+
+        void OffscreenContextTest::_enums()
+        {
+            _enum<ContextBackend>("ContextBackend", getContextBackendEnums);
+            for (auto i : getAvailableContextBackends())
+            {
+                TLRENDER_ASSERT(i != ContextBackend::Auto);
+            }
+        }
+
+        void OffscreenContextTest::_create()
+        {
+            // Contexts cannot be created on every test machine, so only
+            // check the backends that succeed. A backend that is forced with
+            // the "TLRENDER_GL_CONTEXT" environment variable must succeed.
+            const ContextBackend required = getDefaultContextBackend();
+            for (auto i : getAvailableContextBackends())
+            {
+                try
+                {
+                    auto glContext = OffscreenContext::create(_context, i);
+                    TLRENDER_ASSERT(i == glContext->getBackend());
+                    TLRENDER_ASSERT(!glContext->getVersion().empty());
+                    glContext->doneCurrent();
+                    glContext->makeCurrent();
+                    _print(string::Format("{0}: {1}").arg(i).arg(glContext->getVersion()));
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                    TLRENDER_ASSERT(i != required);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/PixelBufferRingTest.h>
+
+#include <tlGL/OffscreenContext.h>
+#include <tlGL/PixelBufferRing.h>
+#include <tlGL/Texture.h>
+
+#include <tlCore/Assert.h>
+
+#if defined(TLRENDER_GL_DEBUG)
+#include <tlGladDebug/gl.h>
+#else // TLRENDER_GL_DEBUG
+#include <tlGlad/gl.h>
+#endif // TLRENDER_GL_DEBUG
+
+#include <cstring>
+#include <thread>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        PixelBufferRingTest::PixelBufferRingTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::PixelBufferRingTest", context)
+        {}
+
+        std::shared_ptr<PixelBufferRingTest> PixelBufferRingTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<PixelBufferRingTest>(new PixelBufferRingTest(context));
+        }
+
+        void PixelBufferRingTest::run()
+        {
+            _ring();
+        }
+
+        namespace
+        {
+            bool compare(Texture& texture, const uint8_t* data, const image::Info& info)
+            {
+                std::vector<uint8_t> buf(image::getDataByteCount(info));
+                texture.bind();
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glGetTexImage(
+                    GL_TEXTURE_2D,
+                    0,
+                    getTextureFormat(info.pixelType),
+                    getTextureType(info.pixelType),
+                    buf.data());
+                return 0 == memcmp(buf.data(), data, buf.size());
+            }
+        }
+
+        void PixelBufferRingTest::_ring()
+        {
+            // Contexts cannot be created on every test machine.
+            std::shared_ptr<OffscreenContext> glContext;
+            try
+            {
+                glContext = OffscreenContext::create(_context);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (glContext && PixelBufferRing::isSupported())
+            {
+                const image::Info info(16, 16, image::PixelType::RGBA_U8);
+                const size_t byteCount = image::getDataByteCount(info);
+                auto ring = PixelBufferRing::create(byteCount * 2);
+                TLRENDER_ASSERT(byteCount * 2 == ring->getByteCount());
+                auto texture = Texture::create(info);
+                {
+                    auto image = ring->createImage(info);
+                    TLRENDER_ASSERT(image);
+                    TLRENDER_ASSERT(ring->contains(image->getData(), byteCount));
+                    for (size_t i = 0; i < byteCount; ++i)
+                    {
+                        image->getData()[i] = i % 256;
+                    }
+                    TLRENDER_ASSERT(ring->copy(image->getData(), image->getInfo(), *texture));
+                    TLRENDER_ASSERT(compare(*texture, image->getData(), info));
+
+                    auto image2 = ring->createImage(info);
+                    TLRENDER_ASSERT(image2);
+                    auto image3 = ring->createImage(info);
+                    TLRENDER_ASSERT(!image3);
+                }
+                ring->update();
+                {
+                    std::vector<uint8_t> data(byteCount);
+                    TLRENDER_ASSERT(!ring->contains(data.data(), byteCount));
+                    for (size_t i = 0; i < byteCount; ++i)
+                    {
+                        data[i] = 255 - i % 256;
+                    }
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        TLRENDER_ASSERT(ring->copy(data.data(), info, *texture));
+                        TLRENDER_ASSERT(compare(*texture, data.data(), info));
+                    }
+                }
+                ring->update();
+                TLRENDER_ASSERT(ring->createImage(info));
+                {
+                    // Images can be created and released on other threads.
+                    auto allocator = ring->getImageAllocator();
+                    std::shared_ptr<image::Image> image;
+                    std::thread(
+                        [allocator, info, &image]
+                        {
+                            image = allocator(info);
+                        }).join();
+                    TLRENDER_ASSERT(image);
+                    TLRENDER_ASSERT(ring->contains(image->getData(), byteCount));
+                    TLRENDER_ASSERT(1 == ring->getImageCount());
+                    std::thread(
+                        [&image]
+                        {
+                            image.reset();
+                        }).join();
+                    TLRENDER_ASSERT(0 == ring->getImageCount());
+                    ring->update();
+
+                    // Images do not keep the ring alive, but the buffer
+                    // stays mapped for them.
+                    image = ring->createImage(info);
+                    TLRENDER_ASSERT(image);
+                    std::weak_ptr<PixelBufferRing> ringWeak(ring);
+                    ring.reset();
+                    TLRENDER_ASSERT(ringWeak.expired());
+                    memset(image->getData(), 0, byteCount);
+                    TLRENDER_ASSERT(!allocator(info));
+                    image.reset();
+                }
+            }
+        }
+    }
+}
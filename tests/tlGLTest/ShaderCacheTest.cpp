@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/ShaderCacheTest.h>
+
+#include <tlGL/OffscreenContext.h>
+#include <tlGL/Shader.h>
+#include <tlGL/ShaderCache.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileInfo.h>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        ShaderCacheTest::ShaderCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::ShaderCacheTest", context)
+        {}
+
+        std::shared_ptr<ShaderCacheTest> ShaderCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ShaderCacheTest>(new ShaderCacheTest(context));
+        }
+
+        void ShaderCacheTest::run()
+        {
+            _cache();
+        }
+
+        namespace
+        {
+            const std::string vertexSource =
+                "#version 410\n"
+                "\n"
+                "in vec3 vPos;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    gl_Position = vec4(vPos, 1.0);\n"
+                "}\n";
+
+            const std::string fragmentSource =
+                "#version 410\n"
+                "\n"
+                "out vec4 fColor;\n"
+                "\n"
+                "uniform vec4 color;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    fColor = color;\n"
+                "}\n";
+        }
+
+        void ShaderCacheTest::_cache()
+        {
+            // Contexts cannot be created on every test machine.
+            std::shared_ptr<OffscreenContext> glContext;
+            try
+            {
+                glContext = OffscreenContext::create(_context);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (glContext && ShaderCache::isSupported())
+            {
+                const std::string directory = file::createTempDir();
+                {
+                    auto cache = ShaderCache::create(directory);
+                    TLRENDER_ASSERT(directory == cache->getDirectory());
+                    TLRENDER_ASSERT(cache->getByteCount() > 0);
+                    setShaderCache(cache);
+                    TLRENDER_ASSERT(cache == getShaderCache());
+
+                    ProgramBinary binary;
+                    TLRENDER_ASSERT(!cache->get(vertexSource, fragmentSource, binary));
+                    auto shader = Shader::create(vertexSource, fragmentSource);
+                    TLRENDER_ASSERT(1 == cache->getCount());
+                    TLRENDER_ASSERT(cache->get(vertexSource, fragmentSource, binary));
+                    TLRENDER_ASSERT(!binary.data.empty());
+
+                    auto shader2 = Shader::create(vertexSource, fragmentSource);
+                    TLRENDER_ASSERT(shader2->getProgram());
+                    shader2->bind();
+                    shader2->setUniform("color", math::Vector4f(1.F, 0.F, 0.F, 1.F));
+
+                    cache->clear();
+                    TLRENDER_ASSERT(0 == cache->getCount());
+                }
+                {
+                    // Load the binary from the cache directory.
+                    auto cache = ShaderCache::create(directory);
+                    setShaderCache(cache);
+                    ProgramBinary binary;
+                    TLRENDER_ASSERT(cache->get(vertexSource, fragmentSource, binary));
+                    auto shader = Shader::create(vertexSource, fragmentSource);
+                    TLRENDER_ASSERT(shader->getProgram());
+                    TLRENDER_ASSERT(!cache->get(vertexSource, fragmentSource + "\n", binary));
+
+                    // Only the binary is left in the directory.
+                    file::ListOptions options;
+                    options.sequence = false;
+                    const auto list = file::list(directory, options);
+                    TLRENDER_ASSERT(1 == list.size());
+                    TLRENDER_ASSERT(".bin" == list[0].getPath().getExtension());
+                }
+                {
+                    // Binaries are removed from the directory when it is
+                    // larger than the maximum size.
+                    const std::string directory2 = file::createTempDir();
+                    auto cache = ShaderCache::create(directory2, 0);
+                    setShaderCache(cache);
+                    auto shader = Shader::create(vertexSource, fragmentSource);
+                    TLRENDER_ASSERT(1 == cache->getCount());
+                    file::ListOptions options;
+                    options.sequence = false;
+                    TLRENDER_ASSERT(file::list(directory2, options).empty());
+                    cache = ShaderCache::create(directory2, 0);
+                    ProgramBinary binary;
+                    TLRENDER_ASSERT(!cache->get(vertexSource, fragmentSource, binary));
+                }
+                {
+                    // A cache without a directory only keeps the binaries
+                    // in memory.
+                    auto cache = ShaderCache::create(std::string());
+                    setShaderCache(cache);
+                    auto shader = Shader::create(vertexSource, fragmentSource);
+                    TLRENDER_ASSERT(1 == cache->getCount());
+                }
+                setShaderCache(nullptr);
+                TLRENDER_ASSERT(!getShaderCache());
+            }
+        }
+    }
+}
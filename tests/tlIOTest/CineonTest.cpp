@@ -87,6 +87,12 @@ namespace tl
                     TLRENDER_ASSERT(k != frameTags.end());
                     TLRENDER_ASSERT(k->second == j.second);
                 }
+
+                // Read the frame again to use the frame template.
+                const auto videoData2 = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+                TLRENDER_ASSERT(videoData2.image);
+                TLRENDER_ASSERT(videoData2.image->getInfo() == videoData.image->getInfo());
+                TLRENDER_ASSERT(videoData2.image->getTags() == frameTags);
             }
 
             void readError(
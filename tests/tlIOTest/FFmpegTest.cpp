@@ -9,6 +9,7 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
 
 #include <array>
 #include <sstream>
@@ -33,6 +34,7 @@ namespace tl
             _enums();
             _util();
             _io();
+            _concatenate();
         }
 
         void FFmpegTest::_enums()
@@ -200,5 +202,66 @@ namespace tl
                 }
             }
         }
+
+        void FFmpegTest::_concatenate()
+        {
+            auto plugin = _context->getSystem<System>()->getPlugin<ffmpeg::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(image::Info(image::Size(16, 16), image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+
+            // Write the segments.
+            std::vector<std::string> segments;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const std::string fileName = string::Format("FFmpegTest_Segment{0}.mp4").arg(i);
+                write(plugin, image, file::Path(fileName), imageInfo, {}, otime::RationalTime(12.0, 24.0));
+                segments.push_back(fileName);
+            }
+
+            // Test that the segments are joined in order.
+            const file::Path path("FFmpegTest_Concatenate.mp4");
+            ffmpeg::concatenate(segments, path.get());
+            {
+                auto read = plugin->read(path);
+                const auto info = read->getInfo().get();
+                TLRENDER_ASSERT(!info.video.empty());
+                TLRENDER_ASSERT(image->getSize() == info.video[0].size);
+                TLRENDER_ASSERT(36.0 == info.videoTime.duration().rescaled_to(24.0).value());
+                for (size_t i = 0; i < 36; ++i)
+                {
+                    const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                    TLRENDER_ASSERT(videoData.image);
+                }
+            }
+
+            // Test errors.
+            try
+            {
+                ffmpeg::concatenate({}, path.get());
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            try
+            {
+                ffmpeg::concatenate({ segments[0], "FFmpegTest_Missing.mp4" }, path.get());
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            const auto imageInfo2 = plugin->getWriteInfo(image::Info(image::Size(32, 32), image::PixelType::RGB_U8));
+            const file::Path path2("FFmpegTest_Segment32x32.mp4");
+            auto image2 = image::Image::create(imageInfo2);
+            image2->zero();
+            write(plugin, image2, path2, imageInfo2, {}, otime::RationalTime(12.0, 24.0));
+            try
+            {
+                ffmpeg::concatenate({ segments[0], path2.get() }, path.get());
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
     }
 }
@@ -24,6 +24,7 @@ namespace tl
             void _enums();
             void _util();
             void _io();
+            void _concatenate();
         };
     }
 }
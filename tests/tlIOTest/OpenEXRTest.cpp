@@ -10,6 +10,7 @@
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
 
+#include <cstring>
 #include <sstream>
 
 using namespace tl::io;
@@ -78,6 +79,29 @@ namespace tl
                 }
             }
 
+            void readStream(const file::Path& path)
+            {
+                auto fileIO = file::FileIO::create(path.get(), file::Mode::Read);
+                std::vector<uint8_t> memoryData(fileIO->getSize());
+                fileIO->read(memoryData.data(), memoryData.size());
+                fileIO.reset();
+
+                exr::IStream memoryStream(path.get(), memoryData.data(), memoryData.size());
+                TLRENDER_ASSERT(memoryStream.isMemoryMapped());
+                const char* p = memoryStream.readMemoryMapped(4);
+                TLRENDER_ASSERT(reinterpret_cast<const uint8_t*>(p) == memoryData.data());
+                TLRENDER_ASSERT(4 == memoryStream.tellg());
+                memoryStream.seekg(0);
+                TLRENDER_ASSERT(0 == memoryStream.tellg());
+
+#if defined(TLRENDER_MMAP)
+                exr::IStream fileStream(path.get());
+                TLRENDER_ASSERT(fileStream.isMemoryMapped());
+                p = fileStream.readMemoryMapped(4);
+                TLRENDER_ASSERT(0 == memcmp(p, memoryData.data(), 4));
+#endif // TLRENDER_MMAP
+            }
+
             void readError(
                 const std::shared_ptr<io::IPlugin>& plugin,
                 const std::shared_ptr<image::Image>& image,
@@ -169,6 +193,7 @@ namespace tl
                                 {
                                     write(plugin, image, path, imageInfo, tags);
                                     read(plugin, image, path, memoryIO, tags);
+                                    readStream(path);
                                     readError(plugin, image, path, memoryIO);
                                 }
                                 catch (const std::exception& e)
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/RawTest.h>
+
+#include <tlIO/IOSystem.h>
+#include <tlIO/Raw.h>
+
+#include <tlCore/Assert.h>
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <sstream>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        RawTest::RawTest(const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::RawTest", context)
+        {}
+
+        std::shared_ptr<RawTest> RawTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RawTest>(new RawTest(context));
+        }
+
+        void RawTest::run()
+        {
+            _io();
+        }
+
+        namespace
+        {
+            const size_t frameCount = 3;
+            const size_t audioSampleCount = 2000;
+
+            void write(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::vector<std::shared_ptr<image::Image> >& images,
+                const std::shared_ptr<audio::Audio>& audio,
+                const file::Path& path,
+                const image::Info& imageInfo)
+            {
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(frameCount, 24.0));
+                info.audio = audio->getInfo();
+                auto write = plugin->write(path, info);
+                for (size_t i = 0; i < images.size(); ++i)
+                {
+                    write->writeVideo(otime::RationalTime(i, 24.0), images[i]);
+                }
+                write->writeAudio(
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 48000.0),
+                        otime::RationalTime(audio->getSampleCount(), 48000.0)),
+                    audio);
+            }
+
+            void read(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::vector<std::shared_ptr<image::Image> >& images,
+                const std::shared_ptr<audio::Audio>& audio,
+                const file::Path& path,
+                bool memoryIO)
+            {
+                std::vector<uint8_t> memoryData;
+                std::vector<file::MemoryRead> memory;
+                if (memoryIO)
+                {
+                    auto fileIO = file::FileIO::create(path.get(), file::Mode::Read);
+                    memoryData.resize(fileIO->getSize());
+                    fileIO->read(memoryData.data(), memoryData.size());
+                    memory.push_back(file::MemoryRead(memoryData.data(), memoryData.size()));
+                }
+                auto read = plugin->read(path, memory);
+                const auto info = read->getInfo().get();
+                TLRENDER_ASSERT(!info.video.empty());
+                TLRENDER_ASSERT(info.video[0].size == images[0]->getSize());
+                TLRENDER_ASSERT(info.video[0].pixelType == images[0]->getPixelType());
+                TLRENDER_ASSERT(frameCount == info.videoTime.duration().value());
+                TLRENDER_ASSERT(info.audio == audio->getInfo());
+                for (size_t i = 0; i < images.size(); ++i)
+                {
+                    const auto videoData = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                    TLRENDER_ASSERT(videoData.image);
+                    TLRENDER_ASSERT(0 == memcmp(
+                        videoData.image->getData(),
+                        images[i]->getData(),
+                        images[i]->getDataByteCount()));
+
+                    // Modifying the image must not change the file or
+                    // the data of the next read.
+                    videoData.image->zero();
+                    const auto videoData2 = read->readVideo(otime::RationalTime(i, 24.0)).get();
+                    TLRENDER_ASSERT(videoData2.image);
+                    TLRENDER_ASSERT(0 == memcmp(
+                        videoData2.image->getData(),
+                        images[i]->getData(),
+                        images[i]->getDataByteCount()));
+                }
+                const auto videoData = read->readVideo(otime::RationalTime(frameCount, 24.0)).get();
+                TLRENDER_ASSERT(!videoData.image);
+                const auto audioData = read->readAudio(otime::TimeRange(
+                    otime::RationalTime(0.0, 48000.0),
+                    otime::RationalTime(audio->getSampleCount(), 48000.0))).get();
+                TLRENDER_ASSERT(audioData.audio);
+                TLRENDER_ASSERT(0 == memcmp(
+                    audioData.audio->getData(),
+                    audio->getData(),
+                    audio->getByteCount()));
+            }
+
+            std::vector<uint8_t> readContents(const file::Path& path)
+            {
+                auto fileIO = file::FileIO::create(path.get(), file::Mode::Read);
+                std::vector<uint8_t> out(fileIO->getSize());
+                fileIO->read(out.data(), out.size());
+                return out;
+            }
+
+            void readError(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const file::Path& path)
+            {
+                {
+                    auto fileIO = file::FileIO::create(path.get(), file::Mode::Read);
+                    const size_t size = fileIO->getSize();
+                    fileIO.reset();
+                    file::truncate(path.get(), size / 2);
+                }
+                auto read = plugin->read(path);
+                const auto info = read->getInfo().get();
+                TLRENDER_ASSERT(info.video.empty());
+                const auto videoData = read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+                TLRENDER_ASSERT(!videoData.image);
+            }
+
+            void writeError(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::vector<std::shared_ptr<image::Image> >& images,
+                const file::Path& path,
+                const image::Info& imageInfo)
+            {
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(frameCount, 24.0));
+                auto write = plugin->write(path, info);
+                image::Info imageInfo2 = imageInfo;
+                imageInfo2.layout.mirror.y = !imageInfo2.layout.mirror.y;
+                auto image = image::Image::create(imageInfo2);
+                try
+                {
+                    write->writeVideo(otime::RationalTime(0.0, 24.0), image);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
+            void headerError(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const file::Path& path,
+                const std::vector<uint8_t>& contents)
+            {
+                // Corrupt each of the header values that are used to
+                // create the information and check that the file is
+                // rejected.
+                const std::vector<std::function<void(raw::Header&)> > corruptions =
+                {
+                    [](raw::Header& header) { header.videoPixelType = static_cast<uint32_t>(image::PixelType::Count); },
+                    [](raw::Header& header) { header.videoLevels = static_cast<uint32_t>(image::VideoLevels::Count); },
+                    [](raw::Header& header) { header.videoYUVCoefficients = static_cast<uint32_t>(image::YUVCoefficients::Count); },
+                    [](raw::Header& header) { header.videoEndian = static_cast<uint8_t>(memory::Endian::Count); },
+                    [](raw::Header& header) { header.videoRate = 0.0; },
+                    [](raw::Header& header) { header.videoFrameCount = std::numeric_limits<uint64_t>::max() / 2; },
+                    [](raw::Header& header) { header.audioDataType = static_cast<uint32_t>(audio::DataType::Count); },
+                    [](raw::Header& header) { header.audioSampleRate = 0; },
+                    [](raw::Header& header) { header.audioChunkCount = std::numeric_limits<uint64_t>::max() / 2; }
+                };
+                for (const auto& corruption : corruptions)
+                {
+                    raw::Header header;
+                    memcpy(&header, contents.data(), sizeof(raw::Header));
+                    corruption(header);
+                    {
+                        auto fileIO = file::FileIO::create(path.get(), file::Mode::Write);
+                        fileIO->write(&header, sizeof(raw::Header));
+                        fileIO->write(
+                            contents.data() + sizeof(raw::Header),
+                            contents.size() - sizeof(raw::Header));
+                    }
+                    auto read = plugin->read(path);
+                    const auto info = read->getInfo().get();
+                    TLRENDER_ASSERT(info.video.empty());
+                    TLRENDER_ASSERT(!info.audio.isValid());
+                }
+            }
+        }
+
+        void RawTest::_io()
+        {
+            auto plugin = _context->getSystem<System>()->getPlugin<raw::Plugin>();
+            TLRENDER_ASSERT(plugin->canWriteAudio());
+
+            const std::vector<bool> memoryIOList =
+            {
+                false,
+                true
+            };
+            const std::vector<image::Size> sizes =
+            {
+                image::Size(16, 16),
+                image::Size(1, 1)
+            };
+
+            for (const bool memoryIO : memoryIOList)
+            {
+                for (const auto& size : sizes)
+                {
+                    for (const auto& pixelType : image::getPixelTypeEnums())
+                    {
+                        const auto imageInfo = plugin->getWriteInfo(image::Info(size, pixelType));
+                        if (imageInfo.isValid())
+                        {
+                            file::Path path;
+                            {
+                                std::stringstream ss;
+                                ss << "RawTest_" << size << '_' << pixelType << ".tlraw";
+                                _print(ss.str());
+                                path = file::Path(ss.str());
+                            }
+                            std::vector<std::shared_ptr<image::Image> > images;
+                            for (size_t i = 0; i < frameCount; ++i)
+                            {
+                                auto image = image::Image::create(imageInfo);
+                                memset(image->getData(), i + 1, image->getDataByteCount());
+                                images.push_back(image);
+                            }
+                            auto audio = audio::Audio::create(
+                                audio::Info(2, audio::DataType::S16, 48000),
+                                audioSampleCount);
+                            memset(audio->getData(), 1, audio->getByteCount());
+                            try
+                            {
+                                write(plugin, images, audio, path, imageInfo);
+                                const auto contents = readContents(path);
+                                write(plugin, images, audio, path, imageInfo);
+                                TLRENDER_ASSERT(contents == readContents(path));
+                                read(plugin, images, audio, path, memoryIO);
+                                TLRENDER_ASSERT(contents == readContents(path));
+                                headerError(plugin, path, contents);
+                                readError(plugin, path);
+                                writeError(plugin, images, path, imageInfo);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                _printError(e.what());
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
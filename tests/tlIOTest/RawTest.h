@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class RawTest : public tests::ITest
+        {
+        protected:
+            RawTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<RawTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _io();
+        };
+    }
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTestLib/AllocationCheck.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // The counter of the check that is armed on this thread, or null.
+    thread_local size_t* allocationCount = nullptr;
+}
+
+void* operator new(std::size_t size)
+{
+    if (allocationCount)
+    {
+        ++(*allocationCount);
+    }
+    if (void* out = std::malloc(size > 0 ? size : 1))
+    {
+        return out;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* value) noexcept
+{
+    std::free(value);
+}
+
+void operator delete(void* value, std::size_t) noexcept
+{
+    std::free(value);
+}
+
+namespace tl
+{
+    namespace tests
+    {
+        AllocationCheck::AllocationCheck() :
+            _prev(allocationCount)
+        {
+            allocationCount = &_count;
+        }
+
+        AllocationCheck::~AllocationCheck()
+        {
+            allocationCount = _prev;
+        }
+
+        size_t AllocationCheck::getCount() const
+        {
+            return _count;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <cstddef>
+
+namespace tl
+{
+    namespace tests
+    {
+        //! Count the memory allocations made by the current thread while
+        //! the check exists. Allocations made by other threads, or outside
+        //! of the check, are not counted.
+        class AllocationCheck
+        {
+            TLRENDER_NON_COPYABLE(AllocationCheck);
+
+        public:
+            AllocationCheck();
+            ~AllocationCheck();
+
+            //! Get the number of allocations.
+            size_t getCount() const;
+
+        private:
+            size_t _count = 0;
+            size_t* _prev = nullptr;
+        };
+    }
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTestLib/LockCheck.h>
+
+#if defined(__linux__)
+#include <atomic>
+
+#include <dlfcn.h>
+#include <pthread.h>
+#endif // __linux__
+
+namespace
+{
+    // The counter of the check that is armed on this thread, or null.
+    thread_local size_t* lockCount = nullptr;
+}
+
+#if defined(__linux__)
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    // Forward to the C library. The function pointer is constant
+    // initialized, so there is no static guard that could itself lock.
+    typedef int (*Function)(pthread_mutex_t*);
+    static std::atomic<Function> function(nullptr);
+    Function f = function.load();
+    if (!f)
+    {
+        f = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        function.store(f);
+    }
+    if (lockCount)
+    {
+        ++(*lockCount);
+    }
+    return f(mutex);
+}
+#endif // __linux__
+
+namespace tl
+{
+    namespace tests
+    {
+        LockCheck::LockCheck() :
+            _prev(lockCount)
+        {
+            lockCount = &_count;
+        }
+
+        LockCheck::~LockCheck()
+        {
+            lockCount = _prev;
+        }
+
+        size_t LockCheck::getCount() const
+        {
+            return _count;
+        }
+
+        bool isLockCheckSupported()
+        {
+#if defined(__linux__)
+            return true;
+#else // __linux__
+            return false;
+#endif // __linux__
+        }
+    }
+}
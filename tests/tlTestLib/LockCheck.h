@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <cstddef>
+
+namespace tl
+{
+    namespace tests
+    {
+        //! Count the mutex locks taken by the current thread while the
+        //! check exists. Locks are only counted on Linux, where the check
+        //! intercepts pthread_mutex_lock(); see isLockCheckSupported().
+        class LockCheck
+        {
+            TLRENDER_NON_COPYABLE(LockCheck);
+
+        public:
+            LockCheck();
+            ~LockCheck();
+
+            //! Get the number of locks.
+            size_t getCount() const;
+
+        private:
+            size_t _count = 0;
+            size_t* _prev = nullptr;
+        };
+
+        //! Get whether locks are counted on this platform.
+        bool isLockCheckSupported();
+    }
+}
@@ -0,0 +1,435 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/CPURenderTest.h>
+
+#include <tlTimeline/CPURender.h>
+#include <tlTimeline/GLRender.h>
+
+#include <tlGL/OffscreenBuffer.h>
+#include <tlGL/OffscreenContext.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/ImageConvert.h>
+#include <tlCore/StringFormat.h>
+
+#include <tlGlad/gl.h>
+
+#include <cmath>
+#include <functional>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        CPURenderTest::CPURenderTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::CPURenderTest", context)
+        {}
+
+        std::shared_ptr<CPURenderTest> CPURenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<CPURenderTest>(new CPURenderTest(context));
+        }
+
+        void CPURenderTest::run()
+        {
+            _render();
+            _video();
+            _compare();
+        }
+
+        namespace
+        {
+            image::Color4f getPixel(const std::shared_ptr<image::Image>& image, int x, int y)
+            {
+                const float* p = reinterpret_cast<const float*>(image->getData()) +
+                    (y * image->getWidth() + x) * 4;
+                return image::Color4f(p[0], p[1], p[2], p[3]);
+            }
+
+            bool isEqual(const image::Color4f& a, const image::Color4f& b)
+            {
+                const float e = .001F;
+                return
+                    std::fabs(a.r - b.r) < e &&
+                    std::fabs(a.g - b.g) < e &&
+                    std::fabs(a.b - b.b) < e &&
+                    std::fabs(a.a - b.a) < e;
+            }
+
+            std::shared_ptr<image::Image> createSolid(
+                const image::Size& size,
+                const image::Color4f& color)
+            {
+                auto out = image::Image::create(size.w, size.h, image::PixelType::RGBA_F32);
+                float* p = reinterpret_cast<float*>(out->getData());
+                for (size_t i = 0; i < static_cast<size_t>(size.w) * size.h; ++i, p += 4)
+                {
+                    p[0] = color.r;
+                    p[1] = color.g;
+                    p[2] = color.b;
+                    p[3] = color.a;
+                }
+                return out;
+            }
+
+            std::shared_ptr<image::Image> createGradient(
+                const image::Size& size,
+                image::PixelType pixelType)
+            {
+                auto tmp = image::Image::create(size.w, size.h, image::PixelType::RGBA_F32);
+                float* p = reinterpret_cast<float*>(tmp->getData());
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x, p += 4)
+                    {
+                        p[0] = x / static_cast<float>(size.w);
+                        p[1] = y / static_cast<float>(size.h);
+                        p[2] = .5F;
+                        p[3] = .5F + .5F * x / static_cast<float>(size.w);
+                    }
+                }
+                auto out = image::Image::create(size.w, size.h, pixelType);
+                image::convert(tmp, out);
+                return out;
+            }
+
+            VideoData createVideo(
+                const std::shared_ptr<image::Image>& image,
+                const std::shared_ptr<image::Image>& imageB = nullptr,
+                float transitionValue = 0.F)
+            {
+                VideoData out;
+                out.time = otime::RationalTime(0.0, 24.0);
+                VideoLayer layer;
+                layer.image = image;
+                if (imageB)
+                {
+                    layer.imageB = imageB;
+                    layer.transition = Transition::Dissolve;
+                    layer.transitionValue = transitionValue;
+                }
+                out.layers.push_back(layer);
+                return out;
+            }
+        }
+
+        void CPURenderTest::_render()
+        {
+            auto render = CPURender::create(_context);
+            render->setThreadCount(2);
+            TLRENDER_ASSERT(2 == render->getThreadCount());
+            const image::Size size(4, 4);
+            RenderOptions renderOptions;
+            renderOptions.clearColor = image::Color4f(0.F, 0.F, 0.F, 1.F);
+            {
+                render->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                render->drawRect(math::Box2i(0, 0, 2, 2), image::Color4f(1.F, 0.F, 0.F, .5F));
+                render->end();
+                const auto& image = render->getImage();
+                TLRENDER_ASSERT(image);
+                TLRENDER_ASSERT(size == image->getSize());
+                TLRENDER_ASSERT(image::PixelType::RGBA_F32 == image->getPixelType());
+                TLRENDER_ASSERT(isEqual(getPixel(image, 0, 0), image::Color4f(.5F, 0.F, 0.F, .75F)));
+                TLRENDER_ASSERT(isEqual(getPixel(image, 1, 1), image::Color4f(.5F, 0.F, 0.F, .75F)));
+                TLRENDER_ASSERT(isEqual(getPixel(image, 3, 3), image::Color4f(0.F, 0.F, 0.F, 1.F)));
+            }
+            {
+                auto image = image::Image::create(2, 1, image::PixelType::RGBA_U8);
+                uint8_t* p = image->getData();
+                p[0] = 255; p[1] = 0; p[2] = 0; p[3] = 255;
+                p[4] = 0; p[5] = 255; p[6] = 0; p[7] = 255;
+                ImageOptions imageOptions;
+                imageOptions.imageFilters.minify = ImageFilter::Nearest;
+                imageOptions.imageFilters.magnify = ImageFilter::Nearest;
+                imageOptions.alphaBlend = AlphaBlend::None;
+                render->begin(size);
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 4, 2),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    imageOptions);
+                render->end();
+                const auto& out = render->getImage();
+                TLRENDER_ASSERT(isEqual(getPixel(out, 0, 0), image::Color4f(1.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 1, 1), image::Color4f(1.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 2, 0), image::Color4f(0.F, 1.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 3, 1), image::Color4f(0.F, 1.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 0, 2), image::Color4f(0.F, 0.F, 0.F, 0.F)));
+            }
+            {
+                render->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                render->setClipRectEnabled(true);
+                render->setClipRect(math::Box2i(2, 2, 2, 2));
+                TLRENDER_ASSERT(render->getClipRectEnabled());
+                TLRENDER_ASSERT(math::Box2i(2, 2, 2, 2) == render->getClipRect());
+                render->drawRect(math::Box2i(0, 0, 4, 4), image::Color4f(0.F, 0.F, 1.F));
+                render->setClipRectEnabled(false);
+                render->end();
+                const auto& out = render->getImage();
+                TLRENDER_ASSERT(isEqual(getPixel(out, 0, 0), image::Color4f(0.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 1, 3), image::Color4f(0.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 2, 2), image::Color4f(0.F, 0.F, 1.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 3, 3), image::Color4f(0.F, 0.F, 1.F)));
+            }
+        }
+
+        void CPURenderTest::_video()
+        {
+            auto render = CPURender::create(_context);
+            const image::Size size(4, 2);
+            const math::Box2i box(0, 0, size.w, size.h);
+            auto red = createSolid(size, image::Color4f(1.F, 0.F, 0.F));
+            auto green = createSolid(size, image::Color4f(0.F, 1.F, 0.F));
+            auto darkRed = createSolid(size, image::Color4f(.25F, 0.F, 0.F));
+            {
+                render->begin(size);
+                render->drawVideo({ createVideo(red, green, .25F) }, { box });
+                render->end();
+                TLRENDER_ASSERT(isEqual(
+                    getPixel(render->getImage(), 0, 0),
+                    image::Color4f(.5625F, .25F, 0.F, 1.F)));
+            }
+            {
+                CompareOptions compareOptions;
+                compareOptions.mode = CompareMode::Wipe;
+                compareOptions.wipeRotation = 0.F;
+                render->begin(size);
+                render->drawVideo(
+                    { createVideo(red), createVideo(green) },
+                    { box, box },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                const auto& out = render->getImage();
+                TLRENDER_ASSERT(isEqual(getPixel(out, 0, 0), image::Color4f(1.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 1, 1), image::Color4f(1.F, 0.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 2, 0), image::Color4f(0.F, 1.F, 0.F)));
+                TLRENDER_ASSERT(isEqual(getPixel(out, 3, 1), image::Color4f(0.F, 1.F, 0.F)));
+            }
+            {
+                CompareOptions compareOptions;
+                compareOptions.mode = CompareMode::Difference;
+                render->begin(size);
+                render->drawVideo(
+                    { createVideo(red), createVideo(darkRed) },
+                    { box, box },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                TLRENDER_ASSERT(isEqual(
+                    getPixel(render->getImage(), 0, 0),
+                    image::Color4f(.75F, 0.F, 0.F, 1.F)));
+            }
+            {
+                DisplayOptions displayOptions;
+                displayOptions.color.enabled = true;
+                displayOptions.color.invert = true;
+                render->begin(size);
+                render->drawVideo({ createVideo(darkRed) }, { box }, {}, { displayOptions });
+                render->end();
+                TLRENDER_ASSERT(isEqual(
+                    getPixel(render->getImage(), 0, 0),
+                    image::Color4f(.75F, 1.F, 1.F, 1.F)));
+            }
+        }
+
+        void CPURenderTest::_compare()
+        {
+            // Compare with the OpenGL renderer when a context is available.
+            std::shared_ptr<gl::OffscreenContext> glContext;
+            try
+            {
+                glContext = gl::OffscreenContext::create(_context);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+                return;
+            }
+            auto glRender = GLRender::create(_context);
+            auto cpuRender = CPURender::create(_context);
+            const image::Size size(64, 48);
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = image::PixelType::RGBA_F32;
+            offscreenBufferOptions.depth = gl::OffscreenDepth::_24;
+            offscreenBufferOptions.stencil = gl::OffscreenStencil::_8;
+            auto buffer = gl::OffscreenBuffer::create(size, offscreenBufferOptions);
+            RenderOptions renderOptions;
+            renderOptions.clearColor = image::Color4f(.1F, .2F, .3F, 1.F);
+
+            const math::Box2i box(0, 0, size.w, size.h);
+            auto imageA = createGradient(image::Size(16, 12), image::PixelType::RGBA_F32);
+            auto imageB = createSolid(image::Size(16, 12), image::Color4f(.8F, .4F, .2F, .6F));
+            auto imageU8 = createGradient(image::Size(8, 6), image::PixelType::RGBA_U8);
+            geom::TriangleMesh2 mesh;
+            mesh.v.push_back(math::Vector2f(.3F, .2F));
+            mesh.v.push_back(math::Vector2f(40.6F, 5.3F));
+            mesh.v.push_back(math::Vector2f(10.2F, 40.7F));
+            mesh.c.push_back(math::Vector4f(1.F, 0.F, 0.F, 1.F));
+            mesh.c.push_back(math::Vector4f(0.F, 1.F, 0.F, .5F));
+            mesh.c.push_back(math::Vector4f(0.F, 0.F, 1.F, 1.F));
+            geom::Triangle2 triangle;
+            triangle.v[0].v = 1;
+            triangle.v[1].v = 2;
+            triangle.v[2].v = 3;
+            triangle.v[0].c = 1;
+            triangle.v[1].c = 2;
+            triangle.v[2].c = 3;
+            mesh.triangles.push_back(triangle);
+
+            struct Scene
+            {
+                std::string name;
+                std::function<void(IRender*)> draw;
+            };
+            std::vector<Scene> scenes;
+            scenes.push_back({ "Rects", [](IRender* render)
+                {
+                    render->drawRect(math::Box2i(4, 4, 30, 20), image::Color4f(1.F, .5F, 0.F, .75F));
+                    render->drawRect(math::Box2i(20, 10, 30, 30), image::Color4f(0.F, .5F, 1.F, .5F));
+                } });
+            scenes.push_back({ "Meshes", [mesh](IRender* render)
+                {
+                    render->drawMesh(mesh, math::Vector2i(5, 2), image::Color4f(1.F, 1.F, 0.F, .5F));
+                    render->drawColorMesh(mesh, math::Vector2i(20, 4), image::Color4f(1.F, 1.F, 1.F, .8F));
+                } });
+            scenes.push_back({ "Batches", [mesh, imageU8](IRender* render)
+                {
+                    // Interleave primitives with state changes that flush
+                    // the batches.
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        render->drawRect(math::Box2i(i * 6, i * 4, 10, 10), image::Color4f(i / 8.F, .5F, 1.F - i / 8.F, .5F));
+                    }
+                    render->drawColorMesh(mesh, math::Vector2i(20, 4), image::Color4f(1.F, 1.F, 1.F, .8F));
+                    render->setClipRectEnabled(true);
+                    render->setClipRect(math::Box2i(10, 10, 30, 20));
+                    render->drawMesh(mesh, math::Vector2i(5, 2), image::Color4f(1.F, 1.F, 0.F, .5F));
+                    render->setClipRectEnabled(false);
+                    render->drawImage(imageU8, math::Box2i(30, 20, 24, 24));
+                    render->drawRect(math::Box2i(36, 26, 20, 10), image::Color4f(0.F, 1.F, 0.F, .5F));
+                } });
+            scenes.push_back({ "Images", [imageA, imageU8](IRender* render)
+                {
+                    ImageOptions imageOptions;
+                    render->drawImage(imageA, math::Box2i(3, 5, 40, 30), image::Color4f(1.F, 1.F, 1.F), imageOptions);
+                    imageOptions.imageFilters.magnify = ImageFilter::Nearest;
+                    imageOptions.alphaBlend = AlphaBlend::Premultiplied;
+                    render->drawImage(imageU8, math::Box2i(30, 20, 24, 24), image::Color4f(1.F, .5F, 1.F), imageOptions);
+                } });
+            scenes.push_back({ "Image cache", [imageA](IRender* render)
+                {
+                    // Draw the same image twice, and then two temporary
+                    // images where the second re-uses the textures of the
+                    // first.
+                    render->drawImage(imageA, math::Box2i(0, 0, 32, 24));
+                    render->drawImage(imageA, math::Box2i(32, 24, 32, 24));
+                    render->drawImage(
+                        createSolid(imageA->getSize(), image::Color4f(1.F, 0.F, 0.F)),
+                        math::Box2i(32, 0, 32, 24));
+                    render->drawImage(
+                        createSolid(imageA->getSize(), image::Color4f(0.F, 0.F, 1.F)),
+                        math::Box2i(0, 24, 32, 24));
+                } });
+            scenes.push_back({ "Dissolve", [imageA, imageB, box](IRender* render)
+                {
+                    DisplayOptions displayOptions;
+                    displayOptions.color.enabled = true;
+                    displayOptions.color.brightness = math::Vector3f(1.2F, 1.F, .9F);
+                    displayOptions.color.contrast = math::Vector3f(1.1F, 1.1F, 1.1F);
+                    displayOptions.color.saturation = math::Vector3f(.8F, .8F, .8F);
+                    displayOptions.levels.enabled = true;
+                    displayOptions.levels.inLow = .1F;
+                    displayOptions.levels.gamma = 1.5F;
+                    render->drawVideo({ createVideo(imageA, imageB, .3F) }, { box }, {}, { displayOptions });
+                } });
+            scenes.push_back({ "Display", [imageA, box](IRender* render)
+                {
+                    DisplayOptions displayOptions;
+                    displayOptions.mirror.x = true;
+                    displayOptions.softClip.enabled = true;
+                    displayOptions.softClip.value = .5F;
+                    displayOptions.videoLevels = image::VideoLevels::LegalRange;
+                    displayOptions.channels = Channels::Green;
+                    render->drawVideo({ createVideo(imageA) }, { box }, {}, { displayOptions });
+                } });
+            scenes.push_back({ "Wipe", [imageA, imageB, box](IRender* render)
+                {
+                    CompareOptions compareOptions;
+                    compareOptions.mode = CompareMode::Wipe;
+                    compareOptions.wipeCenter = math::Vector2f(.4F, .6F);
+                    compareOptions.wipeRotation = 30.F;
+                    render->drawVideo({ createVideo(imageA), createVideo(imageB) }, { box, box }, {}, {}, compareOptions);
+                } });
+            scenes.push_back({ "Overlay", [imageA, imageB, box](IRender* render)
+                {
+                    CompareOptions compareOptions;
+                    compareOptions.mode = CompareMode::Overlay;
+                    compareOptions.overlay = .4F;
+                    render->drawVideo({ createVideo(imageA), createVideo(imageB) }, { box, box }, {}, {}, compareOptions);
+                } });
+            scenes.push_back({ "Difference", [imageA, imageB, box](IRender* render)
+                {
+                    CompareOptions compareOptions;
+                    compareOptions.mode = CompareMode::Difference;
+                    render->drawVideo({ createVideo(imageA), createVideo(imageB) }, { box, box }, {}, {}, compareOptions);
+                } });
+            scenes.push_back({ "Tile", [imageA, imageB](IRender* render)
+                {
+                    CompareOptions compareOptions;
+                    compareOptions.mode = CompareMode::Tile;
+                    const auto boxes = getBoxes(CompareMode::Tile, { imageA->getSize(), imageB->getSize() });
+                    render->drawVideo({ createVideo(imageA), createVideo(imageB) }, boxes, {}, {}, compareOptions);
+                } });
+
+            for (const auto& scene : scenes)
+            {
+                std::vector<float> glData(static_cast<size_t>(size.w) * size.h * 4);
+                {
+                    gl::OffscreenBufferBinding binding(buffer);
+                    glRender->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                    scene.draw(glRender.get());
+                    glRender->end();
+                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                    glReadPixels(0, 0, size.w, size.h, GL_RGBA, GL_FLOAT, glData.data());
+                }
+
+                cpuRender->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                scene.draw(cpuRender.get());
+                cpuRender->end();
+
+                // Convert the rendered image to the bottom-up layout of the
+                // OpenGL rows, the same as the bake application does before
+                // writing.
+                auto cpuImage = image::Image::create(size.w, size.h, image::PixelType::RGBA_F32);
+                TLRENDER_ASSERT(!cpuImage->getInfo().layout.mirror.y);
+                image::convert(cpuRender->getImage(), cpuImage);
+
+                size_t count = 0;
+                const float* gl = glData.data();
+                for (int y = 0; y < size.h; ++y)
+                {
+                    for (int x = 0; x < size.w; ++x, gl += 4)
+                    {
+                        const image::Color4f cpu = getPixel(cpuImage, x, y);
+                        if (std::fabs(cpu.r - gl[0]) > .01F ||
+                            std::fabs(cpu.g - gl[1]) > .01F ||
+                            std::fabs(cpu.b - gl[2]) > .01F ||
+                            std::fabs(cpu.a - gl[3]) > .01F)
+                        {
+                            ++count;
+                        }
+                    }
+                }
+                _print(string::Format("{0}: {1} pixels differ").arg(scene.name).arg(count));
+                TLRENDER_ASSERT(count <= static_cast<size_t>(size.w) * size.h / 50);
+            }
+        }
+    }
+}
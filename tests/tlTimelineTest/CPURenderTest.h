@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class CPURenderTest : public tests::ITest
+        {
+        protected:
+            CPURenderTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<CPURenderTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _render();
+            void _video();
+            void _compare();
+        };
+    }
+}
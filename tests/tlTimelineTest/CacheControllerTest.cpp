@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/CacheControllerTest.h>
+
+#include <tlTimeline/CacheController.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <cmath>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        CacheControllerTest::CacheControllerTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::CacheControllerTest", context)
+        {}
+
+        std::shared_ptr<CacheControllerTest> CacheControllerTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<CacheControllerTest>(new CacheControllerTest(context));
+        }
+
+        void CacheControllerTest::run()
+        {
+            _options();
+            _adjust();
+        }
+
+        void CacheControllerTest::_options()
+        {
+            {
+                CacheControllerOptions options;
+                TLRENDER_ASSERT(options == CacheControllerOptions());
+                options.videoRequestCount = math::SizeTRange(1, 4);
+                TLRENDER_ASSERT(options != CacheControllerOptions());
+            }
+            {
+                CacheController controller;
+                TLRENDER_ASSERT(controller.getOptions() == CacheControllerOptions());
+                TLRENDER_ASSERT(16 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(4.0 == controller.getReadAhead());
+
+                CacheControllerOptions options;
+                options.videoRequestCount = math::SizeTRange(1, 4);
+                options.readAhead = math::DoubleRange(.5, 2.0);
+                controller.setOptions(options);
+                TLRENDER_ASSERT(4 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(2.0 == controller.getReadAhead());
+
+                options.videoRequestCount = math::SizeTRange(1, 16);
+                options.readAhead = math::DoubleRange(.5, 4.0);
+                controller.setOptions(options);
+                TLRENDER_ASSERT(4 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(2.0 == controller.getReadAhead());
+
+                controller.reset();
+                TLRENDER_ASSERT(16 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(4.0 == controller.getReadAhead());
+            }
+        }
+
+        namespace
+        {
+            class Reader
+            {
+            public:
+                Reader(CacheController& controller) :
+                    _controller(controller)
+                {
+                    _controller.update(_time, _stats, 0.0, 0.0, false);
+                }
+
+                // Simulate half a second of requests.
+                bool update(size_t count, double latency, double rate, double cached, bool stalled = false)
+                {
+                    _time += std::chrono::milliseconds(500);
+                    _stats.videoCount += count;
+                    _stats.videoSeconds += count * latency;
+                    return _controller.update(_time, _stats, rate, cached, stalled);
+                }
+
+            private:
+                CacheController& _controller;
+                std::chrono::steady_clock::time_point _time;
+                RequestStats _stats;
+            };
+        }
+
+        void CacheControllerTest::_adjust()
+        {
+            {
+                // Nothing is adjusted while playback is stopped.
+                CacheController controller;
+                Reader reader(controller);
+                TLRENDER_ASSERT(!reader.update(12, .1, 0.0, 0.0, true));
+                TLRENDER_ASSERT(16 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(4.0 == controller.getReadAhead());
+                TLRENDER_ASSERT(24.0 == controller.getVideoThroughput());
+                TLRENDER_ASSERT(std::abs(controller.getVideoLatency() - .1) < .000001);
+            }
+            {
+                // A fast reader with a full cache reduces the request count
+                // and the read ahead.
+                CacheController controller;
+                Reader reader(controller);
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    reader.update(12, .02, 24.0, controller.getReadAhead());
+                }
+                _print(string::Format("Fast reader: {0} requests, {1} read ahead").
+                    arg(controller.getVideoRequestCount()).
+                    arg(controller.getReadAhead()));
+                TLRENDER_ASSERT(2 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(.5 == controller.getReadAhead());
+
+                // A stall doubles the read ahead.
+                TLRENDER_ASSERT(reader.update(12, .02, 24.0, 0.0, true));
+                TLRENDER_ASSERT(1.0 == controller.getReadAhead());
+            }
+            {
+                // A slow reader that is falling behind increases the
+                // request count.
+                CacheController controller;
+                CacheControllerOptions options;
+                options.videoRequestCount = math::SizeTRange(1, 4);
+                controller.setOptions(options);
+                options.videoRequestCount = math::SizeTRange(1, 16);
+                controller.setOptions(options);
+                Reader reader(controller);
+                TLRENDER_ASSERT(reader.update(4, .5, 24.0, 0.0));
+                TLRENDER_ASSERT(5 == controller.getVideoRequestCount());
+                TLRENDER_ASSERT(reader.update(5, .5, 24.0, 0.0));
+                TLRENDER_ASSERT(6 == controller.getVideoRequestCount());
+
+                // The latency rising without the throughput improving
+                // halves the request count.
+                TLRENDER_ASSERT(reader.update(5, 1.0, 24.0, 0.0));
+                TLRENDER_ASSERT(3 == controller.getVideoRequestCount());
+            }
+        }
+    }
+}
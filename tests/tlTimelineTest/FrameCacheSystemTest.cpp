@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/FrameCacheSystemTest.h>
+
+#include <tlTimeline/FrameCacheSystem.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        FrameCacheSystemTest::FrameCacheSystemTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::FrameCacheSystemTest", context)
+        {}
+
+        std::shared_ptr<FrameCacheSystemTest> FrameCacheSystemTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<FrameCacheSystemTest>(new FrameCacheSystemTest(context));
+        }
+
+        void FrameCacheSystemTest::run()
+        {
+            _key();
+            _cache();
+            _budget();
+            _clients();
+        }
+
+        namespace
+        {
+            const size_t frameByteCount = 16 * 9 * 4;
+
+            std::shared_ptr<image::Image> frame()
+            {
+                return image::Image::create(16, 9, image::PixelType::RGBA_U8);
+            }
+
+            std::string key(size_t frame)
+            {
+                return getFrameCacheKey(
+                    file::Path("render.exr"),
+                    otime::RationalTime(frame, 24.0),
+                    0,
+                    io::Options());
+            }
+        }
+
+        void FrameCacheSystemTest::_key()
+        {
+            const file::Path path("render.exr");
+            const otime::RationalTime time(1.0, 24.0);
+            io::Options options;
+            const std::string key = getFrameCacheKey(path, time, 0, options);
+            _print(string::Format("Key: {0}").arg(key));
+            TLRENDER_ASSERT(key == getFrameCacheKey(path, time, 0, options));
+            TLRENDER_ASSERT(key != getFrameCacheKey(file::Path("comp.exr"), time, 0, options));
+            TLRENDER_ASSERT(key != getFrameCacheKey(path, otime::RationalTime(2.0, 24.0), 0, options));
+            TLRENDER_ASSERT(key != getFrameCacheKey(path, time, 1, options));
+            options["FFmpeg/YUVToRGBConversion"] = "1";
+            TLRENDER_ASSERT(key != getFrameCacheKey(path, time, 0, options));
+
+            // Test that the key changes when the file changes.
+            const std::string dir = file::createTempDir();
+            const file::Path moviePath(dir, "render.mov");
+            file::writeLines(moviePath.get(), { "render" });
+            const std::string movieKey = getFrameCacheKey(moviePath, time, 0, options);
+            TLRENDER_ASSERT(movieKey == getFrameCacheKey(moviePath, time, 0, options));
+            file::writeLines(moviePath.get(), { "render", "render" });
+            TLRENDER_ASSERT(movieKey != getFrameCacheKey(moviePath, time, 0, options));
+
+            // Test that image sequences use the file of each frame.
+            const file::Path sequencePath(dir, "render.0001.exr");
+            file::writeLines(sequencePath.get(1), { "render" });
+            file::writeLines(sequencePath.get(2), { "render" });
+            const otime::RationalTime time2(2.0, 24.0);
+            const std::string key1 = getFrameCacheKey(sequencePath, time, 0, options);
+            const std::string key2 = getFrameCacheKey(sequencePath, time2, 0, options);
+            file::writeLines(sequencePath.get(2), { "render", "render" });
+            TLRENDER_ASSERT(key1 == getFrameCacheKey(sequencePath, time, 0, options));
+            TLRENDER_ASSERT(key2 != getFrameCacheKey(sequencePath, time2, 0, options));
+        }
+
+        void FrameCacheSystemTest::_cache()
+        {
+            auto frameCache = FrameCacheSystem::create(_context);
+            const uint64_t client0 = frameCache->addClient();
+            const uint64_t client1 = frameCache->addClient();
+            TLRENDER_ASSERT(client0 != client1);
+            TLRENDER_ASSERT(2 == frameCache->getClientCount());
+
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(!frameCache->get(key(0), client0, image));
+            auto image0 = frame();
+            frameCache->add(key(0), client0, image0);
+            TLRENDER_ASSERT(1 == frameCache->getCount());
+            TLRENDER_ASSERT(frameByteCount == frameCache->getSize());
+            TLRENDER_ASSERT(frameByteCount == frameCache->getClientSize(client0));
+            TLRENDER_ASSERT(0 == frameCache->getClientSize(client1));
+
+            // Frames used by more than one client are stored once, and
+            // charged equally to the clients.
+            TLRENDER_ASSERT(frameCache->get(key(0), client1, image));
+            TLRENDER_ASSERT(image0 == image);
+            frameCache->add(key(0), client1, frame());
+            TLRENDER_ASSERT(1 == frameCache->getCount());
+            TLRENDER_ASSERT(frameByteCount == frameCache->getSize());
+            TLRENDER_ASSERT(frameByteCount / 2 == frameCache->getClientSize(client0));
+            TLRENDER_ASSERT(frameByteCount / 2 == frameCache->getClientSize(client1));
+
+            // Frames from unknown clients are not added.
+            frameCache->add(key(1), client1 + 1, frame());
+            TLRENDER_ASSERT(1 == frameCache->getCount());
+
+            frameCache->clear();
+            TLRENDER_ASSERT(0 == frameCache->getCount());
+            TLRENDER_ASSERT(0 == frameCache->getSize());
+            TLRENDER_ASSERT(0 == frameCache->getClientSize(client0));
+        }
+
+        void FrameCacheSystemTest::_budget()
+        {
+            auto frameCache = FrameCacheSystem::create(_context);
+            frameCache->setMax(frameByteCount * 10);
+            TLRENDER_ASSERT(frameByteCount * 10 == frameCache->getMax());
+            const uint64_t client0 = frameCache->addClient();
+            const uint64_t client1 = frameCache->addClient();
+
+            // The first client can use the whole cache while it is the
+            // only one using it.
+            for (size_t i = 0; i < 20; ++i)
+            {
+                frameCache->add(key(i), client0, frame());
+            }
+            TLRENDER_ASSERT(10 == frameCache->getCount());
+            TLRENDER_ASSERT(frameByteCount * 10 == frameCache->getClientSize(client0));
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(!frameCache->get(key(0), client0, image));
+            TLRENDER_ASSERT(frameCache->get(key(19), client0, image));
+
+            // Frames are removed from the first client until both clients
+            // have an equal share.
+            for (size_t i = 100; i < 120; ++i)
+            {
+                frameCache->add(key(i), client1, frame());
+            }
+            TLRENDER_ASSERT(10 == frameCache->getCount());
+            TLRENDER_ASSERT(frameByteCount * 5 == frameCache->getClientSize(client0));
+            TLRENDER_ASSERT(frameByteCount * 5 == frameCache->getClientSize(client1));
+            TLRENDER_ASSERT(frameCache->get(key(19), client0, image));
+            TLRENDER_ASSERT(frameCache->get(key(119), client1, image));
+
+            // Frames larger than the cache are not added.
+            frameCache->setMax(frameByteCount / 2);
+            TLRENDER_ASSERT(0 == frameCache->getCount());
+            frameCache->add(key(0), client0, frame());
+            TLRENDER_ASSERT(0 == frameCache->getCount());
+
+            // A size of zero disables the cache.
+            frameCache->setMax(0);
+            frameCache->add(key(0), client0, frame());
+            TLRENDER_ASSERT(0 == frameCache->getCount());
+            TLRENDER_ASSERT(0 == frameCache->getSize());
+        }
+
+        void FrameCacheSystemTest::_clients()
+        {
+            auto frameCache = FrameCacheSystem::create(_context);
+            const uint64_t client0 = frameCache->addClient();
+            const uint64_t client1 = frameCache->addClient();
+            frameCache->add(key(0), client0, frame());
+            frameCache->add(key(1), client0, frame());
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(frameCache->get(key(1), client1, image));
+
+            // Removing a client removes the frames only it was using.
+            frameCache->removeClient(client0);
+            TLRENDER_ASSERT(1 == frameCache->getClientCount());
+            TLRENDER_ASSERT(1 == frameCache->getCount());
+            TLRENDER_ASSERT(!frameCache->get(key(0), client1, image));
+            TLRENDER_ASSERT(frameCache->get(key(1), client1, image));
+            TLRENDER_ASSERT(frameByteCount == frameCache->getClientSize(client1));
+            TLRENDER_ASSERT(0 == frameCache->getClientSize(client0));
+
+            frameCache->removeClient(client1);
+            TLRENDER_ASSERT(0 == frameCache->getClientCount());
+            TLRENDER_ASSERT(0 == frameCache->getCount());
+            TLRENDER_ASSERT(0 == frameCache->getSize());
+        }
+    }
+}
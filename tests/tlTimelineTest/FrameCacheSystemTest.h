@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class FrameCacheSystemTest : public tests::ITest
+        {
+        protected:
+            FrameCacheSystemTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<FrameCacheSystemTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _key();
+            void _cache();
+            void _budget();
+            void _clients();
+        };
+    }
+}
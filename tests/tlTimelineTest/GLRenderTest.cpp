@@ -0,0 +1,389 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/GLRenderTest.h>
+
+#include <tlTimeline/GLRenderPrivate.h>
+
+#include <tlGL/OffscreenContext.h>
+
+#include <tlCore/Assert.h>
+
+#include <tlGlad/gl.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        GLRenderTest::GLRenderTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::GLRenderTest", context)
+        {}
+
+        std::shared_ptr<GLRenderTest> GLRenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<GLRenderTest>(new GLRenderTest(context));
+        }
+
+        void GLRenderTest::run()
+        {
+            std::shared_ptr<gl::OffscreenContext> glContext;
+            try
+            {
+                glContext = gl::OffscreenContext::create(_context);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+                return;
+            }
+            _textureCache();
+            _imageUploads();
+            _pixelBufferRing();
+            _batches();
+        }
+
+        void GLRenderTest::_textureCache()
+        {
+            const image::Info info(16, 12, image::PixelType::RGBA_U8);
+            const size_t byteCount = image::getDataByteCount(info);
+            const ImageFilters imageFilters;
+            {
+                // Drawing the same image again re-uses the textures.
+                TextureCache cache;
+                cache.setMax(byteCount * 4);
+                cache.begin();
+                auto image = image::Image::create(info);
+                bool upload = false;
+                auto textures = cache.get(image, imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(!textures.empty());
+                cache.add(image, imageFilters, textures);
+                TLRENDER_ASSERT(byteCount == cache.getByteCount());
+                auto textures2 = cache.get(image, imageFilters, upload);
+                TLRENDER_ASSERT(!upload);
+                TLRENDER_ASSERT(textures == textures2);
+                cache.add(image, imageFilters, textures2);
+
+                // Different filters need different textures.
+                ImageFilters imageFilters2;
+                imageFilters2.magnify = ImageFilter::Nearest;
+                auto textures3 = cache.get(image, imageFilters2, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures3 != textures);
+            }
+            {
+                // The textures of destroyed images are recycled for images
+                // with the same information.
+                TextureCache cache;
+                cache.setMax(byteCount * 4);
+                cache.begin();
+                auto image = image::Image::create(info);
+                bool upload = false;
+                auto textures = cache.get(image, imageFilters, upload);
+                cache.add(image, imageFilters, textures);
+                image.reset();
+                auto image2 = image::Image::create(info);
+                auto textures2 = cache.get(image2, imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures == textures2);
+                TLRENDER_ASSERT(0 == cache.getByteCount());
+                cache.add(image2, imageFilters, textures2);
+
+                // Images with different information are not recycled.
+                image2.reset();
+                auto image3 = image::Image::create(image::Info(8, 6, image::PixelType::RGBA_U8));
+                auto textures3 = cache.get(image3, imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures3 != textures);
+            }
+            {
+                // The textures of images that are still alive are only
+                // recycled when they were not drawn in the current render.
+                TextureCache cache;
+                cache.setMax(byteCount * 4);
+                cache.begin();
+                auto image = image::Image::create(info);
+                bool upload = false;
+                auto textures = cache.get(image, imageFilters, upload);
+                cache.add(image, imageFilters, textures);
+                auto image2 = image::Image::create(info);
+                auto textures2 = cache.get(image2, imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures2 != textures);
+                cache.add(image2, imageFilters, textures2);
+                cache.begin();
+                auto image3 = image::Image::create(info);
+                auto textures3 = cache.get(image3, imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures3 == textures);
+            }
+            {
+                // The least recently used textures are removed when the
+                // cache is over the byte budget.
+                TextureCache cache;
+                cache.setMax(byteCount * 2);
+                cache.begin();
+                std::vector<std::shared_ptr<image::Image> > images;
+                std::vector<std::vector<std::shared_ptr<gl::Texture> > > textures;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    images.push_back(image::Image::create(info));
+                    bool upload = false;
+                    textures.push_back(cache.get(images.back(), imageFilters, upload));
+                    TLRENDER_ASSERT(upload);
+                    cache.add(images.back(), imageFilters, textures.back());
+                    TLRENDER_ASSERT(cache.getByteCount() <= byteCount * 2);
+                }
+                TLRENDER_ASSERT(byteCount * 2 == cache.getByteCount());
+                bool upload = false;
+                auto textures2 = cache.get(images[2], imageFilters, upload);
+                TLRENDER_ASSERT(!upload);
+                cache.add(images[2], imageFilters, textures2);
+                textures2 = cache.get(images[1], imageFilters, upload);
+                TLRENDER_ASSERT(!upload);
+                cache.add(images[1], imageFilters, textures2);
+                textures2 = cache.get(images[0], imageFilters, upload);
+                TLRENDER_ASSERT(upload);
+                TLRENDER_ASSERT(textures2 != textures[0]);
+
+                cache.setMax(0);
+                TLRENDER_ASSERT(0 == cache.getByteCount());
+            }
+        }
+
+        void GLRenderTest::_imageUploads()
+        {
+            auto render = GLRender::create(_context);
+            const image::Size size(64, 48);
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, offscreenBufferOptions);
+            gl::OffscreenBufferBinding binding(buffer);
+            auto image = image::Image::create(image::Info(16, 12, image::PixelType::RGBA_U8));
+            image->zero();
+            {
+                // The image is only uploaded the first time it is drawn.
+                render->begin(size);
+                render->drawImage(image, math::Box2i(0, 0, 32, 24));
+                render->drawImage(image, math::Box2i(32, 24, 32, 24));
+                render->end();
+                const auto stats = render->getStats();
+                TLRENDER_ASSERT(2 == stats.images);
+                TLRENDER_ASSERT(1 == stats.imageUploads);
+            }
+            {
+                render->begin(size);
+                render->drawImage(image, math::Box2i(0, 0, 32, 24));
+                render->end();
+                const auto stats = render->getStats();
+                TLRENDER_ASSERT(1 == stats.images);
+                TLRENDER_ASSERT(0 == stats.imageUploads);
+            }
+            {
+                // New images are uploaded.
+                auto image2 = image::Image::create(image->getInfo());
+                image2->zero();
+                render->begin(size);
+                render->drawImage(image, math::Box2i(0, 0, 32, 24));
+                render->drawImage(image2, math::Box2i(32, 24, 32, 24));
+                render->end();
+                const auto stats = render->getStats();
+                TLRENDER_ASSERT(2 == stats.images);
+                TLRENDER_ASSERT(1 == stats.imageUploads);
+            }
+        }
+
+        void GLRenderTest::_pixelBufferRing()
+        {
+            auto render = GLRender::create(_context);
+            const image::Size size(16, 12);
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, offscreenBufferOptions);
+            gl::OffscreenBufferBinding binding(buffer);
+            const image::Info info(size, image::PixelType::RGBA_U8);
+            const size_t byteCount = image::getDataByteCount(info);
+            auto fill = [](const std::shared_ptr<image::Image>& image, uint8_t value)
+            {
+                uint8_t* data = image->getData();
+                for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                {
+                    data[i] = 3 == i % 4 ? 255 : value;
+                }
+            };
+            auto draw = [render, size](
+                const std::shared_ptr<image::Image>& image,
+                const RenderOptions& renderOptions)
+            {
+                render->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                render->drawImage(image, math::Box2i(0, 0, size.w, size.h));
+                render->end();
+                std::vector<uint8_t> data(size.w * size.h * 4);
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(0, 0, size.w, size.h, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+                return 0 == memcmp(data.data(), image->getData(), data.size());
+            };
+
+            // The ring is disabled by default.
+            RenderOptions renderOptions;
+            auto image = image::Image::create(info);
+            fill(image, 255);
+            TLRENDER_ASSERT(draw(image, renderOptions));
+            TLRENDER_ASSERT(!render->getPixelBufferRing());
+
+            renderOptions.pixelBufferRingByteCount = byteCount;
+            TLRENDER_ASSERT(draw(image, renderOptions));
+            std::weak_ptr<gl::PixelBufferRing> ringWeak = render->getPixelBufferRing();
+            if (auto ring = ringWeak.lock())
+            {
+                // Draw an image created in the ring.
+                auto ringImage = ring->createImage(info);
+                TLRENDER_ASSERT(ringImage);
+                fill(ringImage, 127);
+                TLRENDER_ASSERT(draw(ringImage, renderOptions));
+
+                // Images that do not fit in the ring use the texture pixel
+                // buffers.
+                auto image2 = image::Image::create(image::Info(size.w * 2, size.h, info.pixelType));
+                fill(image2, 63);
+                render->begin(size, ColorConfigOptions(), LUTOptions(), renderOptions);
+                render->drawImage(image2, math::Box2i(0, 0, size.w, size.h));
+                render->end();
+                std::vector<uint8_t> data(byteCount);
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(0, 0, size.w, size.h, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+                TLRENDER_ASSERT(63 == data[0]);
+
+                // Changing the size of the ring keeps the old ring until
+                // its images are destroyed. The images can be released on
+                // another thread, and the old ring is destroyed on the
+                // render thread.
+                ring.reset();
+                renderOptions.pixelBufferRingByteCount = byteCount * 2;
+                TLRENDER_ASSERT(draw(ringImage, renderOptions));
+                TLRENDER_ASSERT(render->getPixelBufferRing() != ringWeak.lock());
+                TLRENDER_ASSERT(!ringWeak.expired());
+                std::thread(
+                    [&ringImage]
+                    {
+                        ringImage.reset();
+                    }).join();
+                TLRENDER_ASSERT(!ringWeak.expired());
+                TLRENDER_ASSERT(draw(image, renderOptions));
+                TLRENDER_ASSERT(ringWeak.expired());
+            }
+        }
+
+        void GLRenderTest::_batches()
+        {
+            auto render = GLRender::create(_context);
+            const image::Size size(16, 12);
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, offscreenBufferOptions);
+            auto buffer2 = gl::OffscreenBuffer::create(size, offscreenBufferOptions);
+            geom::TriangleMesh2 mesh;
+            mesh.v.push_back(math::Vector2f(0.F, 0.F));
+            mesh.v.push_back(math::Vector2f(4.F, 0.F));
+            mesh.v.push_back(math::Vector2f(4.F, 4.F));
+            mesh.c.push_back(math::Vector4f(1.F, 1.F, 1.F, 1.F));
+            geom::Triangle2 triangle;
+            triangle.v[0].v = 1;
+            triangle.v[1].v = 2;
+            triangle.v[2].v = 3;
+            triangle.v[0].c = 1;
+            triangle.v[1].c = 1;
+            triangle.v[2].c = 1;
+            mesh.triangles.push_back(triangle);
+            auto getPixel = [size](int x, int y)
+            {
+                std::vector<uint8_t> data(4);
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(x, size.h - 1 - y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+                return data;
+            };
+            {
+                // Consecutive rectangles and meshes are drawn with a single
+                // call.
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 4, 4), image::Color4f(1.F, 0.F, 0.F));
+                render->drawRect(math::Box2i(4, 0, 4, 4), image::Color4f(0.F, 1.F, 0.F));
+                render->drawMesh(mesh, math::Vector2i(8, 0), image::Color4f(0.F, 0.F, 1.F));
+                render->drawColorMesh(mesh, math::Vector2i(12, 0), image::Color4f(1.F, 1.F, 1.F));
+                render->end();
+                const auto stats = render->getStats();
+                TLRENDER_ASSERT(2 == stats.rects);
+                TLRENDER_ASSERT(2 == stats.meshes);
+                TLRENDER_ASSERT(1 == stats.drawCalls);
+            }
+            {
+                // Changing the clipping rectangle flushes the batch.
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 4, 4), image::Color4f(1.F, 0.F, 0.F));
+                render->setClipRectEnabled(true);
+                render->setClipRect(math::Box2i(0, 0, 8, 8));
+                render->drawRect(math::Box2i(4, 0, 4, 4), image::Color4f(0.F, 1.F, 0.F));
+                render->drawRect(math::Box2i(4, 4, 4, 4), image::Color4f(0.F, 1.F, 0.F));
+                render->setClipRectEnabled(false);
+                render->end();
+                TLRENDER_ASSERT(2 == render->getStats().drawCalls);
+            }
+            {
+                // Changing the transform flushes the batch.
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 4, 4), image::Color4f(1.F, 0.F, 0.F));
+                render->setTransform(math::ortho(
+                    0.F,
+                    static_cast<float>(size.w),
+                    static_cast<float>(size.h),
+                    0.F,
+                    -1.F,
+                    1.F));
+                render->drawRect(math::Box2i(4, 0, 4, 4), image::Color4f(0.F, 1.F, 0.F));
+                render->end();
+                TLRENDER_ASSERT(2 == render->getStats().drawCalls);
+            }
+            {
+                // Batches are drawn to the framebuffer that was bound when
+                // they were started, and changing the framebuffer flushes
+                // the batch.
+                {
+                    gl::OffscreenBufferBinding binding2(buffer2);
+                    glClearColor(0.F, 0.F, 0.F, 0.F);
+                    glClear(GL_COLOR_BUFFER_BIT);
+                }
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 4, 4), image::Color4f(1.F, 0.F, 0.F));
+                {
+                    gl::OffscreenBufferBinding binding2(buffer2);
+                    TLRENDER_ASSERT(buffer2->getID() == gl::getFramebufferBinding());
+                    render->drawRect(math::Box2i(4, 0, 4, 4), image::Color4f(0.F, 1.F, 0.F));
+                }
+                TLRENDER_ASSERT(buffer->getID() == gl::getFramebufferBinding());
+                render->end();
+                TLRENDER_ASSERT(2 == render->getStats().drawCalls);
+                auto pixel = getPixel(0, 0);
+                TLRENDER_ASSERT(255 == pixel[0] && 0 == pixel[1]);
+                pixel = getPixel(4, 0);
+                TLRENDER_ASSERT(0 == pixel[0] && 0 == pixel[1]);
+                {
+                    gl::OffscreenBufferBinding binding2(buffer2);
+                    pixel = getPixel(0, 0);
+                    TLRENDER_ASSERT(0 == pixel[0] && 0 == pixel[1]);
+                    pixel = getPixel(4, 0);
+                    TLRENDER_ASSERT(0 == pixel[0] && 255 == pixel[1]);
+                }
+            }
+        }
+    }
+}
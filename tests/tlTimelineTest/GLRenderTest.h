@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class GLRenderTest : public tests::ITest
+        {
+        protected:
+            GLRenderTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<GLRenderTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _textureCache();
+            void _imageUploads();
+            void _pixelBufferRing();
+            void _batches();
+        };
+    }
+}
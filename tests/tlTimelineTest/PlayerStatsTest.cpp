@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/PlayerStatsTest.h>
+
+#include <tlTimeline/PlayerStats.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        PlayerStatsTest::PlayerStatsTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::PlayerStatsTest", context)
+        {}
+
+        std::shared_ptr<PlayerStatsTest> PlayerStatsTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<PlayerStatsTest>(new PlayerStatsTest(context));
+        }
+
+        void PlayerStatsTest::run()
+        {
+            {
+                TLRENDER_ASSERT(0 == getLatencyBucket(0.0));
+                TLRENDER_ASSERT(0 == getLatencyBucket(.5));
+                TLRENDER_ASSERT(1 == getLatencyBucket(1.0));
+                TLRENDER_ASSERT(2 == getLatencyBucket(3.0));
+                TLRENDER_ASSERT(6 == getLatencyBucket(40.0));
+                TLRENDER_ASSERT(latencyHistogramSize - 1 == getLatencyBucket(1000000.0));
+            }
+            {
+                PlayerStats a;
+                PlayerStats b;
+                TLRENDER_ASSERT(a == b);
+                TLRENDER_ASSERT(latencyHistogramSize == a.videoLatency.size());
+                a.videoCacheMisses = 1;
+                TLRENDER_ASSERT(a != b);
+            }
+            {
+                PlayerStats value;
+                value.videoLatency[getLatencyBucket(40.0)] = 24;
+                value.videoCacheHits = 24;
+                value.droppedFrames = 2;
+                value.readBytesPerSecond["render.exr"] = 1024.0;
+                value.audioUnderruns = 1;
+                nlohmann::json json;
+                to_json(json, value);
+                _print(json.dump());
+                TLRENDER_ASSERT(24 == json.at("videoLatency").at(6).get<size_t>());
+                TLRENDER_ASSERT(24 == json.at("videoCacheHits").get<size_t>());
+                TLRENDER_ASSERT(2 == json.at("droppedFrames").get<size_t>());
+                TLRENDER_ASSERT(1024.0 == json.at("readBytesPerSecond").at("render.exr").get<double>());
+                TLRENDER_ASSERT(1 == json.at("audioUnderruns").get<size_t>());
+            }
+        }
+    }
+}
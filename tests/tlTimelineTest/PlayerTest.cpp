@@ -5,16 +5,23 @@
 #include <tlTimelineTest/PlayerTest.h>
 
 #include <tlTimeline/Player.h>
+#include <tlTimeline/PlayerAudio.h>
+#include <tlTimeline/PlayerDrop.h>
 #include <tlTimeline/Util.h>
 
 #include <tlIO/IOSystem.h>
 
 #include <tlCore/Assert.h>
 
+#include <tlTestLib/AllocationCheck.h>
+#include <tlTestLib/LockCheck.h>
+
 #include <opentimelineio/clip.h>
 #include <opentimelineio/timeline.h>
 #include <opentimelineio/imageSequenceReference.h>
 
+#include <mutex>
+#include <set>
 #include <sstream>
 
 using namespace tl::timeline;
@@ -36,6 +43,8 @@ namespace tl
         {
             _enums();
             _loop();
+            _audioOutput();
+            _drop();
             _player();
         }
 
@@ -81,6 +90,201 @@ namespace tl
             }
         }
 
+        void PlayerTest::_audioOutput()
+        {
+            const audio::Info info(2, audio::DataType::F32, 48000);
+            PlayerAudio audio;
+            audio.info = info;
+            audio.buffer = audio::AudioRingBuffer::create(info, 1000);
+            audio.playback = Playback::Forward;
+            audio.speed = 24.0;
+            audio.volume = .5F;
+            const std::vector<float> in(1000 * 2, 1.F);
+            const uint8_t* inP = reinterpret_cast<const uint8_t*>(in.data());
+            audio.buffer->write(inP, 1000);
+            std::vector<float> out(1000 * 2, -1.F);
+            auto outputEquals = [&out](size_t nFrames, float value)
+            {
+                bool equal = true;
+                for (size_t i = 0; i < nFrames * 2; ++i)
+                {
+                    equal &= value == out[i];
+                }
+                return equal;
+            };
+
+            // The volume is applied to the output and the callback does not
+            // allocate memory or take locks, so it cannot block on the
+            // player mutex.
+            {
+                tests::AllocationCheck allocationCheck;
+                tests::LockCheck lockCheck;
+                audio.output(out.data(), 100, 24.0);
+                TLRENDER_ASSERT(0 == allocationCheck.getCount());
+                TLRENDER_ASSERT(0 == lockCheck.getCount());
+            }
+            if (tests::isLockCheckSupported())
+            {
+                // Check that locks are counted, so the check above can
+                // fail.
+                std::mutex mutex;
+                tests::LockCheck lockCheck;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                }
+                TLRENDER_ASSERT(1 == lockCheck.getCount());
+            }
+            TLRENDER_ASSERT(outputEquals(100, .5F));
+            TLRENDER_ASSERT(900 == audio.buffer->getReadAvailable());
+
+            // Muted audio is consumed but not output.
+            audio.mute = true;
+            audio.output(out.data(), 100, 24.0);
+            TLRENDER_ASSERT(outputEquals(100, 0.F));
+            TLRENDER_ASSERT(800 == audio.buffer->getReadAvailable());
+            audio.mute = false;
+
+            // Audio is not output when the speed does not match the
+            // timeline.
+            audio.output(out.data(), 100, 30.0);
+            TLRENDER_ASSERT(outputEquals(100, 0.F));
+            TLRENDER_ASSERT(700 == audio.buffer->getReadAvailable());
+
+            // Audio is not consumed when playback is stopped.
+            audio.playback = Playback::Stop;
+            audio.output(out.data(), 100, 24.0);
+            TLRENDER_ASSERT(outputEquals(100, 0.F));
+            TLRENDER_ASSERT(700 == audio.buffer->getReadAvailable());
+            audio.playback = Playback::Forward;
+
+            // The frames missed by an underrun are discarded when the audio
+            // arrives.
+            audio.output(out.data(), 800, 24.0);
+            TLRENDER_ASSERT(outputEquals(800, 0.F));
+            TLRENDER_ASSERT(1 == audio.underruns);
+            TLRENDER_ASSERT(800 == audio.dropCount);
+            audio.buffer->write(inP, 300);
+            audio.volume = 2.F;
+            audio.output(out.data(), 100, 24.0);
+            TLRENDER_ASSERT(outputEquals(100, 2.F));
+            TLRENDER_ASSERT(0 == audio.dropCount);
+            TLRENDER_ASSERT(100 == audio.buffer->getReadAvailable());
+
+            // A pending reset outputs silence until the flush.
+            audio.reset = 1;
+            audio.output(out.data(), 100, 24.0);
+            TLRENDER_ASSERT(outputEquals(100, 0.F));
+            TLRENDER_ASSERT(100 == audio.buffer->getReadAvailable());
+            audio.flush = 1;
+            {
+                tests::LockCheck lockCheck;
+                audio.output(out.data(), 100, 24.0);
+                TLRENDER_ASSERT(0 == lockCheck.getCount());
+            }
+            TLRENDER_ASSERT(outputEquals(100, 0.F));
+            TLRENDER_ASSERT(1 == audio.flushAck);
+            TLRENDER_ASSERT(0 == audio.buffer->getReadAvailable());
+        }
+
+        void PlayerTest::_drop()
+        {
+            // Test the drop stride.
+            PlayerDrop drop;
+            for (int64_t i = -3; i <= 3; ++i)
+            {
+                TLRENDER_ASSERT(drop.isStride(otime::RationalTime(i, 24.0)));
+            }
+            drop.stride = 3;
+            TLRENDER_ASSERT(drop.isStride(otime::RationalTime(0.0, 24.0)));
+            TLRENDER_ASSERT(!drop.isStride(otime::RationalTime(1.0, 24.0)));
+            TLRENDER_ASSERT(!drop.isStride(otime::RationalTime(2.0, 24.0)));
+            TLRENDER_ASSERT(drop.isStride(otime::RationalTime(3.0, 24.0)));
+            TLRENDER_ASSERT(!drop.isStride(otime::RationalTime(-1.0, 24.0)));
+            TLRENDER_ASSERT(drop.isStride(otime::RationalTime(-3.0, 24.0)));
+
+            // Test which frames are requested. Frames are skipped when
+            // they are not at the stride, or when they are closer to the
+            // current time than the lead. Frames past the read behind wrap
+            // around the in/out range.
+            drop.stride = 2;
+            const otime::RationalTime currentTime(10.0, 24.0);
+            const double lead = 3.0;
+            const double readBehind = 5.0;
+            const double inOutDuration = 24.0;
+            for (const auto& i : std::vector<std::pair<CacheDirection, std::vector<int64_t> > >({
+                { CacheDirection::Forward, { 0, 2, 4, 14, 16, 18, 20, 22 } },
+                { CacheDirection::Reverse, { 0, 2, 4, 6, 16, 18, 20, 22 } } }))
+            {
+                std::vector<int64_t> frames;
+                for (int64_t frame = 0; frame < 24; ++frame)
+                {
+                    if (drop.isRequest(
+                        otime::RationalTime(frame, 24.0),
+                        currentTime,
+                        i.first,
+                        lead,
+                        readBehind,
+                        inOutDuration))
+                    {
+                        frames.push_back(frame);
+                    }
+                }
+                TLRENDER_ASSERT(i.second == frames);
+            }
+
+            // Test the dropped frame count. Each frame is only counted
+            // once, and the frames at the stride are late.
+            size_t droppedFrames = 0;
+            for (int64_t frame = 0; frame < 8; ++frame)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    if (drop.drop(otime::RationalTime(frame, 24.0)))
+                    {
+                        ++droppedFrames;
+                    }
+                }
+            }
+            TLRENDER_ASSERT(8 == droppedFrames);
+            TLRENDER_ASSERT(4 == drop.lateFrames);
+
+            // Test that late frames increase the stride.
+            drop.update(24.0, 0.0, 0.0, 1.0);
+            TLRENDER_ASSERT(3 == drop.stride);
+            TLRENDER_ASSERT(0 == drop.lateFrames);
+            TLRENDER_ASSERT(drop.drop(otime::RationalTime(9.0, 24.0)));
+            TLRENDER_ASSERT(1 == drop.lateFrames);
+            drop.update(24.0, 4.0, 0.0, 1.0);
+            TLRENDER_ASSERT(6 == drop.stride);
+
+            // Test that the stride is limited by the playback speed.
+            TLRENDER_ASSERT(drop.drop(otime::RationalTime(12.0, 24.0)));
+            drop.update(4.0, .5, 0.0, 1.0);
+            TLRENDER_ASSERT(4 == drop.stride);
+
+            // Test that the stride is decreased after enough of the read
+            // ahead has been cached for a while.
+            for (size_t i = 0; i < 8; ++i)
+            {
+                drop.update(24.0, 0.0, .4, 1.0);
+            }
+            TLRENDER_ASSERT(4 == drop.stride);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                drop.update(24.0, 0.0, .5, 1.0);
+            }
+            TLRENDER_ASSERT(4 == drop.stride);
+            drop.update(24.0, 0.0, .5, 1.0);
+            TLRENDER_ASSERT(3 == drop.stride);
+
+            // Test that frames that are not at the stride are not late.
+            TLRENDER_ASSERT(drop.drop(otime::RationalTime(13.0, 24.0)));
+            TLRENDER_ASSERT(0 == drop.lateFrames);
+
+            drop.reset();
+            TLRENDER_ASSERT(1 == drop.stride);
+        }
+
         void PlayerTest::_player()
         {
             // Write an OTIO timeline.
@@ -151,15 +355,21 @@ namespace tl
                 PlayerCacheOptions cache;
                 size_t requestCount = 16;
                 size_t requestTimeout = 1;
+                bool dropFrames = false;
             };
             FrameOptions frameOptions2;
             frameOptions2.layer = 1;
             frameOptions2.cache.readAhead = otime::RationalTime(1.0, 24.0);
             frameOptions2.cache.readBehind = otime::RationalTime(0.0, 1.0);
-            for (const auto options : std::vector<FrameOptions>({ FrameOptions(), frameOptions2 }))
+            FrameOptions frameOptions3;
+            frameOptions3.cache.adaptive = true;
+            frameOptions3.dropFrames = true;
+            for (const auto options : std::vector<FrameOptions>({ FrameOptions(), frameOptions2, frameOptions3 }))
             {
                 player->setCacheOptions(options.cache);
                 TLRENDER_ASSERT(options.cache == player->observeCacheOptions()->get());
+                player->setDropFrames(options.dropFrames);
+                TLRENDER_ASSERT(options.dropFrames == player->isDropFrames());
                 auto currentVideoObserver = observer::ValueObserver<timeline::VideoData>::create(
                     player->observeCurrentVideo(),
                     [this](const timeline::VideoData& value)
@@ -188,6 +398,29 @@ namespace tl
                             ss << "Video/audio cached frames: " << value.videoFrames.size() << "/" << value.audioFrames.size();
                             _print(ss.str());
                         }
+                        {
+                            std::stringstream ss;
+                            ss << "Video requests: " << value.videoRequestCount << ", read ahead: " << value.readAhead;
+                            _print(ss.str());
+                        }
+                    });
+                size_t droppedFrames = 0;
+                auto droppedFramesObserver = observer::ValueObserver<size_t>::create(
+                    player->observeDroppedFrames(),
+                    [this, &droppedFrames](size_t value)
+                    {
+                        droppedFrames = value;
+                        std::stringstream ss;
+                        ss << "Dropped frames: " << value;
+                        _print(ss.str());
+                    });
+                auto statsObserver = observer::ValueObserver<PlayerStats>::create(
+                    player->observeStats(),
+                    [this](const PlayerStats& value)
+                    {
+                        nlohmann::json json;
+                        to_json(json, value);
+                        _print("Stats: " + json.dump());
                     });
                 for (const auto& loop : getLoopEnums())
                 {
@@ -206,6 +439,45 @@ namespace tl
                     }
                 }
                 player->setPlayback(Playback::Stop);
+                if (!options.dropFrames)
+                {
+                    TLRENDER_ASSERT(0 == droppedFrames);
+                }
+            }
+            player->setDropFrames(false);
+
+            // Test the image allocator. The allocator is called on the cache
+            // thread, so the state is shared with it.
+            {
+                struct Allocations
+                {
+                    std::set<const uint8_t*> data;
+                    std::mutex mutex;
+                };
+                auto allocations = std::make_shared<Allocations>();
+                player->setImageAllocator(
+                    [allocations](const image::Info& info)
+                    {
+                        auto out = image::Image::create(info);
+                        std::unique_lock<std::mutex> lock(allocations->mutex);
+                        allocations->data.insert(out->getData());
+                        return out;
+                    });
+                player->seek(timeRange.start_time() + otime::RationalTime(1.0, 24.0));
+                bool allocated = false;
+                for (size_t i = 0; i < 100 && !allocated; ++i)
+                {
+                    player->tick();
+                    const auto& videoData = player->observeCurrentVideo()->get();
+                    if (!videoData.layers.empty() && videoData.layers[0].image)
+                    {
+                        std::unique_lock<std::mutex> lock(allocations->mutex);
+                        allocated = allocations->data.count(videoData.layers[0].image->getData()) > 0;
+                    }
+                    time::sleep(std::chrono::milliseconds(10));
+                }
+                TLRENDER_ASSERT(allocated);
+                player->setImageAllocator(nullptr);
             }
 
             // Test the playback speed.
@@ -245,6 +517,19 @@ namespace tl
             player->setLoop(Loop::Once);
             TLRENDER_ASSERT(Loop::Once == loop);
 
+            // Test dropping frames.
+            bool dropFrames = false;
+            auto dropFramesObserver = observer::ValueObserver<bool>::create(
+                player->observeDropFrames(),
+                [&dropFrames](bool value)
+                {
+                    dropFrames = value;
+                });
+            player->setDropFrames(true);
+            TLRENDER_ASSERT(dropFrames);
+            player->setDropFrames(false);
+            TLRENDER_ASSERT(!dropFrames);
+
             // Test the current time.
             player->setPlayback(Playback::Stop);
             otime::RationalTime currentTime = time::invalidTime;
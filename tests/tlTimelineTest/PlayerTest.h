@@ -23,6 +23,8 @@ namespace tl
         private:
             void _enums();
             void _loop();
+            void _audioOutput();
+            void _drop();
             void _player();
         };
     }
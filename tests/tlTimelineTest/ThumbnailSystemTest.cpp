@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/ThumbnailSystemTest.h>
+
+#include <tlTimeline/ThumbnailSystem.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+
+#include <cstring>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        ThumbnailSystemTest::ThumbnailSystemTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::ThumbnailSystemTest", context)
+        {}
+
+        std::shared_ptr<ThumbnailSystemTest> ThumbnailSystemTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ThumbnailSystemTest>(new ThumbnailSystemTest(context));
+        }
+
+        void ThumbnailSystemTest::run()
+        {
+            _key();
+            _cache();
+            _directory();
+            _requests();
+        }
+
+        namespace
+        {
+            std::shared_ptr<image::Image> thumbnail(uint8_t value)
+            {
+                auto out = image::Image::create(16, 9, image::PixelType::RGBA_U8);
+                for (size_t i = 0; i < out->getDataByteCount(); ++i)
+                {
+                    out->getData()[i] = value + i % 7;
+                }
+                return out;
+            }
+
+            bool compare(
+                const std::shared_ptr<image::Image>& a,
+                const std::shared_ptr<image::Image>& b)
+            {
+                return a && b &&
+                    a->getInfo() == b->getInfo() &&
+                    0 == std::memcmp(a->getData(), b->getData(), a->getDataByteCount());
+            }
+        }
+
+        void ThumbnailSystemTest::_key()
+        {
+            const file::Path path("ThumbnailSystemTest.mov");
+            const otime::RationalTime time(0.0, 24.0);
+            const image::Size size(16, 9);
+            const std::string key = getThumbnailKey(path, time, 0, size);
+            _print(key);
+            TLRENDER_ASSERT(key == getThumbnailKey(path, time, 0, size));
+            TLRENDER_ASSERT(key != getThumbnailKey(file::Path("ThumbnailSystemTest.mp4"), time, 0, size));
+            TLRENDER_ASSERT(key != getThumbnailKey(path, otime::RationalTime(1.0, 24.0), 0, size));
+            TLRENDER_ASSERT(key != getThumbnailKey(path, time, 1, size));
+            TLRENDER_ASSERT(key != getThumbnailKey(path, time, 0, image::Size(32, 18)));
+            TLRENDER_ASSERT(key == getThumbnailKey(path, time, 0, size, ColorConfigOptions(), LUTOptions()));
+            ColorConfigOptions colorConfigOptions;
+            colorConfigOptions.fileName = "config.ocio";
+            TLRENDER_ASSERT(key == getThumbnailKey(path, time, 0, size, colorConfigOptions));
+            colorConfigOptions.enabled = true;
+            TLRENDER_ASSERT(key != getThumbnailKey(path, time, 0, size, colorConfigOptions));
+            LUTOptions lutOptions;
+            lutOptions.enabled = true;
+            lutOptions.fileName = "lut.cube";
+            TLRENDER_ASSERT(key != getThumbnailKey(path, time, 0, size, ColorConfigOptions(), lutOptions));
+        }
+
+        void ThumbnailSystemTest::_cache()
+        {
+            auto system = _context->getSystem<ThumbnailSystem>();
+            TLRENDER_ASSERT(system);
+            system->setDirectory(std::string());
+            system->clear();
+
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(!system->get("a", image));
+            const auto a = thumbnail(0);
+            system->add("a", a);
+            TLRENDER_ASSERT(system->get("a", image));
+            TLRENDER_ASSERT(image == a);
+            TLRENDER_ASSERT(system->getSize() == a->getDataByteCount());
+
+            const size_t max = system->getMax();
+            system->setMax(a->getDataByteCount());
+            TLRENDER_ASSERT(a->getDataByteCount() == system->getMax());
+            const auto b = thumbnail(1);
+            system->add("b", b);
+            TLRENDER_ASSERT(!system->get("a", image));
+            TLRENDER_ASSERT(system->get("b", image));
+            system->setMax(max);
+
+            system->clear();
+            TLRENDER_ASSERT(!system->get("b", image));
+            TLRENDER_ASSERT(0 == system->getSize());
+        }
+
+        void ThumbnailSystemTest::_directory()
+        {
+            auto system = _context->getSystem<ThumbnailSystem>();
+            const std::string directory = file::createTempDir();
+            system->setDirectory(directory);
+            TLRENDER_ASSERT(directory == system->getDirectory());
+
+            // Thumbnails are read back from the directory after the memory
+            // cache is cleared.
+            const auto a = thumbnail(0);
+            const auto b = thumbnail(1);
+            system->add("a", a);
+            system->add("b", b);
+            system->clear();
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(system->get("a", image));
+            TLRENDER_ASSERT(compare(image, a));
+            TLRENDER_ASSERT(system->get("b", image));
+            TLRENDER_ASSERT(compare(image, b));
+            TLRENDER_ASSERT(!system->get("c", image));
+
+            // Invalid files are ignored.
+            file::ListOptions listOptions;
+            listOptions.sequence = false;
+            for (const auto& i : file::list(directory, listOptions))
+            {
+                auto io = file::FileIO::create(i.getPath().get(), file::Mode::Write);
+                io->write("invalid");
+            }
+            system->clear();
+            TLRENDER_ASSERT(!system->get("a", image));
+            TLRENDER_ASSERT(!system->get("b", image));
+            system->setDirectory(std::string());
+            system->clear();
+        }
+
+        void ThumbnailSystemTest::_requests()
+        {
+            auto system = _context->getSystem<ThumbnailSystem>();
+            system->setDirectory(std::string());
+            system->clear();
+
+            // Thumbnails are added and found on the worker thread.
+            const file::Path path("ThumbnailSystemTest.mov");
+            const otime::RationalTime time(0.0, 24.0);
+            const image::Size size(16, 9);
+            TLRENDER_ASSERT(!system->getThumbnail(path, time, 0, size).get());
+            const auto a = thumbnail(0);
+            system->addThumbnail(path, time, 0, size, a);
+            TLRENDER_ASSERT(system->getThumbnail(path, time, 0, size).get() == a);
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(system->get(getThumbnailKey(path, time, 0, size), image));
+            TLRENDER_ASSERT(image == a);
+
+            // Thumbnails with different color options are not shared.
+            ColorConfigOptions colorConfigOptions;
+            colorConfigOptions.enabled = true;
+            TLRENDER_ASSERT(!system->getThumbnail(path, time, 0, size, colorConfigOptions).get());
+            system->clear();
+        }
+    }
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class ThumbnailSystemTest : public tests::ITest
+        {
+        protected:
+            ThumbnailSystemTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<ThumbnailSystemTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _key();
+            void _cache();
+            void _directory();
+            void _requests();
+        };
+    }
+}
@@ -29,6 +29,7 @@ namespace tl
         {
             _enums();
             _ranges();
+            _chunks();
             _util();
         }
 
@@ -112,6 +113,61 @@ namespace tl
             }
         }
 
+        void UtilTest::_chunks()
+        {
+            {
+                size_t index = 0;
+                size_t count = 0;
+                parseChunk("1/4", index, count);
+                TLRENDER_ASSERT(0 == index);
+                TLRENDER_ASSERT(4 == count);
+                parseChunk("4/4", index, count);
+                TLRENDER_ASSERT(3 == index);
+                TLRENDER_ASSERT(4 == count);
+            }
+            for (const auto& value : { "", "1", "0/4", "5/4", "1/0", "a/b", "1/2/3" })
+            {
+                try
+                {
+                    size_t index = 0;
+                    size_t count = 0;
+                    parseChunk(value, index, count);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+            {
+                // The frames are split as evenly as possible, and the chunks
+                // cover the whole range without gaps.
+                const otime::TimeRange range(otime::RationalTime(10.0, 24.0), otime::RationalTime(10.0, 24.0));
+                const std::vector<otime::TimeRange> chunks =
+                {
+                    otime::TimeRange(otime::RationalTime(10.0, 24.0), otime::RationalTime(3.0, 24.0)),
+                    otime::TimeRange(otime::RationalTime(13.0, 24.0), otime::RationalTime(3.0, 24.0)),
+                    otime::TimeRange(otime::RationalTime(16.0, 24.0), otime::RationalTime(4.0, 24.0))
+                };
+                for (size_t i = 0; i < chunks.size(); ++i)
+                {
+                    TLRENDER_ASSERT(chunks[i] == getChunkRange(range, i, chunks.size()));
+                }
+                TLRENDER_ASSERT(range == getChunkRange(range, 0, 1));
+                const otime::TimeRange last = getChunkRange(range, 9, 10);
+                TLRENDER_ASSERT(otime::TimeRange(otime::RationalTime(19.0, 24.0), otime::RationalTime(1.0, 24.0)) == last);
+            }
+            for (const auto& i : std::vector<std::pair<size_t, size_t> >({ { 0, 0 }, { 1, 1 }, { 0, 11 } }))
+            {
+                try
+                {
+                    const otime::TimeRange range(otime::RationalTime(0.0, 24.0), otime::RationalTime(10.0, 24.0));
+                    getChunkRange(range, i.first, i.second);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
         void UtilTest::_util()
         {
             {
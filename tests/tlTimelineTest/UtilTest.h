@@ -23,6 +23,7 @@ namespace tl
         private:
             void _enums();
             void _ranges();
+            void _chunks();
             void _util();
         };
     }
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2023 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/VideoCacheTest.h>
+
+#include <tlTimeline/Util.h>
+#include <tlTimeline/VideoCache.h>
+
+#include <tlCore/Assert.h>
+
+#include <cmath>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        VideoCacheTest::VideoCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::VideoCacheTest", context)
+        {}
+
+        std::shared_ptr<VideoCacheTest> VideoCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<VideoCacheTest>(new VideoCacheTest(context));
+        }
+
+        void VideoCacheTest::run()
+        {
+            _window();
+            _loop();
+        }
+
+        namespace
+        {
+            VideoData videoData(double frame)
+            {
+                VideoData out;
+                out.time = otime::RationalTime(frame, 24.0);
+                return out;
+            }
+        }
+
+        void VideoCacheTest::_window()
+        {
+            const otime::TimeRange inOutRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(100.0, 24.0));
+            VideoCache cache;
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(0.0, 24.0)));
+            cache.add(videoData(0.0));
+            TLRENDER_ASSERT(0 == cache.getCount());
+
+            cache.setWindow(
+                { otime::TimeRange(otime::RationalTime(0.0, 24.0), otime::RationalTime(10.0, 24.0)) },
+                inOutRange);
+            TLRENDER_ASSERT(10 == cache.getWindowSize());
+            TLRENDER_ASSERT(cache.getSlotCount() >= cache.getWindowSize());
+            auto uncached = cache.getUncachedRanges();
+            TLRENDER_ASSERT(1 == uncached.size());
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(10.0, 24.0)) == uncached[0]);
+
+            for (size_t i = 0; i < 5; ++i)
+            {
+                cache.add(videoData(i));
+            }
+            cache.add(videoData(7.0));
+            cache.add(videoData(20.0));
+            TLRENDER_ASSERT(6 == cache.getCount());
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(20.0, 24.0)));
+            VideoData value;
+            TLRENDER_ASSERT(cache.get(otime::RationalTime(3.0, 24.0), value));
+            TLRENDER_ASSERT(otime::RationalTime(3.0, 24.0) == value.time);
+            TLRENDER_ASSERT(!cache.get(otime::RationalTime(5.0, 24.0), value));
+            auto cached = cache.getCachedRanges();
+            TLRENDER_ASSERT(2 == cached.size());
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(5.0, 24.0)) == cached[0]);
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(7.0, 24.0),
+                otime::RationalTime(1.0, 24.0)) == cached[1]);
+            uncached = cache.getUncachedRanges();
+            TLRENDER_ASSERT(2 == uncached.size());
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(5.0, 24.0),
+                otime::RationalTime(2.0, 24.0)) == uncached[0]);
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(8.0, 24.0),
+                otime::RationalTime(2.0, 24.0)) == uncached[1]);
+
+            cache.add(videoData(5.0));
+            cache.add(videoData(6.0));
+            cached = cache.getCachedRanges();
+            TLRENDER_ASSERT(1 == cached.size());
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(8.0, 24.0)) == cached[0]);
+
+            cache.setWindow(
+                { otime::TimeRange(otime::RationalTime(3.0, 24.0), otime::RationalTime(10.0, 24.0)) },
+                inOutRange);
+            TLRENDER_ASSERT(5 == cache.getCount());
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(2.0, 24.0)));
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(3.0, 24.0)));
+            cached = cache.getCachedRanges();
+            TLRENDER_ASSERT(1 == cached.size());
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(3.0, 24.0),
+                otime::RationalTime(5.0, 24.0)) == cached[0]);
+
+            cache.setWindow(
+                { otime::TimeRange(otime::RationalTime(50.0, 24.0), otime::RationalTime(20.0, 24.0)) },
+                inOutRange);
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(cache.getCachedRanges().empty());
+
+            cache.add(videoData(50.0));
+            TLRENDER_ASSERT(1 == cache.getCount());
+            cache.clear();
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(50.0, 24.0)));
+
+            cache.setWindow({}, inOutRange);
+            TLRENDER_ASSERT(0 == cache.getSlotCount());
+        }
+
+        void VideoCacheTest::_loop()
+        {
+            for (const double duration : { 11.0, 19.0, 25.0, 97.0, 1000.0 })
+            {
+                const otime::TimeRange inOutRange(
+                    otime::RationalTime(10.0, 24.0),
+                    otime::RationalTime(duration, 24.0));
+                VideoCache cache;
+                for (double t = 0.0; t < duration * 2.0; t += 1.0)
+                {
+                    const otime::RationalTime currentTime =
+                        inOutRange.start_time() +
+                        otime::RationalTime(std::fmod(t, duration), 24.0);
+                    const auto ranges = timeline::loop(
+                        otime::TimeRange::range_from_start_end_time_inclusive(
+                            currentTime - otime::RationalTime(2.0, 24.0),
+                            currentTime + otime::RationalTime(7.0, 24.0)),
+                        inOutRange);
+                    cache.setWindow(ranges, inOutRange);
+                    for (const auto& range : cache.getUncachedRanges())
+                    {
+                        for (const auto& time : time::frames(range))
+                        {
+                            cache.add(videoData(time.value()));
+                        }
+                    }
+                    TLRENDER_ASSERT(cache.getUncachedRanges().empty());
+                    size_t count = 0;
+                    for (const auto& range : ranges)
+                    {
+                        for (const auto& time : time::frames(range))
+                        {
+                            TLRENDER_ASSERT(cache.contains(time));
+                            ++count;
+                        }
+                    }
+                    TLRENDER_ASSERT(count == cache.getCount());
+                }
+            }
+        }
+    }
+}
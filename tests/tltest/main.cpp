@@ -8,22 +8,36 @@
 #endif // TLRENDER_QT5 || TLRENDER_QT6
 
 #include <tlGLTest/MeshTest.h>
+#include <tlGLTest/OffscreenContextTest.h>
+#include <tlGLTest/PixelBufferRingTest.h>
+#include <tlGLTest/ShaderCacheTest.h>
 #include <tlGL/Init.h>
 
 #include <tlAppTest/AppTest.h>
+#if defined(TLRENDER_GLFW) && defined(TLRENDER_PROGRAMS)
+#include <tlAppTest/BakeAppTest.h>
+#endif // TLRENDER_GLFW && TLRENDER_PROGRAMS
 #include <tlAppTest/CmdLineTest.h>
 
+#include <tlTimelineTest/CacheControllerTest.h>
 #include <tlTimelineTest/ColorConfigOptionsTest.h>
+#include <tlTimelineTest/CPURenderTest.h>
+#include <tlTimelineTest/FrameCacheSystemTest.h>
+#include <tlTimelineTest/GLRenderTest.h>
 #include <tlTimelineTest/IRenderTest.h>
 #include <tlTimelineTest/LUTOptionsTest.h>
+#include <tlTimelineTest/PlayerStatsTest.h>
 #include <tlTimelineTest/PlayerTest.h>
+#include <tlTimelineTest/ThumbnailSystemTest.h>
 #include <tlTimelineTest/TimelineTest.h>
 #include <tlTimelineTest/UtilTest.h>
+#include <tlTimelineTest/VideoCacheTest.h>
 
 #include <tlIOTest/CineonTest.h>
 #include <tlIOTest/DPXTest.h>
 #include <tlIOTest/IOTest.h>
 #include <tlIOTest/PPMTest.h>
+#include <tlIOTest/RawTest.h>
 #include <tlIOTest/SGITest.h>
 #if defined(TLRENDER_FFMPEG)
 #include <tlIOTest/FFmpegTest.h>
@@ -44,6 +58,9 @@
 #include <tlIOTest/STBTest.h>
 #endif // TLRENDER_STB
 
+#include <tlCoreTest/AudioPeaksTest.h>
+#include <tlCoreTest/AudioRingBufferTest.h>
+#include <tlCoreTest/AudioSIMDTest.h>
 #include <tlCoreTest/AudioTest.h>
 #include <tlCoreTest/BoxTest.h>
 #include <tlCoreTest/ColorTest.h>
@@ -65,6 +82,7 @@
 #include <tlCoreTest/OSTest.h>
 #include <tlCoreTest/PathTest.h>
 #include <tlCoreTest/RangeTest.h>
+#include <tlCoreTest/StagingCacheTest.h>
 #include <tlCoreTest/StringTest.h>
 #include <tlCoreTest/StringFormatTest.h>
 #include <tlCoreTest/TimeTest.h>
@@ -117,6 +135,9 @@ int main(int argc, char* argv[])
     {
         if (1)
         {
+            tests.push_back(core_tests::AudioPeaksTest::create(context));
+            tests.push_back(core_tests::AudioRingBufferTest::create(context));
+            tests.push_back(core_tests::AudioSIMDTest::create(context));
             tests.push_back(core_tests::AudioTest::create(context));
             tests.push_back(core_tests::BoxTest::create(context));
             tests.push_back(core_tests::ColorTest::create(context));
@@ -138,6 +159,7 @@ int main(int argc, char* argv[])
             tests.push_back(core_tests::OSTest::create(context));
             tests.push_back(core_tests::PathTest::create(context));
             tests.push_back(core_tests::RangeTest::create(context));
+            tests.push_back(core_tests::StagingCacheTest::create(context));
             tests.push_back(core_tests::StringTest::create(context));
             tests.push_back(core_tests::StringFormatTest::create(context));
             tests.push_back(core_tests::TimeTest::create(context));
@@ -150,6 +172,7 @@ int main(int argc, char* argv[])
             tests.push_back(io_tests::DPXTest::create(context));
             tests.push_back(io_tests::IOTest::create(context));
             tests.push_back(io_tests::PPMTest::create(context));
+            tests.push_back(io_tests::RawTest::create(context));
             tests.push_back(io_tests::SGITest::create(context));
 #if defined(TLRENDER_FFMPEG)
             tests.push_back(io_tests::FFmpegTest::create(context));
@@ -172,22 +195,35 @@ int main(int argc, char* argv[])
         }
         if (1)
         {
+            tests.push_back(timeline_tests::CacheControllerTest::create(context));
             tests.push_back(timeline_tests::ColorConfigOptionsTest::create(context));
+            tests.push_back(timeline_tests::CPURenderTest::create(context));
+            tests.push_back(timeline_tests::FrameCacheSystemTest::create(context));
+            tests.push_back(timeline_tests::GLRenderTest::create(context));
             tests.push_back(timeline_tests::IRenderTest::create(context));
             tests.push_back(timeline_tests::LUTOptionsTest::create(context));
+            tests.push_back(timeline_tests::PlayerStatsTest::create(context));
             tests.push_back(timeline_tests::PlayerTest::create(context));
+            tests.push_back(timeline_tests::ThumbnailSystemTest::create(context));
             tests.push_back(timeline_tests::TimelineTest::create(context));
             tests.push_back(timeline_tests::UtilTest::create(context));
+            tests.push_back(timeline_tests::VideoCacheTest::create(context));
         }
         if (1)
         {
             tests.push_back(app_tests::AppTest::create(context));
+#if defined(TLRENDER_GLFW) && defined(TLRENDER_PROGRAMS)
+            tests.push_back(app_tests::BakeAppTest::create(context));
+#endif // TLRENDER_GLFW && TLRENDER_PROGRAMS
             tests.push_back(app_tests::CmdLineTest::create(context));
         }
         if (1)
         {
 #if defined(TLRENDER_GL)
             tests.push_back(gl_tests::MeshTest::create(context));
+            tests.push_back(gl_tests::OffscreenContextTest::create(context));
+            tests.push_back(gl_tests::PixelBufferRingTest::create(context));
+            tests.push_back(gl_tests::ShaderCacheTest::create(context));
 #endif // TLRENDER_GL
         }
         if (1)